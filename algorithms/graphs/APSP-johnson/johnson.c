@@ -21,6 +21,8 @@
 // other nodes in G with zero-weight edges; returns this new source
 vertex *extendGraph(graph *G) {
   vertex *src = addVertexR(G, "srcExt");
+    // the original vertices have indices 0..n-1 
+  src->index = nVertices(G) - 1;
   for (vertex *v = firstV(G); v; v = nextV(G)) 
     if (v != src) 
       addEdgeW(G, src, v, 0);
@@ -133,20 +135,36 @@ char *vertexToString(void const *key) {
   return v->label;
 }
 
+//===================================================================
+// Index of the data in the priority queue, so that the queue
+// can keep the positions of the vertices in an array
+size_t vertexToIndex(void const *key) {
+  return ((vertex *)key)->index;
+}
+
 //===================================================================
 // Generates and initializes the min priority queue
 // All vertices are added to the priority queue with infinite
 // distance from the source node and likewise infinite priority
 // The distance and priority of the source node is set to 0
+// The queue is built in one go, in linear time
 bpqueue *initPQ(graph *G, vertex *src) {
 
-  bpqueue *pq = bpqNew(nVertices(G), MIN, compareKeys, copyKey, 
+  size_t n = nVertices(G), i = 0;
+  bpqueue *pq = bpqNew(n, MIN, compareKeys, copyKey, 
                        free, vertexToString, NULL);
+  bpqSetToIndex(pq, vertexToIndex, n);
   
-  for (vertex *v = firstV(G); v; v = nextV(G)) {
+  void **data = safeCalloc(n, sizeof(void *));
+  void **keys = safeCalloc(n, sizeof(void *));
+  for (vertex *v = firstV(G); v; v = nextV(G), i++) {
     v->dDist = v == src ? 0 : DBL_MAX;
-    bpqPush(pq, v, &v->dDist);
+    data[i] = v;
+    keys[i] = &v->dDist;
   }
+  bpqBuild(pq, data, keys, n);
+  free(data);
+  free(keys);
   return pq;
 }
 
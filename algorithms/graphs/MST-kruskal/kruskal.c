@@ -16,48 +16,36 @@
 */
 
 #include "../../../datastructures/graphs/graph/graph.h"
-#include "../../../datastructures/union-find/unionFind.h"
+#include "../../../datastructures/union-find/denseUnionFind.h"
 #include "../../../datastructures/heaps/binheaps/binheap.h"
 
 //===================================================================
-// Comparison function for the edges
-int compareEdges(void const *e1, void const *e2) {
-  edge *edge1 = (edge *)e1;
-  edge *edge2 = (edge *)e2;
-  if (edge1->weight < edge2->weight) return -1;
-  if (edge1->weight > edge2->weight) return 1;
-  return 0;
-}
-
-//===================================================================
-// String representation of the data in the union-find structure
-char *vertexToString(void const *key) {
-  vertex *v = (vertex *)key;
-  return v->label;
-}
-
-//===================================================================
-// Creates a binary heap from the edges of the graph
+// Creates a binary heap from the edges of the graph; the weights
+// are kept inline in the heap, so that the sifts do not have to
+// follow the edge pointers
 binheap *initBinHeap(graph *G) {
-  binheap *H = bhpNew(nEdges(G), MIN, compareEdges);
+  binheap *H = bhpNew(nEdges(G), MIN, NULL);
+  bhpSetKeyType(H, BHP_DOUBLE);
   
   vertex *from;
   for (edge *e = firstE(G, &from); e; e = nextE(G, &from)) {
     if (e->reversed) continue;
     e->from = from;
-    bhpPush(H, e);
+    bhpPushKey(H, e, (bhpKey){.d = e->weight});
   }
   return H;
 }
 
 //===================================================================
 // Creates a new union-find data structure with |V| sets:
-// one for each vertex in the graph
-unionFind *initUnionFind(graph *G) {
-  unionFind *sets = ufNew(nVertices(G), vertexToString);
+// one for each vertex in the graph, which is numbered so that
+// its index is the element of its set
+denseUF *initUnionFind(graph *G) {
+  denseUF *sets = dufNew(nVertices(G));
   
+  size_t i = 0;
   for (vertex *v = firstV(G); v; v = nextV(G)) 
-    ufAddSet(sets, v);
+    v->index = i++;
   return sets;
 }
 
@@ -67,7 +55,7 @@ dll *mstKruskal(graph *G) {
 
   dll *mst = dllNew();
   binheap *H = initBinHeap(G);
-  unionFind *sets = initUnionFind(G);
+  denseUF *sets = initUnionFind(G);
   
     // add |V|-1 edges to the MST without forming a cycle
   while (dllSize(mst) < nVertices(G) - 1) { 
@@ -75,13 +63,12 @@ dll *mstKruskal(graph *G) {
     edge *e = bhpPop(H);
   
       // only add e to the MST if the edge connects
-      // two different sets, so that no cycle is formed
-    if (! ufSameSet(sets, e->from, e->to)) {
+      // two different sets, so that no cycle is formed;
+      // the sets are unified at the same time
+    if (dufUnify(sets, e->from->index, e->to->index))
       dllPushBack(mst, e);
-      ufUnify(sets, e->from, e->to);
-    }
   }
-  ufFree(sets);
+  dufFree(sets);
   bhpFree(H);
   return mst;
 }
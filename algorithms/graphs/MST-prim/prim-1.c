@@ -42,6 +42,13 @@ char *vertexToString(void const *key) {
   return v->label;
 }
 
+//===================================================================
+// Index of the data in the priority queue, so that the queue
+// can keep the positions of the vertices in an array
+size_t vertexToIndex(void const *key) {
+  return ((vertex *)key)->index;
+}
+
 //===================================================================
 // Generates and initializes the min priority queue
 // All vertices are added to the priority queue with infinite
@@ -52,8 +59,11 @@ bpqueue *initPQ(graph *G) {
 
   bpqueue *pq = bpqNew(nVertices(G), MIN, compareKeys, copyKey, 
                        free, vertexToString, NULL);
+  bpqSetToIndex(pq, vertexToIndex, nVertices(G));
   
+  size_t i = 0;
   for (vertex *v = firstV(G); v; v = nextV(G)) {
+    v->index = i++;
     v->dist = DBL_MAX;
     bpqPush(pq, v, &v->dist);
   }
@@ -17,14 +17,6 @@
 #include "../../../lib/clib.h"
 #include <float.h>
 
-//===================================================================
-// Copies the key (priority) of a node in the priority queue
-void *copyKey (void const *key) {
-  double *copy = safeCalloc(1, sizeof(double));
-  *copy = *(double *)key;
-  return copy;
-}
-
 //===================================================================
 // Comparison function for the priority queue
 int compareKeys(void const *k1, void const *k2) {
@@ -42,18 +34,32 @@ char *vertexToString(void const *key) {
   return v->label;
 }
 
+//===================================================================
+// Index of the data in the priority queue, so that the heap
+// can keep its nodes in an array
+size_t vertexToIndex(void const *key) {
+  return ((vertex *)key)->index;
+}
+
 //===================================================================
 // Generates and initializes the min priority queue
 // All vertices are added to the priority queue with infinite
 // distance from the growing minimum spanning tree and likewise
 // infinite priority. An arbitrary vertex is selected as the
 // source vertex and its distance and priority are set to 0
+// The keys are doubles stored in the nodes of the heap, and the
+// nodes are found through the indices of the vertices, so that 
+// no keys are copied and no hashing is done
 fibheap *initFibHeap(graph *G) {
 
-  fibheap *F = fibNew(MIN, compareKeys, copyKey, 
-                      free, vertexToString, NULL);
+  fibheap *F = fibNew(MIN, compareKeys, NULL, 
+                      NULL, vertexToString, NULL);
+  fibSetKeyType(F, FIB_DOUBLE);
+  fibSetToIndex(F, vertexToIndex, nVertices(G));
   
+  size_t i = 0;
   for (vertex *v = firstV(G); v; v = nextV(G)) {
+    v->index = i++;
     v->dist = DBL_MAX;
     fibPush(F, v, &v->dist);
   }
@@ -40,6 +40,13 @@ char *vertexToString(void const *key) {
   return v->label;
 }
 
+//===================================================================
+// Index of the data in the priority queue, so that the queue
+// can keep the positions of the vertices in an array
+size_t vertexToIndex(void const *key) {
+  return ((vertex *)key)->index;
+}
+
 //===================================================================
 // Tries to 'relax' the edge (u, v) with weight w
 // Returns true if relaxation was successful
@@ -61,8 +68,11 @@ bpqueue *initPQ(graph *G, vertex *src) {
 
   bpqueue *pq = bpqNew(nVertices(G), MIN, compareKeys, copyKey, 
                        free, vertexToString, NULL);
+  bpqSetToIndex(pq, vertexToIndex, nVertices(G));
   
+  size_t i = 0;
   for (vertex *v = firstV(G); v; v = nextV(G)) {
+    v->index = i++;
     v->dist = v == src ? 0 : DBL_MAX;
     bpqPush(pq, v, &v->dist);
   }
@@ -15,14 +15,6 @@
 #include "../../../lib/clib.h"
 #include <float.h>
 
-//===================================================================
-// Copies the key (priority) of a node in the priority queue
-void *copyKey (void const *key) {
-  double *copy = safeCalloc(1, sizeof(double));
-  *copy = *(double *)key;
-  return copy;
-}
-
 //===================================================================
 // Comparison function for the priority queue
 int compareKeys(void const *k1, void const *k2) {
@@ -40,6 +32,13 @@ char *vertexToString(void const *key) {
   return v->label;
 }
 
+//===================================================================
+// Index of the data in the priority queue, so that the heap
+// can keep its nodes in an array
+size_t vertexToIndex(void const *key) {
+  return ((vertex *)key)->index;
+}
+
 //===================================================================
 // Tries to 'relax' the edge (u, v) with weight w
 // Returns true if relaxation was successful
@@ -57,15 +56,29 @@ bool relax(vertex *u, vertex *v, double w) {
 // All vertices are added to the priority queue with infinite
 // distance from the source node and likewise infinite priority
 // The distance and priority of the source node is set to 0
+// All vertices are inserted into the root list at once
+// The keys are doubles stored in the nodes of the heap, and the
+// nodes are found through the indices of the vertices, so that 
+// no keys are copied and no hashing is done
 fibheap *initFibHeap(graph *G, vertex *src) {
 
-  fibheap *F = fibNew(MIN, compareKeys, copyKey, 
-                      free, vertexToString, NULL);
+  size_t n = nVertices(G), i = 0;
+  fibheap *F = fibNew(MIN, compareKeys, NULL, 
+                      NULL, vertexToString, NULL);
+  fibSetKeyType(F, FIB_DOUBLE);
+  fibSetToIndex(F, vertexToIndex, n);
   
-  for (vertex *v = firstV(G); v; v = nextV(G)) {
+  void **data = safeCalloc(n, sizeof(void *));
+  void **keys = safeCalloc(n, sizeof(void *));
+  for (vertex *v = firstV(G); v; v = nextV(G), i++) {
+    v->index = i;
     v->dist = v == src ? 0 : DBL_MAX;
-    fibPush(F, v, &v->dist);
+    data[i] = v;
+    keys[i] = &v->dist;
   }
+  fibBuild(F, data, keys, n);
+  free(data);
+  free(keys);
   return F;
 }
 
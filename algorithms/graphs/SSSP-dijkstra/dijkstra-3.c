@@ -0,0 +1,212 @@
+/*
+  file: dijkstra-3.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: Dijkstra's shortest paths algorithm for graphs
+    with non-negative integer weights
+  time complexity: O(E log C) using a radix heap, where C is
+    the largest edge weight: every relaxation pushes a new
+    entry instead of decreasing a key, so that the heap holds
+    up to E entries, each of which moves through at most
+    log C buckets; if some weight is not a non-negative
+    integer, the binary heap version is used, which takes
+    O(E log V)
+  note: make sure to use VERTEX_TYPE2 in the vertex.h file
+    by defining it from the command line using
+      $ gcc -D VERTEX_TYPE2 ...
+*/
+
+#include "../../../datastructures/heaps/radixheaps/radixheap.h"
+#include "../../../datastructures/heaps/bpqueues/bpqueue.h"
+#include "../../../datastructures/graphs/graph/graph.h"
+#include "../../../lib/clib.h"
+#include <float.h>
+
+  // weights up to this bound keep all distances exact
+  // in the double dist field of the vertices
+#define MAX_INT_WEIGHT 4294967295.0
+
+//===================================================================
+// Copies the key (priority) of a node in the priority queue
+void *copyKey (void const *key) {
+  double *copy = safeCalloc(1, sizeof(double));
+  *copy = *(double *)key;
+  return copy;
+}
+
+//===================================================================
+// Comparison function for the priority queue
+int compareKeys(void const *k1, void const *k2) {
+  double d1 = *(double *)k1;
+  double d2 = *(double *)k2;
+  if (d1 < d2) return -1;
+  if (d1 > d2) return 1;
+  return 0;
+}
+
+//===================================================================
+// String representation of the data in the priority queue
+char *vertexToString(void const *key) {
+  vertex *v = (vertex *)key;
+  return v->label;
+}
+
+//===================================================================
+// Index of the data in the priority queue, so that the queue
+// can keep the positions of the vertices in an array
+size_t vertexToIndex(void const *key) {
+  return ((vertex *)key)->index;
+}
+
+//===================================================================
+// Tries to 'relax' the edge (u, v) with weight w
+// Returns true if relaxation was successful
+bool relax(vertex *u, vertex *v, double w) {
+  if (v->dist > u->dist + w) {
+    v->dist = u->dist + w;
+    v->parent = u;
+    return true;
+  }
+  return false;
+}
+
+//===================================================================
+// Returns true if all edge weights are non-negative integers
+bool hasIntWeights(graph *G) {
+  vertex *from;
+  for (edge *e = firstE(G, &from); e; e = nextE(G, &from)) {
+    double w = e->weight;
+    if (w < 0 || w > MAX_INT_WEIGHT || w != (uint64_t)w)
+      return false;
+  }
+  return true;
+}
+
+//===================================================================
+// Computes the shortest paths from vertex src to all other nodes
+// using a radix heap; a vertex is pushed again each time its
+// distance decreases, and the outdated entries are skipped
+void dijkstraRadix(graph *G, vertex *src) {
+
+  for (vertex *v = firstV(G); v; v = nextV(G))
+    v->dist = DBL_MAX;
+  src->dist = 0;
+
+  radixheap *H = rhpNew();
+  rhpPush(H, src, 0);
+
+  uint64_t d;
+  while (! rhpIsEmpty(H)) {
+    vertex *u = rhpPop(H, &d);
+    if (d != (uint64_t)u->dist)
+      continue;                     // outdated entry
+    dll* edges = getNeighbors(G, u);
+
+      // try to relax all the edges from u to its neighbors
+    for (edge *e = dllFirst(edges); e; e = dllNext(edges))
+      if (relax(u, e->to, e->weight))
+        rhpPush(H, e->to, (uint64_t)e->to->dist);
+  }
+  rhpFree(H);
+}
+
+//===================================================================
+// Generates and initializes the min priority queue
+// All vertices are added to the priority queue with infinite
+// distance from the source node and likewise infinite priority
+// The distance and priority of the source node is set to 0
+bpqueue *initPQ(graph *G, vertex *src) {
+
+  bpqueue *pq = bpqNew(nVertices(G), MIN, compareKeys, copyKey,
+                       free, vertexToString, NULL);
+  bpqSetToIndex(pq, vertexToIndex, nVertices(G));
+
+  size_t i = 0;
+  for (vertex *v = firstV(G); v; v = nextV(G)) {
+    v->index = i++;
+    v->dist = v == src ? 0 : DBL_MAX;
+    bpqPush(pq, v, &v->dist);
+  }
+  return pq;
+}
+
+//===================================================================
+// Computes the shortest paths from vertex src to all other nodes
+// using a binary heap
+void dijkstraHeap(graph *G, vertex *src) {
+
+  bpqueue *pq = initPQ(G, src);
+
+  while (! bpqIsEmpty(pq)) {
+    vertex *u = bpqPop(pq);
+    dll* edges = getNeighbors(G, u);
+
+    for (edge *e = dllFirst(edges); e; e = dllNext(edges))
+      if (bpqContains(pq, e->to) && relax(u, e->to, e->weight))
+        bpqUpdateKey(pq, e->to, &e->to->dist);
+  }
+  bpqFree(pq);
+}
+
+//===================================================================
+// Computes the shortest paths from vertex src to all other nodes,
+// using the radix heap if all weights are integral
+void dijkstra(graph *G, vertex *src) {
+  if (hasIntWeights(G))
+    dijkstraRadix(G, src);
+  else
+    dijkstraHeap(G, src);
+}
+
+//===================================================================
+// Shows the results of the shortest paths computation from src
+// displaying the parent and the distance from the source vertex for
+// each vertex in the graph; by following the parent pointers, the
+// shortest path from the source vertex to any other vertex can be
+// reconstructed
+void showDistances(graph *G, vertex *src) {
+  printf("\nShortest paths\n"
+         "Source: %s\n"
+         "---------------------------------\n"
+         "Vertex: Parent, Distance from src\n"
+         "---------------------------------\n",
+         src->label);
+
+  for (vertex *v = firstV(G); v; v = nextV(G)) {
+    printf("  %s: %s, ", v->label,
+           v->parent ? v->parent->label : "NIL");
+    if (v->dist == DBL_MAX)
+      printf("%s\n", "INF");
+    else
+      printf("%.2lf\n", v->dist);
+  }
+  printf("---------------------------------\n\n");
+}
+
+//===================================================================
+
+int main () {
+
+    // read the label of the source vertex
+  char srcL[50];
+  assert(scanf("%s", srcL) == 1);
+
+  graph *G = newGraph(50, WEIGHTED);
+  readGraph(G);
+  showGraph(G);
+
+  vertex *src = getVertex(G, srcL);
+
+  if (! src) {
+    fprintf(stderr, "Source node %s not found.\n", srcL);
+    freeGraph(G);
+    exit(EXIT_FAILURE);
+  }
+
+  dijkstra(G, src);
+  showDistances(G, src);
+
+  freeGraph(G);
+  return 0;
+}
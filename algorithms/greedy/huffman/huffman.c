@@ -34,12 +34,6 @@ node *newNode () {
   return n;
 }
 
-//===================================================================
-// Comparison function for the binary heap
-int cmpNodesByFreq (void const *a, void const *b) {
-  return ((node *)a)->freq - ((node *)b)->freq;
-}
-
 //===================================================================
 // Deallocates the tree
 void freeTree (node *n) {
@@ -67,14 +61,16 @@ binheap *readInput () {
       // only chars from 32 to 255 are considered
     if (ch >= 32 && ch < LENGTH)  
       freqs[ch - 0]++;
-    // make a min binary heap with a node for each character
-  binheap *H = bhpNew(LENGTH, MIN, cmpNodesByFreq);
+    // make a min binary heap with a node for each character,
+    // keeping the frequencies inline as keys
+  binheap *H = bhpNew(LENGTH, MIN, NULL);
+  bhpSetKeyType(H, BHP_UINT64);
   for (size_t i = 0; i < LENGTH; ++i)
     if (freqs[i]) {
       node *n = newNode();
       n->ch = i;
       n->freq = freqs[i];
-      bhpPush(H, n);
+      bhpPushKey(H, n, (bhpKey){.u = n->freq});
     }
   return H;
 }
@@ -135,7 +131,7 @@ node *huffman (binheap *H) {
     z->left = bhpPop(H);
     z->right = bhpPop(H);
     z->freq = z->left->freq + z->right->freq;
-    bhpPush(H, z);
+    bhpPushKey(H, z, (bhpKey){.u = z->freq});
   }
   return bhpPop(H);
 }
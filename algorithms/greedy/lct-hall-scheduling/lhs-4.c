@@ -37,15 +37,6 @@ int cmpActivities(void const *a, void const *b) {
   return ((activity *)a)->start - ((activity *)b)->start;
 }
 
-//===================================================================
-// Compares two halls by the end time of the last activity in their
-// schedules
-int cmpHalls(void const *a, void const *b) {
-  hall *h1 = (hall *)a;
-  hall *h2 = (hall *)b;
-  return h1->sch[h1->schSize - 1].end - h2->sch[h2->schSize - 1].end;
-}
-
 //===================================================================
 // Shows an activity
 void showActivity(activity act) {
@@ -94,22 +85,24 @@ size_t scheduleActivities(activity *acts, size_t nActs,
 
     // create a binary heap for keeping track of occupied halls;
     // the min heap is ordered by the end time of the last 
-    // activity in each hall's schedule
-  binheap *occupied = bhpNew(nActs, MIN, cmpHalls);
+    // activity in each hall's schedule, kept inline as key
+  binheap *occupied = bhpNew(nActs, MIN, NULL);
+  bhpSetKeyType(occupied, BHP_UINT64);
   hall *h; size_t nHalls = 0;
 
     // assign each activity to the earliest available hall
   for (size_t i = 0; i < nActs; i++) {
     if ((h = bhpPeek(occupied))
-        && acts[i].start >= h->sch[h->schSize-1].end) {
+        && acts[i].start >= bhpPeekKey(occupied).u) {
         // if any of the halls in use is about to become
         // available, assign the activity to that hall
       h->sch[h->schSize++] = acts[i];
-      bhpHeapify(occupied, 0);
+      bhpSetTopKey(occupied, (bhpKey){.u = acts[i].end});
     } else {
         // assign activity to a new hall
       halls[nHalls] = newHall(nHalls + 1, acts[i], nActs);
-      bhpPush(occupied, halls[nHalls++]);
+      bhpPushKey(occupied, halls[nHalls++],
+                 (bhpKey){.u = acts[i].end});
     }
   }
   bhpFree(occupied);
@@ -0,0 +1,155 @@
+/*
+  file: lhs-5.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: lecture hall scheduling (LHS)
+               online, using an interval tree
+  time complexity: O(n k log n) where n is the number of activities
+    and k the largest number of activities that overlap one activity
+  note: unlike the other versions, this version does not need all
+        activities in advance: each activity is assigned to a hall
+        as soon as it is read, namely to the hall with the lowest
+        number that is free during the whole activity. The halls
+        that are busy are found by asking an interval tree of all
+        assigned activities for the ones that overlap the new one.
+        If the activities arrive in order of their start times, the
+        schedule uses the minimum number of halls; otherwise, this
+        first-fit strategy may need more halls than the offline
+        versions lhs-1.c to lhs-4.c
+*/
+
+#include "../../../lib/clib.h"
+#include "../../../datastructures/trees/intervaltrees/itree.h"
+
+//===================================================================
+// Defines an activity
+typedef struct {
+  size_t id;               // activity id based on input order
+  size_t start;            // start time
+  size_t end;              // end time
+} activity;
+
+//===================================================================
+// Defines a lecture hall
+typedef struct {
+  size_t id;               // hall id
+  activity *sch;           // schedule of activities
+  size_t schSize;          // number of activities in the schedule
+  size_t schCap;           // capacity of the schedule
+} hall;
+
+//===================================================================
+// Defines the state of the scheduler
+typedef struct {
+  itree *booked;           // intervals of all assigned activities
+  hall **halls;            // halls in use
+  size_t nHalls;           // number of halls in use
+  size_t cap;              // capacity of the halls array
+  size_t *busy;            // busy[i] = id of the last activity for
+                           // which hall i + 1 was found busy
+  size_t actId;            // id of the activity being assigned
+} scheduler;
+
+//===================================================================
+// Compares two activities by their start time
+int cmpActivities(void const *a, void const *b) {
+  activity *a1 = (activity *)a, *a2 = (activity *)b;
+  return (a1->start > a2->start) - (a1->start < a2->start);
+}
+
+//===================================================================
+// Shows an activity
+void showActivity(activity act) {
+  printf("Act %zu: [ %zu, %zu )\n", act.id, act.start, act.end);
+}
+
+//===================================================================
+// Creates a new lecture hall
+hall *newHall(size_t id) {
+  hall *h = safeCalloc(1, sizeof(hall));
+  h->schCap = 8;
+  h->sch = safeCalloc(h->schCap, sizeof(activity));
+  h->id = id;
+  return h;
+}
+
+//===================================================================
+// Marks the hall of a booked activity as busy during the
+// activity being assigned
+void markBusy(itnode *x, void *arg) {
+  scheduler *S = arg;
+  S->busy[((hall *)x->data)->id - 1] = S->actId;
+}
+
+//===================================================================
+// Assigns an activity to the free hall with the lowest number,
+// or to a new hall if all halls are busy during the activity
+void assignActivity(scheduler *S, activity act) {
+
+  S->actId = act.id;
+  itAllOverlaps(S->booked, act.start, act.end, markBusy, S);
+
+  size_t i = 0;
+  while (i < S->nHalls && S->busy[i] == act.id)
+    i++;
+  if (i == S->nHalls) {
+    if (S->nHalls == S->cap) {
+      S->cap *= 2;
+      S->halls = safeRealloc(S->halls, S->cap * sizeof(hall *));
+      S->busy = safeRealloc(S->busy, S->cap * sizeof(size_t));
+    }
+    S->halls[S->nHalls] = newHall(S->nHalls + 1);
+    S->busy[S->nHalls++] = 0;
+  }
+
+  hall *h = S->halls[i];
+  if (h->schSize == h->schCap) {
+    h->schCap *= 2;
+    h->sch = safeRealloc(h->sch, h->schCap * sizeof(activity));
+  }
+  h->sch[h->schSize++] = act;
+  itInsert(S->booked, act.start, act.end, h);
+}
+
+//===================================================================
+// Shows the number of halls and their schedules, sorted by the
+// start times of the activities
+void showSchedules(scheduler *S) {
+  printf("Number of halls: %zu\n\n"
+         "SCHEDULES\n", S->nHalls);
+  for (size_t i = 0; i < S->nHalls; i++) {
+    hall *h = S->halls[i];
+    qsort(h->sch, h->schSize, sizeof(activity), cmpActivities);
+    printf("\n---------\n"
+           " Hall %zu"
+           "\n---------\n", h->id);
+    for (size_t j = 0; j < h->schSize; j++)
+      showActivity(h->sch[j]);
+    free(h->sch);
+    free(h);
+  }
+  printf("\n");
+}
+
+//===================================================================
+
+int main() {
+
+  scheduler S = {itNew(), NULL, 0, 8, NULL, 0};
+  S.halls = safeCalloc(S.cap, sizeof(hall *));
+  S.busy = safeCalloc(S.cap, sizeof(size_t));
+
+    // read and assign the activities one by one
+  activity act = {0, 0, 0};
+  while (scanf(" [ %zu , %zu ) , ", &act.start, &act.end) == 2) {
+    act.id++;
+    assignActivity(&S, act);
+  }
+
+  showSchedules(&S);
+  itFree(S.booked);
+  free(S.halls);
+  free(S.busy);
+  return 0;
+}
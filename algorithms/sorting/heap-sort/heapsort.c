@@ -16,13 +16,6 @@ void showInt(void const *a) {
   printf("%d", *(int *)a);
 }
 
-//===================================================================
-// Comparison function for integers
-// returns < 0 if a < b, 0 if a == b, > 0 if a > b
-int cmpInts(void const *a, void const *b) {
-  return *(int *)a - *(int *)b;
-}
-
 //===================================================================
 // Sorts a heap 
 void heapsort(binheap *H){
@@ -30,6 +23,7 @@ void heapsort(binheap *H){
   for (size_t i = H->size - 1; i >= 1; --i) {
       // swap the root with the heap's last element
     SWAP(H->arr[0], H->arr[i]);
+    SWAP(H->keys[0], H->keys[i]);
       // remove the last element from the heap 
       // by decreasing its size
     H->size--;
@@ -47,9 +41,15 @@ int main (){
     // reads the input array, sets the size
   READ(int, arr, "%d", size);
 
+    // the heap keeps the integers inline as keys, so that
+    // the sifts do not have to follow the pointers
+  bhpKey *keys = safeCalloc(size, sizeof(bhpKey));
+  for (size_t i = 0; i < size; i++)
+    keys[i].d = arr[i];
+
     // builds a max heap, sorts in ascending order
-  binheap *H = bhpBuild(arr, size, sizeof(int),
-                        MAX, cmpInts);
+  binheap *H = bhpBuildKeys(arr, keys, size, sizeof(int),
+                            MAX, BHP_DOUBLE);
   heapsort(H);
   
   bhpSetShow(H, showInt);
@@ -58,8 +58,8 @@ int main (){
   bhpFree(H);
 
     // builds a min heap, sorts in descending order
-  H = bhpBuild(arr, size, sizeof(int),
-               MIN, cmpInts);
+  H = bhpBuildKeys(arr, keys, size, sizeof(int),
+                   MIN, BHP_DOUBLE);
 
   heapsort(H);
 
@@ -67,6 +67,7 @@ int main (){
   bhpShow(H);
 
   bhpFree(H);
+  free(keys);
   free(arr);
   return 0;
 }
\ No newline at end of file
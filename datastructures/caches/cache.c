@@ -0,0 +1,210 @@
+/*
+  Bounded cache with LRU or CLOCK replacement
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "cache.h"
+#include "../../lib/clib.h"
+
+//===================================================================
+// Creates a new cache
+cache *cacheNew(cacheHash hash, cacheCmpKey cmpKey,
+                cachePolicy policy, size_t capacity) {
+  if (capacity == 0) {
+    fprintf(stderr, "cacheNew: capacity must be positive\n");
+    return NULL;
+  }
+  cache *C = safeCalloc(1, sizeof(cache));
+  C->M = mapNew(hash, capacity, cmpKey);
+  C->L = dllNew();
+  C->hand = C->L->NIL;
+  C->policy = policy;
+  C->capacity = capacity;
+  C->label = policy == CACHE_LRU ? "LRU cache" : "CLOCK cache";
+  return C;
+}
+
+//===================================================================
+// Deallocates the cache
+void cacheFree(cache *C) {
+  if (! C) return;
+  cacheClear(C);
+  mapFree(C->M);
+  dllFree(C->L);
+  free(C);
+}
+
+//===================================================================
+// Sets the label for the cache
+void cacheSetLabel(cache *C, char *label) {
+  C->label = label;
+}
+
+//===================================================================
+// Sets the function called for entries leaving the cache
+void cacheSetEvict(cache *C, cacheEvict evict) {
+  C->evict = evict;
+}
+
+//===================================================================
+// Sets the size function, making the capacity count bytes
+void cacheSetSizeOf(cache *C, cacheSizeOf sizeOf,
+                    size_t capacity) {
+  if (cacheSize(C) > 0) {
+    fprintf(stderr, "cacheSetSizeOf: cache is not empty\n");
+    return;
+  }
+  if (capacity == 0) {
+    fprintf(stderr, "cacheSetSizeOf: capacity must be positive\n");
+    return;
+  }
+  C->sizeOf = sizeOf;
+  C->capacity = capacity;
+}
+
+//===================================================================
+// Removes an entry from the map and the list
+static void unlinkEntry(cache *C, cacheEntry *e) {
+  mapDelKey(C->M, e->key);
+  if (C->hand == e->node)
+    C->hand = e->node->next;
+  dllRemoveNode(C->L, e->node);
+  C->used -= e->size;
+}
+
+//===================================================================
+// Removes an entry and passes it to the evict function
+static void removeEntry(cache *C, cacheEntry *e) {
+  unlinkEntry(C, e);
+  if (C->evict)
+    C->evict(e->key, e->value);
+  free(e);
+}
+
+//===================================================================
+// Returns the entry to be evicted
+static cacheEntry *findVictim(cache *C) {
+  if (C->policy == CACHE_LRU)
+    return dllPeekBack(C->L);
+
+    // CLOCK: give entries with the reference bit set
+    // a second chance; the loop ends after at most
+    // one full sweep, as all bits are then cleared
+  dllNode *NIL = C->L->NIL;
+  while (true) {
+    if (C->hand == NIL)
+      C->hand = NIL->next;
+    cacheEntry *e = C->hand->dllData;
+    if (! e->ref)
+      return e;
+    e->ref = false;
+    C->hand = C->hand->next;
+  }
+}
+
+//===================================================================
+// Returns true if the key is in the cache and sets the value
+bool cacheGet(cache *C, void *key, void **value) {
+  void *v = NULL;
+  if (! mapHasKeyVal(C->M, key, &v)) {
+    C->misses++;
+    return false;
+  }
+  cacheEntry *e = v;
+  if (C->policy == CACHE_LRU)
+    dllMoveToFront(C->L, e->node);
+  else
+    e->ref = true;
+  C->hits++;
+  *value = e->value;
+  return true;
+}
+
+//===================================================================
+// Returns true if the key is in the cache
+bool cacheHas(cache *C, void *key) {
+  return mapHasKey(C->M, key);
+}
+
+//===================================================================
+// Adds a key-value pair to the cache
+bool cachePut(cache *C, void *key, void *value) {
+  size_t size = C->sizeOf ? C->sizeOf(key, value) : 1;
+
+    // a replaced entry only passes the pointers
+    // that are not reused to the evict function
+  void *v = NULL;
+  if (mapHasKeyVal(C->M, key, &v)) {
+    cacheEntry *e = v;
+    unlinkEntry(C, e);
+    if (C->evict)
+      C->evict(e->key == key ? NULL : e->key,
+               e->value == value ? NULL : e->value);
+    free(e);
+  }
+  if (size > C->capacity)
+    return false;
+
+    // make room for the new entry
+  while (C->used + size > C->capacity) {
+    removeEntry(C, findVictim(C));
+    C->evictions++;
+  }
+
+  cacheEntry *e = safeCalloc(1, sizeof(cacheEntry));
+  e->key = key;
+  e->value = value;
+  e->size = size;
+  e->ref = true;
+  e->node = dllPushNode(C->L, e);
+  mapAddKey(C->M, key, e);
+  C->used += size;
+  return true;
+}
+
+//===================================================================
+// Removes the key and its value from the cache
+bool cacheDel(cache *C, void *key) {
+  void *v = NULL;
+  if (! mapHasKeyVal(C->M, key, &v))
+    return false;
+  removeEntry(C, v);
+  return true;
+}
+
+//===================================================================
+// Removes all entries from the cache
+void cacheClear(cache *C) {
+  cacheEntry *e;
+  while ((e = dllPeekBack(C->L)))
+    removeEntry(C, e);
+  C->hand = C->L->NIL;
+}
+
+//===================================================================
+// Resets the counters of the cache
+void cacheResetStats(cache *C) {
+  C->hits = C->misses = C->evictions = 0;
+}
+
+//===================================================================
+// Shows the counters of the cache
+void cacheStats(cache *C) {
+  printf("\n+---------------------------+\n"
+         "|      Cache statistics     |\n"
+         "+---------------------------+\n\n"
+         "   Label..............: %s\n"
+         "   Policy.............: %s\n"
+         "   Capacity...........: %zu %s\n"
+         "   Used...............: %zu\n"
+         "   Number of entries..: %zu\n"
+         "   Hits...............: %zu\n"
+         "   Misses.............: %zu\n"
+         "   Hit rate...........: %.4f\n"
+         "   Evictions..........: %zu\n\n\n",
+         C->label, C->policy == CACHE_LRU ? "LRU" : "CLOCK",
+         C->capacity, C->sizeOf ? "bytes" : "entries",
+         C->used, cacheSize(C), C->hits, C->misses,
+         cacheHitRate(C), C->evictions);
+}
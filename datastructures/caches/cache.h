@@ -0,0 +1,126 @@
+/*
+  Bounded cache with LRU or CLOCK replacement
+  The cache maps keys to values, like a map, but holds at most
+    a fixed number of entries, or a fixed number of bytes when
+    a size function is set. When a new entry does not fit,
+    entries are evicted according to the replacement policy:
+    - LRU: the least recently used entry is evicted. The entries
+      are kept in a doubly linked list, most recently used first;
+      a hit moves the entry to the front of the list.
+    - CLOCK: an approximation of LRU. A hit only sets the
+      reference bit of the entry. The eviction hand sweeps over
+      the entries, clearing the reference bits, and evicts the
+      first entry whose bit was already clear. This makes hits
+      cheaper than with LRU, since they do not touch the list.
+  Both policies look up the entries in a map (key -> entry), so
+    that get, put and delete take O(1) expected time.
+  The cache does not own keys or values: the evict function is
+    called for every entry that leaves the cache, so that the
+    caller can free it.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef CACHE_H_INCLUDED
+#define CACHE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>   // uint64_t
+#include "../lists/dll.h"
+#include "../htables/single-value/map.h"
+
+typedef enum { CACHE_LRU, CACHE_CLOCK } cachePolicy;
+
+  // function pointer types
+typedef uint64_t (*cacheHash)(void *key, uint64_t seed);
+typedef int (*cacheCmpKey)(void const *key1, void const *key2);
+typedef size_t (*cacheSizeOf)(void *key, void *value);
+typedef void (*cacheEvict)(void *key, void *value);
+
+typedef struct {
+  void *key;              // key
+  void *value;            // value
+  size_t size;            // size of the entry (1 or bytes)
+  bool ref;               // reference bit (CLOCK)
+  dllNode *node;          // node of the entry in the list
+} cacheEntry;
+
+typedef struct {
+  map *M;                 // key -> entry
+  dll *L;                 // entries, most recently used first
+  dllNode *hand;          // eviction hand (CLOCK)
+  cachePolicy policy;     // replacement policy
+  size_t capacity;        // maximum number of entries or bytes
+  size_t used;            // number of entries or bytes used
+  cacheSizeOf sizeOf;     // size of an entry; NULL counts entries
+  cacheEvict evict;       // called when an entry leaves the cache
+  size_t hits;            // number of successful gets
+  size_t misses;          // number of failed gets
+  size_t evictions;       // number of entries evicted to make room
+  char *label;            // label for the cache
+} cache;
+
+  // creates a new cache holding at most capacity entries
+cache *cacheNew(cacheHash hash, cacheCmpKey cmpKey,
+                cachePolicy policy, size_t capacity);
+
+  // deallocates the cache; the evict function is
+  // called for each entry in the cache
+void cacheFree(cache *C);
+
+  // sets the label for the cache
+void cacheSetLabel(cache *C, char *label);
+
+  // sets the function that is called for every entry
+  // that leaves the cache (evicted, replaced, deleted
+  // or cleared); a key or value that remains in the
+  // cache after a replacement is passed as NULL
+void cacheSetEvict(cache *C, cacheEvict evict);
+
+  // sets the size function for the entries, so that
+  // the capacity counts bytes instead of entries;
+  // the cache must be empty
+void cacheSetSizeOf(cache *C, cacheSizeOf sizeOf,
+                    size_t capacity);
+
+  // returns true if the key is in the cache and sets
+  // the value pointer; counts a hit or a miss and
+  // marks the entry as recently used
+bool cacheGet(cache *C, void *key, void **value);
+
+  // returns true if the key is in the cache, without
+  // updating the counters or the recency of the entry
+bool cacheHas(cache *C, void *key);
+
+  // adds a key-value pair to the cache, evicting other
+  // entries if needed; if the key exists, its value
+  // is replaced; returns false if the entry is larger
+  // than the capacity, in which case it is not added
+bool cachePut(cache *C, void *key, void *value);
+
+  // removes the key and its value from the cache;
+  // returns false if the key was not found
+bool cacheDel(cache *C, void *key);
+
+  // removes all entries; the counters are kept
+void cacheClear(cache *C);
+
+  // resets the hit, miss and eviction counters
+void cacheResetStats(cache *C);
+
+  // shows the counters of the cache
+void cacheStats(cache *C);
+
+  // returns the number of entries in the cache
+static inline size_t cacheSize(cache *C) {
+  return dllSize(C->L);
+}
+
+  // returns the fraction of gets that were hits
+static inline double cacheHitRate(cache *C) {
+  size_t n = C->hits + C->misses;
+  return n ? (double)C->hits / n : 0;
+}
+
+#endif  // CACHE_H_INCLUDED
@@ -0,0 +1,177 @@
+/*
+  Sharded thread-safe cache
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <time.h>
+#include "scache.h"
+#include "../../lib/clib.h"
+
+//===================================================================
+// Mixes the bits of a hash (finalizer of splitmix64), so that
+// the high bits can select the shard
+static inline uint64_t mix(uint64_t h) {
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+//===================================================================
+// Creates a new sharded cache
+scache *scacheNew(cacheHash hash, cacheCmpKey cmpKey,
+                  cachePolicy policy, size_t nShards,
+                  size_t capacity) {
+  size_t n = 1;
+  while (n < nShards)
+    n <<= 1;
+  if (capacity < n) {
+    fprintf(stderr, "scacheNew: capacity must be at least "
+                    "the number of shards\n");
+    return NULL;
+  }
+  scache *S = safeCalloc(1, sizeof(scache));
+  S->shards = safeCalloc(n, sizeof(scacheShard));
+  S->nShards = n;
+  S->hash = hash;
+  S->seed = rand();
+  S->seed ^= (uint64_t)time(NULL) << 16;
+  S->label = "sharded cache";
+  for (size_t i = 0; i < n; i++) {
+    pthread_mutex_init(&S->shards[i].lock, NULL);
+    S->shards[i].C = cacheNew(hash, cmpKey, policy,
+                              (capacity + n - 1) / n);
+  }
+  return S;
+}
+
+//===================================================================
+// Deallocates the cache
+void scacheFree(scache *S) {
+  if (! S) return;
+  for (size_t i = 0; i < S->nShards; i++) {
+    cacheFree(S->shards[i].C);
+    pthread_mutex_destroy(&S->shards[i].lock);
+  }
+  free(S->shards);
+  free(S);
+}
+
+//===================================================================
+// Sets the label for the cache
+void scacheSetLabel(scache *S, char *label) {
+  S->label = label;
+}
+
+//===================================================================
+// Sets the function called for entries leaving the cache
+void scacheSetEvict(scache *S, cacheEvict evict) {
+  for (size_t i = 0; i < S->nShards; i++)
+    cacheSetEvict(S->shards[i].C, evict);
+}
+
+//===================================================================
+// Sets the size function, making the capacity count bytes
+void scacheSetSizeOf(scache *S, cacheSizeOf sizeOf,
+                     size_t capacity) {
+  size_t perShard = (capacity + S->nShards - 1) / S->nShards;
+  for (size_t i = 0; i < S->nShards; i++)
+    cacheSetSizeOf(S->shards[i].C, sizeOf, perShard);
+}
+
+//===================================================================
+// Sets the function that copies the values returned by get
+void scacheSetCopy(scache *S, scacheCopy copy) {
+  S->copy = copy;
+}
+
+//===================================================================
+// Returns the shard of a key
+static inline scacheShard *getShard(scache *S, void *key) {
+  if (S->nShards == 1)
+    return S->shards;
+  uint64_t h = mix(S->hash(key, S->seed));
+  return S->shards + (h >> 32) % S->nShards;
+}
+
+//===================================================================
+// Returns true if the key is in the cache and sets the value
+bool scacheGet(scache *S, void *key, void **value) {
+  scacheShard *sh = getShard(S, key);
+  pthread_mutex_lock(&sh->lock);
+  bool found = cacheGet(sh->C, key, value);
+  if (found && S->copy)
+    *value = S->copy(*value);
+  pthread_mutex_unlock(&sh->lock);
+  return found;
+}
+
+//===================================================================
+// Adds a key-value pair to the cache
+bool scachePut(scache *S, void *key, void *value) {
+  scacheShard *sh = getShard(S, key);
+  pthread_mutex_lock(&sh->lock);
+  bool added = cachePut(sh->C, key, value);
+  pthread_mutex_unlock(&sh->lock);
+  return added;
+}
+
+//===================================================================
+// Removes the key and its value from the cache
+bool scacheDel(scache *S, void *key) {
+  scacheShard *sh = getShard(S, key);
+  pthread_mutex_lock(&sh->lock);
+  bool removed = cacheDel(sh->C, key);
+  pthread_mutex_unlock(&sh->lock);
+  return removed;
+}
+
+//===================================================================
+// Removes all entries from the cache
+void scacheClear(scache *S) {
+  for (size_t i = 0; i < S->nShards; i++) {
+    pthread_mutex_lock(&S->shards[i].lock);
+    cacheClear(S->shards[i].C);
+    pthread_mutex_unlock(&S->shards[i].lock);
+  }
+}
+
+//===================================================================
+// Returns the number of entries in the cache
+size_t scacheSize(scache *S) {
+  size_t n = 0;
+  for (size_t i = 0; i < S->nShards; i++) {
+    pthread_mutex_lock(&S->shards[i].lock);
+    n += cacheSize(S->shards[i].C);
+    pthread_mutex_unlock(&S->shards[i].lock);
+  }
+  return n;
+}
+
+//===================================================================
+// Shows the counters summed over all shards
+void scacheStats(scache *S) {
+  size_t hits = 0, misses = 0, evictions = 0, n = 0;
+  for (size_t i = 0; i < S->nShards; i++) {
+    pthread_mutex_lock(&S->shards[i].lock);
+    cache *C = S->shards[i].C;
+    hits += C->hits;
+    misses += C->misses;
+    evictions += C->evictions;
+    n += cacheSize(C);
+    pthread_mutex_unlock(&S->shards[i].lock);
+  }
+  printf("\n+---------------------------+\n"
+         "|  Sharded cache statistics |\n"
+         "+---------------------------+\n\n"
+         "   Label..............: %s\n"
+         "   Number of shards...: %zu\n"
+         "   Number of entries..: %zu\n"
+         "   Hits...............: %zu\n"
+         "   Misses.............: %zu\n"
+         "   Hit rate...........: %.4f\n"
+         "   Evictions..........: %zu\n\n\n",
+         S->label, S->nShards, n, hits, misses,
+         hits + misses ? (double)hits / (hits + misses) : 0,
+         evictions);
+}
@@ -0,0 +1,90 @@
+/*
+  Sharded thread-safe cache
+  The keys are spread over a number of independent caches
+    (shards) by their hash value, and each shard is protected by
+    its own mutex. Threads that access different shards do not
+    contend, so throughput scales with the number of shards as
+    long as there are more shards than threads.
+  Each shard holds an equal part of the capacity, and evicts by
+    its own LRU or CLOCK policy; the evicted entries are hence
+    not the globally least recently used ones.
+  Since another thread can evict an entry right after a get
+    returns, values that are freed by the evict function must be
+    copied while the shard is locked: set a copy function with
+    scacheSetCopy, and get then returns a copy that the caller
+    owns. The evict function is called with the lock held.
+  Programs using this cache must be linked with -pthread.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef SCACHE_H_INCLUDED
+#define SCACHE_H_INCLUDED
+
+#include <pthread.h>
+#include "cache.h"
+
+typedef void *(*scacheCopy)(void const *value);
+
+typedef struct {
+  pthread_mutex_t lock;   // lock for the shard
+  cache *C;               // the shard itself
+  char pad[64];           // keeps locks in separate cache lines
+} scacheShard;
+
+typedef struct {
+  scacheShard *shards;    // array of shards
+  size_t nShards;         // number of shards, a power of 2
+  cacheHash hash;         // hash function
+  uint64_t seed;          // seed for selecting the shard
+  scacheCopy copy;        // copies values returned by get
+  char *label;            // label for the cache
+} scache;
+
+  // creates a new sharded cache holding at most capacity
+  // entries; the number of shards is rounded up to a
+  // power of 2
+scache *scacheNew(cacheHash hash, cacheCmpKey cmpKey,
+                  cachePolicy policy, size_t nShards,
+                  size_t capacity);
+
+  // deallocates the cache; the evict function is
+  // called for each entry in the cache
+void scacheFree(scache *S);
+
+  // sets the label for the cache
+void scacheSetLabel(scache *S, char *label);
+
+  // sets the function called for entries leaving the cache
+void scacheSetEvict(scache *S, cacheEvict evict);
+
+  // sets the size function, so that the capacity counts
+  // bytes instead of entries; the cache must be empty
+void scacheSetSizeOf(scache *S, cacheSizeOf sizeOf,
+                     size_t capacity);
+
+  // sets the function that copies the values returned
+  // by scacheGet
+void scacheSetCopy(scache *S, scacheCopy copy);
+
+  // returns true if the key is in the cache and sets the
+  // value pointer, to a copy if a copy function is set
+bool scacheGet(scache *S, void *key, void **value);
+
+  // adds a key-value pair to the cache; returns false
+  // if the entry is larger than the capacity of a shard
+bool scachePut(scache *S, void *key, void *value);
+
+  // removes the key and its value from the cache
+bool scacheDel(scache *S, void *key);
+
+  // removes all entries from the cache
+void scacheClear(scache *S);
+
+  // returns the number of entries in the cache
+size_t scacheSize(scache *S);
+
+  // shows the counters summed over all shards
+void scacheStats(scache *S);
+
+#endif  // SCACHE_H_INCLUDED
@@ -0,0 +1,151 @@
+/*
+  Benchmark: LRU versus CLOCK on a skewed workload, and the
+  throughput of the sharded cache for 1 to 8 threads
+  Keys are drawn from a Zipf distribution over n keys; a miss
+  puts the key in the cache, as a memoizing client would.
+  Usage: ./bench.out [n] [capacity] [number of gets]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>
+#include "../cache.h"
+#include "../scache.h"
+#include "../../../lib/clib.h"
+
+#define KEY(i) ((void *)(uintptr_t)(i))
+
+//===================================================================
+// Hash function for integer keys stored as pointers
+uint64_t hashInt(void *key, uint64_t seed) {
+  uint64_t h = (uintptr_t)key + seed;
+  h *= 0x9e3779b97f4a7c15ULL;
+  return h ^ (h >> 29);
+}
+
+//===================================================================
+// Comparison function for integer keys stored as pointers
+int cmpInt(void const *a, void const *b) {
+  uintptr_t x = (uintptr_t)a, y = (uintptr_t)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Draws q keys from a Zipf distribution (s = 1) over n keys,
+// by inverting the cumulative distribution
+static size_t *zipfKeys(size_t n, size_t q) {
+  double *cdf = safeCalloc(n, sizeof(double));
+  double sum = 0;
+  for (size_t i = 0; i < n; i++)
+    cdf[i] = sum += 1.0 / (i + 1);
+  size_t *keys = safeCalloc(q, sizeof(size_t));
+  for (size_t i = 0; i < q; i++) {
+    double u = (double)rand() / RAND_MAX * sum;
+    size_t lo = 0, hi = n - 1;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (cdf[mid] < u) lo = mid + 1;
+      else hi = mid;
+    }
+      // scatter the popular keys over the key space
+    keys[i] = lo * 2654435761ULL % n + 1;
+  }
+  free(cdf);
+  return keys;
+}
+
+//===================================================================
+// Runs the gets on a cache, putting the missed keys
+static void runCache(cachePolicy policy, size_t capacity,
+                     size_t *allKeys, size_t q) {
+  size_t *keys = safeCalloc(q, sizeof(size_t));
+  memcpy(keys, allKeys, q * sizeof(size_t));
+  cache *C = cacheNew(hashInt, cmpInt, policy, capacity);
+  void *v;
+  double start = now();
+  for (size_t i = 0; i < q; i++)
+    if (! cacheGet(C, KEY(keys[i]), &v))
+      cachePut(C, KEY(keys[i]), KEY(keys[i]));
+  double t = now() - start;
+  printf("  %-6s: %6.1f ns/get, hit rate %.4f\n",
+         policy == CACHE_LRU ? "LRU" : "CLOCK",
+         t * 1e9 / q, cacheHitRate(C));
+
+    // hit path only: gets of keys that are all cached
+  size_t nHits = 0;
+  for (size_t i = 0; i < q; i++)
+    if (cacheHas(C, KEY(keys[i])))
+      keys[nHits++] = keys[i];
+  start = now();
+  for (size_t i = 0; i < nHits; i++)
+    cacheGet(C, KEY(keys[i]), &v);
+  t = now() - start;
+  printf("          %6.1f ns/hit\n", t * 1e9 / nHits);
+  cacheFree(C);
+  free(keys);
+}
+
+//===================================================================
+// Threads doing gets on a sharded cache
+typedef struct {
+  scache *S;
+  size_t *keys;
+  size_t q;
+} threadArg;
+
+static void *worker(void *arg) {
+  threadArg *t = arg;
+  void *v;
+  for (size_t i = 0; i < t->q; i++)
+    if (! scacheGet(t->S, KEY(t->keys[i]), &v))
+      scachePut(t->S, KEY(t->keys[i]), KEY(t->keys[i]));
+  return NULL;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t capacity = argc > 2 ? strtoul(argv[2], NULL, 10) : 100000;
+  size_t q = argc > 3 ? strtoul(argv[3], NULL, 10) : 4000000;
+  srand(time(NULL));
+  size_t *keys = zipfKeys(n, q);
+
+  printf("%zu keys, capacity %zu, %zu gets (Zipf)\n",
+         n, capacity, q);
+  runCache(CACHE_LRU, capacity, keys, q);
+  runCache(CACHE_CLOCK, capacity, keys, q);
+
+    // every thread does q / 8 gets on its own part of keys
+  printf("sharded CLOCK cache, 64 shards\n");
+  size_t perThread = q / 8;
+  for (size_t nThreads = 1; nThreads <= 8; nThreads *= 2) {
+    scache *S = scacheNew(hashInt, cmpInt, CACHE_CLOCK, 64, capacity);
+    pthread_t tid[8];
+    threadArg args[8];
+    double start = now();
+    for (size_t i = 0; i < nThreads; i++) {
+      args[i] = (threadArg){S, keys + i * perThread, perThread};
+      pthread_create(&tid[i], NULL, worker, &args[i]);
+    }
+    for (size_t i = 0; i < nThreads; i++)
+      pthread_join(tid[i], NULL);
+    double t = now() - start;
+    printf("  %zu thread(s): %6.2f Mgets/s\n", nThreads,
+           nThreads * perThread / t * 1e-6);
+    scacheFree(S);
+  }
+  free(keys);
+  return 0;
+}
+
+#undef KEY
@@ -0,0 +1,171 @@
+/*
+  Some tests for the LRU and CLOCK caches: eviction order,
+  replacement of values, byte capacities, the evict function
+  and the counters, and a sharded cache used by several threads
+  Author: David De Potter
+*/
+
+#include "../cache.h"
+#include "../scache.h"
+#include "../../../lib/clib.h"
+
+#define KEY(i) ((void *)(uintptr_t)(i))
+
+size_t nEvicted = 0;
+
+//===================================================================
+// Hash function for integer keys stored as pointers
+uint64_t hashInt(void *key, uint64_t seed) {
+  uint64_t h = (uintptr_t)key + seed;
+  h *= 0x9e3779b97f4a7c15ULL;
+  return h ^ (h >> 29);
+}
+
+//===================================================================
+// Comparison function for integer keys stored as pointers
+int cmpInt(void const *a, void const *b) {
+  uintptr_t x = (uintptr_t)a, y = (uintptr_t)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Evict function that frees the values
+void freeVal(void *key, void *value) {
+  free(value);
+  nEvicted++;
+}
+
+//===================================================================
+// Evict function for the sharded cache, which is called
+// from several threads
+void freeShared(void *key, void *value) {
+  free(value);
+}
+
+//===================================================================
+// Size of an entry with a string value
+size_t sizeStr(void *key, void *value) {
+  return strlen(value) + 1;
+}
+
+//===================================================================
+// Checks a condition and reports it
+void check(bool cond, char *msg) {
+  printf("%s: %s\n", cond ? "ok    " : "FAILED", msg);
+}
+
+//===================================================================
+// Threads putting and getting keys in a sharded cache
+typedef struct {
+  scache *S;
+  size_t id;
+  size_t errors;
+} threadArg;
+
+void *worker(void *arg) {
+  threadArg *t = arg;
+  for (size_t i = 0; i < 100000; i++) {
+    size_t k = t->id * 1000000 + i % 5000;
+    void *v;
+    if (scacheGet(t->S, KEY(k), &v)) {
+      if (*(size_t *)v != k)
+        t->errors++;
+      free(v);
+    } else {
+      size_t *val = safeMalloc(sizeof(size_t));
+      *val = k;
+      scachePut(t->S, KEY(k), val);
+    }
+  }
+  return NULL;
+}
+
+//===================================================================
+// Copies a value returned by the sharded cache
+void *copySize(void const *value) {
+  size_t *copy = safeMalloc(sizeof(size_t));
+  *copy = *(size_t *)value;
+  return copy;
+}
+
+//===================================================================
+
+int main () {
+
+  void *v;
+
+    // LRU: touching key 1 makes key 2 the victim
+  cache *C = cacheNew(hashInt, cmpInt, CACHE_LRU, 3);
+  for (size_t i = 1; i <= 3; i++)
+    cachePut(C, KEY(i), KEY(10 * i));
+  cacheGet(C, KEY(1), &v);
+  cachePut(C, KEY(4), KEY(40));
+  check(! cacheHas(C, KEY(2)) && cacheHas(C, KEY(1)) &&
+        cacheHas(C, KEY(3)) && cacheHas(C, KEY(4)),
+        "LRU evicts the least recently used key");
+  cachePut(C, KEY(3), KEY(33));
+  cachePut(C, KEY(5), KEY(50));
+  check(! cacheHas(C, KEY(1)) && cacheGet(C, KEY(3), &v) &&
+        v == KEY(33), "LRU replaces values and marks them used");
+  check(C->hits == 2 && C->misses == 0 && C->evictions == 2,
+        "LRU counters");
+  cacheStats(C);
+  cacheFree(C);
+
+    // CLOCK: a referenced key gets a second chance
+  C = cacheNew(hashInt, cmpInt, CACHE_CLOCK, 3);
+  for (size_t i = 1; i <= 3; i++)
+    cachePut(C, KEY(i), KEY(10 * i));
+  cachePut(C, KEY(4), KEY(40));
+  cacheGet(C, KEY(2), &v);
+  cachePut(C, KEY(5), KEY(50));
+  check(cacheSize(C) == 3 && cacheHas(C, KEY(2)) &&
+        cacheHas(C, KEY(5)), "CLOCK keeps a referenced key");
+  cacheGet(C, KEY(99), &v);
+  check(C->hits == 1 && C->misses == 1 && C->evictions == 2,
+        "CLOCK counters");
+  cacheFree(C);
+
+    // byte capacity with an evict function
+  C = cacheNew(hashInt, cmpInt, CACHE_LRU, 1);
+  cacheSetSizeOf(C, sizeStr, 100);
+  cacheSetEvict(C, freeVal);
+  for (size_t i = 0; i < 50; i++) {
+    char *s = safeCalloc(20, sizeof(char));
+    sprintf(s, "value %zu", i);
+    cachePut(C, KEY(i), s);
+  }
+  check(C->used <= 100 && C->used > 80, "byte capacity");
+  check(nEvicted == 50 - cacheSize(C), "evict function");
+  char *big = safeCalloc(200, sizeof(char));
+  memset(big, 'x', 199);
+  check(! cachePut(C, KEY(1000), big), "entry larger than capacity");
+  free(big);
+  cacheDel(C, KEY(49));
+  check(! cacheHas(C, KEY(49)) && nEvicted == 50 - cacheSize(C),
+        "delete");
+  cacheFree(C);
+  check(nEvicted == 50, "free passes all entries to evict");
+
+    // sharded cache used by 4 threads
+  scache *S = scacheNew(hashInt, cmpInt, CACHE_CLOCK, 16, 8000);
+  scacheSetEvict(S, freeShared);
+  scacheSetCopy(S, copySize);
+  pthread_t tid[4];
+  threadArg args[4];
+  for (size_t i = 0; i < 4; i++) {
+    args[i] = (threadArg){S, i, 0};
+    pthread_create(&tid[i], NULL, worker, &args[i]);
+  }
+  size_t errors = 0;
+  for (size_t i = 0; i < 4; i++) {
+    pthread_join(tid[i], NULL);
+    errors += args[i].errors;
+  }
+  check(errors == 0 && scacheSize(S) <= 8000, "sharded cache");
+  scacheStats(S);
+  scacheFree(S);
+  return 0;
+}
+
+#undef KEY
@@ -0,0 +1,166 @@
+/*
+  Blocked Bloom filter
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <math.h>
+#include <time.h>
+#include "bloom.h"
+#include "../../lib/clib.h"
+
+#define BLOCK_BITS 512
+#define BLOCK_WORDS (BLOCK_BITS / 64)
+
+//===================================================================
+// Mixes the bits of a hash (finalizer of splitmix64); hash
+// functions like FNV-1a spread the last bytes of a key only
+// over the low bits, while the filter needs all of them
+static inline uint64_t mix(uint64_t h) {
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+//===================================================================
+// Creates a new filter
+bloom *bloomNew(bloomHash hash, size_t capacity, double fpRate) {
+  if (fpRate <= 0 || fpRate >= 1) {
+    fprintf(stderr, "bloomNew: false positive rate must be "
+                    "between 0 and 1\n");
+    return NULL;
+  }
+  bloom *B = safeCalloc(1, sizeof(bloom));
+  B->hash = hash;
+  B->label = "Bloom filter";
+  B->seed = rand();
+  B->seed ^= (uint64_t)time(NULL) << 16;
+
+    // optimal number of bits set per key and bits per key
+    // for a classic Bloom filter; since the keys are not spread
+    // evenly over the blocks, a blocked filter needs about one
+    // extra bit per key to reach the same false positive rate
+  double bitsPerKey = -log(fpRate) / (log(2) * log(2));
+  B->k = (unsigned)(bitsPerKey * log(2) + 0.5);
+  bitsPerKey += 1;
+  B->k = B->k < 1 ? 1 : B->k > 16 ? 16 : B->k;
+  size_t nBits = (size_t)(bitsPerKey * (capacity ? capacity : 1));
+  B->nBlocks = (nBits + BLOCK_BITS - 1) / BLOCK_BITS;
+
+    // align the blocks to cache lines
+  B->mem = safeCalloc(B->nBlocks * BLOCK_WORDS + BLOCK_WORDS,
+                      sizeof(uint64_t));
+  B->blocks = (uint64_t *)(((uintptr_t)B->mem + 63) & ~(uintptr_t)63);
+  return B;
+}
+
+//===================================================================
+// Deallocates the filter
+void bloomFree(bloom *B) {
+  if (! B) return;
+  free(B->mem);
+  free(B);
+}
+
+//===================================================================
+// Sets the label for the filter
+void bloomSetLabel(bloom *B, char *label) {
+  B->label = label;
+}
+
+//===================================================================
+// Returns the block of a key and sets the hash from which
+// the bit positions within the block are derived
+static inline uint64_t *getBlock(bloom *B, void *key, uint64_t *g) {
+  uint64_t h = mix(B->hash(key, B->seed));
+  *g = mix(h ^ 0x9e3779b97f4a7c15ULL);
+  size_t b = (size_t)(((h >> 32) * (uint64_t)B->nBlocks) >> 32);
+  return B->blocks + b * BLOCK_WORDS;
+}
+
+//===================================================================
+// Adds a key to the filter
+void bloomAdd(bloom *B, void *key) {
+  uint64_t g;
+  uint64_t *block = getBlock(B, key, &g);
+  uint32_t pos = (uint32_t)g, step = (uint32_t)(g >> 32) | 1;
+  for (unsigned i = 0; i < B->k; i++, pos += step) {
+    uint32_t bit = pos % BLOCK_BITS;
+    block[bit / 64] |= 1ULL << (bit % 64);
+  }
+  B->nKeys++;
+}
+
+//===================================================================
+// Returns false if the key is surely not in the filter
+bool bloomMayContain(bloom *B, void *key) {
+  uint64_t g;
+  uint64_t *block = getBlock(B, key, &g);
+  uint32_t pos = (uint32_t)g, step = (uint32_t)(g >> 32) | 1;
+  for (unsigned i = 0; i < B->k; i++, pos += step) {
+    uint32_t bit = pos % BLOCK_BITS;
+    if (! (block[bit / 64] & (1ULL << (bit % 64))))
+      return false;
+  }
+  return true;
+}
+
+//===================================================================
+// Removes all keys from the filter
+void bloomClear(bloom *B) {
+  memset(B->blocks, 0, B->nBlocks * BLOCK_WORDS * sizeof(uint64_t));
+  B->nKeys = 0;
+}
+
+//===================================================================
+// Returns the expected false positive rate of a classic Bloom
+// filter of the same size for the current number of keys
+double bloomFpRate(bloom *B) {
+  double m = (double)B->nBlocks * BLOCK_BITS;
+  return pow(1 - exp(-(double)B->k * B->nKeys / m), B->k);
+}
+
+//===================================================================
+// Shows the size and the load of the filter
+void bloomStats(bloom *B) {
+  size_t set = 0;
+  for (size_t i = 0; i < B->nBlocks * BLOCK_WORDS; i++)
+    for (uint64_t w = B->blocks[i]; w; w &= w - 1)
+      set++;
+  double nBits = (double)B->nBlocks * BLOCK_BITS;
+
+  printf("\n+---------------------------+\n"
+         "|  Bloom filter statistics  |\n"
+         "+---------------------------+\n\n"
+         "   Label..............: %s\n"
+         "   Number of keys.....: %zu\n"
+         "   Number of blocks...: %zu\n"
+         "   Bits per key.......: %.2f\n"
+         "   Bits set per key...: %u\n"
+         "   Fraction of 1-bits.: %.2f\n"
+         "   Expected FP rate...: %.5f\n\n\n",
+         B->label, B->nKeys, B->nBlocks,
+         B->nKeys ? nBits / B->nKeys : 0, B->k,
+         set / nBits, bloomFpRate(B));
+}
+
+//===================================================================
+// Key filter interface functions
+static bool kfBloomMayContain(void *filter, void *key) {
+  return bloomMayContain((bloom *)filter, key);
+}
+
+static bool kfBloomAdd(void *filter, void *key) {
+  bloomAdd((bloom *)filter, key);
+  return true;
+}
+
+//===================================================================
+// Returns the filter as a key filter
+keyFilter bloomAsFilter(bloom *B) {
+  keyFilter f = {B, kfBloomMayContain, kfBloomAdd, NULL};
+  return f;
+}
+
+#undef BLOCK_BITS
+#undef BLOCK_WORDS
@@ -0,0 +1,77 @@
+/*
+  Blocked Bloom filter
+  A Bloom filter stores a set of keys as bits in a bit array,
+    setting k bits per key. A lookup checks whether all k bits
+    of the key are set: if not, the key is surely absent; if
+    so, it is present, or a false positive.
+  In a blocked Bloom filter, all k bits of a key lie in the
+    same block of 512 bits, which is one cache line, so that
+    both adding and looking up a key touch a single cache line.
+    This costs a slightly higher false positive rate than a
+    classic Bloom filter using the same number of bits.
+  The hash function has the same signature as the hash
+    functions of the htable and the map, so that the same
+    function can be used for a table and its filter. The
+    filter only hashes each key once.
+  Keys can not be removed; use a cuckoo filter for that.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef BLOOM_H_INCLUDED
+#define BLOOM_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>   // uint64_t
+#include "keyFilter.h"
+
+typedef uint64_t (*bloomHash)(void *key, uint64_t seed);
+
+typedef struct {
+  uint64_t *blocks;       // bit array: nBlocks blocks of 8 words
+  void *mem;              // allocated memory for the blocks
+  size_t nBlocks;         // number of blocks
+  size_t nKeys;           // number of added keys
+  unsigned k;             // number of bits set per key
+  bloomHash hash;         // hash function
+  uint64_t seed;          // seed for the hash function
+  char *label;            // label for the filter
+} bloom;
+
+  // creates a new filter for the expected number of
+  // keys and the desired false positive rate
+bloom *bloomNew(bloomHash hash, size_t capacity, double fpRate);
+
+  // deallocates the filter
+void bloomFree(bloom *B);
+
+  // sets the label for the filter
+void bloomSetLabel(bloom *B, char *label);
+
+  // adds a key to the filter
+void bloomAdd(bloom *B, void *key);
+
+  // returns false if the key is surely not in the filter
+bool bloomMayContain(bloom *B, void *key);
+
+  // removes all keys from the filter
+void bloomClear(bloom *B);
+
+  // returns the expected false positive rate for
+  // the current number of keys
+double bloomFpRate(bloom *B);
+
+  // shows the size and the load of the filter
+void bloomStats(bloom *B);
+
+  // returns the filter as a key filter, to be used
+  // as a pre-check by a hash table or map
+keyFilter bloomAsFilter(bloom *B);
+
+  // returns the number of added keys
+static inline size_t bloomSize(bloom *B) {
+  return B->nKeys;
+}
+
+#endif  // BLOOM_H_INCLUDED
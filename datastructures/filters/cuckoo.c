@@ -0,0 +1,218 @@
+/*
+  Cuckoo filter (Fan et al., 2014)
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <time.h>
+#include "cuckoo.h"
+#include "../../lib/clib.h"
+
+#define MAX_KICKS 500     // fingerprints to move before giving up
+
+//===================================================================
+// Mixes the bits of a hash (finalizer of splitmix64)
+static inline uint64_t mix(uint64_t h) {
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+//===================================================================
+// Creates a new filter
+cuckoo *cuckooNew(cuckooHash hash, size_t capacity) {
+  cuckoo *C = safeCalloc(1, sizeof(cuckoo));
+  C->hash = hash;
+  C->label = "Cuckoo filter";
+  C->seed = rand();
+  C->seed ^= (uint64_t)time(NULL) << 16;
+  C->rng = C->seed | 1;
+    // keep the load below 90%
+  C->nBuckets = 2;
+  while (C->nBuckets * CUCKOO_SLOTS * 9 < capacity * 10)
+    C->nBuckets <<= 1;
+  C->buckets = safeCalloc(C->nBuckets, sizeof(*C->buckets));
+  return C;
+}
+
+//===================================================================
+// Deallocates the filter
+void cuckooFree(cuckoo *C) {
+  if (! C) return;
+  free(C->buckets);
+  free(C);
+}
+
+//===================================================================
+// Sets the label for the filter
+void cuckooSetLabel(cuckoo *C, char *label) {
+  C->label = label;
+}
+
+//===================================================================
+// Computes the fingerprint and the first bucket of a key
+static inline uint16_t fingerprint(cuckoo *C, void *key, size_t *i) {
+  uint64_t h = mix(C->hash(key, C->seed));
+  *i = h & (C->nBuckets - 1);
+  uint16_t fp = h >> 48;
+  return fp ? fp : 1;
+}
+
+//===================================================================
+// Returns the alternative bucket of a fingerprint in bucket i;
+// applying it twice gives back i
+static inline size_t altIndex(cuckoo *C, size_t i, uint16_t fp) {
+  return (i ^ mix(fp)) & (C->nBuckets - 1);
+}
+
+//===================================================================
+// Stores the fingerprint in bucket i if it has a free slot
+static inline bool insertFp(cuckoo *C, size_t i, uint16_t fp) {
+  for (size_t s = 0; s < CUCKOO_SLOTS; s++) {
+    if (! C->buckets[i][s]) {
+      C->buckets[i][s] = fp;
+      return true;
+    }
+  }
+  return false;
+}
+
+//===================================================================
+// Removes one copy of the fingerprint from bucket i
+static inline bool deleteFp(cuckoo *C, size_t i, uint16_t fp) {
+  for (size_t s = 0; s < CUCKOO_SLOTS; s++) {
+    if (C->buckets[i][s] == fp) {
+      C->buckets[i][s] = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+//===================================================================
+// Returns true if bucket i holds the fingerprint
+static inline bool hasFp(cuckoo *C, size_t i, uint16_t fp) {
+  uint16_t *b = C->buckets[i];
+  return b[0] == fp || b[1] == fp || b[2] == fp || b[3] == fp;
+}
+
+//===================================================================
+// Returns the next number of a xorshift random generator
+static inline uint64_t nextRandom(cuckoo *C) {
+  C->rng ^= C->rng << 13;
+  C->rng ^= C->rng >> 7;
+  C->rng ^= C->rng << 17;
+  return C->rng;
+}
+
+//===================================================================
+// Stores the fingerprint in bucket i or its alternative, kicking
+// out other fingerprints if needed; if the last kicked out
+// fingerprint does not fit, it is kept in the victim slot
+static void placeFp(cuckoo *C, size_t i, uint16_t fp) {
+  if (insertFp(C, i, fp) || insertFp(C, altIndex(C, i, fp), fp))
+    return;
+  if (nextRandom(C) & 1)
+    i = altIndex(C, i, fp);
+  for (size_t n = 0; n < MAX_KICKS; n++) {
+    size_t s = nextRandom(C) % CUCKOO_SLOTS;
+    SWAP(fp, C->buckets[i][s]);
+    i = altIndex(C, i, fp);
+    if (insertFp(C, i, fp))
+      return;
+  }
+  C->hasVictim = true;
+  C->victimFp = fp;
+  C->victimIdx = i;
+}
+
+//===================================================================
+// Adds a key to the filter; returns false if the filter is full
+bool cuckooAdd(cuckoo *C, void *key) {
+    // the filter is full once a fingerprint did not fit
+  if (C->hasVictim)
+    return false;
+  size_t i;
+  uint16_t fp = fingerprint(C, key, &i);
+  placeFp(C, i, fp);
+  C->nKeys++;
+  return true;
+}
+
+//===================================================================
+// Returns false if the key is surely not in the filter
+bool cuckooMayContain(cuckoo *C, void *key) {
+  size_t i;
+  uint16_t fp = fingerprint(C, key, &i);
+  size_t j = altIndex(C, i, fp);
+  if (hasFp(C, i, fp) || hasFp(C, j, fp))
+    return true;
+  return C->hasVictim && C->victimFp == fp &&
+         (C->victimIdx == i || C->victimIdx == j);
+}
+
+//===================================================================
+// Removes a key that was added to the filter
+bool cuckooDel(cuckoo *C, void *key) {
+  size_t i;
+  uint16_t fp = fingerprint(C, key, &i);
+  size_t j = altIndex(C, i, fp);
+  if (deleteFp(C, i, fp) || deleteFp(C, j, fp)) {
+    C->nKeys--;
+      // a slot was freed, so try to place the victim again
+    if (C->hasVictim) {
+      C->hasVictim = false;
+      placeFp(C, C->victimIdx, C->victimFp);
+    }
+    return true;
+  }
+  if (C->hasVictim && C->victimFp == fp &&
+      (C->victimIdx == i || C->victimIdx == j)) {
+    C->hasVictim = false;
+    C->nKeys--;
+    return true;
+  }
+  return false;
+}
+
+//===================================================================
+// Shows the size and the load of the filter
+void cuckooStats(cuckoo *C) {
+  size_t nSlots = C->nBuckets * CUCKOO_SLOTS;
+  printf("\n+---------------------------+\n"
+         "|  Cuckoo filter statistics |\n"
+         "+---------------------------+\n\n"
+         "   Label..............: %s\n"
+         "   Number of keys.....: %zu\n"
+         "   Number of buckets..: %zu\n"
+         "   Load factor........: %.2f\n"
+         "   Bits per key.......: %.2f\n"
+         "   Full...............: %s\n\n\n",
+         C->label, C->nKeys, C->nBuckets,
+         (double)C->nKeys / nSlots,
+         C->nKeys ? 16.0 * nSlots / C->nKeys : 0,
+         C->hasVictim ? "yes" : "no");
+}
+
+//===================================================================
+// Key filter interface functions
+static bool kfCuckooMayContain(void *filter, void *key) {
+  return cuckooMayContain((cuckoo *)filter, key);
+}
+
+static bool kfCuckooAdd(void *filter, void *key) {
+  return cuckooAdd((cuckoo *)filter, key);
+}
+
+static bool kfCuckooDel(void *filter, void *key) {
+  return cuckooDel((cuckoo *)filter, key);
+}
+
+//===================================================================
+// Returns the filter as a key filter
+keyFilter cuckooAsFilter(cuckoo *C) {
+  keyFilter f = {C, kfCuckooMayContain, kfCuckooAdd, kfCuckooDel};
+  return f;
+}
+
+#undef MAX_KICKS
@@ -0,0 +1,79 @@
+/*
+  Cuckoo filter (Fan et al., 2014)
+  A cuckoo filter stores a short fingerprint of each key in a
+    table of buckets with 4 slots each. A key can only reside
+    in one of two buckets: the second one is derived from the
+    first one and the fingerprint, so that a fingerprint can be
+    moved to its alternative bucket without knowing the key.
+    When both buckets are full, a random fingerprint is kicked
+    out to its alternative bucket, and so on, as in cuckoo
+    hashing.
+  A lookup checks at most two buckets. Unlike a Bloom filter,
+    a cuckoo filter supports removing keys, as long as only
+    keys that were added are removed.
+  With 16-bit fingerprints the false positive rate is at most
+    8 / 65536, about 0.012%, for 2 bytes per slot.
+  The hash function has the same signature as the hash
+    functions of the htable and the map.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef CUCKOO_H_INCLUDED
+#define CUCKOO_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>   // uint64_t
+#include "keyFilter.h"
+
+#define CUCKOO_SLOTS 4    // number of slots per bucket
+
+typedef uint64_t (*cuckooHash)(void *key, uint64_t seed);
+
+typedef struct {
+  uint16_t (*buckets)[CUCKOO_SLOTS]; // fingerprints, 0 is empty
+  size_t nBuckets;        // number of buckets, a power of 2
+  size_t nKeys;           // number of keys
+  cuckooHash hash;        // hash function
+  uint64_t seed;          // seed for the hash function
+  uint64_t rng;           // state of the random generator
+  bool hasVictim;         // true if the victim slot is used
+  uint16_t victimFp;      // fingerprint that did not fit
+  size_t victimIdx;       // one of the buckets of the victim
+  char *label;            // label for the filter
+} cuckoo;
+
+  // creates a new filter for the expected number of keys
+cuckoo *cuckooNew(cuckooHash hash, size_t capacity);
+
+  // deallocates the filter
+void cuckooFree(cuckoo *C);
+
+  // sets the label for the filter
+void cuckooSetLabel(cuckoo *C, char *label);
+
+  // adds a key to the filter; returns false if the
+  // filter is full, in which case the key is not added
+bool cuckooAdd(cuckoo *C, void *key);
+
+  // returns false if the key is surely not in the filter
+bool cuckooMayContain(cuckoo *C, void *key);
+
+  // removes a key that was added to the filter;
+  // returns false if the key was not found
+bool cuckooDel(cuckoo *C, void *key);
+
+  // shows the size and the load of the filter
+void cuckooStats(cuckoo *C);
+
+  // returns the filter as a key filter, to be used
+  // as a pre-check by a hash table or map
+keyFilter cuckooAsFilter(cuckoo *C);
+
+  // returns the number of keys in the filter
+static inline size_t cuckooSize(cuckoo *C) {
+  return C->nKeys;
+}
+
+#endif  // CUCKOO_H_INCLUDED
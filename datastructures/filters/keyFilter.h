@@ -0,0 +1,34 @@
+/*
+  Key filter interface
+  A key filter answers approximate membership queries: a key
+    that was added is never reported as absent, but a key that
+    was never added may be reported as present (false positive).
+  Hash tables and maps accept a key filter as an optional
+    pre-check (see htSetFilter, mapSetFilter), so that most
+    lookups of absent keys never have to walk a bucket.
+  The interface only consists of function pointers, so that the
+    tables do not depend on any particular filter; bloom.h and
+    cuckoo.h each provide a function returning this interface.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef KEYFILTER_H_INCLUDED
+#define KEYFILTER_H_INCLUDED
+
+#include <stdbool.h>
+
+  // function pointer types
+typedef bool (*kfMayContain)(void *filter, void *key);
+typedef bool (*kfAdd)(void *filter, void *key);
+typedef bool (*kfDel)(void *filter, void *key);
+
+typedef struct {
+  void *filter;            // the filter itself
+  kfMayContain mayContain; // false if the key is surely absent
+  kfAdd add;               // adds a key; false if the filter is full
+  kfDel del;               // removes a key; NULL if the filter
+                           // does not support deletions
+} keyFilter;
+
+#endif  // KEYFILTER_H_INCLUDED
@@ -0,0 +1,119 @@
+/*
+  Benchmark: membership queries on a hash table without a
+  key filter, with a blocked Bloom filter, and with a cuckoo
+  filter as a pre-check
+  The table holds n string keys; then q queries are done, of
+  which the given percentage is for keys that are not in the
+  table. The measured false positive rate is the fraction of
+  absent keys for which the filter had to consult the table.
+  Usage: ./bench.out [n] [q] [percentage of absent keys]
+  Author: David De Potter
+*/
+
+#include <time.h>
+#include "../bloom.h"
+#include "../cuckoo.h"
+#include "../../htables/multi-value/htable.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// FNV-1a hash function for strings
+uint64_t hashStr(void *key, uint64_t seed) {
+  char *str = (char *)key;
+  uint64_t hash = 14695981039346656037ULL + seed;
+  while (*str) {
+    hash ^= (unsigned char)*str++;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+//===================================================================
+// Comparison function for strings
+int cmpStr(void const *a, void const *b) {
+  return strcmp((char *)a, (char *)b);
+}
+
+//===================================================================
+// Returns the elapsed time in seconds since start
+static double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// Runs all queries on the table and reports the timing
+static void runQueries(htable *H, char **queries, size_t q, 
+                       char *name) {
+  size_t found = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < q; i++) 
+    found += htHasKey(H, queries[i]);
+  double t = elapsed(start);
+  printf("  %-13s: %6.1f ns/query (%zu found)\n", 
+         name, t * 1e9 / q, found);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 4000000;
+  size_t pct = argc > 3 ? strtoul(argv[3], NULL, 10) : 90;
+  srand(time(NULL));
+
+  char **keys = safeCalloc(n, sizeof(char *));
+  htable *H = htNew(hashStr, cmpStr, NULL, n);
+  htOwnKeys(H, free);
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = safeCalloc(32, sizeof(char));
+    sprintf(keys[i], "vertex-%zu", i);
+    htAddKey(H, keys[i]);
+  }
+
+    // random queries; absent keys get their own strings
+  char **queries = safeCalloc(q, sizeof(char *));
+  size_t nAbsent = 0;
+  for (size_t i = 0; i < q; i++) {
+    if ((size_t)rand() % 100 < pct) {
+      queries[i] = safeCalloc(32, sizeof(char));
+      sprintf(queries[i], "absent-%zu", i);
+      nAbsent++;
+    } else 
+      queries[i] = keys[rand() % n];
+  }
+
+  printf("%zu keys, %zu queries, %zu%% absent\n", n, q, pct);
+  runQueries(H, queries, q, "no filter");
+
+  bloom *B = bloomNew(hashStr, n, 0.01);
+  htSetFilter(H, bloomAsFilter(B));
+  runQueries(H, queries, q, "Bloom (1%)");
+
+  cuckoo *C = cuckooNew(hashStr, n);
+  htSetFilter(H, cuckooAsFilter(C));
+  runQueries(H, queries, q, "cuckoo");
+
+    // measure the false positive rates on the absent keys
+  size_t fpB = 0, fpC = 0;
+  for (size_t i = 0; i < q; i++) {
+    if (strncmp(queries[i], "absent", 6))
+      continue;
+    fpB += bloomMayContain(B, queries[i]);
+    fpC += cuckooMayContain(C, queries[i]);
+  }
+  printf("  false positive rate Bloom..: %.4f%% (%.1f KiB)\n", 
+         100.0 * fpB / nAbsent, B->nBlocks * 64 / 1024.0);
+  printf("  false positive rate cuckoo.: %.4f%% (%.1f KiB)\n", 
+         100.0 * fpC / nAbsent, C->nBuckets * 8 / 1024.0);
+
+  for (size_t i = 0; i < q; i++)
+    if (! strncmp(queries[i], "absent", 6))
+      free(queries[i]);
+  free(queries);
+  free(keys);
+  htFree(H);
+  bloomFree(B);
+  cuckooFree(C);
+  return 0;
+}
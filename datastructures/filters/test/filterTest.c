@@ -0,0 +1,120 @@
+/* 
+  Some tests for the Bloom and cuckoo filters: checks that 
+  there are no false negatives, measures the false positive
+  rates, and uses a cuckoo filter as a pre-check of a hash
+  table from which keys are deleted
+  Author: David De Potter
+*/
+
+#include "../bloom.h"
+#include "../cuckoo.h"
+#include "../../htables/multi-value/htable.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// FNV-1a hash function for strings
+uint64_t hashStr(void *key, uint64_t seed) {
+  char *str = (char *)key;
+  uint64_t hash = 14695981039346656037ULL + seed;
+  while (*str) {
+    hash ^= (unsigned char)*str++;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+//===================================================================
+// Comparison function for strings
+int cmpStr(void const *a, void const *b) {
+  return strcmp((char *)a, (char *)b);
+}
+
+//===================================================================
+
+int main () {
+
+  size_t n = 100000;
+  char key[32];
+
+    // Bloom filter with a 1% false positive rate
+  bloom *B = bloomNew(hashStr, n, 0.01);
+  for (size_t i = 0; i < n; i++) {
+    sprintf(key, "key%zu", i);
+    bloomAdd(B, key);
+  }
+  size_t fn = 0, fp = 0;
+  for (size_t i = 0; i < n; i++) {
+    sprintf(key, "key%zu", i);
+    fn += ! bloomMayContain(B, key);
+    sprintf(key, "absent%zu", i);
+    fp += bloomMayContain(B, key);
+  }
+  bloomStats(B);
+  printf("Bloom filter: %zu false negatives, "
+         "false positive rate %.4f\n", fn, (double)fp / n);
+  bloomFree(B);
+
+    // cuckoo filter; delete every other key
+  cuckoo *C = cuckooNew(hashStr, n);
+  size_t full = 0;
+  for (size_t i = 0; i < n; i++) {
+    sprintf(key, "key%zu", i);
+    full += ! cuckooAdd(C, key);
+  }
+  size_t notDeleted = 0;
+  for (size_t i = 0; i < n; i += 2) {
+    sprintf(key, "key%zu", i);
+    notDeleted += ! cuckooDel(C, key);
+  }
+  fn = fp = 0;
+  size_t stillThere = 0;
+  for (size_t i = 0; i < n; i++) {
+    sprintf(key, "key%zu", i);
+    if (i % 2)
+      fn += ! cuckooMayContain(C, key);
+    else
+      stillThere += cuckooMayContain(C, key);
+    sprintf(key, "absent%zu", i);
+    fp += cuckooMayContain(C, key);
+  }
+  cuckooStats(C);
+  printf("Cuckoo filter: %zu keys did not fit, %zu deletions "
+         "failed\n", full, notDeleted);
+  printf("Cuckoo filter: %zu false negatives, false positive "
+         "rate %.5f,\n               %zu deleted keys still "
+         "reported\n\n", fn, (double)fp / n, stillThere);
+  cuckooFree(C);
+
+    // a hash table with a cuckoo filter as a pre-check
+  htable *H = htNew(hashStr, cmpStr, NULL, 1000);
+  C = cuckooNew(hashStr, 1000);
+  for (size_t i = 0; i < 500; i++) {
+    char *k = safeCalloc(16, sizeof(char));
+    sprintf(k, "key%zu", i);
+    htAddKey(H, k);
+  }
+  htOwnKeys(H, free);
+    // the keys in the table are added to the filter
+  htSetFilter(H, cuckooAsFilter(C));
+  for (size_t i = 500; i < 1000; i++) {
+    char *k = safeCalloc(16, sizeof(char));
+    sprintf(k, "key%zu", i);
+    htAddKey(H, k);
+  }
+  for (size_t i = 0; i < 1000; i += 3) {
+    sprintf(key, "key%zu", i);
+    htDelKey(H, key);
+  }
+  size_t errors = 0;
+  for (size_t i = 0; i < 2000; i++) {
+    sprintf(key, "key%zu", i);
+    bool expected = i < 1000 && i % 3;
+    errors += htHasKey(H, key) != expected;
+  }
+  printf("Hash table with cuckoo filter: %zu keys, "
+         "%zu filter keys, %zu errors\n\n", 
+         htSize(H), cuckooSize(C), errors);
+  htFree(H);
+  cuckooFree(C);
+  return 0;
+}
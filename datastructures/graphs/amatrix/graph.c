@@ -53,7 +53,9 @@ void freeGraph(graph *G) {
   }
   free(G->W);
   free(G->V);
-  sstMapFree(G->indexMap);
+  if (G->indexMap)
+    sstMapFree(G->indexMap);
+  u64MapFree(G->idMap);
   free(G);
 }
 //=================================================================
@@ -156,6 +158,46 @@ void setUndirected(graph *G) {
   G->type = UNDIRECTED;
 }
 
+//=================================================================
+// Makes the graph look up the vertices by label id
+void setLabelId(graph *G, graphLabelId labelId) {
+  if (! G || ! labelId)
+    return;
+  if (G->nVertices > 0) {
+    fprintf(stderr, "setLabelId: graph is not empty\n");
+    return;
+  }
+  G->labelId = labelId;
+  if (! G->idMap)
+    G->idMap = u64MapNew(G->capacity);
+  if (G->indexMap)
+    sstMapFree(G->indexMap);
+  G->indexMap = NULL;
+}
+
+//=================================================================
+// Returns true if the label is in the graph and
+// sets index to the index of its vertex
+static inline bool findIndex(graph *G, char *label, size_t *index) {
+  if (G->labelId) {
+    uint64_t val;
+    if (! u64MapHasKeyVal(G->idMap, G->labelId(label), &val))
+      return false;
+    *index = val;
+    return true;
+  }
+  return sstMapHasKeyVal(G->indexMap, label, index);
+}
+
+//=================================================================
+// Maps the label to the given index
+static inline void mapIndex(graph *G, char *label, size_t index) {
+  if (G->labelId)
+    u64MapAddKey(G->idMap, G->labelId(label), index);
+  else
+    sstMapAddKey(G->indexMap, label, index);
+}
+
 //=================================================================
 // Gets a vertex given its label
 vertex *getVertex(graph *G, char *label) {
@@ -163,7 +205,7 @@ vertex *getVertex(graph *G, char *label) {
     return NULL;
     
   size_t index;
-  if (! sstMapHasKeyVal(G->indexMap, label, &index)) 
+  if (! findIndex(G, label, &index)) 
     return NULL;
   
   return G->V[index];
@@ -203,10 +245,11 @@ static void storeVertex(graph *G, vertex *v) {
 void addVertex(graph *G, char *label) {
   if (! G || ! label) 
     return;
-  if (sstMapHasKey(G->indexMap, label)) 
+  size_t index;
+  if (findIndex(G, label, &index)) 
     return;
   vertex *v = newVertex(label);
-  sstMapAddKey(G->indexMap, label, G->nVertices);
+  mapIndex(G, label, G->nVertices);
   v->idx = G->nVertices;
   storeVertex(G, v);
 }
@@ -216,10 +259,11 @@ void addVertex(graph *G, char *label) {
 vertex *addVertexR(graph *G, char *label) {
   if (! G || ! label) 
     return NULL;
-  if (sstMapHasKey(G->indexMap, label)) 
-    return G->V[sstMapGetVal(G->indexMap, label)];
+  size_t index;
+  if (findIndex(G, label, &index)) 
+    return G->V[index];
   vertex *v = newVertex(label);
-  sstMapAddKey(G->indexMap, label, G->nVertices);
+  mapIndex(G, label, G->nVertices);
   v->idx = G->nVertices;
   storeVertex(G, v);
   return v;
@@ -239,8 +283,8 @@ double getWeightL(graph *G, char *from, char *to) {
   if (! G || ! from || ! to) 
     return 0;
   size_t i, j;
-  if (! sstMapHasKeyVal(G->indexMap, from, &i) || 
-      ! sstMapHasKeyVal(G->indexMap, to, &j)) 
+  if (! findIndex(G, from, &i) || 
+      ! findIndex(G, to, &j)) 
     return 0; 
 
   return G->W[i][j];
@@ -277,8 +321,8 @@ void addEdgeWL(graph *G, char *from, char *to, double weight) {
     return;
 
   size_t i, j;
-  if (! sstMapHasKeyVal(G->indexMap, from, &i) || 
-      ! sstMapHasKeyVal(G->indexMap, to, &j)) 
+  if (! findIndex(G, from, &i) || 
+      ! findIndex(G, to, &j)) 
     return;
 
   addEdgeW(G, G->V[i], G->V[j], weight);
@@ -305,7 +349,8 @@ void addEdgeL(graph *G, char *from, char *to) {
 bool hasVertex(graph *G, char *label) {
   if (! G || ! label) 
     return false;
-  return sstMapHasKey(G->indexMap, label);
+  size_t index;
+  return findIndex(G, label, &index);
 }
 
 //=================================================================
@@ -323,8 +368,8 @@ bool hasEdgeL(graph *G, char *from, char *to) {
     return false;
   
   size_t i, j;
-  if (! sstMapHasKeyVal(G->indexMap, from, &i) || 
-      ! sstMapHasKeyVal(G->indexMap, to, &j)) 
+  if (! findIndex(G, from, &i) || 
+      ! findIndex(G, to, &j)) 
     return false;
 
   return G->W[i][j] != DBL_MAX;
@@ -358,8 +403,8 @@ void delEdgeL(graph *G, char *from, char *to) {
     return;
   
   size_t i, j;
-  if (! sstMapHasKeyVal(G->indexMap, from, &i) || 
-      ! sstMapHasKeyVal(G->indexMap, to, &j)) 
+  if (! findIndex(G, from, &i) || 
+      ! findIndex(G, to, &j)) 
     return;
 
   delEdge(G, G->V[i], G->V[j]);
@@ -545,6 +590,7 @@ vertex *nextV(graph *G) {
 graph *copyGraph(graph *G) {
   if (! G) return NULL;
   graph *copy = newGraph(G->capacity, G->weight);
+  setLabelId(copy, G->labelId);
   copy->type = G->type;
   copy->label = G->label;
   vertex *from, *to;
@@ -566,6 +612,7 @@ graph *transposeGraph(graph *G) {
   if (! G) return NULL;
 
   graph *transposed = newGraph(G->capacity, G->weight);
+  setLabelId(transposed, G->labelId);
   transposed->type = G->type;
   transposed->label = "TRANSPOSE";
   vertex *from, *to;
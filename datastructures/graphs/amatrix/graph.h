@@ -10,6 +10,10 @@
 
     Labels are used to identify the vertices and 
     are stored in a hash map for fast lookup.
+    If the labels are numeric (or otherwise map to unique
+    integers), a label to id function can be set, so that
+    the lookup uses an integer map instead of hashing the
+    label strings.
     The graph can be directed or undirected, and the
     edges can be weighted or unweighted.
 
@@ -24,13 +28,18 @@
 #ifndef GRAPH_H_INCLUDED
 #define GRAPH_H_INCLUDED
 
-#include "../../htables/single-value/string-size-t/sstmap.h"
+#include <stdint.h>
+#include "../../htables/single-value/string-size-t/sstMap.h"
+#include "../../htables/single-value/uint64-uint64/u64Map.h"
 #include "vertex.h"
 
   // graph types
 typedef enum { DIRECTED, UNDIRECTED } graphType;
 typedef enum { WEIGHTED, UNWEIGHTED } weightType; 
 
+  // maps a vertex label to a unique integer id
+typedef uint64_t (*graphLabelId)(char const *label);
+
   // graph data structure
 typedef struct {
   vertex **V;         // array of vertices
@@ -39,6 +48,8 @@ typedef struct {
   size_t capacity;    // maximum number of vertices
   size_t nVertices;   // number of vertices in the graph
   sstMap *indexMap;   // hash map: label to index
+  u64Map *idMap;      // hash map: label id to index
+  graphLabelId labelId; // label to id function, or NULL
   graphType type;     // directed or undirected, 
                       // set to directed by default
   weightType weight;  // weighted or unweighted
@@ -58,6 +69,11 @@ graph *newGraph (size_t capacity, weightType weight);
   // Should be called before adding any edges
 void setUndirected(graph *G);
 
+  // Sets a function mapping the labels to unique integer
+  // ids, which are then used to look up the vertices
+  // Should be called before adding any vertices
+void setLabelId(graph *G, graphLabelId labelId);
+
   // Deallocates the graph
 void freeGraph(graph *G);
 
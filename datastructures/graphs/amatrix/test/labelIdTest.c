@@ -0,0 +1,97 @@
+/*
+  Test of the vertex lookup by label, with the labels hashed as
+    strings and with a label id function
+  The labels are written into one reused buffer before they are
+    passed, so that the graph has to keep its own keys; checks
+    that each label finds the vertex at the right index, with
+    its edges, also after the graph grew and in a copy, and that
+    only the id lookup takes "007" for "7"
+  Author: David De Potter
+*/
+
+#include "../graph.h"
+#include "../../../../lib/clib.h"
+
+#define N 100
+
+//===================================================================
+// Returns the number in a label as its id
+uint64_t labelToId (char const *label) {
+  return strtoull(label, NULL, 10);
+}
+
+//===================================================================
+// Checks the lookups in a graph on the labels 0, 1, ..., N-1 with
+// edges from each label to the next one
+static bool checkLookups (graph *G) {
+  char from[16], to[16];
+  bool ok = nVertices(G) == N && ! getVertex(G, "100");
+  for (size_t i = 0; i < N; i++) {
+    snprintf(from, sizeof(from), "%zu", i);
+    snprintf(to, sizeof(to), "%zu", (i + 1) % N);
+    vertex *v = getVertex(G, from);
+    if (! v || v->idx != i || G->V[i] != v ||
+        strcmp(v->label, from) != 0 || ! hasVertex(G, from) ||
+        ! hasEdgeL(G, from, to) ||
+        (N > 2 && hasEdgeL(G, to, from)))
+      ok = false;
+  }
+  return ok;
+}
+
+//===================================================================
+// Builds the graph, with the lookup by label id if byId is true,
+// and checks the lookups
+static bool testMode (bool byId) {
+  graph *G = newGraph(4, UNWEIGHTED);
+  if (byId) {
+      // a second call finds the string map already freed
+    setLabelId(G, labelToId);
+    setLabelId(G, labelToId);
+  }
+  char from[16], to[16];
+  for (size_t i = 0; i < N; i++) {
+    snprintf(from, sizeof(from), "%zu", i);
+    addVertex(G, from);
+  }
+  for (size_t i = 0; i < N; i++) {
+    snprintf(from, sizeof(from), "%zu", i);
+    snprintf(to, sizeof(to), "%zu", (i + 1) % N);
+    addEdgeL(G, from, to);
+  }
+  bool ok = checkLookups(G);
+
+    // only the id lookup maps "007" to vertex 7
+  vertex *v = getVertex(G, "007");
+  ok = ok && (byId ? v && v->idx == 7 : v == NULL);
+
+    // adding an existing label adds nothing
+  addVertex(G, byId ? "042" : "42");
+  ok = ok && nVertices(G) == N;
+
+    // a copy looks up its own vertices in the same way
+  graph *C = copyGraph(G);
+  ok = ok && checkLookups(C) && getVertex(C, "42") != G->V[42];
+  freeGraph(C);
+  freeGraph(G);
+  return ok;
+}
+
+//===================================================================
+
+int main () {
+  printf("String labels: %s\n", testMode(false) ? "correct"
+                                                 : "WRONG");
+  printf("Label ids:     %s\n", testMode(true) ? "correct"
+                                                : "WRONG");
+
+    // the lookup mode cannot change once there are vertices
+  graph *G = newGraph(4, UNWEIGHTED);
+  addVertex(G, "7");
+  setLabelId(G, labelToId);
+  printf("Late label id refused: %s\n",
+         ! G->labelId && getVertex(G, "7") && ! getVertex(G, "007")
+         ? "correct" : "WRONG");
+  freeGraph(G);
+  return 0;
+}
@@ -202,6 +202,7 @@ graph *newGraph (size_t capacity, weightType weight) {
 void freeGraph(graph *G) {
   if (! G) 
     return;
+  phtFree(G->P);
   htFree(G->V);
   free(G->u);
   free(G->v);
@@ -217,6 +218,24 @@ void setUndirected(graph *G) {
   G->type = UNDIRECTED;
 }
 
+//=================================================================
+// Freezes the vertex table into a perfect hash table
+void freezeGraph(graph *G) {
+  if (! G) 
+    return;
+  phtFree(G->P);
+  G->P = phtFromHtable(G->V);
+}
+
+//=================================================================
+// Returns the vertex in the graph equal to the dummy vertex v,
+// using the frozen table if there is one
+static inline vertex *findVertex(graph *G, vertex *v) {
+  if (G->P)
+    return phtGetKey(G->P, v);
+  return htGetKey(G->V, v);
+}
+
 //=================================================================
 // Gets a vertex given its label
 vertex *getVertex(graph *G, char *label) {
@@ -227,28 +246,33 @@ vertex *getVertex(graph *G, char *label) {
     // this is needed because the hash function 
     // operates on vertices and not on plain strings
   strcpy(G->v->label, label);
-  return htGetKey(G->V, G->v);
+  return findVertex(G, G->v);
 }
 
 //=================================================================
 // Adds a vertex to the graph
 void addVertex(graph *G, char *label) {
   strcpy(G->v->label, label);
-  if (htHasKey(G->V, G->v))
+  if (findVertex(G, G->v))
     return;
   vertex *vertex = newVertex(label);
   htAddKey(G->V, vertex);
+    // the frozen table no longer holds all vertices
+  phtFree(G->P);
+  G->P = NULL;
 }
 
 //=================================================================
 // Adds a vertex to the graph by label and returns a pointer to it
 vertex *addVertexR(graph *G, char *label) {
   strcpy(G->v->label, label);
-  vertex *v = htGetKey(G->V, G->v);
+  vertex *v = findVertex(G, G->v);
   if (v) 
     return v;
   vertex *vertex = newVertex(label);
   htAddKey(G->V, vertex);
+  phtFree(G->P);
+  G->P = NULL;
   return vertex;
 }
   
@@ -300,7 +324,7 @@ edge *getEdgeL(graph *G, char *from, char *to) {
     return NULL;
   strcpy(G->u->label, from);
   strcpy(G->v->label, to);
-  return getEdge(G, htGetKey(G->V, G->u), htGetKey(G->V, G->v));
+  return getEdge(G, findVertex(G, G->u), findVertex(G, G->v));
 }
 
 //=================================================================
@@ -310,7 +334,7 @@ void addEdgeWL(graph *G, char *from, char *to, double weight) {
     return;
   strcpy(G->u->label, from);
   strcpy(G->v->label, to);
-  addEdgeW(G, htGetKey(G->V, G->u), htGetKey(G->V, G->v), weight);
+  addEdgeW(G, findVertex(G, G->u), findVertex(G, G->v), weight);
 }
 
 //=================================================================
@@ -328,7 +352,7 @@ void addEdgeL(graph *G, char *from, char *to) {
     return;
   strcpy(G->u->label, from);
   strcpy(G->v->label, to);
-  addEdge(G, htGetKey(G->V, G->u), htGetKey(G->V, G->v));
+  addEdge(G, findVertex(G, G->u), findVertex(G, G->v));
 }
 
 //=================================================================
@@ -337,7 +361,7 @@ bool hasVertex(graph *G, char *label) {
   if (! G || ! label) 
     return false;
   strcpy(G->v->label, label);
-  return htHasKey(G->V, G->v);
+  return findVertex(G, G->v) != NULL;
 }
 
 //=================================================================
@@ -348,7 +372,15 @@ bool hasVertex(graph *G, char *label) {
 bool hasAdjList(graph *G, vertex *v, dll **adjList) {
   if (! G || ! v) 
     return false;
-  return htHasKeyVals(G->V, v, adjList);
+  if (! G->P)
+    return htHasKeyVals(G->V, v, adjList);
+  void *values;
+  *adjList = NULL;
+  if (! phtHasKeyVal(G->P, v, &values))
+    return false;
+  if (! dllIsEmpty(values))
+    *adjList = values;
+  return true;
 }
 
 //=================================================================
@@ -356,7 +388,9 @@ bool hasAdjList(graph *G, vertex *v, dll **adjList) {
 dll *getNeighbors(graph *G, vertex *v) {
   if (! G || ! v) 
     return NULL;
-  return htGetVals(G->V, v);
+  dll *adjList;
+  hasAdjList(G, v, &adjList);
+  return adjList;
 }
 
 //=================================================================
@@ -365,7 +399,7 @@ dll *getNeighborsL(graph *G, char *label) {
   if (! G || ! label) 
     return NULL;
   strcpy(G->v->label, label);
-  return getNeighbors(G, htGetKey(G->V, G->v));
+  return getNeighbors(G, findVertex(G, G->v));
 }
 
 //=================================================================
@@ -384,7 +418,7 @@ bool hasEdgeL(graph *G, char *from, char *to) {
     return false;
   strcpy(G->u->label, from);
   strcpy(G->v->label, to);
-  return hasEdge(G, htGetKey(G->V, G->u), htGetKey(G->V, G->v));
+  return hasEdge(G, findVertex(G, G->u), findVertex(G, G->v));
 }
 
 //=================================================================
@@ -414,9 +448,9 @@ void delEdgeL(graph *G, char *from, char *to) {
     return;
   strcpy(G->u->label, from);
   strcpy(G->v->label, to);
-  delEdge(G, htGetKey(G->V, G->u), htGetKey(G->V, G->v));
+  delEdge(G, findVertex(G, G->u), findVertex(G, G->v));
   if (G->type == UNDIRECTED) 
-    delEdge(G, htGetKey(G->V, G->v), htGetKey(G->V, G->u));
+    delEdge(G, findVertex(G, G->v), findVertex(G, G->u));
 }
 
 //=================================================================
@@ -514,6 +548,8 @@ void readGraph(graph *G) {
     while (scanf("%s %s %lf", from, to, &weight) == 3) 
       addVandEW(G, from, to, weight);
   }
+    // the vertex set is complete
+  freezeGraph(G);
 }
 
 //=================================================================
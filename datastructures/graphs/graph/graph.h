@@ -12,6 +12,9 @@
     vertex and edge types by modifying these headers.
     You could, for example, add a vertex with a void 
     pointer to satellite data.
+    Once all vertices are added, the vertex table can be
+    frozen into a perfect hash table, so that looking up a
+    vertex by label takes a single probe.
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
 */
@@ -20,6 +23,7 @@
 #define GRAPH_H_INCLUDED
 
 #include "../../htables/multi-value/htable.h"
+#include "../../htables/perfect/phtable.h"
 #include "edge.h"
 #include "vertex.h"
 
@@ -30,6 +34,7 @@ typedef enum { WEIGHTED, UNWEIGHTED } weightType;
   // graph data structure
 typedef struct {
   htable *V;          // hash table of vertices
+  phtable *P;         // frozen copy of V, or NULL
   size_t nEdges;      // number of edges in the graph
   graphType type;     // directed or undirected, 
                       // set to directed by default
@@ -54,6 +59,11 @@ void setUndirected(graph *G);
   // Deallocates the graph
 void freeGraph(graph *G);
 
+  // Freezes the vertex table into a perfect hash table;
+  // edges can still be added and deleted, but adding a
+  // vertex unfreezes the graph
+void freezeGraph(graph *G);
+
   // Sets the pointer to the adjList of a vertex
   // If the vertex has no adj list or is not in the graph,
   // the pointer is set to NULL
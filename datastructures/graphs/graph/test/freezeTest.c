@@ -0,0 +1,77 @@
+/*
+  Test of freezing the vertex table of a graph
+  Builds a cycle on N vertices, freezes the graph and checks that
+    the label lookups through the frozen table find the same
+    vertices and edges as before; edges can still be added while
+    frozen, an existing vertex leaves the graph frozen, and a new
+    vertex unfreezes it
+  Author: David De Potter
+*/
+
+#include "../graph.h"
+#include "../../../../lib/clib.h"
+
+#define N 1000
+
+//===================================================================
+// Returns true if the lookups of all N labels in the graph give
+// the vertices in V, with the edges of the cycle
+static bool checkLookups (graph *G, vertex **V) {
+  char from[16], to[16];
+  bool ok = nVertices(G) >= N && ! getVertex(G, "missing") &&
+            ! hasVertex(G, "missing") &&
+            ! hasEdgeL(G, "v0", "missing");
+  for (size_t i = 0; i < N; i++) {
+    snprintf(from, sizeof(from), "v%zu", i);
+    snprintf(to, sizeof(to), "v%zu", (i + 1) % N);
+    if (getVertex(G, from) != V[i] || ! hasVertex(G, from) ||
+        ! hasEdgeL(G, from, to) || hasEdgeL(G, to, from))
+      ok = false;
+  }
+  return ok;
+}
+
+//===================================================================
+
+int main () {
+  graph *G = newGraph(16, UNWEIGHTED);
+  vertex **V = safeCalloc(N, sizeof(vertex *));
+  char from[16], to[16];
+  for (size_t i = 0; i < N; i++) {
+    snprintf(from, sizeof(from), "v%zu", i);
+    V[i] = addVertexR(G, from);
+  }
+  for (size_t i = 0; i < N; i++) {
+    snprintf(from, sizeof(from), "v%zu", i);
+    snprintf(to, sizeof(to), "v%zu", (i + 1) % N);
+    addEdgeL(G, from, to);
+  }
+  bool ok = ! G->P && checkLookups(G, V);
+  printf("Lookups before freezing: %s\n", ok ? "correct" : "WRONG");
+
+  freezeGraph(G);
+  ok = G->P && checkLookups(G, V);
+  printf("Lookups when frozen:     %s\n", ok ? "correct" : "WRONG");
+
+    // edges and existing vertices keep the graph frozen
+  addEdgeL(G, "v5", "v3");
+  addVertex(G, "v7");
+  ok = G->P && nVertices(G) == N && hasEdgeL(G, "v5", "v3") &&
+       ! hasEdgeL(G, "v3", "v5");
+  delEdgeL(G, "v5", "v3");
+  ok = ok && G->P && ! hasEdgeL(G, "v5", "v3") &&
+       checkLookups(G, V);
+  printf("Edges while frozen:      %s\n", ok ? "correct" : "WRONG");
+
+    // a new vertex unfreezes the graph
+  addVertex(G, "new");
+  ok = ! G->P && nVertices(G) == N + 1 && getVertex(G, "new") &&
+       checkLookups(G, V);
+  addEdgeL(G, "new", "v0");
+  ok = ok && hasEdgeL(G, "new", "v0");
+  printf("New vertex unfreezes:    %s\n", ok ? "correct" : "WRONG");
+
+  free(V);
+  freeGraph(G);
+  return 0;
+}
@@ -48,6 +48,7 @@
     struct vertex *parent;    // pointer to the parent vertex
     double dist;              // distance from the source vertex
     char label[MAX_LABEL];    // the label of the vertex
+    size_t index;             // index of the vertex
     size_t inDegree;          // in-degree of the vertex
   } vertex;
 
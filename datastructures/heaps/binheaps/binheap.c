@@ -7,9 +7,8 @@
 #include "binheap.h"
 #include "../../../lib/clib.h"
 
-#define RIGHT(i) (2 * i + 2)
-#define LEFT(i) (2 * i + 1)
-#define PARENT(i) ((i - 1) / 2)
+#define CHILD(H, i) ((H)->arity * (i) + 1)
+#define PARENT(H, i) (((i) - 1) / (H)->arity)
 
 //===================================================================
 // Creates a new binary heap
@@ -19,6 +18,7 @@ binheap *bhpNew(size_t capacity, bhpType hpType,
   h->capacity = capacity;
   h->cmp = cmp;
   h->arr = safeCalloc(capacity, sizeof(*(h->arr)));
+  h->arity = 2;
   h->hpType = hpType;
   h->fac = hpType == MIN ? 1 : -1;
   h->label = "BINARY HEAP";
@@ -31,6 +31,7 @@ binheap *bhpNew(size_t capacity, bhpType hpType,
 void bhpFree(binheap *H) {
   if (!H) return;
   free(H->arr);
+  free(H->keys);
   free(H);
 }
 
@@ -40,6 +41,33 @@ void bhpSetShow(binheap *H, bhpShowData show) {
   H->show = show;
 }
 
+//===================================================================
+// Sets the number of children per node
+void bhpSetArity(binheap *H, size_t arity) {
+  if (arity < 2) {
+    fprintf(stderr, "bhpSetArity: arity must be at least 2\n");
+    return;
+  }
+  H->arity = arity;
+    // rebuild the heap, starting from the last non-leaf node
+  if (H->size > 1)
+    for (size_t i = PARENT(H, H->size - 1) + 1; i--; ) 
+      bhpHeapify(H, i);
+}
+
+//===================================================================
+// Sets the type of the keys
+void bhpSetKeyType(binheap *H, bhpKeyType keyType) {
+  if (H->size) {
+    fprintf(stderr, "bhpSetKeyType: heap is not empty\n");
+    return;
+  }
+  H->keyType = keyType;
+  free(H->keys);
+  H->keys = keyType == BHP_PTR ? NULL
+          : safeCalloc(H->capacity, sizeof(bhpKey));
+}
+
 //===================================================================
 // Sets the label for the heap
 void bhpSetLabel(binheap *H, char *label) {
@@ -65,44 +93,148 @@ void *bhpPop(binheap *H) {
   if (H->size == 0) return NULL;
   void *top = H->arr[0];
   H->arr[0] = H->arr[H->size - 1];
+  if (H->keys)
+    H->keys[0] = H->keys[H->size - 1];
   H->size--;
   bhpHeapify(H, 0);
   return top;
 }
 
+//===================================================================
+// Doubles the capacity of the heap if it is full
+static void grow(binheap *H) {
+  if (H->size < H->capacity) return;
+  H->capacity = H->capacity ? 2 * H->capacity : 1;
+  H->arr = safeRealloc(H->arr, H->capacity * sizeof(void *));
+  if (H->keys)
+    H->keys = safeRealloc(H->keys, H->capacity * sizeof(bhpKey));
+}
+
+//===================================================================
+// Returns true if inline key a should be closer to the top
+// than inline key b
+static inline bool before(binheap *H, bhpKey a, bhpKey b) {
+  if (H->keyType == BHP_DOUBLE)
+    return H->hpType == MIN ? a.d < b.d : a.d > b.d;
+  return H->hpType == MIN ? a.u < b.u : a.u > b.u;
+}
+
 //===================================================================
 // Adds a new node to the heap
 void bhpPush(binheap *H, void *node) {
-  if (H->size == H->capacity) {
-    H->capacity *= 2;
-    H->arr = safeRealloc(H->arr, H->capacity * sizeof(void *));
+  if (H->keys) {
+    fprintf(stderr, "bhpPush: heap has inline keys, "
+                    "use bhpPushKey\n");
+    return;
   }
+  grow(H);
   size_t idx = H->size;
+    // restore the heap property by moving ancestors
+    // down until the new node fits
+  while (idx > 0) {
+    size_t parent = PARENT(H, idx);
+    if (H->fac * H->cmp(node, H->arr[parent]) >= 0)
+      break;
+    H->arr[idx] = H->arr[parent];
+    idx = parent;
+  }
   H->arr[idx] = node;
-    // restore the heap property
-  while (idx > 0 && 
-        (H->fac * H->cmp(H->arr[idx], H->arr[PARENT(idx)]) < 0)) {
-    SWAP(H->arr[idx], H->arr[PARENT(idx)]);
-    idx = PARENT(idx);
+  H->size++;
+}
+
+//===================================================================
+// Adds a new node with an inline key to the heap
+void bhpPushKey(binheap *H, void *node, bhpKey key) {
+  if (! H->keys) {
+    fprintf(stderr, "bhpPushKey: heap has no inline keys\n");
+    return;
+  }
+  grow(H);
+  size_t idx = H->size;
+    // move ancestors down until the new key fits; only the
+    // keys are compared, the node pointers are just moved
+  while (idx > 0) {
+    size_t parent = PARENT(H, idx);
+    if (! before(H, key, H->keys[parent]))
+      break;
+    H->arr[idx] = H->arr[parent];
+    H->keys[idx] = H->keys[parent];
+    idx = parent;
   }
+  H->arr[idx] = node;
+  H->keys[idx] = key;
   H->size++;
 }
 
+//===================================================================
+// Changes the inline key of the top node
+void bhpSetTopKey(binheap *H, bhpKey key) {
+  if (! H->keys || H->size == 0) {
+    fprintf(stderr, "bhpSetTopKey: heap has no inline keys "
+                    "or is empty\n");
+    return;
+  }
+  H->keys[0] = key;
+  bhpHeapify(H, 0);
+}
+
+//===================================================================
+// Heapifies a heap with inline keys starting from the given index
+static void heapifyKeys(binheap *H, size_t idx) {
+  void *node = H->arr[idx];
+  bhpKey key = H->keys[idx];
+  while (true) {
+    size_t first = CHILD(H, idx);
+    if (first >= H->size)
+      break;
+    size_t last = first + H->arity;
+    if (last > H->size)
+      last = H->size;
+    size_t best = first;
+    for (size_t c = first + 1; c < last; c++)
+      if (before(H, H->keys[c], H->keys[best]))
+        best = c;
+    if (! before(H, H->keys[best], key))
+      break;
+    H->arr[idx] = H->arr[best];
+    H->keys[idx] = H->keys[best];
+    idx = best;
+  }
+  H->arr[idx] = node;
+  H->keys[idx] = key;
+}
+
 //===================================================================
 // Heapifies the binary heap starting from the given index
 void bhpHeapify(binheap *H, size_t idx) {
-  size_t l = LEFT(idx);
-  size_t r = RIGHT(idx);
-    // find the node that is the best candidate for the top
-  size_t best = idx;
-  if (l < H->size && (H->fac * H->cmp(H->arr[l], H->arr[best]) < 0))
-    best = l;
-  if (r < H->size && (H->fac * H->cmp(H->arr[r], H->arr[best]) < 0))
-    best = r;
-  if (best != idx) {
-    SWAP(H->arr[idx], H->arr[best]);
-    bhpHeapify(H, best);
+  if (H->keys) {
+    heapifyKeys(H, idx);
+    return;
+  }
+  void *node = H->arr[idx];
+  while (true) {
+    size_t first = CHILD(H, idx);
+    if (first >= H->size)
+      break;
+    size_t last = first + H->arity;
+    if (last > H->size)
+      last = H->size;
+      // find the child that is the best candidate for the top
+    void *bestNode = H->arr[first];
+    size_t best = first;
+    for (size_t c = first + 1; c < last; c++) {
+      if (H->fac * H->cmp(H->arr[c], bestNode) < 0) {
+        best = c;
+        bestNode = H->arr[c];
+      }
+    }
+    if (H->fac * H->cmp(bestNode, node) >= 0)
+      break;
+      // move the best child up
+    H->arr[idx] = bestNode;
+    idx = best;
   }
+  H->arr[idx] = node;
 }
 
 //===================================================================
@@ -133,6 +265,34 @@ binheap *bhpBuild(void *arr, size_t len, size_t elemSize,
   return H;
 }
 
+//===================================================================
+// Builds a binary heap with inline keys from an array
+binheap *bhpBuildKeys(void *arr, bhpKey *keys, size_t len,
+                      size_t elemSize, bhpType hpType,
+                      bhpKeyType keyType) {
+
+  if (len == 0) {
+    fprintf(stderr, "Error: cannot build a heap "
+                    "from an empty array\n");
+    exit(EXIT_FAILURE);
+  }
+  if (keyType == BHP_PTR) {
+    fprintf(stderr, "bhpBuildKeys: no inline key type\n");
+    return NULL;
+  }
+
+  binheap *H = bhpNew(len, hpType, NULL);
+  bhpSetKeyType(H, keyType);
+  for (size_t i = 0; i < len; i++) {
+    H->arr[i] = (char *)arr + i * elemSize;
+    H->keys[i] = keys[i];
+  }
+  H->size = len;
+  for (size_t i = len / 2; i--; )
+    heapifyKeys(H, i);
+  return H;
+}
+
 //===================================================================
 // Shows the binary heap
 void bhpShow(binheap *H) {
@@ -160,6 +320,5 @@ void bhpShow(binheap *H) {
 
 //===================================================================
 // End of file
-#undef RIGHT
-#undef LEFT
+#undef CHILD
 #undef PARENT
\ No newline at end of file
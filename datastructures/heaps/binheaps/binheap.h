@@ -2,6 +2,15 @@
   Generic binary heap implementation
   Does not support update-key or delete operations,
   use a bpqueue or a fibheap for that
+  The heap is binary by default, but can be made d-ary
+  (bhpSetArity): a 4-ary heap is half as deep as a binary
+  heap, and the 4 children of a node are adjacent in memory,
+  so that sifting down touches fewer cache lines
+  The keys can also be kept inline (bhpSetKeyType): the heap then
+  stores a double or uint64 key for each node in an array next
+  to the node pointers, and the sifts compare these keys directly
+  instead of calling the comparison function, which would have
+  to follow two pointers for each comparison
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
 */
@@ -12,6 +21,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdint.h>
 
 // function pointer types
 typedef int (*bhpCompData)(void const *a, void const *b);
@@ -20,11 +30,23 @@ typedef void (*bhpShowData)(void const *data);
 // binary heap type
 typedef enum { MIN, MAX } bhpType;
 
+// type of the keys: the comparison function, or inline keys
+typedef enum { BHP_PTR, BHP_DOUBLE, BHP_UINT64 } bhpKeyType;
+
+// inline key
+typedef union {
+  double d;
+  uint64_t u;
+} bhpKey;
+
 // binary heap structure
 typedef struct {     
   void **arr;              // array of void pointers
+  bhpKey *keys;            // inline keys of the nodes, or NULL
+  bhpKeyType keyType;      // type of the keys
   size_t size;             // number of nodes in the heap
   size_t capacity;         // capacity of the heap
+  size_t arity;            // number of children per node
   bhpCompData cmp;         // comparison function
   bhpShowData show;        // show function
   bhpType hpType;          // type of heap (min or max)
@@ -45,6 +67,15 @@ binheap *bhpNew(size_t capacity, bhpType type,
   // sets the show function for the heap
 void bhpSetShow(binheap *H, bhpShowData show);
 
+  // sets the number of children per node (default 2);
+  // if the heap is not empty, it is rebuilt
+void bhpSetArity(binheap *H, size_t arity);
+
+  // makes the heap keep inline keys of the given type, which
+  // are then given by bhpPushKey instead of compared by the
+  // comparison function; the heap must be empty
+void bhpSetKeyType(binheap *H, bhpKeyType keyType);
+
   // sets the label for the heap
 void bhpSetLabel(binheap *H, char *label);
 
@@ -68,13 +99,34 @@ void bhpHeapify(binheap *H, size_t idx);
   // adds a new node to the heap
 void bhpPush(binheap *H, void *node);
 
+  // adds a new node with an inline key to the heap, e.g.
+  // bhpPushKey(H, node, (bhpKey){.d = 1.5})
+void bhpPushKey(binheap *H, void *node, bhpKey key);
+
+  // changes the inline key of the top node and restores
+  // the heap property
+void bhpSetTopKey(binheap *H, bhpKey key);
+
   // builds a binary heap from an array
 binheap *bhpBuild(void *arr, size_t nElems, 
     size_t elSize, bhpType hpType, bhpCompData cmp);
 
+  // builds a binary heap with inline keys from an array
+  // and the array of the keys of its elements; exits on an
+  // empty array, as bhpBuild does, and returns NULL if the
+  // key type is not an inline one
+binheap *bhpBuildKeys(void *arr, bhpKey *keys, size_t nElems,
+    size_t elSize, bhpType hpType, bhpKeyType keyType);
+
   // shows the binary heap
 void bhpShow(binheap *H);
 
+  // returns the inline key of the top node;
+  // the heap should not be empty
+static inline bhpKey bhpPeekKey(binheap *H) {
+  return H->keys[0];
+}
+
   // true if the heap is empty
 static inline size_t bhpIsEmpty(binheap *H) {
   return H->size == 0;
@@ -3,7 +3,7 @@
   Supports updating priorities using a hash table
     mapping data to indices in the queue (str(data) -> idx)
     String representation of data should be unique for each 
-    data item
+    data item, unless an integer id or index function is set
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
 */
@@ -11,9 +11,8 @@
 #include "bpqueue.h"
 #include "../../../lib/clib.h"
 
-#define RIGHT(i) (2 * i + 2)
-#define LEFT(i) (2 * i + 1)
-#define PARENT(i) ((i - 1) / 2)
+#define CHILD(pq, i) ((pq)->arity * (i) + 1)
+#define PARENT(pq, i) (((i) - 1) / (pq)->arity)
 
 //===================================================================
 // Creates a new priority queue
@@ -22,12 +21,13 @@ bpqueue *bpqNew(size_t capacity, bpqType type, bpqCompKey compKey,
                 bpqToString toString, void *sentinel) {
 
   bpqueue *pq = safeCalloc(1, sizeof(bpqueue));
-  pq->arr = safeCalloc(capacity, sizeof(bpqNode *));
+  pq->arr = safeCalloc(capacity, sizeof(bpqNode));
   pq->datamap = sstMapNew(CASE_SENSITIVE, capacity);
     // make map (string -> idx) manage its own keys
   sstMapCopyKeys(pq->datamap);   
   pq->toString = toString;
   pq->capacity = capacity;
+  pq->arity = 2;
   pq->compKey = compKey;
   pq->copyKey = copyKey;
   pq->freeKey = freeKey;
@@ -40,12 +40,10 @@ bpqueue *bpqNew(size_t capacity, bpqType type, bpqCompKey compKey,
 }
 
 //===================================================================
-// Creates a new pbqNode
-bpqNode *bpqNodeNew(void *data, void *key) {
-  bpqNode *node = safeCalloc(1, sizeof(bpqNode));
-  node->data = data;
-  node->key = key;
-  return node;
+// Returns the id of the data, or its index if an index 
+// function is set
+static inline uint64_t getId(bpqueue *pq, void *data) {
+  return pq->toIndex ? pq->toIndex(data) : pq->toId(data);
 }
 
 //===================================================================
@@ -53,11 +51,13 @@ bpqNode *bpqNodeNew(void *data, void *key) {
 void bpqFree(bpqueue *pq) {
   if (!pq) return;
   for (size_t i = 0; i < pq->size; i++) {
-    pq->freeKey(pq->arr[i]->key);
-    free(pq->arr[i]);
+    pq->freeKey(pq->arr[i].key);
   }
   free(pq->arr);
-  sstMapFree(pq->datamap);
+  if (pq->datamap)
+    sstMapFree(pq->datamap);
+  u64MapFree(pq->idmap);
+  free(pq->pos);
   free(pq);
 }
 
@@ -69,6 +69,49 @@ void bpqSetShow(bpqueue *pq, bpqShowKey showKey,
   pq->showData = showData;
 }
 
+//===================================================================
+// Sets the data to id function for the priority queue
+void bpqSetToId(bpqueue *pq, bpqToId toId) {
+  if (! bpqIsEmpty(pq)) {
+    fprintf(stderr, "bpqSetToId: priority queue is not empty\n");
+    return;
+  }
+  if (! toId)
+    return;
+  pq->toId = toId;
+  pq->toIndex = NULL;
+  free(pq->pos);
+  pq->pos = NULL;
+  if (! pq->idmap) {
+    pq->idmap = u64MapNew(pq->capacity);
+    u64MapSetLabel(pq->idmap, pq->label);
+  }
+  if (pq->datamap)
+    sstMapFree(pq->datamap);
+  pq->datamap = NULL;
+}
+
+//===================================================================
+// Sets the data to index function for the priority queue
+void bpqSetToIndex(bpqueue *pq, bpqToIndex toIndex, size_t n) {
+  if (! bpqIsEmpty(pq)) {
+    fprintf(stderr, "bpqSetToIndex: priority queue is not empty\n");
+    return;
+  }
+  if (! toIndex)
+    return;
+  pq->toIndex = toIndex;
+  pq->toId = NULL;
+  free(pq->pos);
+  pq->pos = safeCalloc(n ? n : 1, sizeof(size_t));
+  pq->nIndices = n;
+  u64MapFree(pq->idmap);
+  pq->idmap = NULL;
+  if (pq->datamap)
+    sstMapFree(pq->datamap);
+  pq->datamap = NULL;
+}
+
 //===================================================================
 // Sets the label for the priority queue
 void bpqSetLabel(bpqueue *pq, char *label) {
@@ -87,35 +130,121 @@ void bpqSetDelim(bpqueue *pq, char *delim) {
 void *bpqPeek(bpqueue *pq) {
   if (bpqIsEmpty(pq))
     return NULL;
-  return pq->arr[0]->data;
+  return pq->arr[0].data;
+}
+
+//===================================================================
+// Maps the data of the node to the index idx in the queue
+static inline void mapIdx(bpqueue *pq, bpqNode *node, size_t idx) {
+  if (pq->pos)
+    pq->pos[node->id] = idx + 1;
+  else if (pq->toId)
+    u64MapAddKey(pq->idmap, node->id, idx);
+  else
+    sstMapAddKey(pq->datamap, pq->toString(node->data), idx);
+}
+
+//===================================================================
+// Returns true if the data is in the queue and
+// sets idx to the index of the data in the queue
+static inline bool findIdx(bpqueue *pq, void *data, size_t *idx) {
+  if (pq->pos) {
+    size_t i = pq->toIndex(data);
+    if (i >= pq->nIndices || ! pq->pos[i])
+      return false;
+    *idx = pq->pos[i] - 1;
+    return true;
+  }
+  if (pq->toId) {
+    uint64_t val;
+    if (! u64MapHasKeyVal(pq->idmap, pq->toId(data), &val))
+      return false;
+    *idx = val;
+    return true;
+  }
+  return sstMapHasKeyVal(pq->datamap, pq->toString(data), idx);
 }
 
 //===================================================================
-// Swaps two nodes in the priority queue
-static void swapNodes(bpqueue *pq, size_t i, size_t j) {
-  SWAP(pq->arr[i], pq->arr[j]);
-    // update the map with the new indices
-  sstMapAddKey(pq->datamap, pq->toString(pq->arr[i]->data), i);
-  sstMapAddKey(pq->datamap, pq->toString(pq->arr[j]->data), j);
+// Removes the data -> idx mapping of the node
+static inline void unmapIdx(bpqueue *pq, bpqNode *node) {
+  if (pq->pos)
+    pq->pos[node->id] = 0;
+  else if (pq->toId)
+    u64MapDelKey(pq->idmap, node->id);
+  else
+    sstMapDelKey(pq->datamap, pq->toString(node->data));
 }
 
 //===================================================================
-// Heapifies the priority queue
+// Moves a node up from position idx until its parent has a 
+// better or equal key, moving the parents down
+static void siftUp(bpqueue *pq, size_t idx) {
+  bpqNode node = pq->arr[idx];
+  while (idx > 0) {
+    size_t parent = PARENT(pq, idx);
+    if (pq->fac * pq->compKey(node.key, pq->arr[parent].key) >= 0)
+      break;
+    pq->arr[idx] = pq->arr[parent];
+    mapIdx(pq, &pq->arr[idx], idx);
+    idx = parent;
+  }
+  pq->arr[idx] = node;
+  mapIdx(pq, &pq->arr[idx], idx);
+}
+
+//===================================================================
+// Moves a node down from position idx until its best child has
+// a worse or equal key, moving the best children up; the moved
+// nodes are only mapped to their new positions if map is true
+static inline void siftDown(bpqueue *pq, size_t idx, bool map) {
+  bpqNode node = pq->arr[idx];
+  while (true) {
+    size_t first = CHILD(pq, idx);
+    if (first >= pq->size)
+      break;
+    size_t last = first + pq->arity;
+    if (last > pq->size)
+      last = pq->size;
+      // find the child that is the best candidate for the top
+    size_t best = first;
+    void *bestKey = pq->arr[first].key;
+    for (size_t c = first + 1; c < last; c++) {
+      if (pq->fac * pq->compKey(pq->arr[c].key, bestKey) < 0) {
+        best = c;
+        bestKey = pq->arr[c].key;
+      }
+    }
+    if (pq->fac * pq->compKey(bestKey, node.key) >= 0)
+      break;
+    pq->arr[idx] = pq->arr[best];
+    if (map)
+      mapIdx(pq, &pq->arr[idx], idx);
+    idx = best;
+  }
+  pq->arr[idx] = node;
+  if (map)
+    mapIdx(pq, &pq->arr[idx], idx);
+}
+
+//===================================================================
+// Heapifies the priority queue starting from position idx
 static void bpqHeapify(bpqueue *pq, size_t idx) {
-  size_t l = LEFT(idx);
-  size_t r = RIGHT(idx);
-    // find the node that is the best candidate for the top
-  size_t best = idx;
-  if (l < pq->size && (pq->fac * pq->compKey(pq->arr[l]->key, 
-                                 pq->arr[best]->key) < 0))
-    best = l;
-  if (r < pq->size && (pq->fac * pq->compKey(pq->arr[r]->key, 
-                                 pq->arr[best]->key) < 0))
-    best = r;
-  if (best != idx) {
-    swapNodes(pq, idx, best);
-    bpqHeapify(pq, best);
+  siftDown(pq, idx, true);
+}
+
+//===================================================================
+// Sets the number of children per node in the heap
+void bpqSetArity(bpqueue *pq, size_t arity) {
+  if (arity < 2) {
+    fprintf(stderr, "bpqSetArity: arity must be at least 2\n");
+    return;
   }
+  pq->arity = arity;
+    // rebuild the heap, starting from the last non-leaf node
+  if (pq->size > 1)
+    for (size_t i = PARENT(pq, pq->size - 1) + 1; i--; ) 
+      bpqHeapify(pq, i);
 }
 
 //===================================================================
@@ -124,13 +253,11 @@ void *bpqPop(bpqueue *pq) {
   if (bpqIsEmpty(pq))
     return NULL;
     // get the top element
-  void *top = pq->arr[0]->data;
-    // remove the string(data) -> idx mapping
-  sstMapDelKey(pq->datamap, pq->toString(top));
+  void *top = pq->arr[0].data;
+    // remove the data -> idx mapping
+  unmapIdx(pq, &pq->arr[0]);
     // free the key
-  pq->freeKey(pq->arr[0]->key);
-    // free the bpqNode, obviously NOT the data
-  free(pq->arr[0]); 
+  pq->freeKey(pq->arr[0].key);
     // decrease the size of the queue
   pq->size--;
 
@@ -140,10 +267,6 @@ void *bpqPop(bpqueue *pq) {
       
     // move the last node to the top
   pq->arr[0] = pq->arr[pq->size];
-    // avoid dangling pointers
-  pq->arr[pq->size] = NULL;   
-    // update the map
-  sstMapAddKey(pq->datamap, pq->toString(pq->arr[0]->data), 0);
     // restore the heap property
   bpqHeapify(pq, 0);
   return top;
@@ -155,38 +278,101 @@ void bpqPush(bpqueue *pq, void *data, void *key) {
     // increase the capacity of the queue if necessary
   if (pq->size == pq->capacity) {
     pq->capacity *= 2;
-    pq->arr = safeRealloc(pq->arr, pq->capacity * sizeof(bpqNode *));
+    pq->arr = safeRealloc(pq->arr, pq->capacity * sizeof(bpqNode));
   }
-    // get the index of the new node
-  size_t idx = pq->size;
-    // create a new node
-  pq->arr[idx] = bpqNodeNew(data, pq->copyKey(key));
-    // add a string(data) -> idx mapping 
-  sstMapAddKey(pq->datamap, pq->toString(data), idx);
-    // restore the heap property
-  while (idx > 0 && (pq->fac * pq->compKey(pq->arr[idx]->key, 
-                               pq->arr[PARENT(idx)]->key) < 0)) {
-      swapNodes(pq, idx, PARENT(idx));
-      idx = PARENT(idx);
+    // the index of the data must fit in the position array
+  uint64_t id = pq->toIndex || pq->toId ? getId(pq, data) : 0;
+  if (pq->pos && id >= pq->nIndices) {
+    fprintf(stderr, "bpqPush: index of data out of range\n");
+    return;
   }
+    // create a new node at the end of the queue
+  size_t idx = pq->size;
+  pq->arr[idx] = (bpqNode){pq->copyKey(key), data, id};
+    // restore the heap property, which also adds 
+    // the data -> idx mapping
+  siftUp(pq, idx);
     // increase the size of the queue
   pq->size++;
 }
 
+//===================================================================
+// Returns true if no two of the n data items have the same index,
+// id or string; each item is marked in the position array or map
+// of the empty queue, where the marks are overwritten once the
+// items get their positions, or removed again if there is a
+// duplicate, so that the check takes O(n) time
+static bool distinctData(bpqueue *pq, void **data, size_t n) {
+  bool hasId = pq->toIndex || pq->toId;
+  size_t idx;
+  for (size_t i = 0; i < n; i++) {
+    if (findIdx(pq, data[i], &idx)) {
+      while (i--) {
+        bpqNode node = {NULL, data[i],
+                        hasId ? getId(pq, data[i]) : 0};
+        unmapIdx(pq, &node);
+      }
+      return false;
+    }
+    bpqNode node = {NULL, data[i], hasId ? getId(pq, data[i]) : 0};
+    mapIdx(pq, &node, 0);
+  }
+  return true;
+}
+
+//===================================================================
+// Builds the priority queue from n data items and their keys
+bool bpqBuild(bpqueue *pq, void **data, void **keys, size_t n) {
+  if (! bpqIsEmpty(pq)) {
+    fprintf(stderr, "bpqBuild: priority queue is not empty\n");
+    return false;
+  }
+    // the indices of the data must fit in the position array
+  if (pq->pos)
+    for (size_t i = 0; i < n; i++)
+      if (pq->toIndex(data[i]) >= pq->nIndices) {
+        fprintf(stderr, "bpqBuild: index of data out of range\n");
+        return false;
+      }
+  if (! distinctData(pq, data, n)) {
+    fprintf(stderr, "bpqBuild: data occurs more than once\n");
+    return false;
+  }
+  if (n > pq->capacity) {
+    pq->capacity = n;
+    pq->arr = safeRealloc(pq->arr, n * sizeof(bpqNode));
+  }
+    // copy the nodes into the array as they are
+  for (size_t i = 0; i < n; i++) {
+    uint64_t id = pq->toIndex || pq->toId ? getId(pq, data[i]) : 0;
+    pq->arr[i] = (bpqNode){pq->copyKey(keys[i]), data[i], id};
+  }
+  pq->size = n;
+    // heapify bottom-up, starting from the last non-leaf node,
+    // and map all data to their final positions afterwards
+  if (n > 1)
+    for (size_t i = PARENT(pq, n - 1) + 1; i--; )
+      siftDown(pq, i, false);
+  for (size_t i = 0; i < n; i++)
+    mapIdx(pq, &pq->arr[i], i);
+  return true;
+}
+
 //===================================================================
 // Checks if the data is in the priority queue
 bool bpqContains(bpqueue *pq, void *data) {
-  return sstMapHasKey(pq->datamap, pq->toString(data));
+  size_t idx;
+  return findIdx(pq, data, &idx);
 }
 
 //===================================================================
 // Returns the key associated with the data
 void *bpqGetKey(bpqueue *pq, void *data) {
   size_t idx = 0;
-  if (!sstMapHasKeyVal(pq->datamap, pq->toString(data), &idx) ||
-      ! pq->arr[idx])
+  if (! findIdx(pq, data, &idx) ||
+      idx >= pq->size)
     return NULL;
-  return pq->arr[idx]->key;
+  return pq->arr[idx].key;
 }
 
 //===================================================================
@@ -195,26 +381,22 @@ static bool bpqChangeKey(bpqueue *pq, void *data, void *newKey) {
   
     // get the index of the node in the queue
   size_t idx = 0;
-  if (!sstMapHasKeyVal(pq->datamap, pq->toString(data), &idx) ||
-      ! pq->arr[idx]) {
+  if (! findIdx(pq, data, &idx) ||
+      idx >= pq->size) {
     fprintf(stderr, "bpqChangeKey: data not in the queue\n");
     return false;
   }
 
-  if (pq->fac * pq->compKey(newKey, pq->arr[idx]->key) > 0) {
+  if (pq->fac * pq->compKey(newKey, pq->arr[idx].key) > 0) {
     fprintf(stderr, "bpqChangeKey: new key is %s than current key\n",
             pq->type == MIN ? "greater" : "less");
     return false;
   }
 
-  pq->freeKey(pq->arr[idx]->key);
-  pq->arr[idx]->key = pq->copyKey(newKey);
+  pq->freeKey(pq->arr[idx].key);
+  pq->arr[idx].key = pq->copyKey(newKey);
     // restore the heap property
-  while (idx > 0 && (pq->fac * pq->compKey(pq->arr[idx]->key, 
-                               pq->arr[PARENT(idx)]->key) < 0)) {
-    swapNodes(pq, idx, PARENT(idx));
-    idx = PARENT(idx);
-  }
+  siftUp(pq, idx);
 
   return true;
 }
@@ -256,9 +438,9 @@ void bpqShow(bpqueue *pq) {
 
   for (size_t i = 0; i < pq->size; i++) {
     printf ("[");
-    pq->showKey(pq->arr[i]->key);
+    pq->showKey(pq->arr[i].key);
     printf ("]: ");
-    pq->showData(pq->arr[i]->data);
+    pq->showData(pq->arr[i].data);
     if (i < pq->size - 1) printf("%s", pq->delim);
     if ((i + 1) % 5 == 0) printf("\n");
   }
@@ -288,6 +470,5 @@ bool bpqDelete(bpqueue *pq, void *data) {
 
 //===================================================================
 // End of file
-#undef RIGHT
-#undef LEFT
+#undef CHILD
 #undef PARENT
\ No newline at end of file
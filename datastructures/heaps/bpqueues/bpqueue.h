@@ -4,7 +4,20 @@
     mapping data to indices in the queue (str(data) -> idx)
     String representation of data should be unique for each 
     data item
-    The comparison function should compare the keys of the
+    Alternatively, a function mapping data to a unique unsigned
+    64-bit integer can be set (bpqSetToId), in which case the
+    queue keeps its data -> idx mapping in an integer map, which
+    avoids building and hashing a string on every heap swap
+    Fastest is to number the data items 0..n-1 and set a function
+    returning that number (bpqSetToIndex): the queue then keeps
+    the position of each item in a plain array, so that finding,
+    swapping and updating nodes involves no hashing at all
+    The heap is binary by default, but can be made d-ary 
+    (bpqSetArity): a 4-ary heap is half as deep, which makes
+    the many decrease-key operations of e.g. Dijkstra cheaper
+  The nodes are stored in the heap array itself, so that
+    comparing the children of a node does not follow pointers
+  The comparison function should compare the keys of the
     nodes in the queue (not the data) and return -1, 0, 1
     for less than, equal to, greater than, respectively
   Author: David De Potter
@@ -17,7 +30,9 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdint.h>
 #include "../../htables/single-value/string-size-t/sstMap.h"
+#include "../../htables/single-value/uint64-uint64/u64Map.h"
 
 // function pointer types
 typedef int (*bpqCompKey)(void const *a, void const *b);
@@ -26,6 +41,8 @@ typedef void *(*bpqCopyKey)(void const *key);
 typedef void (*bpqShowKey)(void const *key);
 typedef char *(*bpqToString)(void const *data);
 typedef void (*bpqShowData)(void const *data);
+typedef uint64_t (*bpqToId)(void const *data);
+typedef size_t (*bpqToIndex)(void const *data);
 
 // priority queue type
 typedef enum { MIN, MAX } bpqType;
@@ -34,16 +51,23 @@ typedef enum { MIN, MAX } bpqType;
 typedef struct {
   void *key;             // key (priority) of the node
   void *data;            // data associated with the key
+  uint64_t id;           // id or index of the data, if set
 } bpqNode;
 
 // priority queue
 typedef struct {     
-  bpqNode **arr;         // array of nodes
+  bpqNode *arr;          // array of nodes
   sstMap *datamap;       // maps input data to indices in the queue
   bpqToString toString;  // function to convert data to string
+  u64Map *idmap;         // maps data ids to indices in the queue
+  bpqToId toId;          // function to convert data to id, or NULL
+  size_t *pos;           // index of data -> 1 + position in queue
+  size_t nIndices;       // number of indices in pos
+  bpqToIndex toIndex;    // function to convert data to index, or NULL
   bpqShowData showData;  // function to show data                        
   size_t size;           // number of nodes in the queue
   size_t capacity;       // capacity of the queue
+  size_t arity;          // number of children per node
   bpqCompKey compKey;    // comparison function for the keys
   bpqShowKey showKey;    // show function
   bpqFreeKey freeKey;    // function to free key
@@ -74,6 +98,21 @@ bpqueue *bpqNew(size_t capacity, bpqType type,
 void bpqSetShow(bpqueue *pq, bpqShowKey show, 
                 bpqShowData showData);
 
+  // sets a function that maps each data item to a unique
+  // integer id; the queue then uses an integer map instead of 
+  // the string map; must be called before pushing any data
+void bpqSetToId(bpqueue *pq, bpqToId toId);
+
+  // sets a function that maps each data item to a unique
+  // index in 0..n-1; the queue then keeps the positions of
+  // the data in an array of size n instead of a map; 
+  // must be called before pushing any data
+void bpqSetToIndex(bpqueue *pq, bpqToIndex toIndex, size_t n);
+
+  // sets the number of children per node in the heap
+  // (default 2); if the queue is not empty, it is rebuilt
+void bpqSetArity(bpqueue *pq, size_t arity);
+
   // sets the label for the priority queue
 void bpqSetLabel(bpqueue *pq, char *label);
 
@@ -109,6 +148,15 @@ bool bpqUpdateKey(bpqueue *pq, void *data,
   // the given data and key (priority)
 void bpqPush(bpqueue *pq, void *data, void *key);
 
+  // builds the priority queue from the n data items in data
+  // and their keys (priorities) in keys, in O(n) time by
+  // heapifying bottom-up; the queue must be empty and any id
+  // or index function must have been set; returns false, and
+  // leaves the queue empty, if it is not empty, if an index is
+  // out of range, or if two data items have the same index, id
+  // or string
+bool bpqBuild(bpqueue *pq, void **data, void **keys, size_t n);
+
   // returns true if the data is in the queue
 bool bpqContains(bpqueue *pq, void *data);
 
@@ -0,0 +1,104 @@
+/* 
+  Generic priority queue, using a binary heap
+  Benchmark of the three ways in which the queue can find the
+    position of its data: a string map (toString), an integer
+    map (bpqSetToId) and a position array (bpqSetToIndex)
+  Pushes n items with random priorities, decreases the priority
+    of random items 4n times, and pops all items
+  The position array is also timed with 4-ary and 8-ary heaps
+  Usage: ./bench.out [n]
+  Author: David De Potter
+*/
+
+#include "../bpqueue.h"  
+#include <time.h>
+#include <float.h>
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// comparison function for double keys
+int compKeys(void const *a, void const *b) {
+  double x = *(double *)a;
+  double y = *(double *)b;
+  return x < y ? -1 : x > y;
+}
+
+//===================================================================
+// make a copy of a double key
+void *copyKey(void const *key) {
+  double *copy = safeCalloc(1, sizeof(double));
+  *copy = *(double *)key;
+  return copy;
+}
+
+//===================================================================
+// string representation of an item
+char *itemToString(void const *data) {
+  static char buf[32];
+  sprintf(buf, "%zu", *(size_t *)data);
+  return buf;
+}
+
+//===================================================================
+// integer id of an item
+uint64_t itemToId(void const *data) {
+  return *(size_t *)data;
+}
+
+//===================================================================
+// index of an item in 0..n-1
+size_t itemToIndex(void const *data) {
+  return *(size_t *)data;
+}
+
+//===================================================================
+// runs the benchmark for one mode (0: string, 1: id, 2: index)
+// and arity
+void run(size_t *items, double *keys, size_t n, int mode,
+         size_t arity) {
+  clock_t start = clock();
+  bpqueue *pq = bpqNew(n, MIN, compKeys, copyKey, 
+                       free, itemToString, NULL);
+  if (mode == 1)
+    bpqSetToId(pq, itemToId);
+  else if (mode == 2)
+    bpqSetToIndex(pq, itemToIndex, n);
+  bpqSetArity(pq, arity);
+
+  for (size_t i = 0; i < n; i++)
+    bpqPush(pq, items + i, keys + i);
+  for (size_t i = 0; i < 4 * n; i++) {
+    size_t j = rand() % n;
+    keys[j] -= rand() % 1000;
+    bpqUpdateKey(pq, items + j, keys + j);
+  }
+  while (! bpqIsEmpty(pq))
+    bpqPop(pq);
+  bpqFree(pq);
+
+  char *names[] = {"string map", "integer map", "position array"};
+  printf("  %-15s, arity %zu: %6.2f s\n", names[mode], arity,
+         (double)(clock() - start) / CLOCKS_PER_SEC);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t *items = safeCalloc(n, sizeof(size_t));
+  double *keys = safeCalloc(n, sizeof(double));
+  printf("%zu items, %zu decrease-keys\n", n, 4 * n);
+  for (int r = 0; r < 5; r++) {
+    int mode = r < 3 ? r : 2;
+    size_t arity = r < 3 ? 2 : r == 3 ? 4 : 8;
+    srand(n);
+    for (size_t i = 0; i < n; i++) {
+      items[i] = i;
+      keys[i] = 1e9 + rand();
+    }
+    run(items, keys, n, mode, arity);
+  }
+  free(items);
+  free(keys);
+  return 0;
+}
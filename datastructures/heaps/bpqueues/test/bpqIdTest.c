@@ -0,0 +1,151 @@
+/* 
+  Generic priority queue, using a binary heap
+  Tests the priority queue with an integer id function and
+    with an index function instead of a string representation
+    of the data, and with a 4-ary heap:
+    pushes numbered items with random priorities, or builds
+    the queue from them in one go,
+    decreases some priorities, deletes some items, and
+    checks that the items are popped in order
+  Author: David De Potter
+*/
+
+#include "../bpqueue.h"  
+#include <time.h>
+#include <float.h>
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// comparison function for double keys
+int compKeys(void const *a, void const *b) {
+  double x = *(double *)a;
+  double y = *(double *)b;
+  return x < y ? -1 : x > y;
+}
+
+//===================================================================
+// make a copy of a double key
+void *copyKey(void const *key) {
+  double *copy = safeCalloc(1, sizeof(double));
+  *copy = *(double *)key;
+  return copy;
+}
+
+//===================================================================
+// string representation of an item (not used)
+char *itemToString(void const *data) {
+  static char buf[32];
+  sprintf(buf, "%zu", *(size_t *)data);
+  return buf;
+}
+
+//===================================================================
+// integer id of an item
+uint64_t itemToId(void const *data) {
+  return *(size_t *)data;
+}
+
+//===================================================================
+// index of an item in 0..n-1
+size_t itemToIndex(void const *data) {
+  return *(size_t *)data;
+}
+
+//===================================================================
+// runs the test with an id or an index function 
+// and the given arity, pushing the items or building 
+// the queue from them
+void runTest(bool useIndex, size_t arity, bool build) {
+  size_t size = 10000;
+  double bound = -DBL_MAX;
+
+  bpqueue *pq = bpqNew(16, MIN, compKeys, copyKey, 
+                       free, itemToString, &bound);
+  if (useIndex)
+    bpqSetToIndex(pq, itemToIndex, size);
+  else
+    bpqSetToId(pq, itemToId);
+  bpqSetArity(pq, arity);
+  printf("%s function, arity %zu\n", 
+         useIndex ? "Index" : "Id", arity);
+
+  size_t *items = safeCalloc(size, sizeof(size_t));
+  double *keys = safeCalloc(size, sizeof(double));
+  void **data = safeCalloc(size, sizeof(void *));
+  void **keyPtrs = safeCalloc(size, sizeof(void *));
+  for (size_t i = 0; i < size; i++) {
+    items[i] = i;
+    keys[i] = rand() % 100000;
+    data[i] = items + i;
+    keyPtrs[i] = keys + i;
+    if (! build)
+      bpqPush(pq, items + i, keys + i);
+  }
+  if (build && size > 1) {
+      // an item that occurs twice is rejected, and the queue
+      // stays empty and can still be built
+    data[size - 1] = data[0];
+    bool built = bpqBuild(pq, data, keyPtrs, size);
+    printf("Duplicate item %s\n", ! built && bpqIsEmpty(pq) &&
+           ! bpqContains(pq, data[0]) ? "rejected" : "NOT rejected");
+    data[size - 1] = items + size - 1;
+  }
+  if (build)
+    bpqBuild(pq, data, keyPtrs, size);
+  printf("%s %zu items\n", build ? "Built queue from" : "Pushed",
+         bpqSize(pq));
+
+    // decrease the priority of every third item
+  size_t updates = 0;
+  for (size_t i = 0; i < size; i += 3) {
+    double key = *(double *)bpqGetKey(pq, items + i) - 1000;
+    if (bpqUpdateKey(pq, items + i, &key))
+      updates++;
+  }
+  printf("Decreased %zu priorities\n", updates);
+
+    // delete every seventh item
+  size_t deletions = 0;
+  for (size_t i = 0; i < size; i += 7)
+    if (bpqDelete(pq, items + i))
+      deletions++;
+  printf("Deleted %zu items, %zu items left\n", 
+         deletions, bpqSize(pq));
+
+  bool ok = true;
+  for (size_t i = 0; i < size; i++)
+    if (bpqContains(pq, items + i) == (i % 7 == 0))
+      ok = false;
+
+    // pop all items and check the order
+  double prev = -DBL_MAX;
+  size_t popped = 0;
+  while (! bpqIsEmpty(pq)) {
+    double key = *(double *)bpqGetKey(pq, bpqPeek(pq));
+    if (key < prev)
+      ok = false;
+    prev = key;
+    bpqPop(pq);
+    popped++;
+  }
+  printf("Popped %zu items %s\n", popped, 
+         ok ? "in order" : "NOT in order");
+  
+  free(items);
+  free(keys);
+  free(data);
+  free(keyPtrs);
+  bpqFree(pq);
+}
+
+//===================================================================
+
+int main () {
+  srand(time(NULL));
+  runTest(false, 2, false);
+  runTest(true, 2, false);
+  runTest(true, 4, false);
+  runTest(false, 2, true);
+  runTest(true, 4, true);
+  return 0;
+}
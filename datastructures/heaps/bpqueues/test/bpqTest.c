@@ -52,7 +52,7 @@ void showKey(void const *key) {
 task *newTask(size_t n) {
   char *name = safeCalloc(50, sizeof(char));
   sprintf(name, "Task %zu", n);
-  char duration[5];
+  char duration[8];
   sprintf(duration, "%d", rand() % 60);
   sprintf(duration + strlen(duration), ".%02d", rand() % 60);
   task *t = safeCalloc(1, sizeof(task));
@@ -1,7 +1,15 @@
+/* 
+  Generic Fibonacci heap implementation
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
 #include "fibheap.h"
 #include "../../../lib/clib.h"
 #include <math.h>
 
+#define FIB_BLOCK 1024    // number of nodes per block in the pool
+
 //===================================================================
 // FNV-1a hash function
 // (http://www.isthe.com/chongo/tech/comp/fnv/index.html)
@@ -48,34 +56,136 @@ fibheap *fibNew(fibType type, fibCompKey compKey,
 }
 
 //===================================================================
-// Creates a new Fibonnacci node with data and key
+// Sets the data to index function for the Fibonacci heap
+void fibSetToIndex(fibheap *F, fibToIndex toIndex, size_t n) {
+  if (! fibIsEmpty(F)) {
+    fprintf(stderr, "fibSetToIndex: Fibonacci heap is not empty\n");
+    return;
+  }
+  if (! toIndex)
+    return;
+  F->toIndex = toIndex;
+  free(F->nodes);
+  F->nodes = safeCalloc(n ? n : 1, sizeof(fibnode *));
+  F->nIndices = n;
+  if (F->datamap)
+    mapFree(F->datamap);
+  F->datamap = NULL;
+}
+
+//===================================================================
+// Sets the type of the keys
+void fibSetKeyType(fibheap *F, fibKeyType keyType) {
+  if (! fibIsEmpty(F)) {
+    fprintf(stderr, "fibSetKeyType: Fibonacci heap is not empty\n");
+    return;
+  }
+  F->keyType = keyType;
+}
+
+//===================================================================
+// Compares two keys, taking the heap type into account: 
+// returns a negative value if a should be closer to the top
+static inline int cmpKeys(fibheap *F, void const *a, void const *b) {
+  switch (F->keyType) {
+    case FIB_DOUBLE: {
+      double x = *(double *)a, y = *(double *)b;
+      return F->fac * ((x > y) - (x < y));
+    }
+    case FIB_INT64: {
+      int64_t x = *(int64_t *)a, y = *(int64_t *)b;
+      return F->fac * ((x > y) - (x < y));
+    }
+    default:
+      return F->fac * F->compKey(a, b);
+  }
+}
+
+//===================================================================
+// Sets the key of node u to a copy of key
+static inline void setKey(fibheap *F, fibnode *u, void *key) {
+  switch (F->keyType) {
+    case FIB_DOUBLE:
+      u->val.d = *(double *)key;
+      u->key = &u->val;
+      break;
+    case FIB_INT64:
+      u->val.i = *(int64_t *)key;
+      u->key = &u->val;
+      break;
+    default:
+      u->key = F->copyKey(key);
+  }
+}
+
+//===================================================================
+// Returns the node containing the data, or NULL
+static inline fibnode *findNode(fibheap *F, void *data) {
+  if (F->nodes) {
+    size_t i = F->toIndex(data);
+    return i < F->nIndices ? F->nodes[i] : NULL;
+  }
+  return mapGetVal(F->datamap, F->toString(data));
+}
+
+//===================================================================
+// Creates a new Fibonnacci node with data and key, taking it 
+// from the free list of the pool
 static fibnode *newFibnode(fibheap *F, void *data, void *key) {
-  fibnode *u = safeCalloc(1, sizeof(fibnode));
+  if (! F->freeList) {
+      // add a new block of nodes to the pool
+    F->blocks = safeRealloc(F->blocks, 
+                            (F->nBlocks + 1) * sizeof(fibnode *));
+    fibnode *block = safeCalloc(FIB_BLOCK, sizeof(fibnode));
+    F->blocks[F->nBlocks++] = block;
+    for (size_t i = 0; i < FIB_BLOCK; i++) {
+      block[i].next = F->freeList;
+      F->freeList = block + i;
+    }
+  }
+  fibnode *u = F->freeList;
+  F->freeList = u->next;
+  *u = (fibnode){0};
   u->data = data;
-  u->key = key;
-  u->mark = false;
-  u->degree = 0;
-    // add a new key-value pair to the datamap
-  mapAddKey(F->datamap, F->toString(data), u);
+  setKey(F, u, key);
+    // map the data to the node
+  if (F->nodes)
+    F->nodes[F->toIndex(data)] = u;
+  else
+    mapAddKey(F->datamap, F->toString(data), u);
   return u;
 }
 
 //===================================================================
-// Deallocates a Fibonacci node
+// Deallocates a Fibonacci node by returning it to the free list
 static void freeFibnode(fibheap *F, fibnode *u) {
-  F->freeKey(u->key);
-    // remove the key-value pair from the datamap
-  mapDelKey(F->datamap, F->toString(u->data));
-  free(u);
+  if (F->keyType == FIB_PTR)
+    F->freeKey(u->key);
+    // remove the data -> node mapping
+  if (F->nodes)
+    F->nodes[F->toIndex(u->data)] = NULL;
+  else
+    mapDelKey(F->datamap, F->toString(u->data));
+  u->data = NULL;
+  u->next = F->freeList;
+  F->freeList = u;
 }
 
 //===================================================================
 // Deallocates the Fibonacci heap
 void fibFree(fibheap *F) {
-  while (F->size) 
-    fibPop(F);
-  
+  if (! F) return;
+    // the nodes in use are those with data
+  for (size_t b = 0; b < F->nBlocks; b++) {
+    if (F->keyType == FIB_PTR)
+      for (size_t i = 0; i < FIB_BLOCK; i++)
+        if (F->blocks[b][i].data)
+          F->freeKey(F->blocks[b][i].key);
+    free(F->blocks[b]);
+  }
+  free(F->blocks);
   if (F->datamap) mapFree(F->datamap);
+  free(F->nodes);
   free(F);
 }
 
@@ -145,21 +255,26 @@ static void link(fibheap *H, fibnode *u, fibnode *v) {
 
 //===================================================================
 // Inserts a node with given data and key into the Fibonacci heap
-void fibPush(fibheap *F, void *data, void *key) {
+fibnode *fibPush(fibheap *F, void *data, void *key) {
   
-  if (! F || ! data || ! key) return;
+  if (! F || ! data || ! key) return NULL;
 
-  if (F->sentinel && F->fac * F->compKey(key, F->sentinel) == 0) {
+  if (F->sentinel && cmpKeys(F, key, F->sentinel) == 0) {
     fprintf(stderr, "fibPush: key is the sentinel key\n");
-    return;
+    return NULL;
+  }
+
+  if (F->nodes && F->toIndex(data) >= F->nIndices) {
+    fprintf(stderr, "fibPush: index of data out of range\n");
+    return NULL;
   }
 
-  if (mapGetVal(F->datamap, F->toString(data))) {
+  if (findNode(F, data)) {
     fprintf(stderr, "fibPush: data already in the heap\n");
-    return;
+    return NULL;
   }
 
-  fibnode *u = newFibnode(F, data, F->copyKey(key));
+  fibnode *u = newFibnode(F, data, key);
 
   if (! F->top)                  
       // if the heap is empty, make a root list of one node
@@ -168,10 +283,72 @@ void fibPush(fibheap *F, void *data, void *key) {
       // else insert u into the existing root list
       // and update the top pointer if necessary
     cListInsert(u, F->top);     
-    if (F->fac * F->compKey(u->key, F->top->key) < 0) 
+    if (cmpKeys(F, u->key, F->top->key) < 0) 
       F->top = u;              
   }
   F->size++;                   
+  return u;
+}
+
+//===================================================================
+// Inserts n nodes with given data and keys into the Fibonacci heap
+// by linking them into a chain, which is spliced into the root 
+// list in one go
+void fibBuild(fibheap *F, void **data, void **keys, size_t n) {
+
+  if (! F || n == 0) return;
+
+    // an empty heap gets a map that can hold all data at once
+  if (F->size == 0 && F->datamap) {
+    mapFree(F->datamap);
+    F->datamap = mapNew(fibHash, n, cmpStrCS);
+  }
+
+  fibnode *first = NULL, *last = NULL, *best = NULL;
+  for (size_t i = 0; i < n; i++) {
+    if (! data[i] || ! keys[i]) continue;
+    if (F->sentinel && cmpKeys(F, keys[i], F->sentinel) == 0) {
+      fprintf(stderr, "fibBuild: key is the sentinel key\n");
+      continue;
+    }
+    if (F->nodes && F->toIndex(data[i]) >= F->nIndices) {
+      fprintf(stderr, "fibBuild: index of data out of range\n");
+      continue;
+    }
+    if (findNode(F, data[i])) {
+      fprintf(stderr, "fibBuild: data already in the heap\n");
+      continue;
+    }
+    fibnode *u = newFibnode(F, data[i], keys[i]);
+      // append u to the chain of new nodes
+    if (! first) 
+      first = u;
+    else {
+      last->next = u;
+      u->prev = last;
+    }
+    last = u;
+    if (! best || cmpKeys(F, u->key, best->key) < 0)
+      best = u;
+    F->size++;
+  }
+  if (! first) return;
+
+  if (! F->top) {
+      // if the heap was empty, the chain becomes the root list
+    first->prev = last;
+    last->next = first;
+    F->top = best;
+  } else {
+      // else splice the chain into the root list before the top
+      // node and update the top pointer if necessary
+    last->next = F->top;
+    first->prev = F->top->prev;
+    F->top->prev->next = first;
+    F->top->prev = last;
+    if (cmpKeys(F, best->key, F->top->key) < 0)
+      F->top = best;
+  }
 }
 
 //===================================================================
@@ -201,7 +378,7 @@ static void consolidate(fibheap *F) {
     while (A[d]) {      
         // get the node v with the same degree as u
       fibnode *v = A[d];        
-      if (F->fac * F->compKey(u->key, v->key) > 0) 
+      if (cmpKeys(F, u->key, v->key) > 0) 
         SWAP(u, v);
       link(F, v, u);            
       A[d++] = NULL;            
@@ -224,7 +401,7 @@ static void consolidate(fibheap *F) {
           // else insert w into the root list 
           // and update the top pointer if necessary
         cListInsert(w, F->top);
-        if (F->fac * F->compKey(w->key, F->top->key) < 0)
+        if (cmpKeys(F, w->key, F->top->key) < 0)
           F->top = w;  
       }
     }
@@ -308,18 +485,19 @@ static void cascadingCut(fibheap *F, fibnode *u) {
 // Changes the key of the node containing the data to newKey
 static void fibChangeKey(fibheap *F, fibnode *u, void *newKey) {
   
-  F->freeKey(u->key);
-  u->key = F->copyKey(newKey);    
+  if (F->keyType == FIB_PTR)
+    F->freeKey(u->key);
+  setKey(F, u, newKey);    
         
   fibnode *v = u->parent;
-  if (v && (F->fac * F->compKey(u->key, v->key) < 0)) {
+  if (v && cmpKeys(F, u->key, v->key) < 0) {
       // if u is not a root and its key is less than 
       // its parent's key, cut u from its parent  
     cut(F, u, v);
     cascadingCut(F, v);
   }
     // update top pointer if necessary
-  if (F->fac * F->compKey(u->key, F->top->key) < 0) 
+  if (cmpKeys(F, u->key, F->top->key) < 0) 
     F->top = u;
 }
 
@@ -329,19 +507,28 @@ static void fibChangeKey(fibheap *F, fibnode *u, void *newKey) {
 bool fibUpdateKey(fibheap *F, void *data, void *newKey) {
 
   if (!F || ! data || ! newKey) return false;
-  
-  if (F->sentinel && F->fac * F->compKey(newKey, F->sentinel) == 0) {
-    fprintf(stderr, "fibUpdateKey: new key is the sentinel key\n");
-    return false;
-  }
 
-  fibnode *u = mapGetVal(F->datamap, F->toString(data));
+  fibnode *u = findNode(F, data);
   if (! u) {
     fprintf(stderr, "fibUpdateKey: data not in the heap\n");
     return false;
   }
+  return fibUpdateNodeKey(F, u, newKey);
+}
 
-  if (F->fac * F->compKey(newKey, u->key) > 0) {
+//===================================================================
+// Updates the key of the node u to newKey
+// Returns true if the update was successful
+bool fibUpdateNodeKey(fibheap *F, fibnode *u, void *newKey) {
+
+  if (!F || ! u || ! newKey) return false;
+  
+  if (F->sentinel && cmpKeys(F, newKey, F->sentinel) == 0) {
+    fprintf(stderr, "fibUpdateKey: new key is the sentinel key\n");
+    return false;
+  }
+
+  if (cmpKeys(F, newKey, u->key) > 0) {
     fprintf(stderr, "fibUpdateKey: new key is %s than current key\n",
            F->type == MIN ? "greater" : "less");
     return false;
@@ -356,7 +543,7 @@ bool fibUpdateKey(fibheap *F, void *data, void *newKey) {
 // Returns the key of the data in the Fibonacci heap
 void *fibGetKey(fibheap *F, void *data) {
   if (! data || ! F) return NULL;
-  fibnode *u = mapGetVal(F->datamap, F->toString(data));
+  fibnode *u = findNode(F, data);
   if (! u) {
     fprintf(stderr, "fibGetKey: data not in the heap\n");
     return NULL;
@@ -419,7 +606,7 @@ void *fibPeek(fibheap *F) {
 // Returns true if the data is in the Fibonacci heap
 bool fibContains(fibheap *F, void *data) {
   if (! data) return false;
-  return mapHasKey(F->datamap, F->toString(data));
+  return findNode(F, data) != NULL;
 }
 
 //===================================================================
@@ -437,16 +624,28 @@ bool fibDelete(fibheap *F, void *data) {
     return false;
   }
 
-  fibnode *u = mapGetVal(F->datamap, F->toString(data));
+  fibnode *u = findNode(F, data);
   if (! u) {
     fprintf(stderr, "fibDelete: following data not in the heap\n  ");
     F->showData(data);
     return false;
   }
   
+  fibDeleteNode(F, u);
+  return true;
+}
+
+//===================================================================
+// Deletes the node u from the Fibonacci heap by updating its key
+// to the sentinel key and popping it
+void fibDeleteNode(fibheap *F, fibnode *u) {
+  if (! F || ! u) return;
+  if (! F->sentinel) {
+    fprintf(stderr, "fibDeleteNode: sentinel key not set\n");
+    return;
+  }
   fibChangeKey(F, u, F->sentinel);
   fibPop(F);
-  return true;
 }
 
 //===================================================================
@@ -462,19 +661,29 @@ fibheap *fibUnion(fibheap *F1, fibheap *F2) {
     return NULL;
   }
 
-  if (F1->compKey != F2->compKey) {
+  if (F1->compKey != F2->compKey || F1->keyType != F2->keyType) {
     fprintf(stderr, "fibUnion: heaps have different "
                      "comparison functions\n");
     return NULL;
   }
 
-  if (F1->compKey(F1->sentinel, F2->sentinel) != 0) {
+  if ((F1->sentinel == NULL) != (F2->sentinel == NULL) ||
+      (F1->sentinel && 
+       cmpKeys(F1, F1->sentinel, F2->sentinel) != 0)) {
     fprintf(stderr, "fibUnion: heaps have different sentinels\n");
     return NULL;
   }
 
+  if ((F1->nodes == NULL) != (F2->nodes == NULL) ||
+      F1->nIndices != F2->nIndices) {
+    fprintf(stderr, "fibUnion: heaps find their data "
+                    "in different ways\n");
+    return NULL;
+  }
+
   fibheap *F = fibNew(F1->type, F1->compKey, F1->copyKey, 
                       F1->freeKey, F1->toString, F1->sentinel);
+  F->keyType = F1->keyType;
 
   F->size = F1->size + F2->size;
   F->top = F1->top;
@@ -487,11 +696,33 @@ fibheap *fibUnion(fibheap *F1, fibheap *F2) {
   } 
 
   if (F2->top && (! F1->top || 
-      F1->fac * F1->compKey(F2->top->key, F1->top->key) < 0))
+      cmpKeys(F1, F2->top->key, F1->top->key) < 0))
     F->top = F2->top;
   
+    // merge the data -> node mappings
   mapFree(F->datamap);
-  F->datamap = mapMerge(F1->datamap, F2->datamap);
+  F->datamap = NULL;
+  if (F1->nodes) {
+    F->toIndex = F1->toIndex;
+    F->nIndices = F1->nIndices;
+    F->nodes = F1->nodes;
+    for (size_t i = 0; i < F2->nIndices; i++)
+      if (F2->nodes[i])
+        F->nodes[i] = F2->nodes[i];
+    free(F2->nodes);
+  } else
+    F->datamap = mapMerge(F1->datamap, F2->datamap);
+
+    // take over the pools of both heaps; the free 
+    // nodes of F2 are only released with the blocks
+  F->nBlocks = F1->nBlocks + F2->nBlocks;
+  F->blocks = safeCalloc(F->nBlocks + 1, sizeof(fibnode *));
+  memcpy(F->blocks, F1->blocks, F1->nBlocks * sizeof(fibnode *));
+  memcpy(F->blocks + F1->nBlocks, F2->blocks, 
+         F2->nBlocks * sizeof(fibnode *));
+  F->freeList = F1->freeList;
+  free(F1->blocks);
+  free(F2->blocks);
   
   free(F1);
   free(F2);
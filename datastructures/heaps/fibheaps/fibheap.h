@@ -12,6 +12,17 @@
     The sentinel key is used to initialize the key of a node
     that is to be deleted from the heap. The key is set to the
     sentinel key, and the node is then popped from the heap.
+    Instead of the map, the data can be numbered 0..n-1 and a
+    function returning that number can be set (fibSetToIndex),
+    in which case the nodes are kept in a plain array and no
+    hashing is done at all. Push also returns a handle to the
+    new node, which can be passed to fibUpdateNodeKey and
+    fibDeleteNode without any lookup
+    Keys that are doubles or 64-bit integers can be stored in
+    the nodes themselves (fibSetKeyType), which avoids copying
+    and freeing keys and calling the comparison function
+    The nodes are taken from a pool of blocks with a free list,
+    instead of being allocated one by one
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
 */
@@ -22,6 +33,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdint.h>
 #include "../../htables/single-value/map.h"
 
 // function pointer types
@@ -31,13 +43,22 @@ typedef void *(*fibCopyKey)(void const *key);
 typedef void (*fibShowKey)(void const *key);
 typedef char *(*fibToString)(void const *data);
 typedef void (*fibShowData)(void const *data);
+typedef size_t (*fibToIndex)(void const *data);
 
 // Fibonacci heap type
 typedef enum { MIN, MAX } fibType;
 
+// type of the keys: pointers to keys that are copied with the
+// copy function, or doubles or 64-bit integers stored in the nodes
+typedef enum { FIB_PTR, FIB_DOUBLE, FIB_INT64 } fibKeyType;
+
 // Fibonacci heap node
 typedef struct fibnode {
   void *key;              // key (priority) of the node
+  union {                 // key stored in the node, if the
+    double d;             // key type is FIB_DOUBLE or FIB_INT64;
+    int64_t i;            // key then points to it
+  } val;
   void *data;             // data associated with the key
   size_t degree;          // degree of the node
   bool mark;              // mark of the node
@@ -52,6 +73,13 @@ typedef struct {
   fibnode *top;           // pointer to the top node of the heap
   map *datamap;           // map (string -> fibnode ptr) for data
   fibToString toString;   // function to convert data to string
+  fibnode **nodes;        // index of data -> node, or NULL
+  size_t nIndices;        // number of indices in nodes
+  fibToIndex toIndex;     // function to convert data to index
+  fibKeyType keyType;     // type of the keys
+  fibnode **blocks;       // blocks of nodes in the pool
+  size_t nBlocks;         // number of blocks
+  fibnode *freeList;      // unused nodes, linked by next
   fibShowData showData;   // function to show data                        
   size_t size;            // number of nodes in the queue
   fibCompKey compKey;     // comparison function for the keys
@@ -81,12 +109,32 @@ void fibSetShow(fibheap *F, fibShowKey showKey, fibShowData showData);
   // sets the label for the Fibonacci heap
 void fibSetLabel(fibheap *F, char *label);
 
+  // sets a function that maps each data item to a unique
+  // index in 0..n-1; the heap then keeps its nodes in an
+  // array of size n instead of a map; must be called
+  // before pushing any data
+void fibSetToIndex(fibheap *F, fibToIndex toIndex, size_t n);
+
+  // sets the type of the keys (default FIB_PTR); with FIB_DOUBLE
+  // or FIB_INT64, the keys passed to the heap should point to
+  // a double or an int64_t, which is stored in the node, and 
+  // the copy, free and comparison functions are not used;
+  // must be called before pushing any data
+void fibSetKeyType(fibheap *F, fibKeyType keyType);
+
   // deallocates the Fibonacci heap
 void fibFree(fibheap *F);
 
   // inserts a new node into the Fibonacci heap with
-  // the given data and key (priority)
-void fibPush(fibheap *F, void *data, void *key);
+  // the given data and key (priority); returns a handle to
+  // the node, which stays valid until the node is popped or
+  // deleted, or NULL if the data could not be inserted
+fibnode *fibPush(fibheap *F, void *data, void *key);
+
+  // inserts n nodes with the given data and keys into the 
+  // Fibonacci heap at once, by splicing them into the root 
+  // list; if the heap is empty, its map is sized for n items
+void fibBuild(fibheap *F, void **data, void **keys, size_t n);
 
   // returns the top element of the Fibonacci heap without removing 
   // it from the heap; returns NULL if the queue is empty
@@ -100,6 +148,10 @@ void *fibPop(fibheap *F);
   // returns true if the update was successful
 bool fibUpdateKey(fibheap *F, void *data, void *newKey);
 
+  // updates the priority of the node with the given handle
+  // returns true if the update was successful
+bool fibUpdateNodeKey(fibheap *F, fibnode *u, void *newKey);
+
   // returns true if the data is in the Fibonacci heap
 bool fibContains(fibheap *F, void *data);
 
@@ -111,10 +163,14 @@ void *fibGetKey(fibheap *F, void *data);
   // returns true if the deletion was successful
 bool fibDelete(fibheap *F, void *data);
 
+  // deletes the node with the given handle from the heap
+void fibDeleteNode(fibheap *F, fibnode *u);
+
   // takes the union of two Fibonacci heaps and
   // returns the resulting Fibonacci heap;
   // the two input heaps should have the same type (MIN / MAX),
-  // the same key comparison function, and the same sentinel key
+  // the same key comparison function and key type, the same
+  // sentinel key, and find their data in the same way
 fibheap *fibUnion(fibheap *F1, fibheap *F2);
 
   // returns the size of the Fibonacci heap
@@ -0,0 +1,173 @@
+/*
+  Relaxed concurrent priority queue (MultiQueue)
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <time.h>
+#include "multiqueue.h"
+#include "../../../lib/clib.h"
+
+  // state of the random generator of the calling thread
+static __thread uint64_t rngState;
+
+//===================================================================
+// Returns a random number in 0..n-1, using a xorshift generator
+// per thread, which is seeded on first use
+static inline size_t randomHeap(size_t n) {
+  if (! rngState) {
+    int local;
+    rngState = (uintptr_t)&local ^ ((uint64_t)time(NULL) << 32);
+    rngState |= 1;
+  }
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return (rngState >> 11) % n;
+}
+
+//===================================================================
+// Reads the top of heap h without taking its lock
+static inline void *peekTop(mqHeap *h) {
+  return __atomic_load_n(&h->top, __ATOMIC_ACQUIRE);
+}
+
+//===================================================================
+// Publishes the top of heap h; the lock of h must be held
+static inline void setTop(mqHeap *h) {
+  __atomic_store_n(&h->top, bhpPeek(h->H), __ATOMIC_RELEASE);
+}
+
+//===================================================================
+// Creates a new MultiQueue
+mqueue *mqNew(size_t nHeaps, bhpType type, bhpCompData cmp) {
+  if (nHeaps == 0) {
+    fprintf(stderr, "mqNew: number of heaps must be positive\n");
+    return NULL;
+  }
+  mqueue *Q = safeCalloc(1, sizeof(mqueue));
+  Q->heaps = safeCalloc(nHeaps, sizeof(mqHeap));
+  Q->nHeaps = nHeaps;
+  Q->cmp = cmp;
+  Q->type = type;
+  Q->fac = type == MIN ? 1 : -1;
+  Q->label = "MULTIQUEUE";
+  for (size_t i = 0; i < nHeaps; i++) {
+    pthread_mutex_init(&Q->heaps[i].lock, NULL);
+    Q->heaps[i].H = bhpNew(64, type, cmp);
+  }
+  return Q;
+}
+
+//===================================================================
+// Deallocates the queue
+void mqFree(mqueue *Q) {
+  if (! Q) return;
+  for (size_t i = 0; i < Q->nHeaps; i++) {
+    bhpFree(Q->heaps[i].H);
+    pthread_mutex_destroy(&Q->heaps[i].lock);
+  }
+  free(Q->heaps);
+  free(Q);
+}
+
+//===================================================================
+// Sets the label for the queue
+void mqSetLabel(mqueue *Q, char *label) {
+  Q->label = label;
+}
+
+//===================================================================
+// Adds an element to a random heap; a heap that is locked by
+// another thread is skipped a few times before waiting for it
+void mqPush(mqueue *Q, void *elem) {
+  mqHeap *h = Q->heaps + randomHeap(Q->nHeaps);
+  for (size_t tries = 1; pthread_mutex_trylock(&h->lock); tries++) {
+    h = Q->heaps + randomHeap(Q->nHeaps);
+    if (tries == 4) {
+      pthread_mutex_lock(&h->lock);
+      break;
+    }
+  }
+  bhpPush(h->H, elem);
+  setTop(h);
+  pthread_mutex_unlock(&h->lock);
+}
+
+//===================================================================
+// Pops the top of heap h, waiting for its lock; returns NULL
+// if the heap is empty
+static void *popHeap(mqHeap *h) {
+  pthread_mutex_lock(&h->lock);
+  void *elem = bhpPop(h->H);
+  setTop(h);
+  pthread_mutex_unlock(&h->lock);
+  return elem;
+}
+
+//===================================================================
+// Removes the better of the tops of two random heaps
+void *mqPop(mqueue *Q) {
+
+  for (size_t tries = 0; tries < Q->nHeaps; tries++) {
+    mqHeap *a = Q->heaps + randomHeap(Q->nHeaps);
+    mqHeap *b = Q->heaps + randomHeap(Q->nHeaps);
+    void *topA = peekTop(a), *topB = peekTop(b);
+    if (! topA && ! topB)
+      continue;
+    if (! topA || (topB && Q->fac * Q->cmp(topB, topA) < 0))
+      a = b;
+    if (pthread_mutex_trylock(&a->lock))
+      continue;
+      // the top may have been popped in the meantime,
+      // but any element of the heap will do
+    void *elem = bhpPop(a->H);
+    setTop(a);
+    pthread_mutex_unlock(&a->lock);
+    if (elem)
+      return elem;
+  }
+
+    // the random heaps were empty or busy: go over all heaps
+    // so that an element in the queue is always found
+  for (size_t i = 0; i < Q->nHeaps; i++) {
+    if (! peekTop(Q->heaps + i))
+      continue;
+    void *elem = popHeap(Q->heaps + i);
+    if (elem)
+      return elem;
+  }
+  return NULL;
+}
+
+//===================================================================
+// Returns the number of elements in the queue
+size_t mqSize(mqueue *Q) {
+  size_t size = 0;
+  for (size_t i = 0; i < Q->nHeaps; i++) {
+    pthread_mutex_lock(&Q->heaps[i].lock);
+    size += Q->heaps[i].H->size;
+    pthread_mutex_unlock(&Q->heaps[i].lock);
+  }
+  return size;
+}
+
+//===================================================================
+// Shows the number of elements in each heap
+void mqShow(mqueue *Q) {
+  printf("--------------------\n"
+         "%s\n"
+         "Type: %s\n"
+         "Heaps: %zu\n"
+         "Size: %zu\n"
+         "--------------------\n",
+         Q->label,
+         Q->type == MIN ? "MIN" : "MAX",
+         Q->nHeaps, mqSize(Q));
+  for (size_t i = 0; i < Q->nHeaps; i++) {
+    printf("%zu", Q->heaps[i].H->size);
+    printf(i < Q->nHeaps - 1 ? ", " : "\n");
+    if ((i + 1) % 10 == 0) printf("\n");
+  }
+  printf("--------------------\n\n");
+}
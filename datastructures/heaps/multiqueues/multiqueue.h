@@ -0,0 +1,67 @@
+/*
+  Relaxed concurrent priority queue (MultiQueue)
+    The elements are spread over a number of binary heaps, each
+    protected by its own mutex. A push goes to a random heap; a
+    pop looks at the tops of two random heaps and pops from the
+    better one. The popped element is hence not always the top
+    of the whole queue, but its rank is small on average (about
+    the number of heaps), and threads rarely contend for the
+    same lock as long as there are a few heaps per thread.
+  The tops of the heaps are compared without holding a lock,
+    so an element can still be passed to the comparison
+    function by some thread shortly after it was popped by
+    another one: elements should not be freed while other
+    threads are using the queue.
+  Programs using this queue must be linked with -pthread.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef MULTIQUEUE_H_INCLUDED
+#define MULTIQUEUE_H_INCLUDED
+
+#include <pthread.h>
+#include "../binheaps/binheap.h"
+
+typedef struct {
+  pthread_mutex_t lock;   // lock for the heap
+  binheap *H;             // the heap itself
+  void *top;              // top of the heap, or NULL if empty
+  char pad[64];           // keeps locks in separate cache lines
+} mqHeap;
+
+typedef struct {
+  mqHeap *heaps;          // array of heaps
+  size_t nHeaps;          // number of heaps
+  bhpCompData cmp;        // comparison function
+  bhpType type;           // type of queue (MIN or MAX)
+  int fac;                // factor for comparison
+  char *label;            // label for the queue
+} mqueue;
+
+  // creates a new MultiQueue with nHeaps heaps, given type
+  // (MIN / MAX), and comparison function; a good choice for
+  // nHeaps is 2 to 4 times the number of threads
+mqueue *mqNew(size_t nHeaps, bhpType type, bhpCompData cmp);
+
+  // deallocates the queue
+void mqFree(mqueue *Q);
+
+  // sets the label for the queue
+void mqSetLabel(mqueue *Q, char *label);
+
+  // adds an element to a random heap
+void mqPush(mqueue *Q, void *elem);
+
+  // removes and returns the better of the tops of two random
+  // heaps; returns NULL only if all heaps were found empty
+void *mqPop(mqueue *Q);
+
+  // returns the number of elements in the queue; only exact
+  // if no other thread is using the queue
+size_t mqSize(mqueue *Q);
+
+  // shows the number of elements in each heap
+void mqShow(mqueue *Q);
+
+#endif  // MULTIQUEUE_H_INCLUDED
@@ -0,0 +1,169 @@
+/*
+  Benchmark of the MultiQueue against a binary heap behind a
+    single lock
+  Throughput: each thread repeatedly pops an element and pushes
+    a new one with a larger key, as in a parallel Dijkstra;
+    the MultiQueue has 2 heaps per thread
+  Rank error: the rank of each popped key among the keys in the
+    queue (0 for an exact priority queue), measured in a single
+    thread that plays the role of p threads by using 2p heaps
+  The keys are stored in the element pointers themselves
+  Usage: ./bench.out [number of elements] [number of operations]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>
+#include "../multiqueue.h"
+#include "../../../../lib/clib.h"
+
+#define ELEM(k) ((void *)(uintptr_t)(k))
+#define KEY(e) ((uintptr_t)(e))
+#define KEYSPACE (1 << 20)
+
+//===================================================================
+// Comparison function for keys stored as pointers
+int cmpKeys(void const *a, void const *b) {
+  uintptr_t x = KEY(a), y = KEY(b);
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Binary heap protected by a single lock
+typedef struct {
+  pthread_mutex_t lock;
+  binheap *H;
+} lockedHeap;
+
+//===================================================================
+// Threads doing pop-push pairs on either queue
+typedef struct {
+  mqueue *Q;         // the MultiQueue, or NULL
+  lockedHeap *L;     // the locked heap
+  size_t ops;        // number of pop-push pairs
+  unsigned seed;     // seed for the key increments
+} threadArg;
+
+static void *worker(void *arg) {
+  threadArg *t = arg;
+  uint64_t r = t->seed | 1;
+  for (size_t i = 0; i < t->ops; i++) {
+    r ^= r << 13; r ^= r >> 7; r ^= r << 17;
+    uintptr_t key;
+    if (t->Q) {
+      key = KEY(mqPop(t->Q));
+      mqPush(t->Q, ELEM(key + 1 + r % 1000));
+    } else {
+      pthread_mutex_lock(&t->L->lock);
+      key = KEY(bhpPop(t->L->H));
+      bhpPush(t->L->H, ELEM(key + 1 + r % 1000));
+      pthread_mutex_unlock(&t->L->lock);
+    }
+  }
+  return NULL;
+}
+
+//===================================================================
+// Runs the throughput benchmark for the given number of threads
+// on a queue holding n elements
+static void throughput(size_t nThreads, size_t n, size_t ops) {
+  mqueue *Q = mqNew(2 * nThreads, MIN, cmpKeys);
+  lockedHeap L;
+  pthread_mutex_init(&L.lock, NULL);
+  L.H = bhpNew(n, MIN, cmpKeys);
+  for (size_t i = 0; i < n; i++) {
+    size_t key = 1 + rand() % KEYSPACE;
+    mqPush(Q, ELEM(key));
+    bhpPush(L.H, ELEM(key));
+  }
+
+  pthread_t tid[64];
+  threadArg args[64];
+  double t[2];
+  for (size_t q = 0; q < 2; q++) {
+    double start = now();
+    for (size_t i = 0; i < nThreads; i++) {
+      args[i] = (threadArg){q ? Q : NULL, &L, ops / nThreads, rand()};
+      pthread_create(&tid[i], NULL, worker, &args[i]);
+    }
+    for (size_t i = 0; i < nThreads; i++)
+      pthread_join(tid[i], NULL);
+    t[q] = now() - start;
+  }
+  printf("  %2zu thread(s): %6.2f Mops/s (locked heap: %6.2f Mops/s)\n",
+         nThreads, ops / t[1] * 1e-6, ops / t[0] * 1e-6);
+  mqFree(Q);
+  bhpFree(L.H);
+  pthread_mutex_destroy(&L.lock);
+}
+
+//===================================================================
+// Fenwick tree over the key space, counting the keys in the queue
+static void fenAdd(size_t *fen, size_t key, long delta) {
+  for (; key <= KEYSPACE; key += key & -key)
+    fen[key] += delta;
+}
+
+static size_t fenCount(size_t *fen, size_t key) {
+  size_t count = 0;
+  for (; key > 0; key -= key & -key)
+    count += fen[key];
+  return count;
+}
+
+//===================================================================
+// Measures the mean and maximum rank of the popped keys for a
+// MultiQueue with 2p heaps holding n elements
+static void rankError(size_t p, size_t n, size_t ops) {
+  mqueue *Q = mqNew(2 * p, MIN, cmpKeys);
+  size_t *fen = safeCalloc(KEYSPACE + 1, sizeof(size_t));
+  for (size_t i = 0; i < n; i++) {
+    size_t key = 1 + rand() % KEYSPACE;
+    mqPush(Q, ELEM(key));
+    fenAdd(fen, key, 1);
+  }
+  double sum = 0;
+  size_t max = 0;
+  for (size_t i = 0; i < ops; i++) {
+    size_t key = KEY(mqPop(Q));
+      // number of keys in the queue that are smaller
+    size_t rank = fenCount(fen, key - 1);
+    sum += rank;
+    if (rank > max) max = rank;
+    fenAdd(fen, key, -1);
+    key = 1 + rand() % KEYSPACE;
+    mqPush(Q, ELEM(key));
+    fenAdd(fen, key, 1);
+  }
+  printf("  %2zu heaps: mean rank %6.2f, max rank %4zu\n",
+         2 * p, sum / ops, max);
+  free(fen);
+  mqFree(Q);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t ops = argc > 2 ? strtoul(argv[2], NULL, 10) : 4000000;
+  srand(time(NULL));
+
+  printf("Throughput, %zu elements, %zu pop-push pairs\n", n, ops);
+  for (size_t p = 1; p <= 16; p *= 2)
+    throughput(p, n, ops);
+
+  printf("Rank error, %zu elements, %zu pop-push pairs "
+         "(locked heap: 0)\n", n, ops);
+  for (size_t p = 1; p <= 16; p *= 2)
+    rankError(p, n, ops);
+  return 0;
+}
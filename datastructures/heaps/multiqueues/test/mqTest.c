@@ -0,0 +1,93 @@
+/*
+  Relaxed concurrent priority queue (MultiQueue)
+  Checks that a MultiQueue with a single heap pops in order,
+    and that with 4 threads pushing and popping at the same
+    time every element is popped exactly once
+  Author: David De Potter
+*/
+
+#include "../multiqueue.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+#define N 100000
+#define THREADS 4
+
+size_t items[THREADS * N];
+size_t popped[THREADS * N];
+
+//===================================================================
+// Comparison function for size_t elements
+int cmpItems(void const *a, void const *b) {
+  size_t x = *(size_t *)a, y = *(size_t *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Each thread pushes its own items, popping one element after
+// every second push, and counts the popped elements
+typedef struct {
+  mqueue *Q;
+  size_t id;
+} threadArg;
+
+static void *worker(void *arg) {
+  threadArg *t = arg;
+  for (size_t i = t->id * N; i < (t->id + 1) * N; i++) {
+    mqPush(t->Q, items + i);
+    if (i % 2) {
+      size_t *elem = mqPop(t->Q);
+      if (elem)
+        __atomic_fetch_add(&popped[elem - items], 1,
+                           __ATOMIC_RELAXED);
+    }
+  }
+  return NULL;
+}
+
+//===================================================================
+
+int main () {
+
+  srand(time(NULL));
+  for (size_t i = 0; i < THREADS * N; i++)
+    items[i] = rand() % N;
+
+    // with a single heap, the queue is an ordinary heap
+  mqueue *Q = mqNew(1, MAX, cmpItems);
+  for (size_t i = 0; i < N; i++)
+    mqPush(Q, items + i);
+  bool ordered = true;
+  size_t *prev = mqPop(Q), *elem;
+  while ((elem = mqPop(Q))) {
+    if (*elem > *prev)
+      ordered = false;
+    prev = elem;
+  }
+  printf("Single heap pops in order: %s\n", ordered ? "yes" : "no");
+  mqFree(Q);
+
+    // several threads using the queue at the same time
+  Q = mqNew(2 * THREADS, MIN, cmpItems);
+  pthread_t tid[THREADS];
+  threadArg args[THREADS];
+  for (size_t i = 0; i < THREADS; i++) {
+    args[i] = (threadArg){Q, i};
+    pthread_create(&tid[i], NULL, worker, &args[i]);
+  }
+  for (size_t i = 0; i < THREADS; i++)
+    pthread_join(tid[i], NULL);
+  printf("Left in the queue: %zu\n", mqSize(Q));
+  mqShow(Q);
+
+  while ((elem = mqPop(Q)))
+    popped[elem - items]++;
+  bool once = true;
+  for (size_t i = 0; i < THREADS * N; i++)
+    if (popped[i] != 1)
+      once = false;
+  printf("Every element popped exactly once: %s\n",
+         once ? "yes" : "no");
+  mqFree(Q);
+  return 0;
+}
@@ -0,0 +1,417 @@
+/*
+  Generic pairing heap implementation
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "pairheap.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// FNV-1a hash function
+// (http://www.isthe.com/chongo/tech/comp/fnv/index.html)
+static uint64_t phpHash(void *key, uint64_t seed) {
+
+  if (! key) {
+    fprintf(stderr, "phpHash: key is NULL\n");
+    exit(EXIT_FAILURE);
+  }
+  char *str = (char *)key;
+  char ch;
+    // FNV offset basis and magic seed
+  uint64_t hash = 14695981039346656037ULL + seed;
+  while ((ch = *str++)) {
+    hash ^= ch;
+    hash *= 1099511628211ULL;  // FNV prime
+  }
+  return hash;
+}
+
+//===================================================================
+// Case sensitive comparison for keys
+static int cmpStrCS(void const *str1, void const *str2) {
+  return strcmp((char *)str1, (char *)str2);
+}
+
+//===================================================================
+// Creates a new pairing heap
+pairheap *phpNew(phpType type, phpCompKey compKey,
+                 phpCopyKey copyKey, phpFreeKey freeKey,
+                 phpToString toString) {
+
+  pairheap *H = safeCalloc(1, sizeof(pairheap));
+  H->datamap = mapNew(phpHash, 30, cmpStrCS);
+  H->label = "PAIRING HEAP";
+  H->copyKey = copyKey;
+  H->freeKey = freeKey;
+  H->toString = toString;
+  H->compKey = compKey;
+  H->type = type;
+  H->fac = type == MIN ? 1 : -1;
+  return H;
+}
+
+//===================================================================
+// Sets the data to index function for the pairing heap
+void phpSetToIndex(pairheap *H, phpToIndex toIndex, size_t n) {
+  if (! phpIsEmpty(H)) {
+    fprintf(stderr, "phpSetToIndex: pairing heap is not empty\n");
+    return;
+  }
+  if (! toIndex)
+    return;
+  H->toIndex = toIndex;
+  free(H->nodes);
+  H->nodes = safeCalloc(n ? n : 1, sizeof(phpnode *));
+  H->nIndices = n;
+  if (H->datamap)
+    mapFree(H->datamap);
+  H->datamap = NULL;
+}
+
+//===================================================================
+// Sets the show function for the pairing heap
+void phpSetShow(pairheap *H, phpShowKey showKey,
+                phpShowData showData) {
+  H->showKey = showKey;
+  H->showData = showData;
+}
+
+//===================================================================
+// Sets the label for the pairing heap
+void phpSetLabel(pairheap *H, char *label) {
+  H->label = label;
+}
+
+//===================================================================
+// Returns the node containing the data, or NULL
+static inline phpnode *findNode(pairheap *H, void *data) {
+  if (H->nodes) {
+    size_t i = H->toIndex(data);
+    return i < H->nIndices ? H->nodes[i] : NULL;
+  }
+  return mapGetVal(H->datamap, H->toString(data));
+}
+
+//===================================================================
+// Removes the data -> node mapping of node u, and
+// deallocates the node
+static void freePhpnode(pairheap *H, phpnode *u) {
+  H->freeKey(u->key);
+  if (H->nodes)
+    H->nodes[H->toIndex(u->data)] = NULL;
+  else
+    mapDelKey(H->datamap, H->toString(u->data));
+  free(u);
+}
+
+//===================================================================
+// Deallocates the pairing heap
+void phpFree(pairheap *H) {
+  if (! H) return;
+    // visit all nodes using a stack of nodes
+  phpnode **stack = safeCalloc(H->size + 1, sizeof(phpnode *));
+  size_t n = 0;
+  if (H->top)
+    stack[n++] = H->top;
+  while (n) {
+    phpnode *u = stack[--n];
+    for (phpnode *c = u->child; c; c = c->next)
+      stack[n++] = c;
+    H->freeKey(u->key);
+    free(u);
+  }
+  free(stack);
+  if (H->datamap) mapFree(H->datamap);
+  free(H->nodes);
+  free(H);
+}
+
+//===================================================================
+// Melds two trees with roots a and b, making the root with the
+// worse key the leftmost child of the other; returns the new root
+static inline phpnode *meld(pairheap *H, phpnode *a, phpnode *b) {
+  if (! a) return b;
+  if (! b) return a;
+  if (H->fac * H->compKey(b->key, a->key) < 0) {
+    phpnode *tmp = a;
+    a = b;
+    b = tmp;
+  }
+  b->prev = a;
+  b->next = a->child;
+  if (a->child)
+    a->child->prev = b;
+  a->child = b;
+  return a;
+}
+
+//===================================================================
+// Melds a list of siblings into one tree in two passes: first the
+// siblings are melded in pairs from left to right, and then the
+// resulting trees are melded from right to left
+static phpnode *mergePairs(pairheap *H, phpnode *first) {
+  if (! first) return NULL;
+
+    // first pass: the melded pairs are kept on a stack,
+    // linked by their prev pointers
+  phpnode *stack = NULL;
+  while (first) {
+    phpnode *a = first, *b = first->next;
+    first = b ? b->next : NULL;
+    a->next = a->prev = NULL;
+    if (b)
+      b->next = b->prev = NULL;
+    phpnode *r = meld(H, a, b);
+    r->prev = stack;
+    stack = r;
+  }
+
+    // second pass: meld the trees from right to left
+  phpnode *root = stack;
+  stack = stack->prev;
+  root->prev = NULL;
+  while (stack) {
+    phpnode *next = stack->prev;
+    stack->prev = NULL;
+    root = meld(H, stack, root);
+    stack = next;
+  }
+  return root;
+}
+
+//===================================================================
+// Cuts node u, which is not the root, from its parent and siblings
+static inline void detach(phpnode *u) {
+  if (u->prev->child == u)
+      // u is the leftmost child of its parent
+    u->prev->child = u->next;
+  else
+    u->prev->next = u->next;
+  if (u->next)
+    u->next->prev = u->prev;
+  u->next = u->prev = NULL;
+}
+
+//===================================================================
+// Inserts a node with given data and key into the pairing heap
+phpnode *phpPush(pairheap *H, void *data, void *key) {
+
+  if (! H || ! data || ! key) return NULL;
+
+  if (H->nodes && H->toIndex(data) >= H->nIndices) {
+    fprintf(stderr, "phpPush: index of data out of range\n");
+    return NULL;
+  }
+
+  if (findNode(H, data)) {
+    fprintf(stderr, "phpPush: data already in the heap\n");
+    return NULL;
+  }
+
+  phpnode *u = safeCalloc(1, sizeof(phpnode));
+  u->data = data;
+  u->key = H->copyKey(key);
+  if (H->nodes)
+    H->nodes[H->toIndex(data)] = u;
+  else
+    mapAddKey(H->datamap, H->toString(data), u);
+
+  H->top = meld(H, H->top, u);
+  H->size++;
+  return u;
+}
+
+//===================================================================
+// Takes a peek at the top node in the pairing heap
+void *phpPeek(pairheap *H) {
+  if (! H->top) return NULL;
+  return H->top->data;
+}
+
+//===================================================================
+// Extracts the top node from the pairing heap
+void *phpPop(pairheap *H) {
+
+  phpnode *z = H->top;
+  if (! z) return NULL;
+
+  H->top = mergePairs(H, z->child);
+  H->size--;
+  void *data = z->data;
+  freePhpnode(H, z);
+  return data;
+}
+
+//===================================================================
+// Updates the key of the node u to newKey
+// Returns true if the update was successful
+bool phpUpdateNodeKey(pairheap *H, phpnode *u, void *newKey) {
+
+  if (! H || ! u || ! newKey) return false;
+
+  if (H->fac * H->compKey(newKey, u->key) > 0) {
+    fprintf(stderr, "phpUpdateKey: new key is %s than current key\n",
+           H->type == MIN ? "greater" : "less");
+    return false;
+  }
+
+  H->freeKey(u->key);
+  u->key = H->copyKey(newKey);
+
+    // cut the subtree of u and meld it with the root
+  if (u != H->top) {
+    detach(u);
+    H->top = meld(H, H->top, u);
+  }
+  return true;
+}
+
+//===================================================================
+// Updates the key of the node containing the data to newKey
+// Returns true if the update was successful
+bool phpUpdateKey(pairheap *H, void *data, void *newKey) {
+
+  if (! H || ! data || ! newKey) return false;
+
+  phpnode *u = findNode(H, data);
+  if (! u) {
+    fprintf(stderr, "phpUpdateKey: data not in the heap\n");
+    return false;
+  }
+  return phpUpdateNodeKey(H, u, newKey);
+}
+
+//===================================================================
+// Returns the key of the data in the pairing heap
+void *phpGetKey(pairheap *H, void *data) {
+  if (! data || ! H) return NULL;
+  phpnode *u = findNode(H, data);
+  if (! u) {
+    fprintf(stderr, "phpGetKey: data not in the heap\n");
+    return NULL;
+  }
+  return u->key;
+}
+
+//===================================================================
+// Returns true if the data is in the pairing heap
+bool phpContains(pairheap *H, void *data) {
+  if (! data) return false;
+  return findNode(H, data) != NULL;
+}
+
+//===================================================================
+// Deletes the node u from the pairing heap: its children are
+// melded into one tree, which takes the place of u
+void phpDeleteNode(pairheap *H, phpnode *u) {
+  if (! H || ! u) return;
+  if (u == H->top) {
+    phpPop(H);
+    return;
+  }
+  detach(u);
+  H->top = meld(H, H->top, mergePairs(H, u->child));
+  H->size--;
+  freePhpnode(H, u);
+}
+
+//===================================================================
+// Deletes the node containing the data from the pairing heap
+// Returns true if deletion was successful
+bool phpDelete(pairheap *H, void *data) {
+  if (! H || ! data) {
+    fprintf(stderr, "phpDelete: invalid arguments\n");
+    return false;
+  }
+
+  phpnode *u = findNode(H, data);
+  if (! u) {
+    fprintf(stderr, "phpDelete: data not in the heap\n");
+    return false;
+  }
+  phpDeleteNode(H, u);
+  return true;
+}
+
+//===================================================================
+// Takes the union of two pairing heaps and returns the resulting
+// pairing heap
+pairheap *phpUnion(pairheap *H1, pairheap *H2) {
+
+  if (! H1) return H2;
+  if (! H2) return H1;
+
+  if (H1->type != H2->type) {
+    fprintf(stderr, "phpUnion: heaps have different types\n");
+    return NULL;
+  }
+
+  if (H1->compKey != H2->compKey) {
+    fprintf(stderr, "phpUnion: heaps have different "
+                    "comparison functions\n");
+    return NULL;
+  }
+
+  if ((H1->nodes == NULL) != (H2->nodes == NULL) ||
+      H1->nIndices != H2->nIndices) {
+    fprintf(stderr, "phpUnion: heaps find their data "
+                    "in different ways\n");
+    return NULL;
+  }
+
+    // merge the data -> node mappings
+  if (H1->nodes) {
+    for (size_t i = 0; i < H2->nIndices; i++)
+      if (H2->nodes[i])
+        H1->nodes[i] = H2->nodes[i];
+    free(H2->nodes);
+  } else
+    H1->datamap = mapMerge(H1->datamap, H2->datamap);
+
+  H1->top = meld(H1, H1->top, H2->top);
+  H1->size += H2->size;
+  free(H2);
+  return H1;
+}
+
+//===================================================================
+// Shows all data in the pairing heap starting from node u
+// at given level
+static void showAllData(pairheap *H, phpnode *u, size_t level) {
+
+  for (phpnode *v = u; v; v = v->next) {
+    for (size_t i = 0; i < level; i++) printf("   ");
+    printf(" |-> ");
+    H->showData(v->data);
+    printf(" (key: ");
+    H->showKey(v->key);
+    printf(")\n");
+    if (v->child) showAllData(H, v->child, level + 1);
+  }
+}
+
+//===================================================================
+// Shows the pairing heap
+void phpShow(pairheap *H) {
+
+  if (! H->showData || ! H->showKey) {
+    fprintf(stderr, "phpShow: showData or "
+                    "showKey function not set\n");
+    return;
+  }
+
+  printf("--------------------\n"
+          " %s\n"
+          " Size: %zu\n"
+          "--------------------\n",
+          H->label, H->size);
+
+  if (! H->top) {
+    printf("< Empty >\n");
+    printf("--------------------\n\n");
+    return;
+  }
+  showAllData(H, H->top, 0);
+  printf("--------------------\n\n");
+}
@@ -0,0 +1,159 @@
+/*
+  Generic pairing heap interface
+    A pairing heap is a single heap-ordered tree, in which each
+    node keeps a pointer to its leftmost child, to its right
+    sibling, and to its left sibling (or its parent if it is
+    the leftmost child). Push and decrease-key just meld a
+    node or a subtree with the root; pop melds the children of
+    the root in two passes. Its amortized bounds are a bit
+    weaker than those of the Fibonacci heap, but it has fewer
+    pointers per node and no degree table, and is usually
+    faster in practice
+    The API is the same as that of the Fibonacci heap (fibheap.h),
+    except that no sentinel key is needed to delete a node
+    Data are found using a hash table mapping data to nodes
+    (str(data) -> phpnode ptr), and so the string representation
+    of data should be unique for each data item. Alternatively,
+    the data can be numbered 0..n-1 and a function returning that
+    number can be set (phpSetToIndex), in which case the nodes
+    are kept in a plain array. The push function also returns a
+    handle to the new node, which can be passed to
+    phpUpdateNodeKey and phpDeleteNode without any lookup
+    The comparison function should compare the keys of the
+    nodes in the heap (not the data) and return -1, 0, 1
+    for less than, equal to, greater than, respectively
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef PAIRHEAP_H_INCLUDED
+#define PAIRHEAP_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "../../htables/single-value/map.h"
+
+// function pointer types
+typedef int (*phpCompKey)(void const *a, void const *b);
+typedef void (*phpFreeKey)(void *key);
+typedef void *(*phpCopyKey)(void const *key);
+typedef void (*phpShowKey)(void const *key);
+typedef char *(*phpToString)(void const *data);
+typedef size_t (*phpToIndex)(void const *data);
+typedef void (*phpShowData)(void const *data);
+
+// pairing heap type
+typedef enum { MIN, MAX } phpType;
+
+// pairing heap node
+typedef struct phpnode {
+  void *key;              // key (priority) of the node
+  void *data;             // data associated with the key
+  struct phpnode *child;  // leftmost child of the node
+  struct phpnode *next;   // right sibling of the node
+  struct phpnode *prev;   // left sibling, or parent if the
+                          // node is the leftmost child
+} phpnode;
+
+// pairing heap
+typedef struct {
+  phpnode *top;           // root of the heap
+  map *datamap;           // map (string -> phpnode ptr) for data
+  phpToString toString;   // function to convert data to string
+  phpnode **nodes;        // index of data -> node, or NULL
+  size_t nIndices;        // number of indices in nodes
+  phpToIndex toIndex;     // function to convert data to index
+  phpShowData showData;   // function to show data
+  size_t size;            // number of nodes in the heap
+  phpCompKey compKey;     // comparison function for the keys
+  phpShowKey showKey;     // show function
+  phpFreeKey freeKey;     // function to free key
+  phpCopyKey copyKey;     // function to copy key
+  phpType type;           // type of pairing heap (MIN or MAX)
+  int fac;                // factor for comparison
+  char *label;            // label for the pairing heap
+                          // default is "PAIRING HEAP"
+} pairheap;
+
+// function prototypes
+
+  // creates a new pairing heap, with given type (MIN / MAX),
+  // key comparison function, key copy function, key free
+  // function, and a function to convert data to string
+pairheap *phpNew(phpType type, phpCompKey cmp, phpCopyKey copy,
+                 phpFreeKey free, phpToString toString);
+
+  // sets a function that maps each data item to a unique
+  // index in 0..n-1; the heap then keeps its nodes in an
+  // array of size n instead of a map; must be called
+  // before pushing any data
+void phpSetToIndex(pairheap *H, phpToIndex toIndex, size_t n);
+
+  // sets the show function for the pairing heap
+void phpSetShow(pairheap *H, phpShowKey showKey,
+                phpShowData showData);
+
+  // sets the label for the pairing heap
+void phpSetLabel(pairheap *H, char *label);
+
+  // deallocates the pairing heap
+void phpFree(pairheap *H);
+
+  // inserts a new node into the pairing heap with the given
+  // data and key (priority); returns a handle to the node,
+  // which stays valid until the node is popped or deleted,
+  // or NULL if the data could not be inserted
+phpnode *phpPush(pairheap *H, void *data, void *key);
+
+  // returns the top element of the pairing heap without
+  // removing it; returns NULL if the heap is empty
+void *phpPeek(pairheap *H);
+
+  // returns and removes the top element from the pairing
+  // heap; returns NULL if the heap is empty
+void *phpPop(pairheap *H);
+
+  // updates the priority of a node in the heap
+  // returns true if the update was successful
+bool phpUpdateKey(pairheap *H, void *data, void *newKey);
+
+  // updates the priority of the node with the given handle
+  // returns true if the update was successful
+bool phpUpdateNodeKey(pairheap *H, phpnode *u, void *newKey);
+
+  // returns true if the data is in the pairing heap
+bool phpContains(pairheap *H, void *data);
+
+  // returns the key (priority) of the data in the heap
+  // returns NULL if the data is not in the heap
+void *phpGetKey(pairheap *H, void *data);
+
+  // deletes the node containing the data from the heap
+  // returns true if the deletion was successful
+bool phpDelete(pairheap *H, void *data);
+
+  // deletes the node with the given handle from the heap
+void phpDeleteNode(pairheap *H, phpnode *u);
+
+  // takes the union of two pairing heaps and returns the
+  // resulting heap, which reuses H1; H2 is deallocated;
+  // the two heaps should have the same type (MIN / MAX),
+  // the same key comparison function, and find their data
+  // in the same way
+pairheap *phpUnion(pairheap *H1, pairheap *H2);
+
+  // returns the size of the pairing heap
+static inline size_t phpSize(pairheap *H) {
+  return H->size;
+}
+
+  // returns true if the heap is empty
+static inline bool phpIsEmpty(pairheap *H) {
+  return H->size == 0;
+}
+
+  // shows the pairing heap
+void phpShow(pairheap *H);
+
+#endif  // PAIRHEAP_H_INCLUDED
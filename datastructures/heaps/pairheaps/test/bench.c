@@ -0,0 +1,232 @@
+/*
+  Benchmark of the pairing heap against the Fibonacci heap and
+    the binary heap priority queue (bpqueue), running Dijkstra's
+    algorithm on a random graph with n vertices and 8n edges
+  The Fibonacci heap can only find its data through a string
+    map; the pairing heap and bpqueue are also timed with an
+    index function, and the pairing heap with the handles
+    returned by push
+  Usage: ./bench.out [n]
+  Author: David De Potter
+*/
+
+#include <time.h>
+#include <float.h>
+
+  // the three heaps each define MIN and MAX,
+  // so rename them per header
+#define MIN FIB_MIN
+#define MAX FIB_MAX
+#include "../../fibheaps/fibheap.h"
+#undef MIN
+#undef MAX
+#define MIN BPQ_MIN
+#define MAX BPQ_MAX
+#include "../../bpqueues/bpqueue.h"
+#undef MIN
+#undef MAX
+#define MIN PHP_MIN
+#define MAX PHP_MAX
+#include "../pairheap.h"
+#undef MIN
+#undef MAX
+#include "../../../../lib/clib.h"
+
+// graph in compressed sparse row format
+typedef struct {
+  size_t n;          // number of vertices
+  size_t *first;     // edges of u are first[u]..first[u+1]-1
+  size_t *to;        // target vertex of each edge
+  double *w;         // weight of each edge
+} csrGraph;
+
+size_t *items;       // items[i] = i
+char (*labels)[16];  // string representations of the items
+double *dist;        // distances from the source
+
+//===================================================================
+// comparison function for double keys
+int compKeys(void const *a, void const *b) {
+  double x = *(double *)a;
+  double y = *(double *)b;
+  return x < y ? -1 : x > y;
+}
+
+//===================================================================
+// make a copy of a double key
+void *copyKey(void const *key) {
+  double *copy = safeMalloc(sizeof(double));
+  *copy = *(double *)key;
+  return copy;
+}
+
+//===================================================================
+// string representation of an item
+char *itemToString(void const *data) {
+  return labels[*(size_t *)data];
+}
+
+//===================================================================
+// index of an item in 0..n-1
+size_t itemToIndex(void const *data) {
+  return *(size_t *)data;
+}
+
+//===================================================================
+// generates a random graph with n vertices and m edges
+csrGraph *randomGraph(size_t n, size_t m) {
+  csrGraph *G = safeCalloc(1, sizeof(csrGraph));
+  G->n = n;
+  G->first = safeCalloc(n + 1, sizeof(size_t));
+  G->to = safeCalloc(m, sizeof(size_t));
+  G->w = safeCalloc(m, sizeof(double));
+  for (size_t u = 0, e = 0; u < n; u++) {
+    G->first[u] = e;
+    size_t deg = m / n;
+    for (size_t i = 0; i < deg; i++, e++) {
+        // a ring keeps all vertices reachable
+      G->to[e] = i == 0 ? (u + 1) % n : (size_t)rand() % n;
+      G->w[e] = 1 + rand() % 1000;
+    }
+  }
+  G->first[n] = n * (m / n);
+  return G;
+}
+
+//===================================================================
+// Dijkstra using bpqueue
+void dijkstraBpq(csrGraph *G, bool useIndex) {
+  bpqueue *pq = bpqNew(G->n, BPQ_MIN, compKeys, copyKey, free,
+                       itemToString, NULL);
+  if (useIndex)
+    bpqSetToIndex(pq, itemToIndex, G->n);
+  for (size_t v = 0; v < G->n; v++) {
+    dist[v] = v ? DBL_MAX : 0;
+    bpqPush(pq, items + v, dist + v);
+  }
+  while (! bpqIsEmpty(pq)) {
+    size_t u = *(size_t *)bpqPop(pq);
+    for (size_t e = G->first[u]; e < G->first[u + 1]; e++) {
+      size_t v = G->to[e];
+      if (dist[u] + G->w[e] < dist[v] &&
+          bpqContains(pq, items + v)) {
+        dist[v] = dist[u] + G->w[e];
+        bpqUpdateKey(pq, items + v, dist + v);
+      }
+    }
+  }
+  bpqFree(pq);
+}
+
+//===================================================================
+// Dijkstra using fibheap
+void dijkstraFib(csrGraph *G) {
+  fibheap *F = fibNew(FIB_MIN, compKeys, copyKey, free,
+                      itemToString, NULL);
+  for (size_t v = 0; v < G->n; v++) {
+    dist[v] = v ? DBL_MAX : 0;
+    fibPush(F, items + v, dist + v);
+  }
+  while (! fibIsEmpty(F)) {
+    size_t u = *(size_t *)fibPop(F);
+    for (size_t e = G->first[u]; e < G->first[u + 1]; e++) {
+      size_t v = G->to[e];
+      if (dist[u] + G->w[e] < dist[v] &&
+          fibContains(F, items + v)) {
+        dist[v] = dist[u] + G->w[e];
+        fibUpdateKey(F, items + v, dist + v);
+      }
+    }
+  }
+  fibFree(F);
+}
+
+//===================================================================
+// Dijkstra using pairheap; mode 0: string map, 1: index
+// function, 2: handles
+void dijkstraPhp(csrGraph *G, int mode) {
+  pairheap *H = phpNew(PHP_MIN, compKeys, copyKey, free,
+                       itemToString);
+  if (mode > 0)
+    phpSetToIndex(H, itemToIndex, G->n);
+  phpnode **handles = safeCalloc(G->n, sizeof(phpnode *));
+  for (size_t v = 0; v < G->n; v++) {
+    dist[v] = v ? DBL_MAX : 0;
+    handles[v] = phpPush(H, items + v, dist + v);
+  }
+  while (! phpIsEmpty(H)) {
+    size_t u = *(size_t *)phpPop(H);
+    handles[u] = NULL;
+    for (size_t e = G->first[u]; e < G->first[u + 1]; e++) {
+      size_t v = G->to[e];
+      if (dist[u] + G->w[e] >= dist[v])
+        continue;
+      if (mode == 2) {
+        if (handles[v]) {
+          dist[v] = dist[u] + G->w[e];
+          phpUpdateNodeKey(H, handles[v], dist + v);
+        }
+      } else if (phpContains(H, items + v)) {
+        dist[v] = dist[u] + G->w[e];
+        phpUpdateKey(H, items + v, dist + v);
+      }
+    }
+  }
+  free(handles);
+  phpFree(H);
+}
+
+//===================================================================
+// Reports the time of a run and a checksum of the distances
+void report(char *name, clock_t start, size_t n) {
+  double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+  double sum = 0;
+  for (size_t v = 0; v < n; v++)
+    sum += dist[v];
+  printf("  %-26s: %6.2f s (checksum %.0f)\n", name, t, sum);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+  srand(time(NULL));
+  items = safeCalloc(n, sizeof(size_t));
+  labels = safeCalloc(n, sizeof(*labels));
+  dist = safeCalloc(n, sizeof(double));
+  for (size_t i = 0; i < n; i++) {
+    items[i] = i;
+    sprintf(labels[i], "%zu", i);
+  }
+  csrGraph *G = randomGraph(n, 8 * n);
+
+  printf("Dijkstra, %zu vertices, %zu edges\n", n, 8 * n);
+  clock_t start = clock();
+  dijkstraFib(G);
+  report("fibheap, string map", start, n);
+  start = clock();
+  dijkstraBpq(G, false);
+  report("bpqueue, string map", start, n);
+  start = clock();
+  dijkstraPhp(G, 0);
+  report("pairheap, string map", start, n);
+  start = clock();
+  dijkstraBpq(G, true);
+  report("bpqueue, position array", start, n);
+  start = clock();
+  dijkstraPhp(G, 1);
+  report("pairheap, node array", start, n);
+  start = clock();
+  dijkstraPhp(G, 2);
+  report("pairheap, handles", start, n);
+
+  free(G->first);
+  free(G->to);
+  free(G->w);
+  free(G);
+  free(items);
+  free(labels);
+  free(dist);
+  return 0;
+}
@@ -0,0 +1,139 @@
+/*
+  Generic pairing heap
+  Tests the pairing heap with a string map and with an index
+    function: pushes numbered items with random priorities,
+    decreases some priorities, partly through the handles
+    returned by push, deletes some items, takes the union
+    with a second heap, and checks that the items are popped
+    in order
+  Author: David De Potter
+*/
+
+#include "../pairheap.h"
+#include <time.h>
+#include <float.h>
+#include "../../../../lib/clib.h"
+
+#define SIZE 10000
+
+char labels[2 * SIZE][8];
+
+//===================================================================
+// comparison function for double keys
+int compKeys(void const *a, void const *b) {
+  double x = *(double *)a;
+  double y = *(double *)b;
+  return x < y ? -1 : x > y;
+}
+
+//===================================================================
+// make a copy of a double key
+void *copyKey(void const *key) {
+  double *copy = safeCalloc(1, sizeof(double));
+  *copy = *(double *)key;
+  return copy;
+}
+
+//===================================================================
+// string representation of an item, which should stay
+// valid while the item is in the heap
+char *itemToString(void const *data) {
+  return labels[*(size_t *)data];
+}
+
+//===================================================================
+// index of an item in 0..2 * SIZE - 1
+size_t itemToIndex(void const *data) {
+  return *(size_t *)data;
+}
+
+//===================================================================
+// creates a pairing heap, with or without an index function
+pairheap *newHeap(bool useIndex) {
+  pairheap *H = phpNew(MIN, compKeys, copyKey, free, itemToString);
+  if (useIndex)
+    phpSetToIndex(H, itemToIndex, 2 * SIZE);
+  return H;
+}
+
+//===================================================================
+// runs the test with a string map or an index function
+void runTest(bool useIndex) {
+
+  printf("%s\n", useIndex ? "Index function" : "String map");
+  size_t *items = safeCalloc(2 * SIZE, sizeof(size_t));
+  phpnode **handles = safeCalloc(SIZE, sizeof(phpnode *));
+
+    // items 0..SIZE-1 go into H, the others into H2
+  pairheap *H = newHeap(useIndex), *H2 = newHeap(useIndex);
+  for (size_t i = 0; i < 2 * SIZE; i++) {
+    items[i] = i;
+    double key = rand() % 100000;
+    if (i < SIZE)
+      handles[i] = phpPush(H, items + i, &key);
+    else
+      phpPush(H2, items + i, &key);
+  }
+  printf("Pushed %zu + %zu items\n", phpSize(H), phpSize(H2));
+
+    // decrease the priority of every third item, using
+    // the handle for the even ones
+  size_t updates = 0;
+  for (size_t i = 0; i < SIZE; i += 3) {
+    double key = *(double *)phpGetKey(H, items + i) - 1000;
+    if (i % 2 ? phpUpdateKey(H, items + i, &key)
+              : phpUpdateNodeKey(H, handles[i], &key))
+      updates++;
+  }
+  printf("Decreased %zu priorities\n", updates);
+
+    // delete every seventh item
+  size_t deletions = 0;
+  for (size_t i = 0; i < SIZE; i += 7)
+    if (phpDelete(H, items + i))
+      deletions++;
+  printf("Deleted %zu items, %zu items left\n",
+         deletions, phpSize(H));
+
+    // pop some items, so that the tree is not just
+    // a root with many children
+  for (size_t i = 0; i < 100; i++)
+    phpPop(H2);
+
+  H = phpUnion(H, H2);
+  printf("Union has %zu items\n", phpSize(H));
+
+  bool ok = true;
+  for (size_t i = 0; i < SIZE; i++)
+    if (phpContains(H, items + i) == (i % 7 == 0))
+      ok = false;
+
+    // pop all items and check the order
+  double prev = -DBL_MAX;
+  size_t popped = 0;
+  while (! phpIsEmpty(H)) {
+    double key = *(double *)phpGetKey(H, phpPeek(H));
+    if (key < prev)
+      ok = false;
+    prev = key;
+    phpPop(H);
+    popped++;
+  }
+  printf("Popped %zu items %s\n\n", popped,
+         ok ? "in order" : "NOT in order");
+
+  free(items);
+  free(handles);
+  phpFree(H);
+}
+
+//===================================================================
+
+int main () {
+  srand(time(NULL));
+  for (size_t i = 0; i < 2 * SIZE; i++)
+    sprintf(labels[i], "%zu", i);
+  runTest(false);
+  runTest(true);
+  return 0;
+}
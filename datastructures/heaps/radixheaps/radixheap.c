@@ -0,0 +1,157 @@
+/*
+  Monotone priority queue with unsigned integer keys, using a
+    radix heap
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <inttypes.h>
+#include "radixheap.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// Returns the bucket for a key: 0 if the key equals the last
+// popped key, otherwise 1 + the position of the highest bit
+// in which the key differs from it
+static inline size_t bucketOf(radixheap *H, uint64_t key) {
+  uint64_t x = key ^ H->last;
+  if (x == 0) return 0;
+#if defined(__GNUC__)
+  return 64 - __builtin_clzll(x);
+#else
+  size_t b = 0;
+  while (x) {
+    x >>= 1;
+    b++;
+  }
+  return b;
+#endif
+}
+
+//===================================================================
+// Appends a node to a bucket
+static inline void bucketAdd(rhpBucket *B, uint64_t key,
+                             void *data) {
+  if (B->size == B->capacity) {
+    B->capacity = B->capacity ? 2 * B->capacity : 8;
+    B->arr = safeRealloc(B->arr, B->capacity * sizeof(rhpNode));
+  }
+  B->arr[B->size++] = (rhpNode){key, data};
+}
+
+//===================================================================
+// Creates a new empty radix heap
+radixheap *rhpNew() {
+  radixheap *H = safeCalloc(1, sizeof(radixheap));
+  H->label = "RADIX HEAP";
+  return H;
+}
+
+//===================================================================
+// Deallocates the radix heap
+void rhpFree(radixheap *H) {
+  if (! H) return;
+  for (size_t b = 0; b < RHP_BUCKETS; b++)
+    free(H->buckets[b].arr);
+  free(H);
+}
+
+//===================================================================
+// Sets the label for the heap
+void rhpSetLabel(radixheap *H, char *label) {
+  H->label = label;
+}
+
+//===================================================================
+// Adds a new node to the heap
+bool rhpPush(radixheap *H, void *data, uint64_t key) {
+  if (key < H->last) {
+    fprintf(stderr, "rhpPush: key is smaller than the last "
+                    "popped key\n");
+    return false;
+  }
+  bucketAdd(&H->buckets[bucketOf(H, key)], key, data);
+  H->size++;
+  return true;
+}
+
+//===================================================================
+// Makes sure bucket 0 holds the nodes with the smallest key,
+// by redistributing the first non-empty bucket
+static void refill(radixheap *H) {
+  if (H->buckets[0].size > 0) return;
+  size_t b = 1;
+  while (H->buckets[b].size == 0)
+    b++;
+
+    // the minimum of the bucket becomes the new last key
+  rhpBucket *B = &H->buckets[b];
+  uint64_t min = B->arr[0].key;
+  for (size_t i = 1; i < B->size; i++)
+    if (B->arr[i].key < min)
+      min = B->arr[i].key;
+  H->last = min;
+
+    // all nodes of bucket b now go to lower buckets
+  for (size_t i = 0; i < B->size; i++)
+    bucketAdd(&H->buckets[bucketOf(H, B->arr[i].key)],
+              B->arr[i].key, B->arr[i].data);
+  H->nMoves += B->size;
+  B->size = 0;
+}
+
+//===================================================================
+// Returns the data with the smallest key without removing it; the
+// first non-empty bucket is searched instead of redistributed, as
+// a refill would raise the last key above the last popped key, and
+// make rhpPush refuse keys that are still valid
+void *rhpPeek(radixheap *H, uint64_t *key) {
+  if (H->size == 0) return NULL;
+  size_t b = 0;
+  while (H->buckets[b].size == 0)
+    b++;
+  rhpBucket *B = &H->buckets[b];
+  size_t min = B->size - 1;
+  for (size_t i = 0; i < B->size; i++)
+    if (B->arr[i].key < B->arr[min].key)
+      min = i;
+  if (key) *key = B->arr[min].key;
+  return B->arr[min].data;
+}
+
+//===================================================================
+// Returns and removes the data with the smallest key
+void *rhpPop(radixheap *H, uint64_t *key) {
+  if (H->size == 0) return NULL;
+  refill(H);
+  rhpBucket *B = &H->buckets[0];
+  if (key) *key = H->last;
+  H->size--;
+  return B->arr[--B->size].data;
+}
+
+//===================================================================
+// Removes all nodes from the heap
+void rhpClear(radixheap *H) {
+  for (size_t b = 0; b < RHP_BUCKETS; b++)
+    H->buckets[b].size = 0;
+  H->size = 0;
+  H->last = 0;
+}
+
+//===================================================================
+// Shows the statistics of the heap
+void rhpStats(radixheap *H) {
+  size_t used = 0;
+  for (size_t b = 0; b < RHP_BUCKETS; b++)
+    if (H->buckets[b].size) used++;
+  printf("\n+---------------------------+\n"
+         "|   Radix heap statistics   |\n"
+         "+---------------------------+\n\n"
+         "   Label..............: %s\n"
+         "   Number of nodes....: %zu\n"
+         "   Non-empty buckets..: %zu\n"
+         "   Last popped key....: %" PRIu64 "\n"
+         "   Bucket moves.......: %zu\n\n\n",
+         H->label, H->size, used, H->last, H->nMoves);
+}
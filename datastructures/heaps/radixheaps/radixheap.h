@@ -0,0 +1,101 @@
+/*
+  Monotone priority queue with unsigned integer keys, using a
+    radix heap
+  The keys of the popped items never decrease, and a pushed key
+    may not be smaller than the last popped key; this is exactly
+    the access pattern of Dijkstra's algorithm with non-negative
+    integer weights
+  An item with key k is kept in bucket b, where b is the position
+    of the highest bit in which k differs from the last popped
+    key (bucket 0 holds the keys equal to it). When bucket 0 is
+    empty, a pop takes the first non-empty bucket, makes its
+    minimum the new last key, and spreads the bucket over the
+    lower buckets. Since an item can only move to lower buckets,
+    it moves at most 64 times, which makes the amortized cost of
+    a pop O(log C), with C the largest difference between a key
+    and the last popped key, and the cost of a push O(1)
+  There is no decrease-key: push the item again with its new
+    key and skip the outdated entries when they are popped
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef RADIXHEAP_H_INCLUDED
+#define RADIXHEAP_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#define RHP_BUCKETS 65
+
+// radix heap node
+typedef struct {
+  uint64_t key;          // key (priority) of the node
+  void *data;            // data associated with the key
+} rhpNode;
+
+// bucket of nodes
+typedef struct {
+  rhpNode *arr;          // array of nodes
+  size_t size;           // number of nodes in the bucket
+  size_t capacity;       // capacity of the bucket
+} rhpBucket;
+
+// radix heap
+typedef struct {
+  rhpBucket buckets[RHP_BUCKETS];
+  uint64_t last;         // last popped key
+  size_t size;           // number of nodes in the heap
+  size_t nMoves;         // number of nodes moved between buckets
+  char *label;           // label for the heap
+                         // default is "RADIX HEAP"
+} radixheap;
+
+// function prototypes
+
+  // creates a new empty radix heap
+radixheap *rhpNew();
+
+  // deallocates the radix heap
+void rhpFree(radixheap *H);
+
+  // sets the label for the heap
+void rhpSetLabel(radixheap *H, char *label);
+
+  // adds a new node with the given data and key to the
+  // heap; returns false if the key is smaller than the
+  // last popped key
+bool rhpPush(radixheap *H, void *data, uint64_t key);
+
+  // returns and removes the data with the smallest key;
+  // the key is stored in *key if key is not NULL;
+  // returns NULL if the heap is empty
+void *rhpPop(radixheap *H, uint64_t *key);
+
+  // returns the data with the smallest key without removing
+  // it; the key is stored in *key if key is not NULL;
+  // returns NULL if the heap is empty; the last popped key
+  // is left as it is, and if no node has that key, each
+  // call takes time linear in the size of the lowest
+  // non-empty bucket
+void *rhpPeek(radixheap *H, uint64_t *key);
+
+  // removes all nodes and resets the last popped key to 0
+void rhpClear(radixheap *H);
+
+  // shows the statistics of the heap
+void rhpStats(radixheap *H);
+
+  // true if the heap is empty
+static inline bool rhpIsEmpty(radixheap *H) {
+  return H->size == 0;
+}
+
+  // returns the number of nodes in the heap
+static inline size_t rhpSize(radixheap *H) {
+  return H->size;
+}
+
+#endif  // RADIXHEAP_H_INCLUDED
@@ -0,0 +1,74 @@
+/*
+  Monotone priority queue, using a radix heap
+  Simulates the use in Dijkstra's algorithm: every popped key
+    is pushed again, increased by a random amount, for a
+    number of rounds, and the popped keys are checked to be
+    non-decreasing; finally, checks that a key smaller than
+    the last popped key is refused, and that a key between
+    the last popped key and a peeked key is accepted
+  Author: David De Potter
+*/
+
+#include "../radixheap.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+//===================================================================
+
+int main () {
+
+  srand(time(NULL));
+  size_t n = 10000, rounds = 200000;
+  size_t *items = safeCalloc(n, sizeof(size_t));
+
+  radixheap *H = rhpNew();
+  for (size_t i = 0; i < n; i++) {
+    items[i] = i;
+    rhpPush(H, &items[i], rand() % 1000);
+  }
+
+    // pop and push back with a larger key, including
+    // large jumps that use the high buckets
+  uint64_t key, prev = 0;
+  bool ordered = true;
+  for (size_t r = 0; r < rounds; r++) {
+    size_t *item = rhpPop(H, &key);
+    if (key < prev)
+      ordered = false;
+    prev = key;
+    uint64_t inc = r % 1000 == 0 ? (uint64_t)rand() << 20
+                                 : (uint64_t)(rand() % 100);
+    rhpPush(H, item, key + inc);
+  }
+
+    // empty the heap
+  size_t count = 0;
+  while (! rhpIsEmpty(H)) {
+    rhpPop(H, &key);
+    if (key < prev)
+      ordered = false;
+    prev = key;
+    count++;
+  }
+
+  printf("Popped keys are %s\n", ordered ? "in order" : "NOT in order");
+  printf("Remaining items: %zu of %zu\n", count, n);
+  printf("Key below last popped key refused: %s\n",
+         ! rhpPush(H, items, prev - 1) ? "yes" : "no");
+
+    // a peek may not raise the bound on pushed keys
+  rhpPush(H, items, prev + 100);
+  uint64_t peeked;
+  size_t *peekItem = rhpPeek(H, &peeked);
+  bool pushed = rhpPush(H, items + 1, prev + 50);
+  size_t *first = rhpPop(H, &key);
+  printf("Key below peeked key accepted: %s\n",
+         pushed && peekItem == items && peeked == prev + 100 &&
+         first == items + 1 && key == prev + 50 ? "yes" : "no");
+  rhpClear(H);
+  rhpStats(H);
+
+  rhpFree(H);
+  free(items);
+  return 0;
+}
@@ -8,6 +8,26 @@
 #include "htable.h"
 #include "../../../lib/clib.h"
 
+//=================================================================
+// returns false if the key filter is set and says
+// that the key is surely not in the table
+static inline bool filterMayContain(htable *H, void *key) {
+  return ! H->filter.mayContain || 
+         H->filter.mayContain(H->filter.filter, key);
+}
+
+//=================================================================
+// adds a key to the key filter, if set; if the filter
+// is full, it is detached since it can no longer
+// answer for all keys
+static void filterAdd(htable *H, void *key) {
+  if (! H->filter.mayContain || 
+      H->filter.add(H->filter.filter, key))
+    return;
+  fprintf(stderr, "htable: key filter is full and is removed\n");
+  memset(&H->filter, 0, sizeof(keyFilter));
+}
+
 //=================================================================
 // creates a new hash table
 htable *htNew(htHash hash, htCmpKey cmpKey, 
@@ -64,6 +84,21 @@ void htCopyVals(htable *H, htCopyValue copyValue,
   H->freeValue = freeValue;
 }
 
+//=================================================================
+// sets a key filter as a pre-check for lookups
+void htSetFilter(htable *H, keyFilter filter) {
+  H->filter = filter;
+  if (! filter.mayContain)
+    return;
+  for (size_t i = 0; i < H->capacity; i++) {
+    if (! H->buckets[i])
+      continue;
+    for (htEntry *e = dllFirst(H->buckets[i]); e; 
+         e = dllNext(H->buckets[i]))
+      filterAdd(H, e->key);
+  }
+}
+
 //=================================================================
 // gets number of values associated with a key
 size_t htKeySize(htable *H, void *key) {
@@ -101,6 +136,8 @@ static size_t getIndex(htable *H, void *key) {
 //=================================================================
 // returns true if the key exists
 bool htHasKey(htable *H, void *key) {
+  if (! filterMayContain(H, key))
+    return false;
   size_t index = getIndex(H, key);
   dll *bucket = H->buckets[index];
   if (! bucket || dllIsEmpty(bucket))
@@ -115,6 +152,8 @@ bool htHasKey(htable *H, void *key) {
 //=================================================================
 // Returns the key from the table given an identifying key
 void *htGetKey(htable *H, void *key) {
+  if (! filterMayContain(H, key))
+    return NULL;
   size_t index = getIndex(H, key);
   dll *bucket = H->buckets[index];
   if (! bucket) 
@@ -140,9 +179,11 @@ void *htGetVal(htable *H, void *key, void *value) {
 // with the key; set to NULL if the key has no 
 // values; returns true if the key exists
 bool htHasKeyVals(htable *H, void *key, dll **values) {
+  *values = NULL;
+  if (! filterMayContain(H, key))
+    return false;
   size_t index = getIndex(H, key);
   dll *bucket = H->buckets[index];
-  *values = NULL;
   if (!bucket) 
     return false;
   for (htEntry *e = dllFirst(bucket); e; e = dllNext(bucket)) {
@@ -241,6 +282,7 @@ static void htAddNewkeyVal(htable *H, void *key, void *value,
     dllPush(entry->values, value);
     // add the new key-value pair to the bucket
   dllPush(bucket, entry);
+  filterAdd(H, entry->key);
     // one key more
   H->nKeys++;
 }
@@ -316,6 +358,8 @@ bool htDelKey(htable *H, void *key) {
   
   for (htEntry *e = dllFirst(bucket); e; e = dllNext(bucket)) {
     if (! H->cmpKey(key, e->key)) {
+      if (H->filter.del)
+        H->filter.del(H->filter.filter, e->key);
         // free key if a free function is provided
       if (H->freeKey)
         H->freeKey(e->key);    
@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include <stdint.h>   // uint64_t
 #include "../../lists/dll.h"
+#include "../../filters/keyFilter.h"
 
   // function pointer types
 typedef uint64_t (*htHash)(void *hashKey, uint64_t seed);
@@ -49,6 +50,7 @@ typedef struct {
   char *label;            // label for the hash table
   char *valDelim;         // delimiter for the values
                           // default is ", "
+  keyFilter filter;       // optional pre-check for lookups
 } htable;
 
 typedef struct {          // key-value pair
@@ -92,6 +94,13 @@ void htOwnKeys(htable *H, htFreeKey freeKey);
   // freeing them when the table is freed
 void htOwnVals(htable *H, htFreeValue freeValue);
 
+  // sets a key filter (e.g. a Bloom or cuckoo filter)
+  // that is checked before the buckets on every lookup;
+  // the keys in the table are added to the filter;
+  // the table does not own the filter
+  // pass a filter with NULL functions to remove it
+void htSetFilter(htable *H, keyFilter filter);
+
   // frees the hash table
 void htFree(htable *H);
 
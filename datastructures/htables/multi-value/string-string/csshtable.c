@@ -0,0 +1,590 @@
+/*
+  Compact string hash table:
+    both keys and values are strings, stored in an arena.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <ctype.h>
+#include <string.h>
+#include <time.h>
+#include "csshtable.h"
+#include "../../../../lib/clib.h"
+
+#define EMPTY 0           // hash of an empty slot
+#define DELETED 1         // hash of a deleted slot
+
+  // slot in the open addressing table
+typedef struct {
+  uint64_t hash;          // hash of the key, or EMPTY / DELETED
+  csshtSpan key;          // key string in the arena
+  uint32_t vals;          // index of the first value span
+  uint32_t nVals;         // number of values
+  uint32_t valCap;        // capacity of the run of value spans
+} csshtSlot;
+
+struct csshtable {
+  csshtSlot *slots;       // open addressing table (linear probing)
+  size_t capacity;        // number of slots, a power of 2
+  size_t nKeys;           // number of keys
+  size_t nDeleted;        // number of deleted slots
+  char *arena;            // key and value bytes
+  size_t arenaLen;        // number of used arena bytes
+  size_t arenaCap;        // capacity of the arena
+  size_t arenaDead;       // number of arena bytes no longer used
+  csshtSpan *vals;        // runs of value spans
+  size_t valsLen;         // number of used value spans
+  size_t valsCap;         // capacity of the value span array
+  size_t valsDead;        // number of value spans no longer used
+  sshtCase htCase;        // case sensitivity
+  uint64_t seed;          // magic seed for the hash function
+  size_t iter;            // current slot for the iterator
+  char *label;            // label for the hash table
+  char *valDelim;         // delimiter for the values
+};
+
+//===================================================================
+// FNV-1a hash function
+// (http://www.isthe.com/chongo/tech/comp/fnv/index.html)
+// Case insensitive tables hash the lower case key, so that keys
+// which compare equal also end up in the same probe sequence
+static uint64_t csshtHash(csshtable *ht, char const *str,
+                          size_t len) {
+  uint64_t hash = 14695981039346656037ULL + ht->seed;
+  for (size_t i = 0; i < len; i++) {
+    unsigned char ch = str[i];
+    hash ^= ht->htCase == CASE_SENSITIVE ? ch : tolower(ch);
+    hash *= 1099511628211ULL;  // FNV prime
+  }
+  return hash < 2 ? hash + 2 : hash;
+}
+
+//===================================================================
+// Returns true if the string equals the string at span s
+static bool spanEquals(csshtable *ht, csshtSpan s,
+                       char const *str, size_t len) {
+  if (s.len != len)
+    return false;
+  char const *a = ht->arena + s.off;
+  if (ht->htCase == CASE_SENSITIVE)
+    return memcmp(a, str, len) == 0;
+  for (size_t i = 0; i < len; i++)
+    if (tolower((unsigned char)a[i]) !=
+        tolower((unsigned char)str[i]))
+      return false;
+  return true;
+}
+
+//===================================================================
+// Copies a string with its terminating '\0' to the end of the arena
+// and returns its span; the string may point into the arena itself
+static csshtSpan arenaAppend(csshtable *ht, char const *str,
+                             size_t len) {
+  if (ht->arenaLen + len + 1 > UINT32_MAX) {
+    fprintf(stderr, "csshtable: arena exceeds 4 GiB\n");
+    exit(EXIT_FAILURE);
+  }
+  if (ht->arenaLen + len + 1 > ht->arenaCap) {
+      // keep track of strings that live in the arena
+      // itself, since a reallocation moves them
+    bool inArena = str >= ht->arena &&
+                   str < ht->arena + ht->arenaLen;
+    size_t off = inArena ? str - ht->arena : 0;
+    while (ht->arenaLen + len + 1 > ht->arenaCap)
+      ht->arenaCap *= 2;
+    ht->arena = safeRealloc(ht->arena, ht->arenaCap);
+    if (inArena)
+      str = ht->arena + off;
+  }
+  csshtSpan s = { (uint32_t)ht->arenaLen, (uint32_t)len };
+  memcpy(ht->arena + ht->arenaLen, str, len);
+  ht->arena[ht->arenaLen + len] = '\0';
+  ht->arenaLen += len + 1;
+  return s;
+}
+
+//===================================================================
+// Reserves a run of n value spans at the end of the span array
+// and returns the index of its first span
+static uint32_t valsReserve(csshtable *ht, size_t n) {
+  if (ht->valsLen + n > UINT32_MAX) {
+    fprintf(stderr, "csshtable: too many values\n");
+    exit(EXIT_FAILURE);
+  }
+  if (ht->valsLen + n > ht->valsCap) {
+    while (ht->valsLen + n > ht->valsCap)
+      ht->valsCap *= 2;
+    ht->vals = safeRealloc(ht->vals,
+                           ht->valsCap * sizeof(csshtSpan));
+  }
+  uint32_t idx = ht->valsLen;
+  ht->valsLen += n;
+  return idx;
+}
+
+//===================================================================
+// Creates a new compact string-string hash table
+csshtable *csshtNew(sshtCase htCase, size_t capacity) {
+  csshtable *ht = safeCalloc(1, sizeof(csshtable));
+  ht->capacity = 32;
+  while (ht->capacity < capacity)
+    ht->capacity <<= 1;
+  ht->slots = safeCalloc(ht->capacity, sizeof(csshtSlot));
+  ht->arenaCap = 16 * ht->capacity;
+  ht->arena = safeMalloc(ht->arenaCap);
+  ht->valsCap = ht->capacity;
+  ht->vals = safeMalloc(ht->valsCap * sizeof(csshtSpan));
+  ht->htCase = htCase;
+  ht->label = "Hash table";
+  ht->valDelim = ", ";
+  srand(time(NULL));
+  ht->seed = rand();
+  ht->seed ^= (uint64_t)time(NULL) << 16;
+  return ht;
+}
+
+//===================================================================
+// Setters
+
+void csshtSetLabel(csshtable *ht, char *label) {
+  ht->label = label;
+}
+
+void csshtSetValDelim(csshtable *ht, char *valDelim) {
+  ht->valDelim = valDelim;
+}
+
+//===================================================================
+// Deallocates the hash table
+void csshtFree(csshtable *ht) {
+  if (! ht) return;
+  free(ht->slots);
+  free(ht->arena);
+  free(ht->vals);
+  free(ht);
+}
+
+//===================================================================
+// Returns the slot holding the key, or NULL if not found
+static csshtSlot *findSlot(csshtable *ht, char const *key,
+                           size_t len, uint64_t hash) {
+  size_t mask = ht->capacity - 1;
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+    csshtSlot *s = ht->slots + i;
+    if (s->hash == EMPTY)
+      return NULL;
+    if (s->hash == hash && spanEquals(ht, s->key, key, len))
+      return s;
+  }
+}
+
+//===================================================================
+// Returns the first free slot in the probe sequence of the hash
+static csshtSlot *freeSlot(csshtable *ht, uint64_t hash) {
+  size_t mask = ht->capacity - 1;
+  size_t i = hash & mask;
+  while (ht->slots[i].hash > DELETED)
+    i = (i + 1) & mask;
+  return ht->slots + i;
+}
+
+//===================================================================
+// Rebuilds the table with the given number of slots; all live keys
+// and their values are copied to a fresh arena, each key followed
+// by its values, so that dead bytes and spans are reclaimed
+static void rebuild(csshtable *ht, size_t capacity) {
+  csshtSlot *oldSlots = ht->slots;
+  size_t oldCap = ht->capacity;
+  char *oldArena = ht->arena;
+  csshtSpan *oldVals = ht->vals;
+
+  ht->capacity = capacity;
+  ht->slots = safeCalloc(capacity, sizeof(csshtSlot));
+  ht->arenaCap = MAX(ht->arenaLen - ht->arenaDead, 16) * 2;
+  ht->arena = safeMalloc(ht->arenaCap);
+  ht->arenaLen = ht->arenaDead = 0;
+  ht->valsCap = MAX(ht->valsLen - ht->valsDead, 16) * 2;
+  ht->vals = safeMalloc(ht->valsCap * sizeof(csshtSpan));
+  ht->valsLen = ht->valsDead = 0;
+  ht->nDeleted = 0;
+
+  for (size_t i = 0; i < oldCap; i++) {
+    csshtSlot *o = oldSlots + i;
+    if (o->hash <= DELETED)
+      continue;
+    csshtSlot *s = freeSlot(ht, o->hash);
+    s->hash = o->hash;
+    s->key = arenaAppend(ht, oldArena + o->key.off, o->key.len);
+    s->nVals = s->valCap = o->nVals;
+    s->vals = valsReserve(ht, o->nVals);
+    for (size_t j = 0; j < o->nVals; j++) {
+      csshtSpan v = oldVals[o->vals + j];
+      ht->vals[s->vals + j] = arenaAppend(ht, oldArena + v.off,
+                                          v.len);
+    }
+  }
+  free(oldSlots);
+  free(oldArena);
+  free(oldVals);
+}
+
+//===================================================================
+// Grows the table if the number of used slots exceeds 75% of
+// the capacity, or compacts it if more than half of the arena
+// or value spans are dead
+static void csshtRehash(csshtable *ht) {
+  if (ht->nKeys + ht->nDeleted + 1 > 0.75 * ht->capacity)
+    rebuild(ht, ht->nKeys + 1 > 0.5 * ht->capacity ?
+                ht->capacity * 2 : ht->capacity);
+  else if (ht->arenaDead > 4096 &&
+           ht->arenaDead > ht->arenaLen / 2)
+    rebuild(ht, ht->capacity);
+  else if (ht->valsDead > 1024 &&
+           ht->valsDead > ht->valsLen / 2)
+    rebuild(ht, ht->capacity);
+}
+
+//===================================================================
+// Returns a copy of the string if it points into the arena, and
+// NULL otherwise; a rebuild frees the arena, so that a string
+// that was returned by the table cannot be read after it
+static char *arenaCopy(csshtable *ht, char const *str) {
+  if (str < ht->arena || str >= ht->arena + ht->arenaLen)
+    return NULL;
+  size_t len = strlen(str);
+  char *copy = safeMalloc(len + 1);
+  memcpy(copy, str, len + 1);
+  return copy;
+}
+
+//===================================================================
+// Returns the slot of the key, adding the key if it does not exist
+static csshtSlot *addKey(csshtable *ht, char const *key) {
+  size_t len = strlen(key);
+  uint64_t hash = csshtHash(ht, key, len);
+  csshtSlot *s = findSlot(ht, key, len, hash);
+  if (s)
+    return s;
+  char *copy = arenaCopy(ht, key);
+  if (copy)
+    key = copy;
+  csshtRehash(ht);
+  s = freeSlot(ht, hash);
+  if (s->hash == DELETED)
+    ht->nDeleted--;
+  s->hash = hash;
+  s->key = arenaAppend(ht, key, len);
+  s->vals = s->nVals = s->valCap = 0;
+  ht->nKeys++;
+  free(copy);
+  return s;
+}
+
+//===================================================================
+// Returns the index of the value in the value run of slot s,
+// or nVals if the value is not there
+static size_t findVal(csshtable *ht, csshtSlot *s,
+                      char const *value, size_t len) {
+  csshtSpan *run = ht->vals + s->vals;
+  for (size_t i = 0; i < s->nVals; i++)
+    if (spanEquals(ht, run[i], value, len))
+      return i;
+  return s->nVals;
+}
+
+//===================================================================
+// Adds a value to the value run of slot s if not yet there;
+// a full run is extended in place if it is the last run in the
+// span array, and otherwise moved to the end with twice its size
+static void addVal(csshtable *ht, csshtSlot *s, char const *value) {
+  size_t len = strlen(value);
+  if (findVal(ht, s, value, len) < s->nVals)
+    return;
+  if (s->nVals == s->valCap) {
+    uint32_t extra = s->valCap ? s->valCap : 1;
+    if (s->valCap && s->vals + s->valCap == ht->valsLen)
+      valsReserve(ht, extra);
+    else {
+      uint32_t idx = valsReserve(ht, s->valCap + extra);
+      memcpy(ht->vals + idx, ht->vals + s->vals,
+             s->nVals * sizeof(csshtSpan));
+      ht->valsDead += s->valCap;
+      s->vals = idx;
+    }
+    s->valCap += extra;
+  }
+  ht->vals[s->vals + s->nVals++] = arenaAppend(ht, value, len);
+}
+
+//===================================================================
+// Adds a key without a value; nothing happens if the key exists
+void csshtAddKey(csshtable *ht, char *key) {
+  if (! ht || ! key) return;
+  addKey(ht, key);
+}
+
+//===================================================================
+// Adds a key-value pair; the value is appended to the values of
+// the key if the key exists and the value is not yet there
+void csshtAddKeyVal(csshtable *ht, char *key, char *value) {
+  if (! ht || ! key) return;
+    // a value in the arena must outlive a rebuild by addKey
+  char *copy = value ? arenaCopy(ht, value) : NULL;
+  csshtSlot *s = addKey(ht, key);
+  if (value)
+    addVal(ht, s, copy ? copy : value);
+  free(copy);
+}
+
+//===================================================================
+// Same as above, but with an array of values
+void csshtAddKeyVals(csshtable *ht, char *key, char **values,
+                     size_t len) {
+  if (! ht || ! key) return;
+    // values in the arena must outlive a rebuild by addKey
+  char **copies = NULL;
+  for (size_t i = 0; i < len; i++) {
+    char *copy = arenaCopy(ht, values[i]);
+    if (copy && ! copies)
+      copies = safeCalloc(len, sizeof(char *));
+    if (copy)
+      copies[i] = copy;
+  }
+  csshtSlot *s = addKey(ht, key);
+  for (size_t i = 0; i < len; i++)
+    addVal(ht, s, copies && copies[i] ? copies[i] : values[i]);
+  if (copies)
+    for (size_t i = 0; i < len; i++)
+      free(copies[i]);
+  free(copies);
+}
+
+//===================================================================
+// Returns the slot of the key, or NULL if not found
+static csshtSlot *getSlot(csshtable *ht, char const *key) {
+  size_t len = strlen(key);
+  return findSlot(ht, key, len, csshtHash(ht, key, len));
+}
+
+//===================================================================
+// Returns a view on the values in slot s
+static csshtVals slotVals(csshtable *ht, csshtSlot *s) {
+  csshtVals v = { ht->arena, NULL, 0 };
+  if (s && s->nVals) {
+    v.spans = ht->vals + s->vals;
+    v.size = s->nVals;
+  }
+  return v;
+}
+
+//===================================================================
+// Sets the value view to the values of the key;
+// returns true if the key exists
+bool csshtHasKeyVals(csshtable *ht, char *key, csshtVals *values) {
+  csshtSlot *s = getSlot(ht, key);
+  *values = slotVals(ht, s);
+  return s != NULL;
+}
+
+//===================================================================
+// Returns the values associated with the key
+csshtVals csshtGetVals(csshtable *ht, char *key) {
+  return slotVals(ht, getSlot(ht, key));
+}
+
+//===================================================================
+// Returns true if the key-value pair exists
+bool csshtHasKeyVal(csshtable *ht, char *key, char *value) {
+  csshtSlot *s = getSlot(ht, key);
+  return s && findVal(ht, s, value, strlen(value)) < s->nVals;
+}
+
+//===================================================================
+// Returns true if the key exists
+bool csshtHasKey(csshtable *ht, char *key) {
+  return getSlot(ht, key) != NULL;
+}
+
+//===================================================================
+// Returns the number of values associated with the key
+size_t csshtKeySize(csshtable *ht, char *key) {
+  csshtSlot *s = getSlot(ht, key);
+  return s ? s->nVals : 0;
+}
+
+//===================================================================
+// Deletes a key and its values; the arena bytes and value spans
+// are reclaimed by the next compaction
+bool csshtDelKey(csshtable *ht, char *key) {
+  csshtSlot *s = getSlot(ht, key);
+  if (! s)
+    return false;
+  ht->arenaDead += s->key.len + 1;
+  for (size_t i = 0; i < s->nVals; i++)
+    ht->arenaDead += ht->vals[s->vals + i].len + 1;
+  ht->valsDead += s->valCap;
+  s->hash = DELETED;
+  ht->nKeys--;
+  ht->nDeleted++;
+  return true;
+}
+
+//===================================================================
+// Deletes a value from the values of the key, preserving the order
+// of the remaining values
+bool csshtDelVal(csshtable *ht, char *key, char *value) {
+  csshtSlot *s = getSlot(ht, key);
+  if (! s)
+    return false;
+  size_t i = findVal(ht, s, value, strlen(value));
+  if (i == s->nVals)
+    return false;
+  csshtSpan *run = ht->vals + s->vals;
+  ht->arenaDead += run[i].len + 1;
+  memmove(run + i, run + i + 1,
+          (s->nVals - i - 1) * sizeof(csshtSpan));
+  s->nVals--;
+  return true;
+}
+
+//===================================================================
+// Returns the number of keys in the table
+size_t csshtSize(csshtable *ht) {
+  return ht->nKeys;
+}
+
+//===================================================================
+// Returns true if the table is empty
+bool csshtIsEmpty(csshtable *ht) {
+  return ht->nKeys == 0;
+}
+
+//===================================================================
+// Returns the number of bytes allocated by the table
+size_t csshtMemory(csshtable *ht) {
+  return sizeof(csshtable) +
+         ht->capacity * sizeof(csshtSlot) +
+         ht->arenaCap +
+         ht->valsCap * sizeof(csshtSpan);
+}
+
+//===================================================================
+// Returns the key in the first used slot from the iterator on
+static char const *iterKey(csshtable *ht) {
+  while (ht->iter < ht->capacity) {
+    csshtSlot *s = ht->slots + ht->iter++;
+    if (s->hash > DELETED)
+      return ht->arena + s->key.off;
+  }
+  return NULL;
+}
+
+//===================================================================
+// Returns the first key and resets the iterator
+char const *csshtFirst(csshtable *ht) {
+  ht->iter = 0;
+  return iterKey(ht);
+}
+
+//===================================================================
+// Returns the next key; NULL if the end is reached
+char const *csshtNext(csshtable *ht) {
+  return iterKey(ht);
+}
+
+//===================================================================
+// Shows a key and its values
+static void showSlot(csshtable *ht, csshtSlot *s) {
+  printf("%s[%u]", ht->arena + s->key.off, s->nVals);
+  printf(s->nVals ? ": " : "\n");
+  for (size_t i = 0; i < s->nVals; i++)
+    printf("%s%s", ht->arena + ht->vals[s->vals + i].off,
+           i + 1 < s->nVals ? ht->valDelim : "\n");
+}
+
+//===================================================================
+// Shows a key and its values
+void csshtShowEntry(csshtable *ht, char *key) {
+  csshtSlot *s = getSlot(ht, key);
+  if (! s) {
+    printf("Key not found\n");
+    return;
+  }
+  showSlot(ht, s);
+}
+
+//===================================================================
+// Shows the hash table
+void csshtShow(csshtable *ht) {
+  printf("\n--------------------\n"
+          "  %s [%zu]\n"
+          "--------------------\n",
+          ht->label, ht->nKeys);
+  for (size_t i = 0; i < ht->capacity; i++)
+    if (ht->slots[i].hash > DELETED)
+      showSlot(ht, ht->slots + i);
+  printf("--------------------\n\n");
+}
+
+//===================================================================
+// Gives an overview of the table's layout and probe lengths
+void csshtStats(csshtable *ht) {
+  size_t maxProbe = 0, totalProbe = 0;
+  size_t mask = ht->capacity - 1;
+  for (size_t i = 0; i < ht->capacity; i++) {
+    csshtSlot *s = ht->slots + i;
+    if (s->hash <= DELETED)
+      continue;
+    size_t probe = ((i - s->hash) & mask) + 1;
+    totalProbe += probe;
+    if (probe > maxProbe)
+      maxProbe = probe;
+  }
+
+  printf("\n+---------------------------+\n"
+         "|   Hash table statistics   |\n"
+         "+---------------------------+\n\n"
+         "   Number of slots....: %zu\n"
+         "   Deleted slots......: %zu\n"
+         "   Number of keys.....: %zu\n"
+         "   Load factor........: %.2f\n"
+         "   Max. probe length..: %zu\n"
+         "   Avg. probe length..: %.2f\n"
+         "   Arena bytes........: %zu (%zu dead)\n"
+         "   Value spans........: %zu (%zu dead)\n"
+         "   Memory in use......: %zu bytes\n\n\n",
+         ht->capacity, ht->nDeleted, ht->nKeys,
+         (double)ht->nKeys / ht->capacity, maxProbe,
+         ht->nKeys ? (double)totalProbe / ht->nKeys : 0,
+         ht->arenaLen, ht->arenaDead,
+         ht->valsLen, ht->valsDead, csshtMemory(ht));
+}
+
+//===================================================================
+// Merges the smaller table into the larger one;
+// the smaller table is destroyed
+csshtable *csshtMerge(csshtable *ht1, csshtable *ht2) {
+  if (ht1->htCase != ht2->htCase) {
+    fprintf(stderr, "csshtMerge: case sensitivity differs\n");
+    return NULL;
+  }
+
+  if (csshtSize(ht1) < csshtSize(ht2))
+    return csshtMerge(ht2, ht1);
+
+  for (size_t i = 0; i < ht2->capacity; i++) {
+    csshtSlot *s = ht2->slots + i;
+    if (s->hash <= DELETED)
+      continue;
+    csshtSlot *t = addKey(ht1, ht2->arena + s->key.off);
+    for (size_t j = 0; j < s->nVals; j++)
+      addVal(ht1, t, ht2->arena + ht2->vals[s->vals + j].off);
+  }
+  csshtFree(ht2);
+  return ht1;
+}
+
+//===================================================================
+// End of file
+#undef EMPTY
+#undef DELETED
@@ -0,0 +1,112 @@
+/*
+  Compact string hash table:
+    both keys and values are strings.
+    Same interface as the sshtable, but instead of storing
+    every key and value as a separately allocated string in
+    a chain of dll nodes, all key and value bytes are copied
+    into one append-only arena. The table itself is an open
+    addressing table of small fixed-size slots holding arena
+    offsets and lengths, and the values of a key are stored
+    as one contiguous run of (offset, length) pairs, so that
+    scanning the values of a key is a sequential memory read.
+    Since the table always stores its own copies, there are
+    no ownership or copy settings.
+    Pointers returned by the table point into the arena and
+    are only valid until the next modification of the table.
+    The arena is limited to 4 GiB of key and value bytes.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef CSSHTABLE_H_INCLUDED
+#define CSSHTABLE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "sshtable.h"     // sshtCase
+
+typedef struct csshtable csshtable;
+
+  // a string stored in the arena
+typedef struct {
+  uint32_t off;           // offset of the first byte in the arena
+  uint32_t len;           // length of the string, without '\0'
+} csshtSpan;
+
+  // read-only view of the values associated with a key
+typedef struct {
+  char const *arena;      // base of the arena
+  csshtSpan const *spans; // contiguous run of value strings
+  size_t size;            // number of values
+} csshtVals;
+
+csshtable *csshtNew(sshtCase htCase, size_t capacity);
+
+void csshtSetLabel(csshtable *ht, char *label);
+
+void csshtSetValDelim(csshtable *ht, char *valDelim);
+
+void csshtFree(csshtable *ht);
+
+  // sets the value view to the values associated
+  // with the key; returns true if the key exists
+bool csshtHasKeyVals(csshtable *ht, char *key,
+  csshtVals *values);
+
+  // returns the values associated with the key;
+  // the view is empty if the key has no values
+csshtVals csshtGetVals(csshtable *ht, char *key);
+
+bool csshtHasKeyVal(csshtable *ht, char *key,
+  char *value);
+
+void csshtAddKey(csshtable *ht, char *key);
+
+void csshtAddKeyVal(csshtable *ht, char *key,
+  char *value);
+
+// same as above, but with an array of values
+void csshtAddKeyVals(csshtable *ht, char *key,
+  char **values, size_t len);
+
+bool csshtHasKey(csshtable *ht, char *key);
+
+bool csshtDelKey(csshtable *ht, char *key);
+
+bool csshtDelVal(csshtable *ht,
+  char *key, char *value);
+
+void csshtShowEntry(csshtable *ht, char *key);
+
+void csshtStats(csshtable *ht);
+
+void csshtShow(csshtable *ht);
+
+size_t csshtSize(csshtable *ht);
+
+  // returns the number of bytes used by the table
+size_t csshtMemory(csshtable *ht);
+
+  // merges the smaller table into the larger one;
+  // the smaller table is destroyed
+csshtable *csshtMerge(csshtable *ht1, csshtable *ht2);
+
+bool csshtIsEmpty(csshtable *ht);
+
+size_t csshtKeySize(csshtable *ht, char *key);
+
+  // returns the first key in the table and resets
+  // the iterator; NULL if the table is empty
+char const *csshtFirst(csshtable *ht);
+
+  // returns the next key in the table;
+  // NULL if the end of the table is reached
+char const *csshtNext(csshtable *ht);
+
+  // returns the i-th value of a value view
+static inline char const *csshtValAt(csshtVals vals, size_t i) {
+  return vals.arena + vals.spans[i].off;
+}
+
+#endif // CSSHTABLE_H_INCLUDED
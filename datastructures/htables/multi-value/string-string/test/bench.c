@@ -0,0 +1,96 @@
+/*
+  Benchmark: sshtable versus its compact, arena-backed variant
+  Builds a dictionary of n keys with k values each, then scans
+  the values of all keys, and reports the timings and the peak
+  memory use of the process.
+  Usage: ./bench.out [ssht | cssht] [n] [k]
+  Run once for each table type, since the peak memory use
+  is measured for the whole process.
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <sys/resource.h>
+#include <time.h>
+#include "../sshtable.h"
+#include "../csshtable.h"
+#include "../../../../../lib/clib.h"
+
+//===================================================================
+// Returns the elapsed time in seconds since start
+static double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// Returns the peak resident set size in MiB
+static double peakMiB() {
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_maxrss / 1024.0;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  bool compact = argc < 2 || strcmp(argv[1], "ssht") != 0;
+  size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+  size_t k = argc > 3 ? strtoul(argv[3], NULL, 10) : 4;
+  char key[32], val[48];
+  size_t bytes = 0;
+
+  printf("%s table, %zu keys, %zu values per key\n",
+         compact ? "Compact" : "Chained", n, k);
+
+  clock_t start = clock();
+  sshtable *ssht = NULL;
+  csshtable *cssht = NULL;
+
+  if (compact) {
+    cssht = csshtNew(CASE_SENSITIVE, n);
+    for (size_t i = 0; i < n; i++) {
+      sprintf(key, "key-%zu", i);
+      for (size_t j = 0; j < k; j++) {
+        sprintf(val, "value-%zu-%zu", i, j);
+        csshtAddKeyVal(cssht, key, val);
+      }
+    }
+  } else {
+    ssht = sshtNew(CASE_SENSITIVE, n);
+    sshtCopyKeys(ssht);
+    sshtCopyVals(ssht);
+    for (size_t i = 0; i < n; i++) {
+      sprintf(key, "key-%zu", i);
+      for (size_t j = 0; j < k; j++) {
+        sprintf(val, "value-%zu-%zu", i, j);
+        sshtAddKeyVal(ssht, key, val);
+      }
+    }
+  }
+  printf("  build..........: %.3f s\n", elapsed(start));
+
+    // look up every key and scan all of its values
+  start = clock();
+  for (size_t i = 0; i < n; i++) {
+    sprintf(key, "key-%zu", i);
+    if (compact) {
+      csshtVals vals = csshtGetVals(cssht, key);
+      for (size_t j = 0; j < vals.size; j++)
+        bytes += strlen(csshtValAt(vals, j));
+    } else {
+      dll *vals = sshtGetVals(ssht, key);
+      for (char *v = dllFirst(vals); v; v = dllNext(vals))
+        bytes += strlen(v);
+    }
+  }
+  printf("  lookup + scan..: %.3f s (%zu value bytes)\n",
+         elapsed(start), bytes);
+  printf("  peak memory....: %.1f MiB\n", peakMiB());
+
+  if (compact)
+    csshtFree(cssht);
+  else
+    sshtFree(ssht);
+  return 0;
+}
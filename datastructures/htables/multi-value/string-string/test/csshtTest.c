@@ -0,0 +1,175 @@
+/* 
+  Some tests for the compact string-string hash table
+  Author: David De Potter
+*/
+
+#include "../csshtable.h" // use the compact string-string hash table
+
+int main (){
+  
+  csshtable *ht = csshtNew(CASE_INSENSITIVE, 40);
+  
+    // the compact table always copies the keys and values
+    // into its arena: whatever the number of keys, the
+    // table only makes a handful of allocations
+
+  csshtAddKeyVal(ht, "one", "uno");
+  csshtAddKeyVal(ht, "two", "due");
+    // adds a second value to the key "two"
+  csshtAddKeyVal(ht, "two", "deux");   
+  csshtAddKeyVal(ht, "three", "tre");
+  csshtAddKeyVal(ht, "four", "quattro");
+  csshtAddKeyVal(ht, "five", "cinque");
+  csshtAddKeyVal(ht, "six", "sei");
+  csshtAddKeyVal(ht, "seven", "sette");
+  csshtAddKeyVal(ht, "eight", "otto");
+  csshtAddKeyVal(ht, "nine", "nove");
+  csshtAddKeyVal(ht, "ten", "dieci");
+    // adds two more values to the key "one"
+  csshtAddKeyVal(ht, "one", "ein");
+  csshtAddKeyVal(ht, "one", "un");
+  csshtAddKey(ht, "eleven");
+  
+  csshtShow(ht);
+
+    // tries to add the same value to the key "one"
+    // nothing happens because the value is already there
+  csshtAddKeyVal(ht, "one", "uno");
+
+    // tries to add the same key with case differences;
+    // if the hash table is case sensitive,
+    // a new key is added, otherwise the
+    // value is added to the existing key
+  csshtAddKeyVal(ht, "Five", "fünf");
+
+    // tries to add the same value with case differences;
+    // if the hash table is case sensitive,
+    // a new value is added, otherwise nothing
+  csshtAddKeyVal(ht, "Five", "Fünf");
+
+    // deletes some keys
+  csshtDelKey(ht, "three");
+  csshtDelKey(ht, "four");
+  csshtDelKey(ht, "five");
+
+    // removes values from the key "two"
+  csshtDelVal(ht, "two", "due");
+    // after the following statement, the key "two" 
+    // has no more values
+  csshtDelVal(ht, "two", "deux");
+
+    // tries to remove a value from a 
+    // key without values; nothing happens
+  csshtDelVal(ht, "two", "deux");
+
+    // tries to remove a non-existing value from an 
+    // existing key
+    // nothing happens because the value is not there
+  csshtDelVal(ht, "nine", "tre");
+
+  printf("\nAfter adding and removing some keys and values:\n\n");
+  csshtShow(ht);
+  csshtStats(ht);
+
+    // add more keys to trigger the rehashing;
+    // a table starts with 32 buckets at minimum
+    // and rehashes at 75% load factor
+  csshtAddKeyVal(ht, "eleven", "undici");
+  csshtAddKeyVal(ht, "twelve", "dodici");
+  csshtAddKeyVal(ht, "thirteen", "tredici");
+  csshtAddKeyVal(ht, "fourteen", "quattordici");
+  csshtAddKeyVal(ht, "fifteen", "quindici");
+  csshtAddKeyVal(ht, "sixteen", "sedici");
+  csshtAddKeyVal(ht, "seventeen", "diciassette");
+  csshtAddKeyVal(ht, "eighteen", "diciotto");
+  csshtAddKeyVal(ht, "nineteen", "diciannove");
+  csshtAddKeyVal(ht, "twenty", "venti");
+  csshtAddKeyVal(ht, "twenty-one", "ventuno");
+  csshtAddKeyVal(ht, "twenty-two", "ventidue");
+  csshtAddKeyVal(ht, "twenty-three", "ventitre");
+  csshtAddKeyVal(ht, "twenty-four", "ventiquattro");
+  csshtAddKeyVal(ht, "twenty-five", "venticinque");
+  csshtAddKeyVal(ht, "twenty-six", "ventisei");
+  csshtAddKeyVal(ht, "twenty-seven", "ventisette");
+  csshtAddKeyVal(ht, "twenty-eight", "ventotto");
+  csshtAddKeyVal(ht, "twenty-nine", "ventinove");
+  csshtAddKeyVal(ht, "thirty", "trenta");
+  csshtAddKeyVal(ht, "thirty-one", "trentuno");
+  csshtAddKeyVal(ht, "thirty-two", "trentadue");
+  csshtAddKeyVal(ht, "thirty-three", "trentatre");
+  csshtAddKeyVal(ht, "thirty-four", "trentaquattro");
+  csshtAddKeyVal(ht, "thirty-five", "trentacinque");
+  csshtAddKeyVal(ht, "thirty-six", "trentasei");
+  csshtAddKeyVal(ht, "thirty-seven", "trentasette");
+  csshtAddKeyVals(ht, "thirty-eight", 
+    (char *[]){"trentotto", "trente-huit", "achtunddreißig"}, 3);
+  csshtAddKeyVals(ht, "thirty-nine", 
+    (char *[]){"trentanove", "trente-neuf", "neununddreißig"}, 3);
+  csshtAddKeyVals(ht, "forty", 
+    (char *[]){"quaranta", "quarante", "vierzig"}, 3);
+    
+    // results in a different order of the keys
+    // because of the rehashing
+  printf("\nAfter rehashing:\n\n");
+  csshtShow(ht);
+  csshtStats(ht);
+
+    // make a second hash table
+  csshtable *ht2 = csshtNew(CASE_INSENSITIVE, 10);
+  csshtAddKeyVal(ht2, "fifty", "cinquanta");
+  csshtAddKeyVal(ht2, "fifty", "cincuenta");
+  csshtAddKeyVal(ht2, "sixty", "sessanta");
+  csshtAddKeyVal(ht2, "seventy", "settanta");
+  csshtAddKeyVal(ht2, "eighty", "ottanta");
+  csshtAddKeyVal(ht2, "ninety", "novanta");
+  csshtAddKeyVal(ht2, "hundred", "cento");
+  csshtAddKeyVal(ht2, "thousand", "mille");
+  csshtAddKeyVal(ht2, "million", "milione");
+
+    // add some identical keys from the first hash table
+  csshtAddKeyVal(ht2, "twenty", "venti");
+  csshtAddKeyVal(ht2, "one", "uno");
+
+    // identical keys with different values
+  csshtAddKeyVal(ht2, "twenty", "veinte");
+  csshtAddKeyVal(ht2, "two", "dos");
+
+  printf("\nA second hash table:\n\n");
+
+  csshtShow(ht2);
+
+    // merge the second hash table into the first
+  csshtable *ht3 = csshtMerge(ht, ht2);
+
+  printf("\nMerged hash table:\n\n");
+  csshtShow(ht3);
+  csshtStats(ht3);
+
+    // free the hash tables
+  csshtFree(ht3);
+
+    // keys and values that point into the table itself, here
+    // the suffixes of a stored value, must still be read
+    // correctly when adding them rebuilds the table
+  csshtable *ht4 = csshtNew(CASE_SENSITIVE, 4);
+  char *alpha = "abcdefghijklmnopqrstuvwxyz";
+  csshtAddKeyVal(ht4, "alphabet", alpha);
+  bool ok = true;
+  for (size_t i = 1; i < 26; i++) {
+    char *val = (char *)csshtValAt(csshtGetVals(ht4, "alphabet"), 0);
+    char *vals[] = {val + i - 1, val};
+    if (i % 2)
+      csshtAddKeyVal(ht4, val + i, val + i - 1);
+    else
+      csshtAddKeyVals(ht4, val + i, vals, 2);
+    if (! csshtHasKeyVal(ht4, alpha + i, alpha + i - 1) ||
+        (i % 2 == 0 && ! csshtHasKeyVal(ht4, alpha + i, alpha)))
+      ok = false;
+  }
+  printf("\nKeys and values taken from the table: %s\n",
+         ok && csshtSize(ht4) == 26 ? "correct" : "WRONG");
+  csshtFree(ht4);
+
+  return 0;
+}
+
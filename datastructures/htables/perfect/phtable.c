@@ -0,0 +1,327 @@
+/*
+  Static perfect hash table (CLRS 11.5), using two-level hashing
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <time.h>
+#include "phtable.h"
+#include "../../../lib/clib.h"
+
+#define MAX_ATTEMPTS 64       // first level seeds to try
+#define MAX_SEC_ATTEMPTS 1024 // secondary seeds to try per bucket
+
+//===================================================================
+// Mixes the bits of the key hash with the seed of a bucket
+// (finalizer of splitmix64), so that the secondary slot
+// can be derived without hashing the key a second time
+static inline uint64_t mix(uint64_t h, uint64_t seed) {
+  h ^= seed;
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+//===================================================================
+// Hashes the key with the first level seed; the result is mixed,
+// since hash functions like FNV-1a spread the last bytes of the
+// key only over the low bits, and the mixing is a bijection, so
+// distinct hashes stay distinct
+static inline uint64_t phtHashKey(phtable *P, void *key) {
+  return mix(P->hash(key, P->seed), P->seed);
+}
+
+//===================================================================
+// Maps the high 32 bits of a hash to the range [0, n)
+// using a multiplication instead of a modulo
+static inline uint32_t reduce(uint64_t h, uint32_t n) {
+  return (uint32_t)(((h >> 32) * (uint64_t)n) >> 32);
+}
+
+//===================================================================
+// Returns the bucket of a key hash
+static inline phtBucket *getBucket(phtable *P, uint64_t h) {
+  return P->buckets + reduce(h, (uint32_t)P->nKeys);
+}
+
+//===================================================================
+// Returns the slot of a key hash within its bucket
+static inline uint32_t getSlot(phtBucket *b, uint64_t h) {
+  return b->offset + reduce(mix(h, b->seed), b->size);
+}
+
+//===================================================================
+// Tries to find a seed for the secondary table of the bucket
+// holding the keys idx[0..n-1] with hashes h; the slots
+// are marked with the index + 1 of the key in occ
+// returns 1 if successful, 0 if two keys have the same
+// hash, and -1 if two keys are equal
+static int placeBucket(phtable *P, phtBucket *b, void **keys,
+                       uint64_t *h, size_t *idx, size_t n,
+                       uint32_t *occ) {
+
+  for (uint64_t seed = 0; seed < MAX_SEC_ATTEMPTS; seed++) {
+    b->seed = seed;
+    size_t i;
+    for (i = 0; i < n; i++) {
+      uint32_t s = getSlot(b, h[idx[i]]);
+      if (! occ[s]) {
+        occ[s] = idx[i] + 1;
+        continue;
+      }
+        // two keys with the same hash can not be separated
+        // by any secondary seed
+      size_t other = occ[s] - 1;
+      if (h[other] == h[idx[i]])
+        return P->cmpKey(keys[other], keys[idx[i]]) == 0 ? -1 : 0;
+      break;
+    }
+    if (i == n)
+      return 1;
+      // clear the slots for the next attempt
+    for (size_t j = 0; j < i; j++)
+      occ[getSlot(b, h[idx[j]])] = 0;
+  }
+  return 0;
+}
+
+//===================================================================
+// Tries to build the table with the given first level seed;
+// returns 1 if successful, 0 if another seed should be tried,
+// and -1 if there are duplicate keys
+static int phtTryBuild(phtable *P, void **keys, void **values,
+                       uint64_t *h, size_t *idx, uint32_t *occ) {
+  size_t n = P->nKeys;
+  for (size_t i = 0; i < n; i++)
+    h[i] = phtHashKey(P, keys[i]);
+
+    // count the keys per bucket and the number of slots
+  memset(P->buckets, 0, n * sizeof(phtBucket));
+  for (size_t i = 0; i < n; i++)
+    getBucket(P, h[i])->size++;
+  size_t nSlots = 0;
+  for (size_t j = 0; j < n; j++) {
+    P->buckets[j].offset = nSlots;
+    nSlots += P->buckets[j].size * P->buckets[j].size;
+  }
+  if (nSlots > 4 * n)
+    return 0;
+
+    // sort the key indices by bucket; the size field is
+    // temporarily used as the fill count of the bucket
+  size_t *start = safeCalloc(n + 1, sizeof(size_t));
+  for (size_t j = 0; j < n; j++)
+    start[j + 1] = start[j] + P->buckets[j].size;
+  for (size_t i = 0; i < n; i++) {
+    phtBucket *b = getBucket(P, h[i]);
+    idx[start[b - P->buckets] + --b->size] = i;
+  }
+
+  P->nSlots = nSlots;
+  memset(occ, 0, (nSlots ? nSlots : 1) * sizeof(uint32_t));
+  int result = 1;
+  for (size_t j = 0; j < n && result == 1; j++) {
+    phtBucket *b = P->buckets + j;
+    size_t nj = start[j + 1] - start[j];
+    b->size = nj * nj;
+    if (nj)
+      result = placeBucket(P, b, keys, h, idx + start[j], nj, occ);
+  }
+  free(start);
+  if (result != 1)
+    return result;
+
+    // move the keys and values into their slots
+  P->slots = safeCalloc(nSlots ? nSlots : 1, sizeof(phtEntry));
+  for (size_t s = 0; s < nSlots; s++) {
+    if (! occ[s])
+      continue;
+    P->slots[s].key = keys[occ[s] - 1];
+    P->slots[s].value = values ? values[occ[s] - 1] : NULL;
+  }
+  return 1;
+}
+
+//===================================================================
+// Builds a perfect hash table from n distinct keys and their values
+phtable *phtNew(phtHash hash, phtCmpKey cmpKey, void **keys,
+                void **values, size_t n) {
+  if (n > UINT32_MAX / 4) {
+    fprintf(stderr, "phtNew: too many keys\n");
+    return NULL;
+  }
+  phtable *P = safeCalloc(1, sizeof(phtable));
+  P->hash = hash;
+  P->cmpKey = cmpKey;
+  P->nKeys = n;
+  P->label = "perfect hash table";
+  P->seed = rand();
+  P->seed ^= (uint64_t)time(NULL) << 16;
+  if (n == 0)
+    return P;
+
+  P->buckets = safeCalloc(n, sizeof(phtBucket));
+  uint64_t *h = safeCalloc(n, sizeof(uint64_t));
+  size_t *idx = safeCalloc(n, sizeof(size_t));
+  uint32_t *occ = safeCalloc(4 * n, sizeof(uint32_t));
+
+  int result = phtTryBuild(P, keys, values, h, idx, occ);
+  for (size_t i = 1; i < MAX_ATTEMPTS && result == 0; i++) {
+      // try the next seed of a linear congruential sequence
+    P->seed = P->seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    result = phtTryBuild(P, keys, values, h, idx, occ);
+  }
+  free(h);
+  free(idx);
+  free(occ);
+
+  if (result != 1) {
+    fprintf(stderr, result ? "phtNew: duplicate keys\n" :
+                    "phtNew: no perfect hash function found\n");
+    phtFree(P);
+    return NULL;
+  }
+  return P;
+}
+
+//===================================================================
+// Deallocates the table, but not the keys and values
+void phtFree(phtable *P) {
+  if (! P) return;
+  free(P->buckets);
+  free(P->slots);
+  free(P);
+}
+
+//===================================================================
+// Sets the label for the table
+void phtSetLabel(phtable *P, char *label) {
+  P->label = label;
+}
+
+//===================================================================
+// Collects the entries of the buckets of a chained table into
+// arrays of keys and values and builds the frozen table; the
+// entries of htable and map both start with a key and a value
+static phtable *phtFromBuckets(phtHash hash, phtCmpKey cmpKey,
+                               dll **buckets, size_t capacity,
+                               size_t nKeys, char *label) {
+  void **keys = safeCalloc(nKeys ? nKeys : 1, sizeof(void *));
+  void **values = safeCalloc(nKeys ? nKeys : 1, sizeof(void *));
+  size_t n = 0;
+  for (size_t i = 0; i < capacity; i++) {
+    if (! buckets[i])
+      continue;
+    for (mapEntry *e = dllFirst(buckets[i]); e;
+         e = dllNext(buckets[i])) {
+      keys[n] = e->key;
+      values[n++] = e->value;
+    }
+  }
+  phtable *P = phtNew(hash, cmpKey, keys, values, n);
+  if (P)
+    P->label = label;
+  free(keys);
+  free(values);
+  return P;
+}
+
+//===================================================================
+// Freezes a hash table
+phtable *phtFromHtable(htable *H) {
+  return phtFromBuckets(H->hash, H->cmpKey, H->buckets,
+                        H->capacity, H->nKeys, H->label);
+}
+
+//===================================================================
+// Freezes a map
+phtable *phtFromMap(map *M) {
+  return phtFromBuckets(M->hash, M->cmpKey, M->buckets,
+                        M->capacity, M->nKeys, M->label);
+}
+
+//===================================================================
+// Freezes a string - size_t map, which is a specialized map
+phtable *phtFromSstMap(struct sstMap *M) {
+  return phtFromMap((map *)M);
+}
+
+//===================================================================
+// Returns the entry of the slot the key maps to if it holds
+// the key; returns NULL otherwise
+static inline phtEntry *phtFind(phtable *P, void *key) {
+  if (! P->nKeys)
+    return NULL;
+  uint64_t h = phtHashKey(P, key);
+  phtBucket *b = getBucket(P, h);
+  if (! b->size)
+    return NULL;
+  phtEntry *e = P->slots + getSlot(b, h);
+  if (! e->key || P->cmpKey(e->key, key) != 0)
+    return NULL;
+  return e;
+}
+
+//===================================================================
+// Returns true if the key exists and sets the
+// value pointer to the value associated with the key
+bool phtHasKeyVal(phtable *P, void *key, void **value) {
+  phtEntry *e = phtFind(P, key);
+  if (! e)
+    return false;
+  *value = e->value;
+  return true;
+}
+
+//===================================================================
+// Returns true if the key exists
+bool phtHasKey(phtable *P, void *key) {
+  return phtFind(P, key) != NULL;
+}
+
+//===================================================================
+// Returns the stored key equal to the given key
+void *phtGetKey(phtable *P, void *key) {
+  phtEntry *e = phtFind(P, key);
+  return e ? e->key : NULL;
+}
+
+//===================================================================
+// Returns the value associated with the key
+void *phtGetVal(phtable *P, void *key) {
+  phtEntry *e = phtFind(P, key);
+  return e ? e->value : NULL;
+}
+
+//===================================================================
+// Returns the number of bytes used by the table
+size_t phtMemory(phtable *P) {
+  return sizeof(phtable) + P->nKeys * sizeof(phtBucket) +
+         P->nSlots * sizeof(phtEntry);
+}
+
+//===================================================================
+// Shows the number of slots and the memory use
+void phtStats(phtable *P) {
+  size_t maxBucket = 0;
+  for (size_t j = 0; j < P->nKeys; j++)
+    if (P->buckets[j].size > maxBucket)
+      maxBucket = P->buckets[j].size;
+
+  printf("\n+--------------------------------+\n"
+         "| Perfect hash table statistics  |\n"
+         "+--------------------------------+\n\n"
+         "   Label..............: %s\n"
+         "   Number of keys.....: %zu\n"
+         "   Number of buckets..: %zu\n"
+         "   Number of slots....: %zu\n"
+         "   Slots per key......: %.2f\n"
+         "   Largest bucket.....: %zu slots\n"
+         "   Memory.............: %zu bytes\n\n\n",
+         P->label, P->nKeys, P->nKeys, P->nSlots,
+         P->nKeys ? (double)P->nSlots / P->nKeys : 0,
+         maxBucket, phtMemory(P));
+}
+
+#undef MAX_ATTEMPTS
+#undef MAX_SEC_ATTEMPTS
@@ -0,0 +1,117 @@
+/*
+  Static perfect hash table (CLRS 11.5), using two-level hashing
+  The table is built once from a fixed set of keys, typically
+    by freezing an htable, map or sstMap that will no longer
+    change, and is read-only afterwards.
+  The first level hashes the n keys into n buckets; a bucket
+    holding n_j keys gets a secondary table of n_j² slots with
+    its own seed, chosen such that there are no collisions.
+    The first level seed is chosen such that the total number
+    of slots stays below 4n. A lookup therefore computes one
+    hash of the key, reads one bucket and one slot, and does
+    at most one key comparison, no matter how the keys are
+    distributed.
+  The frozen table does not copy nor own the keys and values:
+    it refers to those of the source table, which must stay
+    alive for as long as the frozen table is used.
+  The hash function takes a seed, like the hash functions of
+    the htable and the map, and should give independent
+    hashes for different seeds.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef PHTABLE_H_INCLUDED
+#define PHTABLE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>   // uint64_t
+#include "../multi-value/htable.h"
+#include "../single-value/map.h"
+
+struct sstMap;
+
+  // function pointer types
+typedef uint64_t (*phtHash)(void *hashKey, uint64_t seed);
+typedef int (*phtCmpKey)(void const *key1, void const *key2);
+
+typedef struct {          // key-value pair
+  void *key;              // key, NULL if the slot is empty
+  void *value;            // value
+} phtEntry;
+
+typedef struct {          // first level bucket
+  uint64_t seed;          // seed of the secondary hash
+  uint32_t offset;        // index of the first slot
+  uint32_t size;          // number of slots (n_j²)
+} phtBucket;
+
+  // perfect hash table structure
+typedef struct {
+  size_t nKeys;           // number of keys
+  size_t nSlots;          // total number of slots
+  phtBucket *buckets;     // first level: nKeys buckets
+  phtEntry *slots;        // second level slots of all buckets
+  phtHash hash;           // hash function
+  phtCmpKey cmpKey;       // comparison function for the keys
+  uint64_t seed;          // seed of the first level hash
+  char *label;            // label for the table
+} phtable;
+
+  // builds a perfect hash table from n distinct keys
+  // and their values; returns NULL if there are
+  // duplicate keys
+phtable *phtNew(phtHash hash, phtCmpKey cmpKey, void **keys,
+                void **values, size_t n);
+
+  // freezes a hash table; the values of the frozen
+  // table are the value lists (dll *) of the keys
+phtable *phtFromHtable(htable *H);
+
+  // freezes a map
+phtable *phtFromMap(map *M);
+
+  // freezes a string - size_t map; the values of
+  // the frozen table point to the size_t values
+phtable *phtFromSstMap(struct sstMap *M);
+
+  // deallocates the table, but not the keys and values
+void phtFree(phtable *P);
+
+  // sets the label for the table
+  // default is "perfect hash table"
+void phtSetLabel(phtable *P, char *label);
+
+  // returns true if the key exists and sets the
+  // value pointer to the value associated with the key
+bool phtHasKeyVal(phtable *P, void *key, void **value);
+
+  // returns true if the key exists
+bool phtHasKey(phtable *P, void *key);
+
+  // returns the stored key equal to the given key
+  // returns NULL if the key is not found
+void *phtGetKey(phtable *P, void *key);
+
+  // returns the value associated with the key
+  // returns NULL if the key is not found
+void *phtGetVal(phtable *P, void *key);
+
+  // shows the number of slots and the memory use
+void phtStats(phtable *P);
+
+  // returns the number of bytes used by the table
+size_t phtMemory(phtable *P);
+
+  // returns the number of keys in the table
+static inline size_t phtSize(phtable *P) {
+  return P->nKeys;
+}
+
+  // returns true if the table is empty
+static inline bool phtIsEmpty(phtable *P) {
+  return P->nKeys == 0;
+}
+
+#endif  // PHTABLE_H_INCLUDED
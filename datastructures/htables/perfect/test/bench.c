@@ -0,0 +1,97 @@
+/*
+  Benchmark: lookups in a chained string - size_t map versus 
+  the same map frozen into a perfect hash table
+  Builds a map of n labels, freezes it, and then looks up
+  all labels in random order, followed by as many labels
+  that are not in the map, and reports the average time
+  per lookup.
+  Usage: ./bench.out [n]
+  Author: David De Potter
+*/
+
+#include <time.h>
+#include "../phtable.h"
+#include "../../single-value/string-size-t/sstMap.h"
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// Returns the elapsed time in seconds since start
+static double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// Returns an array of n labels, shuffled
+static char **newLabels(size_t n, char *prefix) {
+  char **labels = safeCalloc(n, sizeof(char *));
+  for (size_t i = 0; i < n; i++) {
+    labels[i] = safeCalloc(32, sizeof(char));
+    sprintf(labels[i], "%s%zu", prefix, i);
+  }
+  for (size_t i = n - 1; i > 0; i--) {
+    size_t j = rand() % (i + 1);
+    SWAP(labels[i], labels[j]);
+  }
+  return labels;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  srand(time(NULL));
+  char **hits = newLabels(n, "vertex-");
+  char **misses = newLabels(n, "absent-");
+  size_t sum = 0, found = 0;
+
+  printf("%zu labels\n", n);
+  clock_t start = clock();
+  sstMap *M = sstMapNew(CASE_SENSITIVE, n);
+  for (size_t i = 0; i < n; i++) 
+    sstMapAddKey(M, hits[i], i);
+  printf("  build chained map.....: %.3f s\n", elapsed(start));
+
+  start = clock();
+  phtable *P = phtFromSstMap(M);
+  printf("  freeze................: %.3f s\n", elapsed(start));
+  printf("  frozen table memory...: %.1f MiB\n", 
+         phtMemory(P) / 1048576.0);
+
+  start = clock();
+  for (size_t i = 0; i < n; i++) 
+    sum += sstMapGetVal(M, hits[i]);
+  double tMap = elapsed(start);
+  start = clock();
+  for (size_t i = 0; i < n; i++) 
+    found += sstMapHasKey(M, misses[i]);
+  double tMapMiss = elapsed(start);
+
+  start = clock();
+  for (size_t i = 0; i < n; i++) 
+    sum -= *(size_t *)phtGetVal(P, hits[i]);
+  double tPht = elapsed(start);
+  start = clock();
+  for (size_t i = 0; i < n; i++) 
+    found += phtHasKey(P, misses[i]);
+  double tPhtMiss = elapsed(start);
+
+  printf("  chained, hits.........: %.1f ns/lookup\n", tMap * 1e9 / n);
+  printf("  chained, misses.......: %.1f ns/lookup\n", 
+         tMapMiss * 1e9 / n);
+  printf("  perfect, hits.........: %.1f ns/lookup\n", tPht * 1e9 / n);
+  printf("  perfect, misses.......: %.1f ns/lookup\n", 
+         tPhtMiss * 1e9 / n);
+  printf("  checks................: %s\n", 
+         sum == 0 && found == 0 ? "ok" : "FAILED");
+
+  phtFree(P);
+  sstMapFree(M);
+  for (size_t i = 0; i < n; i++) {
+    free(hits[i]);
+    free(misses[i]);
+  }
+  free(hits);
+  free(misses);
+  return 0;
+}
@@ -0,0 +1,90 @@
+/* 
+  Some tests for the perfect hash table: a string-size_t map
+  and a hash table with multiple values per key are frozen,
+  and all lookups are checked against the source tables
+  Author: David De Potter
+*/
+
+#include "../phtable.h"
+#include "../../single-value/string-size-t/sstMap.h"
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// FNV-1a hash function for strings
+uint64_t hashStr(void *key, uint64_t seed) {
+  char *str = (char *)key;
+  uint64_t hash = 14695981039346656037ULL + seed;
+  while (*str) {
+    hash ^= (unsigned char)*str++;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+//===================================================================
+// Comparison function for strings
+int cmpStr(void const *a, void const *b) {
+  return strcmp((char *)a, (char *)b);
+}
+
+//===================================================================
+
+int main () {
+  
+  sstMap *M = sstMapNew(CASE_SENSITIVE, 40);
+  sstMapCopyKeys(M);
+  sstMapSetLabel(M, "Test map");
+  char key[20];
+
+    // add some key-value pairs
+  for (size_t i = 0; i < 1000; i++) {
+    sprintf(key, "key%zu", i);
+    sstMapAddKey(M, key, i * 3);
+  }
+
+    // freeze the map
+  phtable *P = phtFromSstMap(M);
+  printf("Froze a map with %zu keys\n", sstMapSize(M));
+  phtStats(P);
+
+    // check all keys and some keys that are not there
+  size_t errors = 0;
+  for (size_t i = 0; i < 2000; i++) {
+    sprintf(key, "key%zu", i);
+    size_t *val = phtGetVal(P, key);
+    if (i < 1000 ? ! val || *val != i * 3 : val != NULL)
+      errors++;
+  }
+  printf("Lookups in the frozen map: %zu errors\n\n", errors);
+  phtFree(P);
+  sstMapFree(M);
+
+    // a hash table with several values per key
+  htable *H = htNew(hashStr, cmpStr, cmpStr, 16);
+  htSetLabel(H, "Test table");
+  char *words[] = {"apple", "banana", "cherry", "date", 
+                   "elderberry", "fig", "grape"};
+  for (size_t i = 0; i < 7; i++) 
+    for (size_t j = 0; j <= i; j++) 
+      htAddKeyVal(H, words[i], words[j]);
+
+  P = phtFromHtable(H);
+  phtStats(P);
+  for (size_t i = 0; i < 7; i++) {
+    dll *vals = phtGetVal(P, words[i]);
+    printf("%-10s: %zu values, first is %s\n", words[i], 
+           dllSize(vals), (char *)dllFirst(vals));
+  }
+  printf("kiwi......: %s\n", phtHasKey(P, "kiwi") ? 
+         "present" : "not present");
+  phtFree(P);
+  htFree(H);
+
+    // duplicate keys are refused
+  void *dup[] = {"one", "two", "one"};
+  P = phtNew(hashStr, cmpStr, dup, NULL, 3);
+  printf("Duplicate keys %s\n\n", P ? "accepted" : "refused");
+  phtFree(P);
+
+  return 0;
+}
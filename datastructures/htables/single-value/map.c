@@ -9,6 +9,26 @@
 #include "map.h"
 #include "../../../lib/clib.h"
 
+//=================================================================
+// Returns false if the key filter is set and says
+// that the key is surely not in the map
+static inline bool filterMayContain(map *M, void *key) {
+  return ! M->filter.mayContain || 
+         M->filter.mayContain(M->filter.filter, key);
+}
+
+//=================================================================
+// Adds a key to the key filter, if set; if the filter
+// is full, it is detached since it can no longer
+// answer for all keys
+static void filterAdd(map *M, void *key) {
+  if (! M->filter.mayContain || 
+      M->filter.add(M->filter.filter, key))
+    return;
+  fprintf(stderr, "map: key filter is full and is removed\n");
+  memset(&M->filter, 0, sizeof(keyFilter));
+}
+
 //=================================================================
 // Creates a new map
 map *mapNew(mapHash hash, size_t capacity, 
@@ -79,6 +99,21 @@ void mapFree(map *M) {
   free(M);
 }
 
+//=================================================================
+// Sets a key filter as a pre-check for lookups
+void mapSetFilter(map *M, keyFilter filter) {
+  M->filter = filter;
+  if (! filter.mayContain)
+    return;
+  for (size_t i = 0; i < M->capacity; i++) {
+    if (! M->buckets[i])
+      continue;
+    for (mapEntry *e = dllFirst(M->buckets[i]); e; 
+         e = dllNext(M->buckets[i]))
+      filterAdd(M, e->key);
+  }
+}
+
 //=================================================================
 // Returns the index of the bucket for a key
 static size_t getIndex(map *M, void *key) {
@@ -88,6 +123,8 @@ static size_t getIndex(map *M, void *key) {
 //=================================================================
 // Returns true if the key exists and sets the pointer to the value
 bool mapHasKeyVal(map *M, void *key, void **value) {
+  if (! filterMayContain(M, key))
+    return false;
   size_t index = getIndex(M, key);
   dll *bucket = M->buckets[index];
   if (! bucket || dllIsEmpty(bucket))
@@ -104,7 +141,7 @@ bool mapHasKeyVal(map *M, void *key, void **value) {
 //=================================================================
 // Returns true if the key exists
 bool mapHasKey(map *M, void *key) {
-  if (!key || !M->buckets[getIndex(M, key)])
+  if (!key)
     return false;
   void *value = NULL;
   return mapHasKeyVal(M, key, &value);
@@ -113,6 +150,8 @@ bool mapHasKey(map *M, void *key) {
 //=================================================================
 // Returns the key from the table given an identifying key
 void *mapGetKey(map *M, void *key) {
+  if (! filterMayContain(M, key))
+    return NULL;
   size_t index = getIndex(M, key);
   dll *bucket = M->buckets[index];
   if (! bucket) 
@@ -187,6 +226,7 @@ static void mapAddNewkeyVal(map *M, void *key, void *value,
 
     // add the new key-value pair to the bucket
   dllPush(bucket, entry);
+  filterAdd(M, entry->key);
     // one key more
   M->nKeys++;
 }
@@ -238,6 +278,8 @@ bool mapDelKey(map *M, void *key) {
   
   for (mapEntry *e = dllFirst(bucket); e; e = dllNext(bucket)) {
     if (! M->cmpKey(key, e->key)) {
+      if (M->filter.del)
+        M->filter.del(M->filter.filter, e->key);
         // free key if a free function is provided
       if (M->freeKey) 
         M->freeKey(e->key);
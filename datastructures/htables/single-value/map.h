@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <stdint.h>   // uint64_t
 #include "../../lists/dll.h"
+#include "../../filters/keyFilter.h"
 
   // function pointer types
 typedef uint64_t (*mapHash)(void *hashKey, uint64_t seed);
@@ -41,6 +42,7 @@ typedef struct {
   mapCopyValue copyValue; // function to copy the value
   size_t nFilled;         // number of filled buckets
   char *label;            // label for the map
+  keyFilter filter;       // optional pre-check for lookups
 } map;
 
 typedef struct {          // key-value pair
@@ -80,6 +82,13 @@ void mapOwnKeys(map *M, mapFreeKey freeKey);
   // freeing them when the map is freed
 void mapOwnVals(map *M, mapFreeValue freeValue);
 
+  // sets a key filter (e.g. a Bloom or cuckoo filter)
+  // that is checked before the buckets on every lookup;
+  // the keys in the map are added to the filter;
+  // the map does not own the filter
+  // pass a filter with NULL functions to remove it
+void mapSetFilter(map *M, keyFilter filter);
+
   // dellocates the map
 void mapFree(map *M);
 
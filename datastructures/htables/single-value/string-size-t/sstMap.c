@@ -116,6 +116,12 @@ void sstMapOwnKeys(sstMap *M) {
   mapOwnKeys((map *)M, free);
 }
 
+//===================================================================
+// sets a key filter as a pre-check for lookups
+void sstMapSetFilter(sstMap *M, keyFilter filter) {
+  mapSetFilter((map *)M, filter);
+}
+
 //===================================================================
 // deallocates the map
 void sstMapFree(sstMap *M) {
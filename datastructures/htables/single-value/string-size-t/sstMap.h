@@ -27,6 +27,10 @@ void sstMapCopyKeys(sstMap *M);
 
 void sstMapOwnKeys(sstMap *M);
 
+  // sets a key filter as a pre-check for lookups;
+  // the filter should hash the keys as strings
+void sstMapSetFilter(sstMap *M, keyFilter filter);
+
 bool sstMapHasKeyVal(sstMap *M, char *key, size_t *val);
 
 bool sstMapHasKey(sstMap *M, char *key);
@@ -0,0 +1,65 @@
+/* 
+  Some tests for the uint64_t - uint64_t map
+  Author: David De Potter
+*/
+
+#include "../u64Map.h" // use the uint64_t - uint64_t map
+#include "../../../../../lib/clib.h"
+
+int main (){
+  
+  u64Map *map = u64MapNew(40);
+  u64MapSetLabel(map, "Test map");
+
+    // add some key-value pairs: the keys are 
+    // multiples of 4096, like page-aligned pointers
+  for (uint64_t i = 0; i < 100; i++) 
+    u64MapAddKey(map, i << 12, i);
+  
+  printf("\nAdded 100 keys to the map\n");
+  u64MapShow(map);
+
+    // update some values
+  for (uint64_t i = 1; i < 100; i += 20) {
+    printf("Updating value of %llu to %llu\n", 
+           (unsigned long long)(i << 12), 
+           (unsigned long long)(i * 1000));
+    u64MapAddKey(map, i << 12, i * 1000);
+  }
+
+    // delete some keys
+  for (uint64_t i = 0; i < 100; i += 10) {
+    printf("\nDeleting %llu", (unsigned long long)(i << 12));
+    u64MapDelKey(map, i << 12);
+  }
+
+    // check some keys to see if they are still there
+  printf("\n\nChecking if keys are still there...\n\n");
+  for (uint64_t i = 0; i < 100; i += 5) 
+    printf("%llu is %s", (unsigned long long)(i << 12),
+      u64MapHasKey(map, i << 12) ? "present\n" : "gone\n");
+
+    // get the values of some keys
+  printf("\nGetting values of some keys...\n");
+  for (uint64_t i = 0; i < 100; i += 13) 
+    printf("\nValue of key %llu is %llu", 
+           (unsigned long long)(i << 12),
+           (unsigned long long)u64MapGetVal(map, i << 12));
+
+  printf("\n\n");
+  u64MapShow(map);
+  u64MapStats(map);
+
+    // every key that was not deleted should still be 
+    // found after the backward shift deletions
+  size_t lost = 0;
+  for (uint64_t i = 0; i < 100; i++) {
+    uint64_t val;
+    if (i % 10 && ! u64MapHasKeyVal(map, i << 12, &val))
+      lost++;
+  }
+  printf("Keys lost after deletions: %zu\n\n", lost);
+
+  u64MapFree(map);
+  return 0;
+}
@@ -0,0 +1,231 @@
+/*
+  Specialized uint64_t - uint64_t map implementation:
+    keys and values are unsigned 64-bit integers
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "u64Map.h"
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// Fibonacci hashing: multiplies the key by 2^64 / phi and keeps the
+// high bits, so that keys differing only in their high bits, or
+// pointers with zeroed low bits, are spread over all slots
+static inline size_t u64Hash(u64Map *M, uint64_t key) {
+  return (key * 11400714819323198485ULL) >> M->shift;
+}
+
+//===================================================================
+// Allocates an empty slot array of the given capacity
+static void allocSlots(u64Map *M, size_t capacity) {
+  M->capacity = capacity;
+  M->shift = 64;
+  while (capacity >>= 1)
+    M->shift--;
+  M->slots = safeMalloc(M->capacity * sizeof(u64Entry));
+  for (size_t i = 0; i < M->capacity; i++)
+    M->slots[i].key = U64MAP_EMPTY;
+}
+
+//===================================================================
+// Creates a new map
+u64Map *u64MapNew(size_t capacity) {
+  u64Map *M = safeCalloc(1, sizeof(u64Map));
+    // keep the load factor below 70% for the expected capacity
+  size_t cap = 16;
+  while (cap * 7 < capacity * 10)
+    cap <<= 1;
+  allocSlots(M, cap);
+  M->label = "u64Map";
+  return M;
+}
+
+//===================================================================
+// Deallocates the map
+void u64MapFree(u64Map *M) {
+  if (! M) return;
+  free(M->slots);
+  free(M);
+}
+
+//===================================================================
+// Sets the label for the map
+void u64MapSetLabel(u64Map *M, char *label) {
+  M->label = label;
+}
+
+//===================================================================
+// Returns the index of the slot holding the key, or the index of
+// the empty slot where the probe sequence for the key ends
+static inline size_t probe(u64Map *M, uint64_t key) {
+  size_t mask = M->capacity - 1;
+  size_t i = u64Hash(M, key);
+  while (M->slots[i].key != key && M->slots[i].key != U64MAP_EMPTY)
+    i = (i + 1) & mask;
+  return i;
+}
+
+//===================================================================
+// Doubles the capacity of the map and reinserts all keys
+static void u64MapRehash(u64Map *M) {
+  u64Entry *old = M->slots;
+  size_t oldCap = M->capacity;
+  allocSlots(M, oldCap * 2);
+  for (size_t i = 0; i < oldCap; i++)
+    if (old[i].key != U64MAP_EMPTY)
+      M->slots[probe(M, old[i].key)] = old[i];
+  free(old);
+}
+
+//===================================================================
+// Returns true if the key exists and sets the
+// value pointer to the value associated with the key
+bool u64MapHasKeyVal(u64Map *M, uint64_t key, uint64_t *val) {
+  u64Entry *e = M->slots + probe(M, key);
+  if (e->key == U64MAP_EMPTY)
+    return false;
+  *val = e->value;
+  return true;
+}
+
+//===================================================================
+// Returns true if the key exists
+bool u64MapHasKey(u64Map *M, uint64_t key) {
+  return key != U64MAP_EMPTY &&
+         M->slots[probe(M, key)].key == key;
+}
+
+//===================================================================
+// Adds a key-value pair to the map; if the key
+// exists, the value is updated
+void u64MapAddKey(u64Map *M, uint64_t key, uint64_t val) {
+  if (key == U64MAP_EMPTY) {
+    fprintf(stderr, "u64MapAddKey: key %llu is reserved\n",
+            (unsigned long long)key);
+    return;
+  }
+  u64Entry *e = M->slots + probe(M, key);
+  if (e->key == key) {
+    e->value = val;
+    return;
+  }
+    // rehash if the load factor would exceed 70%
+  if ((M->nKeys + 1) * 10 >= M->capacity * 7) {
+    u64MapRehash(M);
+    e = M->slots + probe(M, key);
+  }
+  e->key = key;
+  e->value = val;
+  M->nKeys++;
+}
+
+//===================================================================
+// Returns the value associated with the key
+// returns 0 if the key is not found
+uint64_t u64MapGetVal(u64Map *M, uint64_t key) {
+  uint64_t val = 0;
+  u64MapHasKeyVal(M, key, &val);
+  return val;
+}
+
+//===================================================================
+// Removes the key and its value; instead of leaving a tombstone,
+// the following entries of the cluster are shifted back into the
+// gap when their probe sequence allows it (Knuth, TAOCP 6.4 R)
+bool u64MapDelKey(u64Map *M, uint64_t key) {
+  if (key == U64MAP_EMPTY)
+    return false;
+  size_t mask = M->capacity - 1;
+  size_t i = probe(M, key);
+  if (M->slots[i].key != key)
+    return false;
+
+  for (size_t j = (i + 1) & mask;
+       M->slots[j].key != U64MAP_EMPTY; j = (j + 1) & mask) {
+    size_t home = u64Hash(M, M->slots[j].key);
+      // move the entry at j to the gap at i if its home
+      // slot does not lie cyclically in (i, j]
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      M->slots[i] = M->slots[j];
+      i = j;
+    }
+  }
+  M->slots[i].key = U64MAP_EMPTY;
+  M->nKeys--;
+  return true;
+}
+
+//===================================================================
+// Removes all keys from the map
+void u64MapClear(u64Map *M) {
+  for (size_t i = 0; i < M->capacity; i++)
+    M->slots[i].key = U64MAP_EMPTY;
+  M->nKeys = 0;
+}
+
+//===================================================================
+// Returns the entry in the first used slot from the iterator on
+static u64Entry *iterEntry(u64Map *M) {
+  while (M->iter < M->capacity) {
+    u64Entry *e = M->slots + M->iter++;
+    if (e->key != U64MAP_EMPTY)
+      return e;
+  }
+  return NULL;
+}
+
+//===================================================================
+// Returns the first key-value pair and resets the iterator
+u64Entry *u64MapFirst(u64Map *M) {
+  M->iter = 0;
+  return iterEntry(M);
+}
+
+//===================================================================
+// Returns the next key-value pair
+u64Entry *u64MapNext(u64Map *M) {
+  return iterEntry(M);
+}
+
+//===================================================================
+// Shows the map
+void u64MapShow(u64Map *M) {
+  printf("\n--------------------\n"
+          "  %s [%zu]\n"
+          "--------------------\n",
+          M->label, M->nKeys);
+
+  for (u64Entry *e = u64MapFirst(M); e; e = u64MapNext(M))
+    printf("  %llu: %llu\n", (unsigned long long)e->key,
+           (unsigned long long)e->value);
+
+  printf("--------------------\n\n");
+}
+
+//===================================================================
+// Gives an overview of the probe lengths
+void u64MapStats(u64Map *M) {
+  size_t maxProbe = 0, totalProbe = 0;
+  size_t mask = M->capacity - 1;
+  for (size_t i = 0; i < M->capacity; i++) {
+    if (M->slots[i].key == U64MAP_EMPTY)
+      continue;
+    size_t len = ((i - u64Hash(M, M->slots[i].key)) & mask) + 1;
+    totalProbe += len;
+    if (len > maxProbe)
+      maxProbe = len;
+  }
+
+  printf("\n+---------------------------+\n"
+         "|      Map statistics       |\n"
+         "+---------------------------+\n\n"
+         "   Number of slots....: %zu\n"
+         "   Number of keys.....: %zu\n"
+         "   Load factor........: %.2f\n"
+         "   Max. probe length..: %zu\n"
+         "   Avg. probe length..: %.2f\n\n\n",
+         M->capacity, M->nKeys,
+         (double)M->nKeys / M->capacity, maxProbe,
+         M->nKeys ? (double)totalProbe / M->nKeys : 0);
+}
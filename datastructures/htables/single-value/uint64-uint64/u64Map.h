@@ -0,0 +1,93 @@
+/* 
+  Specialized uint64_t - uint64_t map implementation:
+    keys and values are unsigned 64-bit integers, such as
+    pointers or ids mapped to array indices.
+    Uses open addressing with linear probing on a flat 
+    array of key-value pairs, so that no callbacks, string 
+    conversions or allocations are needed per operation.
+    The key U64MAP_EMPTY (UINT64_MAX) marks empty slots 
+    and cannot be used as a key.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef U64MAP_H_INCLUDED
+#define U64MAP_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#define U64MAP_EMPTY UINT64_MAX
+
+typedef struct {          // key-value pair
+  uint64_t key;           // key
+  uint64_t value;         // value
+} u64Entry;
+
+typedef struct {
+  u64Entry *slots;        // array of key-value pairs
+  size_t capacity;        // number of slots, a power of 2
+  size_t nKeys;           // number of keys
+  unsigned shift;         // 64 - log2(capacity)
+  size_t iter;            // current slot for the iterator
+  char *label;            // label for the map
+} u64Map;
+
+  // creates a new map
+u64Map *u64MapNew(size_t capacity);
+
+  // deallocates the map
+void u64MapFree(u64Map *M);
+
+  // sets the label for the map
+void u64MapSetLabel(u64Map *M, char *label);
+
+  // returns true if the key exists and sets the
+  // value pointer to the value associated with the key
+bool u64MapHasKeyVal(u64Map *M, uint64_t key, uint64_t *val);
+
+  // returns true if the key exists
+bool u64MapHasKey(u64Map *M, uint64_t key);
+
+  // adds a key-value pair to the map; if the key
+  // exists, the value is updated
+void u64MapAddKey(u64Map *M, uint64_t key, uint64_t val);
+
+  // returns the value associated with the key
+  // returns 0 if the key is not found
+uint64_t u64MapGetVal(u64Map *M, uint64_t key);
+
+  // removes the key and its value
+  // true if the key was removed
+  // false if the key was not found
+bool u64MapDelKey(u64Map *M, uint64_t key);
+
+  // removes all keys from the map
+void u64MapClear(u64Map *M);
+
+  // shows the map
+void u64MapShow(u64Map *M);
+
+  // shows distribution statistics
+void u64MapStats(u64Map *M);
+
+  // returns the first key-value pair in the map and
+  // resets the iterator; NULL if the map is empty
+u64Entry *u64MapFirst(u64Map *M);
+
+  // returns the next key-value pair in the map;
+  // NULL if the end of the map is reached
+u64Entry *u64MapNext(u64Map *M);
+
+  // returns the number of keys in the map
+static inline size_t u64MapSize(u64Map *M) {
+  return M->nKeys;
+}
+
+  // returns true if the map is empty
+static inline bool u64MapIsEmpty(u64Map *M) {
+  return M->nKeys == 0;
+}
+
+#endif  // U64MAP_H_INCLUDED
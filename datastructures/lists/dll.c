@@ -134,10 +134,10 @@ void dllFree (dll *L) {
 }
 
 //=================================================================
-// Prepends a node to the DLL 
-void dllPush (dll *L, void *data) {
+// Prepends a node to the DLL and returns it
+dllNode *dllPushNode (dll *L, void *data) {
   if (! L) 
-    return;
+    return NULL;
     // create a new first node
   dllNode *n = dllNewNode();
     // current first node becomes the second node
@@ -152,6 +152,46 @@ void dllPush (dll *L, void *data) {
     n->dllData = L->copyData(data);
   else
     n->dllData = data;
+  return n;
+}
+
+//=================================================================
+// Prepends a node to the DLL 
+void dllPush (dll *L, void *data) {
+  dllPushNode(L, data);
+}
+
+//=================================================================
+// Moves a node of the DLL to the front
+void dllMoveToFront (dll *L, dllNode *node) {
+  if (! L || node == L->NIL || node == L->NIL->next) 
+    return;
+  if (L->iter == node)
+    L->iter = node->next;
+    // unlink the node
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+    // relink it as the first node
+  node->next = L->NIL->next;
+  L->NIL->next->prev = node;
+  L->NIL->next = node;
+  node->prev = L->NIL;
+}
+
+//=================================================================
+// Removes a node from the DLL and returns its data
+void *dllRemoveNode (dll *L, dllNode *node) {
+  if (! L || node == L->NIL) 
+    return NULL;
+  if (L->iter == node)
+    L->iter = node->next;
+  void *data = node->dllData;
+    // free the node, NOT the data
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+  free(node);
+  L->size--;
+  return data;
 }
 
 //=================================================================
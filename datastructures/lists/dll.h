@@ -80,6 +80,18 @@ dllNode *dllNewNode();
   // Pushes data to the front of the DLL
 void dllPush(dll *L, void *data);
 
+  // Pushes data to the front of the DLL and returns
+  // the new node, which can be used as a handle for
+  // dllMoveToFront and dllRemoveNode
+dllNode *dllPushNode(dll *L, void *data);
+
+  // Moves a node of the DLL to the front in O(1)
+void dllMoveToFront(dll *L, dllNode *node);
+
+  // Removes a node from the DLL in O(1) and returns
+  // its data; the data is NOT freed
+void *dllRemoveNode(dll *L, dllNode *node);
+
   // Inserts data in a sorted DLL
 void dllInsert(dll *L, void *data);
 
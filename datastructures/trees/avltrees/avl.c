@@ -0,0 +1,560 @@
+/*
+  Generic AVL tree implementation
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "avl.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// Creates a new node with given data
+static avlnode *avlNewNode (avltree *T, void *data) {
+  avlnode *n = safeCalloc(1, sizeof(avlnode));
+  if (T->copy)
+    n->data = T->copy(data);
+  else
+    n->data = data;
+  n->height = 1;
+  n->parent = n->left = n->right = T->NIL;
+  return n;
+}
+
+//===================================================================
+// Creates a new AVL tree
+avltree *avlNew (avlCmpData cmp) {
+  avltree *T = safeCalloc(1, sizeof(avltree));
+  T->cmp = cmp;
+  T->NIL = avlNewNode(T, NULL);
+  T->NIL->height = 0;
+  T->NIL->parent = T->NIL->left = T->NIL->right = T->NIL;
+  T->ROOT = T->NIL;
+  return T;
+}
+
+//===================================================================
+// Makes the tree make copies of the data
+void avlCopyData (avltree *T, avlCpyData copy, avlFreeData free) {
+  T->copy = copy;
+  T->free = free;
+}
+
+//===================================================================
+// Sets the tree to own the data
+void avlOwnData (avltree *T, avlFreeData free) {
+  T->free = free;
+}
+
+//===================================================================
+// Sets the show function for the tree
+void avlSetShow (avltree *T, avlShowData show) {
+  T->show = show;
+}
+
+//===================================================================
+// Deallocates memory for a node
+static void avlFreeNode (avltree *T, avlnode *n) {
+  if (T->free)
+    T->free(n->data);
+  free(n);
+}
+
+//===================================================================
+// Deallocates memory for all nodes in a subtree rooted at x
+static void avlFreeNodes (avltree *T, avlnode *x) {
+  if (x != T->NIL) {
+    avlFreeNodes(T, x->left);
+    avlFreeNodes(T, x->right);
+    avlFreeNode(T, x);
+  }
+}
+
+//===================================================================
+// Deallocates the AVL tree
+void avlFree (avltree *T) {
+  if (T) {
+    avlFreeNodes(T, T->ROOT);
+    free(T->NIL);
+    free(T);
+  }
+}
+
+//===================================================================
+// Returns true if the tree is empty
+bool avlIsEmpty (avltree *T) {
+  return T->ROOT == T->NIL;
+}
+
+//===================================================================
+// Returns the node with the smallest key in the subtree rooted at x
+avlnode *avlMinimum (avltree *T, avlnode *x) {
+  while (x->left != T->NIL)
+    x = x->left;
+  return x;
+}
+
+//===================================================================
+// Returns the node with the largest key in the subtree rooted at x
+avlnode *avlMaximum (avltree *T, avlnode *x) {
+  while (x->right != T->NIL)
+    x = x->right;
+  return x;
+}
+
+//===================================================================
+// Returns the successor of a node
+avlnode *avlSuccessor (avltree *T, avlnode *x) {
+  if (x->right != T->NIL)
+    return avlMinimum(T, x->right);
+  avlnode *y = x->parent;
+  while (y != T->NIL && x == y->right) {
+    x = y;
+    y = y->parent;
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the predecessor of a node
+avlnode *avlPredecessor (avltree *T, avlnode *x) {
+  if (x->left != T->NIL)
+    return avlMaximum(T, x->left);
+  avlnode *y = x->parent;
+  while (y != T->NIL && x == y->left) {
+    x = y;
+    y = y->parent;
+  }
+  return y;
+}
+
+//===================================================================
+// Searches for a key in the AVL tree
+avlnode *avlSearch (avltree *T, void *key) {
+  avlnode *x = T->ROOT;
+  while (x != T->NIL) {
+    int c = T->cmp(key, x->data);
+    if (c == 0)
+      return x;
+    x = c < 0 ? x->left : x->right;
+  }
+  return NULL;
+}
+
+//===================================================================
+// Returns the first node with a key not less than key
+avlnode *avlLowerBound (avltree *T, void *key) {
+  avlnode *x = T->ROOT, *y = T->NIL;
+  while (x != T->NIL) {
+    if (T->cmp(x->data, key) < 0)
+      x = x->right;
+    else {
+      y = x;
+      x = x->left;
+    }
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the first node with a key greater than key
+avlnode *avlUpperBound (avltree *T, void *key) {
+  avlnode *x = T->ROOT, *y = T->NIL;
+  while (x != T->NIL) {
+    if (T->cmp(x->data, key) <= 0)
+      x = x->right;
+    else {
+      y = x;
+      x = x->left;
+    }
+  }
+  return y;
+}
+
+//===================================================================
+// Recomputes the height of node x from its children
+static inline void updateHeight (avlnode *x) {
+  x->height = MAX(x->left->height, x->right->height) + 1;
+}
+
+//===================================================================
+// Returns the balance factor of node x
+static inline int balance (avlnode *x) {
+  return x->left->height - x->right->height;
+}
+
+//===================================================================
+// Performs a left rotation on the subtree rooted at x, and
+// returns the new root of the subtree
+static avlnode *leftRotate (avltree *T, avlnode *x) {
+  avlnode *y = x->right;
+  x->right = y->left;
+  if (y->left != T->NIL)
+    y->left->parent = x;
+  y->parent = x->parent;
+  if (x->parent == T->NIL)
+    T->ROOT = y;
+  else if (x == x->parent->left)
+    x->parent->left = y;
+  else
+    x->parent->right = y;
+  y->left = x;
+  x->parent = y;
+  updateHeight(x);
+  updateHeight(y);
+  return y;
+}
+
+//===================================================================
+// Performs a right rotation on the subtree rooted at x, and
+// returns the new root of the subtree
+static avlnode *rightRotate (avltree *T, avlnode *x) {
+  avlnode *y = x->left;
+  x->left = y->right;
+  if (y->right != T->NIL)
+    y->right->parent = x;
+  y->parent = x->parent;
+  if (x->parent == T->NIL)
+    T->ROOT = y;
+  else if (x == x->parent->right)
+    x->parent->right = y;
+  else
+    x->parent->left = y;
+  y->right = x;
+  x->parent = y;
+  updateHeight(x);
+  updateHeight(y);
+  return y;
+}
+
+//===================================================================
+// Restores the AVL property at node x, whose subtrees are AVL
+// trees with heights that differ by at most 2, by a single or a
+// double rotation; returns the new root of the subtree
+static avlnode *rebalance (avltree *T, avlnode *x) {
+  updateHeight(x);
+  if (balance(x) > 1) {
+    if (balance(x->left) < 0)
+      leftRotate(T, x->left);
+    x = rightRotate(T, x);
+  } else if (balance(x) < -1) {
+    if (balance(x->right) > 0)
+      rightRotate(T, x->right);
+    x = leftRotate(T, x);
+  }
+  return x;
+}
+
+//===================================================================
+// Rebalances the nodes on the path from x up to the root, and
+// stops as soon as the height of a subtree stays the same,
+// since then nothing changes above it
+static void retrace (avltree *T, avlnode *x) {
+  while (x != T->NIL) {
+    int height = x->height;
+    x = rebalance(T, x);
+    if (x->height == height)
+      return;
+    x = x->parent;
+  }
+}
+
+//===================================================================
+// Inserts a node into the AVL tree
+void avlInsert (avltree *T, void *data) {
+  avlnode *z = avlNewNode(T, data);
+  avlnode *y = T->NIL;
+  avlnode *x = T->ROOT;
+
+  while (x != T->NIL) {
+    y = x;
+    if (T->cmp(z->data, x->data) < 0)
+      x = x->left;
+    else
+      x = x->right;
+  }
+  z->parent = y;
+  if (y == T->NIL)
+    T->ROOT = z;
+  else if (T->cmp(z->data, y->data) < 0)
+    y->left = z;
+  else
+    y->right = z;
+  retrace(T, y);
+  T->size++;
+}
+
+//===================================================================
+// Builds a perfectly balanced subtree from the sorted data
+// in [lo, hi)
+static avlnode *avlBuild (avltree *T, void **data, size_t lo,
+                          size_t hi, avlnode *parent) {
+  if (lo == hi)
+    return T->NIL;
+  size_t mid = lo + (hi - lo) / 2;
+  avlnode *x = avlNewNode(T, data[mid]);
+  x->parent = parent;
+  x->left = avlBuild(T, data, lo, mid, x);
+  x->right = avlBuild(T, data, mid + 1, hi, x);
+  updateHeight(x);
+  return x;
+}
+
+//===================================================================
+// Builds a balanced tree from n data items sorted by key
+bool avlBulkLoad (avltree *T, void **data, size_t n) {
+  if (T->ROOT != T->NIL) {
+    fprintf(stderr, "avlBulkLoad: tree is not empty\n");
+    return false;
+  }
+  for (size_t i = 1; i < n; i++)
+    if (T->cmp(data[i - 1], data[i]) > 0) {
+      fprintf(stderr, "avlBulkLoad: data is not sorted\n");
+      return false;
+    }
+  T->ROOT = avlBuild(T, data, 0, n, T->NIL);
+  T->size = n;
+  return true;
+}
+
+//===================================================================
+// Replaces the subtree rooted at u with the subtree rooted at v
+static void avlTransplant (avltree *T, avlnode *u, avlnode *v) {
+  if (u->parent == T->NIL)
+    T->ROOT = v;
+  else if (u == u->parent->left)
+    u->parent->left = v;
+  else
+    u->parent->right = v;
+  if (v != T->NIL)
+    v->parent = u->parent;
+}
+
+//===================================================================
+// Deletes a node from the AVL tree
+void avlDelete (avltree *T, avlnode *z) {
+  avlnode *p;               // lowest node whose subtree changed
+
+  if (z->left == T->NIL) {
+    p = z->parent;
+    avlTransplant(T, z, z->right);
+  } else if (z->right == T->NIL) {
+    p = z->parent;
+    avlTransplant(T, z, z->left);
+  } else {
+    avlnode *y = avlMinimum(T, z->right);
+    if (y->parent == z)
+      p = y;
+    else {
+      p = y->parent;
+      avlTransplant(T, y, y->right);
+      y->right = z->right;
+      y->right->parent = y;
+    }
+    avlTransplant(T, z, y);
+    y->left = z->left;
+    y->left->parent = y;
+    y->height = z->height;
+  }
+    // unlike after an insertion, a rotation may leave the subtree
+    // one level lower, in which case the retracing goes on
+  retrace(T, p);
+  avlFreeNode(T, z);
+  T->size--;
+}
+
+//===================================================================
+// Shows the data in the tree in order, 20 items at a time
+static void avlShowAllData (avltree *T, avlnode *x, short *count) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  char buffer[100], ch;
+  if (x != T->NIL) {
+    avlShowAllData(T, x->left, count);
+    if (*count < 20){
+      T->show(x->data);
+      *count += 1;
+    } else if (*count == 20){
+      printf("Print 20 more? (y/n): ");
+      if ((fgets (buffer, 100, stdin) &&
+      sscanf(buffer, "%c", &ch) != 1) || ch != 'y')
+        *count = 21;
+      else
+        *count = 0;
+      clearStdin(buffer);
+    }
+    avlShowAllData(T, x->right, count);
+  }
+}
+
+//===================================================================
+// Shows the data in the tree in order
+void avlShow (avltree *T, avlnode *x) {
+  short count = 0;
+  avlShowAllData(T, x, &count);
+  printf("\n");
+}
+
+//===================================================================
+// Shows the data in a node
+void avlShowNode (avltree *T, avlnode *n) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  if (n) T->show(n->data);
+}
+
+//===================================================================
+// Shows all levels of the tree structure by in-order traversal
+static void avlShowLevels (avltree *T, avlnode *x, size_t level) {
+  if (x == T->NIL) return;
+
+  avlShowLevels(T, x->left, level + 1);
+
+  if (level) {
+    for (size_t i = 0; i < level; i++)
+      printf("-");
+    if (x->parent->left == x)
+      printf("|L(%zu): ", level);
+    else
+      printf("|R(%zu): ", level);
+  } else
+    printf("ROOT: ");
+  avlShowNode(T, x);
+  printf(" [h=%d]\n", x->height);
+
+  avlShowLevels(T, x->right, level + 1);
+}
+
+//===================================================================
+// Shows the tree structure
+void avlShowTree (avltree *T, avlnode *x) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  printf("--------------\n"
+         "Tree structure\n"
+         "--------------\n");
+  avlShowLevels(T, x, 0);
+}
+
+//===================================================================
+// Writes the data in the tree in order to a file
+void avlWrite (avltree *T, avlnode *x, FILE *fp, avlWriteData write) {
+  if (x != T->NIL) {
+    avlWrite(T, x->left, fp, write);
+    write(x->data, fp);
+    avlWrite(T, x->right, fp, write);
+  }
+}
+
+//===================================================================
+// Reads data from a file with one record per line, of any length;
+// the records are collected first, so that sorted records can be
+// bulk loaded instead of inserted one by one
+avltree *avlFromFile (char *filename, size_t dataSize,
+    avlCmpData cmp, avlStrToData fromStr) {
+
+  FILE *fp = fopen(filename, "r");
+  if (fp == NULL) {
+    printf("Error: could not open file %s\n", filename);
+    exit(EXIT_FAILURE);
+  }
+    // a large stream buffer saves system calls on big files
+  setvbuf(fp, NULL, _IOFBF, 1 << 20);
+
+  string *line = newString(128);
+  size_t n = 0, cap = 1024;
+  void **data = safeCalloc(cap, sizeof(void *));
+  bool sorted = true;
+  while (readLine(fp, line)) {
+    if (n == cap) {
+      cap *= 2;
+      data = safeRealloc(data, cap * sizeof(void *));
+    }
+    data[n] = safeCalloc(1, dataSize);
+    if (! fromStr(data[n], (char *)line->data)) {
+      printf("Error: invalid input data on line %zu.\n"
+             "Check file %s for errors and try again.\n",
+              n + 1, filename);
+      for (size_t i = 0; i <= n; i++)
+        free(data[i]);
+      free(data);
+      freeString(line);
+      fclose(fp);
+      exit(EXIT_FAILURE);
+    }
+    if (n && cmp(data[n - 1], data[n]) > 0)
+      sorted = false;
+    n++;
+  }
+
+  avltree *T = avlNew(cmp);
+  if (sorted)
+    avlBulkLoad(T, data, n);
+  else
+    for (size_t i = 0; i < n; i++)
+      avlInsert(T, data[i]);
+  printf("Data successfully read from file %s\n", filename);
+  free(data);
+  freeString(line);
+  fclose(fp);
+  return T;
+}
+
+//===================================================================
+// Traverses the tree in order and adds the data to a list
+static void avlInOrderList (avltree *T, avlnode *x, dll *list) {
+  if (x != T->NIL) {
+    avlInOrderList(T, x->left, list);
+    dllPushBack(list, x->data);
+    avlInOrderList(T, x->right, list);
+  }
+}
+
+//===================================================================
+// Returns an in-order traversal list of the tree
+dll *avlInOrder (avltree *T) {
+  dll *list = dllNew();
+  avlInOrderList(T, T->ROOT, list);
+  return list;
+}
+
+//===================================================================
+// Traverses the tree in pre-order and adds the data to a list
+static void avlPreOrderList (avltree *T, avlnode *x, dll *list) {
+  if (x != T->NIL) {
+    dllPushBack(list, x->data);
+    avlPreOrderList(T, x->left, list);
+    avlPreOrderList(T, x->right, list);
+  }
+}
+
+//===================================================================
+// Returns a pre-order traversal list of the tree
+dll *avlPreOrder (avltree *T) {
+  dll *list = dllNew();
+  avlPreOrderList(T, T->ROOT, list);
+  return list;
+}
+
+//===================================================================
+// Traverses the tree in post-order and adds the data to a list
+static void avlPostOrderList (avltree *T, avlnode *x, dll *list) {
+  if (x != T->NIL) {
+    avlPostOrderList(T, x->left, list);
+    avlPostOrderList(T, x->right, list);
+    dllPushBack(list, x->data);
+  }
+}
+
+//===================================================================
+// Returns a post-order traversal list of the tree
+dll *avlPostOrder (avltree *T) {
+  dll *list = dllNew();
+  avlPostOrderList(T, T->ROOT, list);
+  return list;
+}
@@ -0,0 +1,137 @@
+/*
+  Generic AVL tree implementation
+  Each node keeps the height of its subtree, which is 1 for a
+  leaf and 0 for the sentinel NIL, so that the heights of the
+  subtrees of a node never differ by more than 1
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef AVL_H_INCLUDED
+#define AVL_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "../../lists/dll.h"
+
+// function pointer types
+typedef int (*avlCmpData)(void const *a, void const *b);
+typedef void (*avlShowData)(void const *data);
+typedef void (*avlWriteData)(void const *data, FILE *file);
+typedef bool (*avlStrToData)(void *data, char const *str);
+typedef void (*avlFreeData)(void *data);
+typedef void *(*avlCpyData)(void const *data);
+
+// data structures and types
+typedef struct avlnode {
+  void *data;                 // data stored in the node
+  int height;                 // height of the subtree
+  struct avlnode *parent;     // parent node
+  struct avlnode *left;       // left child
+  struct avlnode *right;      // right child
+} avlnode;
+
+typedef struct {
+  avlnode *ROOT, *NIL;        // root and sentinel nodes
+  avlCmpData cmp;             // comparison function
+  avlShowData show;           // show function
+  avlFreeData free;           // function to free data
+  avlCpyData copy;            // function to copy data
+  size_t size;                // number of tree nodes
+} avltree;
+
+// function prototypes
+
+  // creates a new AVL tree
+avltree *avlNew (avlCmpData cmp);
+
+  // makes the tree make copies of the data
+void avlCopyData (avltree *T, avlCpyData copy,
+                  avlFreeData free);
+
+  // sets the tree to own the data
+void avlOwnData (avltree *T, avlFreeData free);
+
+  // sets the show function for the tree
+void avlSetShow (avltree *T, avlShowData show);
+
+  // returns true if the tree is empty
+bool avlIsEmpty (avltree *T);
+
+  // inserts a new node into the tree
+void avlInsert (avltree *T, void *data);
+
+  // builds a balanced tree from n data items sorted by key in
+  // O(n) time; the tree must be empty; returns false if it is
+  // not, or if the data is not sorted
+bool avlBulkLoad (avltree *T, void **data, size_t n);
+
+  // deallocates the tree
+void avlFree (avltree *T);
+
+  // searches the tree for a key
+avlnode *avlSearch (avltree *T, void *key);
+
+  // deletes a node from the tree
+void avlDelete (avltree *T, avlnode *z);
+
+  // returns the minimum node in the tree
+avlnode *avlMinimum (avltree *T, avlnode *x);
+
+  // returns the maximum node in the tree
+avlnode *avlMaximum (avltree *T, avlnode *x);
+
+  // returns the successor of a node
+avlnode *avlSuccessor (avltree *T, avlnode *x);
+
+  // returns the predecessor of a node
+avlnode *avlPredecessor (avltree *T, avlnode *x);
+
+  // returns the first node with a key not less than key,
+  // or NIL if there is none
+avlnode *avlLowerBound (avltree *T, void *key);
+
+  // returns the first node with a key greater than key,
+  // or NIL if there is none
+avlnode *avlUpperBound (avltree *T, void *key);
+
+  // displays the (sub)tree rooted at x in order
+void avlShow (avltree *T, avlnode *x);
+
+  // shows the structure of the tree rooted at x
+void avlShowTree (avltree *T, avlnode *x);
+
+  // shows a tree node
+void avlShowNode (avltree *T, avlnode *x);
+
+  // writes a tree to a file in order
+void avlWrite (avltree *T, avlnode *x, FILE *fp,
+  avlWriteData write);
+
+  // reads a tree from a file with one record per line; if the
+  // records are sorted, as written by avlWrite, the tree is
+  // built in O(n) time
+avltree *avlFromFile (char *filename, size_t dataSize,
+  avlCmpData cmp, avlStrToData fromStr);
+
+  // returns the number of nodes in the tree
+static inline size_t avlSize (avltree *T) {
+  return T->size;
+}
+
+  // returns the height of the tree
+static inline size_t avlHeight (avltree *T) {
+  return T->ROOT->height;
+}
+
+  // returns an in-order traversal list of the tree
+dll *avlInOrder (avltree *T);
+
+  // returns a pre-order traversal list of the tree
+dll *avlPreOrder (avltree *T);
+
+  // returns a post-order traversal list of the tree
+dll *avlPostOrder (avltree *T);
+
+#endif  // AVL_H_INCLUDED
@@ -0,0 +1,157 @@
+#include "../avl.h"
+#include "../../../../lib/clib.h"
+#include <stdio.h>
+#include <time.h>
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  return *(int *)a - *(int *)b;
+}
+
+//===================================================================
+// Shows an integer
+void showInt (void const *a) {
+  printf("%d", *(int *)a);
+}
+
+//===================================================================
+// Checks the stored heights and the AVL property of the subtree
+// rooted at x; returns its height
+static int checkAvl (avltree *T, avlnode *x, bool *ok) {
+  if (x == T->NIL)
+    return 0;
+  int left = checkAvl(T, x->left, ok);
+  int right = checkAvl(T, x->right, ok);
+  if (left - right > 1 || right - left > 1)
+    *ok = false;
+  if (x->height != MAX(left, right) + 1)
+    *ok = false;
+  if (x->left != T->NIL && x->left->parent != x)
+    *ok = false;
+  if (x->right != T->NIL && x->right->parent != x)
+    *ok = false;
+  return x->height;
+}
+
+//===================================================================
+// Checks a tree under random insertions and deletions against
+// an array that counts how often each key is in the tree
+static bool stressTest (size_t n) {
+  avltree *T = avlNew(cmpInt);
+  avlOwnData(T, free);
+  int *count = safeCalloc(n, sizeof(int));
+  size_t size = 0;
+  bool ok = true;
+  for (size_t i = 0; i < 20 * n && ok; i++) {
+    int key = rand() % n;
+    if (rand() % 2) {
+      int *d = safeMalloc(sizeof(int));
+      *d = key;
+      avlInsert(T, d);
+      count[key]++;
+      size++;
+    } else {
+      avlnode *x = avlSearch(T, &key);
+      if ((x != NULL) != (count[key] > 0))
+        ok = false;
+      else if (x) {
+        avlDelete(T, x);
+        count[key]--;
+        size--;
+      }
+    }
+    checkAvl(T, T->ROOT, &ok);
+    if (T->ROOT->parent != T->NIL || avlSize(T) != size)
+      ok = false;
+  }
+  int key = 0;
+  for (avlnode *x = avlMinimum(T, T->ROOT); x != T->NIL;
+       x = avlSuccessor(T, x)) {
+    while (key < (int)n && count[key] == 0)
+      key++;
+    if (key == (int)n || *(int *)x->data != key)
+      ok = false;
+    else
+      count[key]--;
+  }
+  free(count);
+  avlFree(T);
+  return ok;
+}
+
+//===================================================================
+
+int main (void) {
+  srand(time(NULL));
+  avltree *T = avlNew(cmpInt);
+  avlSetShow(T, showInt);
+  avlOwnData(T, free);
+
+  // insert 20 random integers
+  for (int i = 0; i < 20; i++) {
+    int *d = safeMalloc(sizeof(int));
+    *d = rand() % 100;
+    avlInsert(T, d);
+  }
+
+  // the tree structure shows the height
+  // of each node, and that the heights of
+  // the subtrees of a node differ by at
+  // most one
+  avlShowTree(T, T->ROOT);
+  printf("\n");
+
+  // in-order traversal
+  printf("\nIn-order \n");
+  printf("---------\n");
+  dll *inOrder = avlInOrder(T);
+  dllSetShow(inOrder, showInt);
+  dllShow(inOrder);
+  dllFree(inOrder);
+  printf("\n");
+
+  // pre-order traversal
+  printf("Pre-order \n");
+  printf("---------\n");
+  dll *preOrder = avlPreOrder(T);
+  dllSetShow(preOrder, showInt);
+  dllShow(preOrder);
+  dllFree(preOrder);
+  printf("\n");
+
+  // post-order traversal
+  printf("Post-order \n");
+  printf("----------\n");
+  dll *postOrder = avlPostOrder(T);
+  dllSetShow(postOrder, showInt);
+  dllShow(postOrder);
+  dllFree(postOrder);
+  printf("\n");
+
+  // make a second tree with data that
+  // is inserted in ascending order
+  avltree *T2 = avlNew(cmpInt);
+  avlSetShow(T2, showInt);
+  avlOwnData(T2, free);
+  for (int i = 1; i < 21; i++) {
+    int *d = safeMalloc(sizeof(int));
+    *d = i;
+    avlInsert(T2, d);
+  }
+
+  // the worst case of a binary search
+  // tree does not apply to AVL trees:
+  // the tree is balanced and its height
+  // is at most 1.44 log n
+  avlShowTree(T2, T2->ROOT);
+  printf("\nHeight: %zu\n\n", avlHeight(T2));
+
+  // random insertions and deletions
+  printf("Random insertions and deletions: %s\n",
+         stressTest(1000) ? "passed" : "FAILED");
+
+  avlFree(T);
+  avlFree(T2);
+  return 0;
+}
@@ -0,0 +1,172 @@
+/*
+  Benchmark of the AVL tree against the red-black tree and the
+    unbalanced binary search tree for mixed workloads
+  Builds each tree from the same n keys, then runs the same random
+    sequence of operations on it, for several ratios of searches
+    to updates; an update inserts a new key or deletes a random
+    key, so that the size of the trees stays about the same;
+    reports the time and the number of key comparisons per
+    operation, and the height of each tree afterwards
+  Usage: ./bench.out [n] [number of operations] [ascending]
+    with ascending set to 1, the initial keys are inserted in
+    ascending order, which is the worst case for the unbalanced
+    tree, so that n should be kept small (e.g. 20000)
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../avl.h"
+#include "../../rbtrees/rbt.h"
+#include "../../bstrees/bst.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+
+typedef struct {
+  double time;             // seconds for all operations
+  size_t comparisons;      // key comparisons for all operations
+  size_t height;           // height of the tree afterwards
+} result;
+
+static size_t comparisons = 0;
+
+//===================================================================
+// Compares two integers, and counts the comparisons
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  comparisons++;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Returns the height of the subtree rooted at x
+static size_t bstHeight (bstree *T, bsnode *x) {
+  if (x == T->NIL)
+    return 0;
+  size_t left = bstHeight(T, x->left);
+  size_t right = bstHeight(T, x->right);
+  return 1 + MAX(left, right);
+}
+
+//===================================================================
+// Runs the operations on an AVL tree; the n initial keys are
+// followed by the q operation keys in keys, and ops holds
+// 's' (search), 'i' (insert) or 'd' (delete) for each of them
+static result runAvl (int *keys, size_t n, char *ops, size_t q) {
+  avltree *T = avlNew(cmpInt);
+  for (size_t i = 0; i < n; i++)
+    avlInsert(T, keys + i);
+  int *args = keys + n;
+  comparisons = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++) {
+    avlnode *x;
+    if (ops[i] == 's')
+      avlSearch(T, args + i);
+    else if (ops[i] == 'i')
+      avlInsert(T, args + i);
+    else if ((x = avlSearch(T, args + i)))
+      avlDelete(T, x);
+  }
+  result r = {now() - start, comparisons, avlHeight(T)};
+  avlFree(T);
+  return r;
+}
+
+//===================================================================
+// Runs the operations on a red-black tree
+static result runRbt (int *keys, size_t n, char *ops, size_t q) {
+  rbtree *T = rbtNew(cmpInt);
+  for (size_t i = 0; i < n; i++)
+    rbtInsert(T, keys + i);
+  int *args = keys + n;
+  comparisons = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++) {
+    rbnode *x;
+    if (ops[i] == 's')
+      rbtSearch(T, args + i);
+    else if (ops[i] == 'i')
+      rbtInsert(T, args + i);
+    else if ((x = rbtSearch(T, args + i)))
+      rbtDelete(T, x);
+  }
+  result r = {now() - start, comparisons, rbtHeight(T)};
+  rbtFree(T);
+  return r;
+}
+
+//===================================================================
+// Runs the operations on an unbalanced binary search tree
+static result runBst (int *keys, size_t n, char *ops, size_t q) {
+  bstree *T = bstNew(cmpInt);
+  for (size_t i = 0; i < n; i++)
+    bstInsert(T, keys + i);
+  int *args = keys + n;
+  comparisons = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++) {
+    bsnode *x;
+    if (ops[i] == 's')
+      bstSearch(T, args + i);
+    else if (ops[i] == 'i')
+      bstInsert(T, args + i);
+    else if ((x = bstSearch(T, args + i)))
+      bstDelete(T, x);
+  }
+  result r = {now() - start, comparisons, bstHeight(T, T->ROOT)};
+  bstFree(T);
+  return r;
+}
+
+//===================================================================
+// Shows a result
+static void showResult (char *name, result r, size_t q) {
+  printf("    %-4s %8.3f us/op  %6.1f cmp/op  height %zu\n", name,
+         r.time * 1e6 / q, (double)r.comparisons / q, r.height);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+  bool ascending = argc > 3 && atoi(argv[3]) == 1;
+  srand(time(NULL));
+
+    // initial keys in [0, 2n), followed by the operation keys
+  int *keys = safeCalloc(n + q, sizeof(int));
+  for (size_t i = 0; i < n; i++)
+    keys[i] = ascending ? (int)(2 * i) : rand() % (2 * n);
+  for (size_t i = n; i < n + q; i++)
+    keys[i] = rand() % (2 * n);
+  char *ops = safeCalloc(q, sizeof(char));
+  printf("%zu %s keys, %zu operations\n", n,
+         ascending ? "ascending" : "random", q);
+
+  int reads[] = {50, 90, 99, 100};
+  for (size_t k = 0; k < sizeof(reads) / sizeof(reads[0]); k++) {
+    size_t updates = 0;
+    for (size_t i = 0; i < q; i++)
+      if (rand() % 100 < reads[k])
+        ops[i] = 's';
+      else
+        ops[i] = updates++ % 2 ? 'd' : 'i';
+    printf("  %d%% searches\n", reads[k]);
+    showResult("avl", runAvl(keys, n, ops, q), q);
+    showResult("rbt", runRbt(keys, n, ops, q), q);
+    showResult("bst", runBst(keys, n, ops, q), q);
+  }
+
+  free(keys);
+  free(ops);
+  return 0;
+}
@@ -110,19 +110,49 @@ void bstInsert (bstree *T, void *data) {
   T->size++;
 }
 
+//===================================================================
+// Builds a perfectly balanced subtree from the sorted data
+// in [lo, hi)
+static bsnode *bstBuild (bstree *T, void **data, size_t lo,
+                         size_t hi, bsnode *parent) {
+  if (lo == hi)
+    return T->NIL;
+  size_t mid = lo + (hi - lo) / 2;
+  bsnode *x = bstNewNode(T, data[mid]);
+  x->parent = parent;
+  x->left = bstBuild(T, data, lo, mid, x);
+  x->right = bstBuild(T, data, mid + 1, hi, x);
+  return x;
+}
+
+//===================================================================
+// Builds a perfectly balanced tree from n data items sorted by key
+bool bstBulkLoad (bstree *T, void **data, size_t n) {
+  if (T->ROOT != T->NIL) {
+    fprintf(stderr, "bstBulkLoad: tree is not empty\n");
+    return false;
+  }
+  for (size_t i = 1; i < n; i++)
+    if (T->cmp(data[i - 1], data[i]) > 0) {
+      fprintf(stderr, "bstBulkLoad: data is not sorted\n");
+      return false;
+    }
+  T->ROOT = bstBuild(T, data, 0, n, T->NIL);
+  T->size = n;
+  return true;
+}
+
 //===================================================================
 // Searches the tree for a key
 bsnode *bstSearch (bstree *T, void *key) {
   bsnode *x = T->ROOT;
-  while (x != T->NIL && T->cmp(x->data, key) != 0) {
-    if (T->cmp(key, x->data) < 0)
-      x = x->left;
-    else
-      x = x->right;
+  while (x != T->NIL) {
+    int c = T->cmp(key, x->data);
+    if (c == 0)
+      return x;
+    x = c < 0 ? x->left : x->right;
   }
-  if (x == T->NIL)
-    return NULL;
-  return x;
+  return NULL;
 }
 
 //===================================================================
@@ -201,6 +231,61 @@ bsnode *bstPredecessor (bstree *T, bsnode *x) {
   return y;
 }
 
+//===================================================================
+// Returns the first node with a key not less than key
+bsnode *bstLowerBound (bstree *T, void *key) {
+  bsnode *x = T->ROOT, *y = T->NIL;
+  while (x != T->NIL) {
+    if (T->cmp(x->data, key) < 0)
+      x = x->right;
+    else {
+      y = x;
+      x = x->left;
+    }
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the first node with a key greater than key
+bsnode *bstUpperBound (bstree *T, void *key) {
+  bsnode *x = T->ROOT, *y = T->NIL;
+  while (x != T->NIL) {
+    if (T->cmp(x->data, key) <= 0)
+      x = x->right;
+    else {
+      y = x;
+      x = x->left;
+    }
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the number of nodes with a key in [low, high)
+size_t bstCountRange (bstree *T, void *low, void *high) {
+  size_t count = 0;
+  for (bsnode *x = bstLowerBound(T, low); x != T->NIL && 
+       T->cmp(x->data, high) < 0; x = bstSuccessor(T, x))
+    count++;
+  return count;
+}
+
+//===================================================================
+// Deletes all nodes with a key in [low, high); deleting a node
+// relinks its successor, but keeps it valid
+size_t bstDeleteRange (bstree *T, void *low, void *high) {
+  size_t count = 0;
+  bsnode *x = bstLowerBound(T, low);
+  while (x != T->NIL && T->cmp(x->data, high) < 0) {
+    bsnode *next = bstSuccessor(T, x);
+    bstDelete(T, x);
+    x = next;
+    count++;
+  }
+  return count;
+}
+
 //===================================================================
 // Shows the data in the tree in order, 20 items at a time
 static void bstShowAllData (bstree *T, bsnode *x, short *count) {
@@ -300,36 +385,55 @@ void bstWrite (bstree *T, bsnode *x, FILE *fp,
 }
 
 //===================================================================
-// Reads data from a file and inserts it into the tree
+// Reads data from a file with one record per line, of any length;
+// the records are collected first, so that sorted records can be
+// bulk loaded instead of inserted one by one
 bstree *bstFromFile (char *filename, size_t dataSize,
     bstCmpData cmp, bstStrToData fromStr) {
-  
-  FILE *fp; char buffer[100];
-  size_t lineNr = 0;
 
-  fp = fopen(filename, "r");
+  FILE *fp = fopen(filename, "r");
   if (! fp) {
     printf("Error: could not open file %s\n", filename);
     exit(EXIT_FAILURE);
   }
-
-  bstree *T = bstNew(cmp);
-  while (fgets(buffer, 100, fp) != NULL) {
-    lineNr++;
-    void *data = safeCalloc(1, dataSize);
-    if (! fromStr(data, buffer)) {
-      printf("Error: invalid input data on line %lu.\n"
+    // a large stream buffer saves system calls on big files
+  setvbuf(fp, NULL, _IOFBF, 1 << 20);
+
+  string *line = newString(128);
+  size_t n = 0, cap = 1024;
+  void **data = safeCalloc(cap, sizeof(void *));
+  bool sorted = true;
+  while (readLine(fp, line)) {
+    if (n == cap) {
+      cap *= 2;
+      data = safeRealloc(data, cap * sizeof(void *));
+    }
+    data[n] = safeCalloc(1, dataSize);
+    if (! fromStr(data[n], (char *)line->data)) {
+      printf("Error: invalid input data on line %zu.\n"
              "Check file %s for errors and try again.\n", 
-              lineNr, filename);
-      if (T->free) 
-        T->free(data);
-      bstFree(T);
+              n + 1, filename);
+      for (size_t i = 0; i <= n; i++)
+        free(data[i]);
+      free(data);
+      freeString(line);
       fclose(fp);
       exit(EXIT_FAILURE);
     }
-    bstInsert(T, data);
+    if (n && cmp(data[n - 1], data[n]) > 0)
+      sorted = false;
+    n++;
   }
+
+  bstree *T = bstNew(cmp);
+  if (sorted)
+    bstBulkLoad(T, data, n);
+  else
+    for (size_t i = 0; i < n; i++)
+      bstInsert(T, data[i]);
   printf("Data successfully read from file %s\n", filename);
+  free(data);
+  freeString(line);
   fclose(fp);
   return T;
 }
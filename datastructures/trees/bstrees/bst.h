@@ -60,6 +60,11 @@ bool bstIsEmpty (bstree *T);
   // inserts a new node into the tree
 void bstInsert(bstree *tree, void *data);
 
+  // builds a perfectly balanced tree from n data items sorted
+  // by key in O(n) time; the tree must be empty; returns false
+  // if it is not, or if the data is not sorted
+bool bstBulkLoad(bstree *T, void **data, size_t n);
+
   // deallocates the tree
 void bstFree(bstree *tree);
 
@@ -81,6 +86,28 @@ bsnode *bstSuccessor(bstree *T, bsnode *x);
   // returns the predecessor of a node
 bsnode *bstPredecessor(bstree *T, bsnode *x);
 
+  // returns the first node with a key not less than key,
+  // or NIL if there is none
+bsnode *bstLowerBound(bstree *T, void *key);
+
+  // returns the first node with a key greater than key,
+  // or NIL if there is none
+bsnode *bstUpperBound(bstree *T, void *key);
+
+  // the nodes with a key in [low, high) can be visited in order
+  // without building a list:
+  //   bsnode *end = bstLowerBound(T, high);
+  //   for (bsnode *x = bstLowerBound(T, low); x != end;
+  //        x = bstSuccessor(T, x))
+  // and those in [low, high] by ending at bstUpperBound(T, high)
+
+  // returns the number of nodes with a key in [low, high)
+size_t bstCountRange(bstree *T, void *low, void *high);
+
+  // deletes all nodes with a key in [low, high), and returns
+  // their number
+size_t bstDeleteRange(bstree *T, void *low, void *high);
+
   // displays the (sub)tree rooted at x in order
 void bstShow(bstree *T, bsnode *x);
 
@@ -94,7 +121,9 @@ void bstShowNode(bstree *T, bsnode *x);
 void bstWrite (bstree *T, bsnode *x, FILE *fp, 
   bstWriteData write);
 
-  // reads a tree from a file
+  // reads a tree from a file with one record per line; if the
+  // records are sorted, as written by bstWrite, the tree is
+  // built in O(n) time
 bstree *bstFromFile(char *filename, size_t dataSize,
   bstCmpData cmp, bstStrToData fromStr);
 
@@ -0,0 +1,644 @@
+/*
+  Generic B+-tree implementation
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "bptree.h"
+#include "../../../lib/clib.h"
+
+  // minimum number of items in a non-root leaf, and of
+  // children of a non-root internal node
+#define BPT_MIN (BPT_ORDER / 2)
+
+//===================================================================
+// Creates a new leaf or internal node
+static bptnode *bptNewNode (bool isLeaf) {
+  size_t size = sizeof(bptnode);
+  if (! isLeaf)
+    size += BPT_ORDER * sizeof(bptnode *);
+  bptnode *x = safeCalloc(1, size);
+  x->isLeaf = isLeaf;
+  return x;
+}
+
+//===================================================================
+// Creates a new B+-tree
+bptree *bptNew (bptCmpData cmp) {
+  bptree *T = safeCalloc(1, sizeof(bptree));
+  T->cmp = cmp;
+  return T;
+}
+
+//===================================================================
+// Makes the tree make copies of the data
+void bptCopyData (bptree *T, bptCpyData copy, bptFreeData free) {
+  T->copy = copy;
+  T->free = free;
+}
+
+//===================================================================
+// Sets the tree to own the data
+void bptOwnData (bptree *T, bptFreeData free) {
+  T->free = free;
+}
+
+//===================================================================
+// Sets the show function for the tree
+void bptSetShow (bptree *T, bptShowData show) {
+  T->show = show;
+}
+
+//===================================================================
+// Sets the key prefix function
+void bptSetKey (bptree *T, bptKeyData key) {
+  if (T->size) {
+    fprintf(stderr, "bptSetKey: tree is not empty\n");
+    return;
+  }
+  T->key = key;
+}
+
+//===================================================================
+// Deallocates all nodes in the subtree rooted at x
+static void bptFreeNodes (bptree *T, bptnode *x) {
+  if (x->isLeaf) {
+    if (T->free)
+      for (size_t i = 0; i < x->n; i++)
+        T->free(x->items[i]);
+  } else
+    for (size_t i = 0; i <= x->n; i++)
+      bptFreeNodes(T, x->child[i]);
+  free(x);
+}
+
+//===================================================================
+// Deallocates the B+-tree
+void bptFree (bptree *T) {
+  if (T) {
+    if (T->ROOT)
+      bptFreeNodes(T, T->ROOT);
+    free(T);
+  }
+}
+
+//===================================================================
+// Returns the key prefix of the data
+static inline uint64_t prefix (bptree *T, void const *data) {
+  return T->key ? T->key(data) : 0;
+}
+
+//===================================================================
+// Compares two items by their key prefixes, and by the
+// comparison function if the prefixes are equal
+static inline int compare (bptree *T, uint64_t pa, void *a,
+                           uint64_t pb, void *b) {
+  if (pa != pb)
+    return pa < pb ? -1 : 1;
+  return T->cmp(a, b);
+}
+
+//===================================================================
+// Returns the number of items in node x with a key less than
+// key, or not greater than key if upper is true
+static size_t position (bptree *T, bptnode *x, uint64_t kp,
+                        void *key, bool upper) {
+  size_t i = 0;
+  if (T->key) {
+      // the prefixes are inline, so a linear scan over them is
+      // faster than a binary search for the small nodes
+    while (i < x->n && x->pre[i] < kp)
+      i++;
+    while (i < x->n && x->pre[i] == kp) {
+      int c = T->cmp(x->items[i], key);
+      if (c > 0 || (c == 0 && ! upper))
+        break;
+      i++;
+    }
+    return i;
+  }
+  size_t j = x->n;
+  while (i < j) {
+    size_t mid = i + (j - i) / 2;
+    int c = T->cmp(x->items[mid], key);
+    if (c < 0 || (c == 0 && upper))
+      i = mid + 1;
+    else
+      j = mid;
+  }
+  return i;
+}
+
+//===================================================================
+// Returns true if node x is full
+static inline bool isFull (bptnode *x) {
+  return x->n == (x->isLeaf ? BPT_ORDER : BPT_ORDER - 1);
+}
+
+//===================================================================
+// Returns true if node x has too few items
+static inline bool isUnderfull (bptnode *x) {
+  return x->n < (x->isLeaf ? BPT_MIN : BPT_MIN - 1);
+}
+
+//===================================================================
+// Inserts an item and, for an internal node, the child to its
+// right at position i of node x
+static void insertAt (bptnode *x, size_t i, uint64_t pre,
+                      void *item, bptnode *right) {
+  memmove(x->pre + i + 1, x->pre + i, (x->n - i) * sizeof(uint64_t));
+  memmove(x->items + i + 1, x->items + i,
+          (x->n - i) * sizeof(void *));
+  if (! x->isLeaf)
+    memmove(x->child + i + 2, x->child + i + 1,
+            (x->n - i) * sizeof(bptnode *));
+  x->pre[i] = pre;
+  x->items[i] = item;
+  if (! x->isLeaf)
+    x->child[i + 1] = right;
+  x->n++;
+}
+
+//===================================================================
+// Removes the item and, for an internal node, the child to its
+// right at position i of node x
+static void removeAt (bptnode *x, size_t i) {
+  x->n--;
+  memmove(x->pre + i, x->pre + i + 1, (x->n - i) * sizeof(uint64_t));
+  memmove(x->items + i, x->items + i + 1,
+          (x->n - i) * sizeof(void *));
+  if (! x->isLeaf)
+    memmove(x->child + i + 1, x->child + i + 2,
+            (x->n - i) * sizeof(bptnode *));
+}
+
+//===================================================================
+// Splits the full child i of the non-full internal node x
+// (CLRS 18.2); a leaf gives a copy of its middle key to x,
+// while an internal node moves its middle key up to x
+static void splitChild (bptnode *x, size_t i) {
+  bptnode *y = x->child[i];
+  bptnode *z = bptNewNode(y->isLeaf);
+  uint64_t pre;
+  void *sep;
+
+  if (y->isLeaf) {
+    z->n = y->n - BPT_MIN;
+    memcpy(z->pre, y->pre + BPT_MIN, z->n * sizeof(uint64_t));
+    memcpy(z->items, y->items + BPT_MIN, z->n * sizeof(void *));
+    y->n = BPT_MIN;
+    pre = z->pre[0];
+    sep = z->items[0];
+    z->next = y->next;
+    if (z->next)
+      z->next->prev = z;
+    z->prev = y;
+    y->next = z;
+  } else {
+    size_t m = BPT_MIN - 1;
+    z->n = y->n - m - 1;
+    memcpy(z->pre, y->pre + m + 1, z->n * sizeof(uint64_t));
+    memcpy(z->items, y->items + m + 1, z->n * sizeof(void *));
+    memcpy(z->child, y->child + m + 1,
+           (z->n + 1) * sizeof(bptnode *));
+    y->n = m;
+    pre = y->pre[m];
+    sep = y->items[m];
+  }
+  insertAt(x, i, pre, sep, z);
+}
+
+//===================================================================
+// Inserts new data into the tree, splitting the full nodes on
+// the way down, so that a split never has to go back up
+void bptInsert (bptree *T, void *data) {
+  if (T->copy)
+    data = T->copy(data);
+  uint64_t kp = prefix(T, data);
+
+  if (! T->ROOT) {
+    T->ROOT = bptNewNode(true);
+    T->height = 1;
+  }
+  if (isFull(T->ROOT)) {
+    bptnode *s = bptNewNode(false);
+    s->child[0] = T->ROOT;
+    T->ROOT = s;
+    splitChild(s, 0);
+    T->height++;
+  }
+
+  bptnode *x = T->ROOT;
+  while (! x->isLeaf) {
+    size_t i = position(T, x, kp, data, true);
+    if (isFull(x->child[i])) {
+      splitChild(x, i);
+      if (compare(T, x->pre[i], x->items[i], kp, data) <= 0)
+        i++;
+    }
+    x = x->child[i];
+  }
+  insertAt(x, position(T, x, kp, data, true), kp, data, NULL);
+  T->size++;
+}
+
+//===================================================================
+// Builds the tree from n data items sorted by key
+bool bptBulkLoad (bptree *T, void **data, size_t n) {
+  if (T->ROOT) {
+    fprintf(stderr, "bptBulkLoad: tree is not empty\n");
+    return false;
+  }
+  for (size_t i = 1; i < n; i++)
+    if (compare(T, prefix(T, data[i - 1]), data[i - 1],
+                prefix(T, data[i]), data[i]) > 0) {
+      fprintf(stderr, "bptBulkLoad: data is not sorted\n");
+      return false;
+    }
+  if (n == 0)
+    return true;
+
+    // the items are spread evenly over the fewest leaves, so
+    // that no leaf is less than half full
+  size_t count = (n + BPT_ORDER - 1) / BPT_ORDER;
+  bptnode **level = safeCalloc(count, sizeof(bptnode *));
+  void **mins = safeCalloc(count, sizeof(void *));
+  uint64_t *minPres = safeCalloc(count, sizeof(uint64_t));
+  size_t k = 0;
+  for (size_t i = 0; i < count; i++) {
+    bptnode *x = bptNewNode(true);
+    x->n = n / count + (i < n % count);
+    for (size_t j = 0; j < x->n; j++, k++) {
+      x->items[j] = T->copy ? T->copy(data[k]) : data[k];
+      x->pre[j] = prefix(T, x->items[j]);
+    }
+    if (i) {
+      x->prev = level[i - 1];
+      level[i - 1]->next = x;
+    }
+    level[i] = x;
+    mins[i] = x->items[0];
+    minPres[i] = x->pre[0];
+  }
+  T->height = 1;
+
+    // each next level gets a separator for each child except
+    // the first, namely the smallest item in the child's subtree
+  while (count > 1) {
+    size_t nParents = (count + BPT_ORDER - 1) / BPT_ORDER;
+    k = 0;
+    for (size_t i = 0; i < nParents; i++) {
+      bptnode *x = bptNewNode(false);
+      size_t nChildren = count / nParents + (i < count % nParents);
+      void *min = mins[k];
+      uint64_t minPre = minPres[k];
+      x->child[0] = level[k++];
+      for (size_t j = 1; j < nChildren; j++, k++) {
+        x->items[j - 1] = mins[k];
+        x->pre[j - 1] = minPres[k];
+        x->child[j] = level[k];
+      }
+      x->n = nChildren - 1;
+      level[i] = x;
+      mins[i] = min;
+      minPres[i] = minPre;
+    }
+    count = nParents;
+    T->height++;
+  }
+  T->ROOT = level[0];
+  T->size = n;
+  free(level);
+  free(mins);
+  free(minPres);
+  return true;
+}
+
+//===================================================================
+// Returns a cursor to the first item with a key not less than key
+bptcursor bptLowerBound (bptree *T, void *key) {
+  bptcursor c = {NULL, 0};
+  if (! T->ROOT)
+    return c;
+  uint64_t kp = prefix(T, key);
+  bptnode *x = T->ROOT;
+  while (! x->isLeaf)
+    x = x->child[position(T, x, kp, key, false)];
+  c.pos = position(T, x, kp, key, false);
+  c.leaf = x;
+  if (c.pos == x->n) {
+      // all items in this leaf are smaller
+    c.leaf = x->next;
+    c.pos = 0;
+  }
+  return c;
+}
+
+//===================================================================
+// Returns the data with the given key, or NULL
+void *bptSearch (bptree *T, void *key) {
+  bptcursor c = bptLowerBound(T, key);
+  if (c.leaf && T->cmp(c.leaf->items[c.pos], key) == 0)
+    return c.leaf->items[c.pos];
+  return NULL;
+}
+
+//===================================================================
+// Returns the leftmost leaf in the subtree rooted at x
+static bptnode *leftmostLeaf (bptnode *x) {
+  while (! x->isLeaf)
+    x = x->child[0];
+  return x;
+}
+
+//===================================================================
+// Restores the minimum size of the underfull child i of the
+// internal node x, by moving an item from a sibling if the
+// sibling can spare one, and by merging the child with the
+// sibling otherwise
+static void fixChild (bptnode *x, size_t i) {
+  size_t j = i > 0 ? i - 1 : i;
+  bptnode *L = x->child[j], *R = x->child[j + 1];
+
+  if (L->isLeaf) {
+    if (L->n + R->n <= BPT_ORDER) {
+      memcpy(L->pre + L->n, R->pre, R->n * sizeof(uint64_t));
+      memcpy(L->items + L->n, R->items, R->n * sizeof(void *));
+      L->n += R->n;
+      L->next = R->next;
+      if (L->next)
+        L->next->prev = L;
+      free(R);
+      removeAt(x, j);
+      return;
+    }
+    if (L->n < R->n) {
+      insertAt(L, L->n, R->pre[0], R->items[0], NULL);
+      removeAt(R, 0);
+    } else {
+      insertAt(R, 0, L->pre[L->n - 1], L->items[L->n - 1], NULL);
+      L->n--;
+    }
+    x->pre[j] = R->pre[0];
+    x->items[j] = R->items[0];
+    return;
+  }
+
+    // internal nodes: the separator in x comes down
+  if (L->n + R->n + 1 <= BPT_ORDER - 1) {
+    L->pre[L->n] = x->pre[j];
+    L->items[L->n] = x->items[j];
+    memcpy(L->pre + L->n + 1, R->pre, R->n * sizeof(uint64_t));
+    memcpy(L->items + L->n + 1, R->items, R->n * sizeof(void *));
+    memcpy(L->child + L->n + 1, R->child,
+           (R->n + 1) * sizeof(bptnode *));
+    L->n += R->n + 1;
+    free(R);
+    removeAt(x, j);
+  } else if (L->n < R->n) {
+    insertAt(L, L->n, x->pre[j], x->items[j], R->child[0]);
+    x->pre[j] = R->pre[0];
+    x->items[j] = R->items[0];
+    R->child[0] = R->child[1];
+    removeAt(R, 0);
+  } else {
+    insertAt(R, 0, x->pre[j], x->items[j], R->child[0]);
+    R->child[0] = L->child[L->n];
+    x->pre[j] = L->pre[L->n - 1];
+    x->items[j] = L->items[L->n - 1];
+    L->n--;
+  }
+}
+
+//===================================================================
+// Removes an item with the given key from the subtree rooted at
+// x; returns the removed item, or NULL if there is none
+static void *deleteFrom (bptree *T, bptnode *x, uint64_t kp,
+                         void *key) {
+  size_t i = position(T, x, kp, key, false);
+  if (x->isLeaf) {
+    if (i == x->n || compare(T, x->pre[i], x->items[i], kp, key))
+      return NULL;
+    void *item = x->items[i];
+    removeAt(x, i);
+    return item;
+  }
+
+    // equal keys may continue past a separator equal to the key
+  for (; i <= x->n; i++) {
+    void *item = deleteFrom(T, x->child[i], kp, key);
+    if (item) {
+        // each separator is the smallest item in the subtree to
+        // its right, so it may be the removed item
+      if (i > 0 && x->items[i - 1] == item) {
+        bptnode *leaf = leftmostLeaf(x->child[i]);
+        x->pre[i - 1] = leaf->pre[0];
+        x->items[i - 1] = leaf->items[0];
+      }
+      if (isUnderfull(x->child[i]))
+        fixChild(x, i);
+      return item;
+    }
+    if (i == x->n || compare(T, x->pre[i], x->items[i], kp, key))
+      break;
+  }
+  return NULL;
+}
+
+//===================================================================
+// Deletes data with the given key from the tree
+bool bptDelete (bptree *T, void *key) {
+  if (! T->ROOT)
+    return false;
+  void *item = deleteFrom(T, T->ROOT, prefix(T, key), key);
+  if (! item)
+    return false;
+
+  bptnode *r = T->ROOT;
+  if (r->n == 0) {
+      // the root lost its last separator or item
+    T->ROOT = r->isLeaf ? NULL : r->child[0];
+    T->height--;
+    free(r);
+  }
+  if (T->free)
+    T->free(item);
+  T->size--;
+  return true;
+}
+
+//===================================================================
+// Returns a cursor to the item with the smallest key
+bptcursor bptMinimum (bptree *T) {
+  bptcursor c = {NULL, 0};
+  if (T->ROOT)
+    c.leaf = leftmostLeaf(T->ROOT);
+  return c;
+}
+
+//===================================================================
+// Returns a cursor to the item with the largest key
+bptcursor bptMaximum (bptree *T) {
+  bptcursor c = {NULL, 0};
+  bptnode *x = T->ROOT;
+  if (x) {
+    while (! x->isLeaf)
+      x = x->child[x->n];
+    c.leaf = x;
+    c.pos = x->n - 1;
+  }
+  return c;
+}
+
+//===================================================================
+// Returns a cursor to the next item in order
+bptcursor bptSuccessor (bptcursor c) {
+  if (c.leaf && ++c.pos == c.leaf->n) {
+    c.leaf = c.leaf->next;
+    c.pos = 0;
+  }
+  return c;
+}
+
+//===================================================================
+// Returns a cursor to the previous item in order
+bptcursor bptPredecessor (bptcursor c) {
+  if (c.leaf && c.pos-- == 0) {
+    c.leaf = c.leaf->prev;
+    c.pos = c.leaf ? c.leaf->n - 1 : 0;
+  }
+  return c;
+}
+
+//===================================================================
+// Calls visit for all data with a key in [low, high)
+size_t bptRange (bptree *T, void *low, void *high,
+                 bptVisit visit, void *arg) {
+  size_t count = 0;
+  uint64_t hp = prefix(T, high);
+  bptcursor c = bptLowerBound(T, low);
+  while (c.leaf) {
+    bptnode *x = c.leaf;
+      // walk along the leaf, then follow the link to the next
+    for (; c.pos < x->n; c.pos++, count++) {
+      if (compare(T, x->pre[c.pos], x->items[c.pos], hp, high) >= 0)
+        return count;
+      visit(x->items[c.pos], arg);
+    }
+    c.leaf = x->next;
+    c.pos = 0;
+  }
+  return count;
+}
+
+//===================================================================
+// Shows the data in the tree in order
+void bptShow (bptree *T) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  for (bptcursor c = bptMinimum(T); c.leaf; c = bptSuccessor(c))
+    T->show(bptData(c));
+  printf("\n");
+}
+
+//===================================================================
+// Shows the nodes in the subtree rooted at x, one per line,
+// indented by their level
+static void bptShowLevels (bptree *T, bptnode *x, size_t level) {
+  for (size_t i = 0; i < level; i++)
+    printf("-");
+  if (level)
+    printf("|%s(%zu): ", x->isLeaf ? "L" : "I", level);
+  else
+    printf("ROOT: ");
+  for (size_t i = 0; i < x->n; i++)
+    T->show(x->items[i]);
+  printf("\n");
+  if (! x->isLeaf)
+    for (size_t i = 0; i <= x->n; i++)
+      bptShowLevels(T, x->child[i], level + 1);
+}
+
+//===================================================================
+// Shows the tree structure
+void bptShowTree (bptree *T) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  printf("--------------\n"
+         "Tree structure\n"
+         "--------------\n");
+  if (T->ROOT)
+    bptShowLevels(T, T->ROOT, 0);
+}
+
+//===================================================================
+// Writes the data in the tree in order to a file
+void bptWrite (bptree *T, FILE *fp, bptWriteData write) {
+  for (bptcursor c = bptMinimum(T); c.leaf; c = bptSuccessor(c))
+    write(bptData(c), fp);
+}
+
+//===================================================================
+// Reads a tree from a file
+bptree *bptFromFile (char *filename, size_t dataSize,
+    bptCmpData cmp, bptStrToData fromStr) {
+
+  FILE *fp = fopen(filename, "r");
+  if (! fp) {
+    printf("Error: could not open file %s\n", filename);
+    exit(EXIT_FAILURE);
+  }
+    // a large stream buffer saves system calls on big files
+  setvbuf(fp, NULL, _IOFBF, 1 << 20);
+
+  string *line = newString(128);
+  size_t n = 0, cap = 1024;
+  void **data = safeCalloc(cap, sizeof(void *));
+  bool sorted = true;
+  while (readLine(fp, line)) {
+    if (n == cap) {
+      cap *= 2;
+      data = safeRealloc(data, cap * sizeof(void *));
+    }
+    data[n] = safeCalloc(1, dataSize);
+    if (! fromStr(data[n], (char *)line->data)) {
+      printf("Error: invalid input data on line %zu.\n"
+             "Check file %s for errors and try again.\n",
+              n + 1, filename);
+      for (size_t i = 0; i <= n; i++)
+        free(data[i]);
+      free(data);
+      freeString(line);
+      fclose(fp);
+      exit(EXIT_FAILURE);
+    }
+    if (n && cmp(data[n - 1], data[n]) > 0)
+      sorted = false;
+    n++;
+  }
+
+  bptree *T = bptNew(cmp);
+  if (sorted)
+    bptBulkLoad(T, data, n);
+  else
+    for (size_t i = 0; i < n; i++)
+      bptInsert(T, data[i]);
+  printf("Data successfully read from file %s\n", filename);
+  free(data);
+  freeString(line);
+  fclose(fp);
+  return T;
+}
+
+//===================================================================
+// Returns an in-order traversal list of the tree
+dll *bptInOrder (bptree *T) {
+  dll *list = dllNew();
+  for (bptcursor c = bptMinimum(T); c.leaf; c = bptSuccessor(c))
+    dllPushBack(list, bptData(c));
+  return list;
+}
@@ -0,0 +1,175 @@
+/*
+  Generic B+-tree implementation
+  All data is kept in the leaves, which are linked in order, so
+  that range scans only walk along the leaves; the internal nodes
+  only hold separator keys. A node holds up to BPT_ORDER items
+  or children, so that a search touches a few nodes of a few
+  cache lines each, instead of one node per level of a binary
+  tree. An optional key function maps the data to a 64-bit key
+  prefix that is kept inline in the nodes, so that most
+  comparisons do not have to follow the data pointers
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef BPTREE_H_INCLUDED
+#define BPTREE_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "../../lists/dll.h"
+
+  // maximum number of items in a leaf, and of children of
+  // an internal node; must be even and at least 4
+#ifndef BPT_ORDER
+#define BPT_ORDER 32
+#endif
+
+// function pointer types
+typedef int (*bptCmpData)(void const *a, void const *b);
+typedef uint64_t (*bptKeyData)(void const *data);
+typedef void (*bptShowData)(void const *data);
+typedef void (*bptWriteData)(void const *data, FILE *file);
+typedef bool (*bptStrToData)(void *data, char const *str);
+typedef void (*bptFreeData)(void *data);
+typedef void *(*bptCpyData)(void const *data);
+typedef void (*bptVisit)(void *data, void *arg);
+
+// data structures and types
+typedef struct bptnode {
+  size_t n;                   // number of items
+  bool isLeaf;                // true if the node is a leaf
+  uint64_t pre[BPT_ORDER];    // key prefixes of the items
+  void *items[BPT_ORDER];     // data in a leaf, separators
+                              // in an internal node
+  struct bptnode *prev;       // previous leaf
+  struct bptnode *next;       // next leaf
+  struct bptnode *child[];    // n + 1 children of an internal
+                              // node; absent in a leaf
+} bptnode;
+
+typedef struct {
+  bptnode *ROOT;              // root node
+  bptCmpData cmp;             // comparison function
+  bptKeyData key;             // key prefix function
+  bptShowData show;           // show function
+  bptFreeData free;           // function to free data
+  bptCpyData copy;            // function to copy data
+  size_t size;                // number of items
+  size_t height;              // number of levels
+} bptree;
+
+typedef struct {
+  bptnode *leaf;              // leaf of the item, NULL at the end
+  size_t pos;                 // position of the item in the leaf
+} bptcursor;
+
+// function prototypes
+
+  // creates a new B+-tree
+bptree *bptNew (bptCmpData cmp);
+
+  // makes the tree make copies of the data
+void bptCopyData (bptree *T, bptCpyData copy,
+                  bptFreeData free);
+
+  // sets the tree to own the data
+void bptOwnData (bptree *T, bptFreeData free);
+
+  // sets the show function for the tree
+void bptSetShow (bptree *T, bptShowData show);
+
+  // sets the key prefix function, which must be order-preserving:
+  // key(a) < key(b) implies cmp(a, b) < 0; the comparison function
+  // is only called for items with equal prefixes; the tree must
+  // be empty
+void bptSetKey (bptree *T, bptKeyData key);
+
+  // deallocates the tree
+void bptFree (bptree *T);
+
+  // inserts new data into the tree; equal keys are allowed
+void bptInsert (bptree *T, void *data);
+
+  // builds the tree from n data items sorted by key, filling
+  // the leaves from left to right; the tree must be empty;
+  // returns false if it is not, or if the data is not sorted
+bool bptBulkLoad (bptree *T, void **data, size_t n);
+
+  // returns the data with the given key, or NULL if there is
+  // no such data
+void *bptSearch (bptree *T, void *key);
+
+  // deletes data with the given key from the tree; returns false
+  // if there is no such data
+bool bptDelete (bptree *T, void *key);
+
+  // returns a cursor to the first item with a key not less
+  // than key
+bptcursor bptLowerBound (bptree *T, void *key);
+
+  // returns a cursor to the item with the smallest key
+bptcursor bptMinimum (bptree *T);
+
+  // returns a cursor to the item with the largest key
+bptcursor bptMaximum (bptree *T);
+
+  // returns a cursor to the next item in order; the cursor is
+  // at the end if there is none
+bptcursor bptSuccessor (bptcursor c);
+
+  // returns a cursor to the previous item in order; the cursor
+  // is at the end if there is none
+bptcursor bptPredecessor (bptcursor c);
+
+  // calls visit(data, arg) for all data with a key in
+  // [low, high), in order; returns the number of items visited
+size_t bptRange (bptree *T, void *low, void *high,
+                 bptVisit visit, void *arg);
+
+  // displays the data in the tree in order
+void bptShow (bptree *T);
+
+  // shows the structure of the tree
+void bptShowTree (bptree *T);
+
+  // writes the data in the tree to a file in order
+void bptWrite (bptree *T, FILE *fp, bptWriteData write);
+
+  // reads a tree from a file with one record per line; if the
+  // records are sorted, as written by bptWrite, the tree is
+  // built in O(n) time
+bptree *bptFromFile (char *filename, size_t dataSize,
+  bptCmpData cmp, bptStrToData fromStr);
+
+  // returns an in-order traversal list of the tree
+dll *bptInOrder (bptree *T);
+
+  // returns true if the cursor is at the end
+static inline bool bptAtEnd (bptcursor c) {
+  return c.leaf == NULL;
+}
+
+  // returns the data at the cursor, or NULL at the end
+static inline void *bptData (bptcursor c) {
+  return c.leaf ? c.leaf->items[c.pos] : NULL;
+}
+
+  // returns the number of items in the tree
+static inline size_t bptSize (bptree *T) {
+  return T->size;
+}
+
+  // returns true if the tree is empty
+static inline bool bptIsEmpty (bptree *T) {
+  return T->size == 0;
+}
+
+  // returns the height of the tree
+static inline size_t bptHeight (bptree *T) {
+  return T->height;
+}
+
+#endif  // BPTREE_H_INCLUDED
@@ -0,0 +1,175 @@
+/*
+  Benchmark of the B+-tree against the red-black tree
+  Inserts n integer keys in random and in sequential order, then
+    looks up all keys in random order, and sums all keys in a
+    number of ranges; the B+-tree is run once with comparisons
+    on the data only, once with inline key prefixes, and once
+    bulk loaded from the sorted keys
+  Usage: ./bench.out [n]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../bptree.h"
+#include "../../rbtrees/rbt.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the key prefix of a non-negative integer
+uint64_t keyInt (void const *a) {
+  return *(int *)a;
+}
+
+//===================================================================
+// Adds an integer to a running sum
+void addInt (void *data, void *arg) {
+  *(long *)arg += *(int *)data;
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Shuffles an array of integers
+static void shuffle (int *arr, size_t n) {
+  for (size_t i = n - 1; i > 0; i--) {
+    size_t j = rand() % (i + 1);
+    int tmp = arr[i];
+    arr[i] = arr[j];
+    arr[j] = tmp;
+  }
+}
+
+//===================================================================
+// Times the red-black tree; returns the checksum of the lookups
+// and range sums
+static long benchRbt (int *ins, int *look, size_t n, size_t q,
+                      double *tIns, double *tLook, double *tRange) {
+  rbtree *T = rbtNew(cmpInt);
+  double start = now();
+  for (size_t i = 0; i < n; i++)
+    rbtInsert(T, ins + i);
+  *tIns = now() - start;
+
+  long sum = 0;
+  start = now();
+  for (size_t i = 0; i < n; i++)
+    sum += *(int *)rbtSearch(T, look + i)->data;
+  *tLook = now() - start;
+
+  start = now();
+  for (size_t i = 0; i < q; i++) {
+    int low = look[i], high = low + 1000;
+      // the tree has all keys, so the first node is found by
+      // a search
+    for (rbnode *x = rbtSearch(T, &low);
+         x != T->NIL && *(int *)x->data < high;
+         x = rbtSuccessor(T, x))
+      sum += *(int *)x->data;
+  }
+  *tRange = now() - start;
+  rbtFree(T);
+  return sum;
+}
+
+//===================================================================
+// Times the B+-tree; bulk loads the sorted keys if sorted is not
+// NULL; returns the checksum of the lookups and range sums
+static long benchBpt (int *ins, int *look, size_t n, size_t q,
+                      bool usePrefix, void **sorted,
+                      double *tIns, double *tLook, double *tRange) {
+  bptree *T = bptNew(cmpInt);
+  if (usePrefix)
+    bptSetKey(T, keyInt);
+  double start = now();
+  if (sorted)
+    bptBulkLoad(T, sorted, n);
+  else
+    for (size_t i = 0; i < n; i++)
+      bptInsert(T, ins + i);
+  *tIns = now() - start;
+
+  long sum = 0;
+  start = now();
+  for (size_t i = 0; i < n; i++)
+    sum += *(int *)bptSearch(T, look + i);
+  *tLook = now() - start;
+
+  start = now();
+  for (size_t i = 0; i < q; i++) {
+    int low = look[i], high = low + 1000;
+    bptRange(T, &low, &high, addInt, &sum);
+  }
+  *tRange = now() - start;
+  bptFree(T);
+  return sum;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t q = n / 100;
+  srand(time(NULL));
+
+  int *seq = safeCalloc(n, sizeof(int));
+  int *rnd = safeCalloc(n, sizeof(int));
+  int *look = safeCalloc(n, sizeof(int));
+  void **sorted = safeCalloc(n, sizeof(void *));
+  for (size_t i = 0; i < n; i++) {
+    seq[i] = rnd[i] = look[i] = (int)i;
+    sorted[i] = seq + i;
+  }
+  shuffle(rnd, n);
+  shuffle(look, n);
+
+  printf("%zu keys, %zu range sums of 1000 keys, order %d\n"
+         "%-26s %10s %10s %10s\n", n, q, BPT_ORDER,
+         "", "insert", "lookup", "range");
+  for (size_t order = 0; order < 2; order++) {
+    int *ins = order ? seq : rnd;
+    printf("%s insertions\n", order ? "Sequential" : "Random");
+    double tIns, tLook, tRange;
+    long sums[4];
+    sums[0] = benchRbt(ins, look, n, q, &tIns, &tLook, &tRange);
+    printf("  %-24s %8.0f ns %7.0f ns %7.1f us\n", "red-black tree",
+           tIns * 1e9 / n, tLook * 1e9 / n, tRange * 1e6 / q);
+    sums[1] = benchBpt(ins, look, n, q, false, NULL,
+                       &tIns, &tLook, &tRange);
+    printf("  %-24s %8.0f ns %7.0f ns %7.1f us\n", "B+-tree",
+           tIns * 1e9 / n, tLook * 1e9 / n, tRange * 1e6 / q);
+    sums[2] = benchBpt(ins, look, n, q, true, NULL,
+                       &tIns, &tLook, &tRange);
+    printf("  %-24s %8.0f ns %7.0f ns %7.1f us\n",
+           "B+-tree, key prefixes",
+           tIns * 1e9 / n, tLook * 1e9 / n, tRange * 1e6 / q);
+    sums[3] = benchBpt(ins, look, n, q, true, sorted,
+                       &tIns, &tLook, &tRange);
+    printf("  %-24s %8.0f ns %7.0f ns %7.1f us\n",
+           "B+-tree, bulk loaded",
+           tIns * 1e9 / n, tLook * 1e9 / n, tRange * 1e6 / q);
+    printf("  checksums %s\n", sums[0] == sums[1] &&
+           sums[1] == sums[2] && sums[2] == sums[3] ?
+           "agree" : "DIFFER");
+  }
+
+  free(seq);
+  free(rnd);
+  free(look);
+  free(sorted);
+  return 0;
+}
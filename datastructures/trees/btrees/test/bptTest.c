@@ -0,0 +1,261 @@
+/*
+  Test of the B+-tree: random insertions and deletions with many
+    equal keys, with and without a key prefix function, checked
+    against a sorted array after each round, together with the
+    structure of the tree; then bulk loading, range scans,
+    and reading a written tree back from a file
+  Author: David De Potter
+*/
+
+#include "../bptree.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the key prefix of an integer, preserving its order
+uint64_t keyInt (void const *a) {
+  return (uint64_t)*(int *)a + 0x80000000u;
+}
+
+//===================================================================
+// Shows an integer
+void showInt (void const *a) {
+  printf("%d ", *(int *)a);
+}
+
+//===================================================================
+// Adds an integer to a running sum
+void addInt (void *data, void *arg) {
+  *(long *)arg += *(int *)data;
+}
+
+//===================================================================
+// Writes an integer to a file
+void writeInt (void const *a, FILE *fp) {
+  fprintf(fp, "%d\n", *(int *)a);
+}
+
+//===================================================================
+// Converts a string to an integer
+bool strToInt (void *a, char const *str) {
+  return sscanf(str, "%d", (int *)a) == 1;
+}
+
+//===================================================================
+// Checks the subtree rooted at x: its items are sorted, each
+// separator is the smallest item of the subtree to its right, the
+// nodes are at least half full, and all leaves are at the same
+// depth and linked in order; returns the smallest item
+static void *checkNode (bptree *T, bptnode *x, size_t depth,
+                        bool isRoot, bptnode **prevLeaf, bool *ok) {
+  if (! isRoot && x->n < (x->isLeaf ? BPT_ORDER / 2 :
+                                      BPT_ORDER / 2 - 1))
+    *ok = false;
+  for (size_t i = 0; i < x->n; i++)
+    if ((T->key && x->pre[i] != T->key(x->items[i])) ||
+        (i && cmpInt(x->items[i - 1], x->items[i]) > 0))
+      *ok = false;
+  if (x->isLeaf) {
+    if (depth != T->height || x->prev != *prevLeaf ||
+        (*prevLeaf && (*prevLeaf)->next != x) ||
+        (*prevLeaf && cmpInt((*prevLeaf)->items[(*prevLeaf)->n - 1],
+                             x->items[0]) > 0))
+      *ok = false;
+    *prevLeaf = x;
+    return x->n ? x->items[0] : NULL;
+  }
+  void *min = checkNode(T, x->child[0], depth + 1, false,
+                        prevLeaf, ok);
+  for (size_t i = 1; i <= x->n; i++)
+    if (checkNode(T, x->child[i], depth + 1, false,
+                  prevLeaf, ok) != x->items[i - 1])
+      *ok = false;
+  return min;
+}
+
+//===================================================================
+// Checks the tree against the sorted array of its n keys
+static bool checkTree (bptree *T, int *keys, size_t n) {
+  bool ok = bptSize(T) == n;
+  bptnode *prevLeaf = NULL;
+  if (T->ROOT) {
+    checkNode(T, T->ROOT, 1, true, &prevLeaf, &ok);
+    if (prevLeaf->next)
+      ok = false;
+  } else if (T->height != 0)
+    ok = false;
+  size_t i = 0;
+  for (bptcursor c = bptMinimum(T); ! bptAtEnd(c);
+       c = bptSuccessor(c), i++)
+    if (i >= n || *(int *)bptData(c) != keys[i])
+      ok = false;
+  if (i != n)
+    ok = false;
+  i = n;
+  for (bptcursor c = bptMaximum(T); ! bptAtEnd(c);
+       c = bptPredecessor(c))
+    if (i == 0 || *(int *)bptData(c) != keys[--i])
+      ok = false;
+  return ok && i == 0;
+}
+
+//===================================================================
+// Inserts and deletes random keys in a tree and a sorted array;
+// returns true if they agree after each round
+static bool randomRounds (bool usePrefix) {
+  size_t n = 0, cap = 20000;
+  int *keys = safeCalloc(cap, sizeof(int));
+  bptree *T = bptNew(cmpInt);
+  bptOwnData(T, free);
+  if (usePrefix)
+    bptSetKey(T, keyInt);
+  bool ok = true;
+
+  for (size_t round = 0; round < 20 && ok; round++) {
+    size_t nOps = 1 + rand() % 2000;
+    bool grow = round < 10;
+    for (size_t op = 0; op < nOps; op++) {
+      int key = rand() % 1000 - 500;
+      size_t i = 0;
+      while (i < n && keys[i] < key)
+        i++;
+      if ((grow && rand() % 4) || (! grow && rand() % 4 == 0)) {
+        if (n == cap)
+          continue;
+        memmove(keys + i + 1, keys + i, (n - i) * sizeof(int));
+        keys[i] = key;
+        n++;
+        int *d = safeMalloc(sizeof(int));
+        *d = key;
+        bptInsert(T, d);
+      } else {
+        bool found = i < n && keys[i] == key;
+        if (found) {
+          memmove(keys + i, keys + i + 1, (n - i - 1) * sizeof(int));
+          n--;
+        }
+        if (bptDelete(T, &key) != found)
+          ok = false;
+      }
+    }
+    if (! checkTree(T, keys, n))
+      ok = false;
+  }
+
+    // delete everything that is left
+  while (n > 0 && ok) {
+    int key = keys[rand() % n];
+    size_t i = 0;
+    while (keys[i] != key)
+      i++;
+    memmove(keys + i, keys + i + 1, (n - i - 1) * sizeof(int));
+    n--;
+    if (! bptDelete(T, &key))
+      ok = false;
+  }
+  ok = ok && checkTree(T, keys, 0);
+  bptFree(T);
+  free(keys);
+  return ok;
+}
+
+//===================================================================
+
+int main (void) {
+  srand(time(NULL));
+
+  printf("Random insertions and deletions\n");
+  printf("  without key prefixes: %s\n",
+         randomRounds(false) ? "correct" : "WRONG");
+  printf("  with key prefixes:    %s\n",
+         randomRounds(true) ? "correct" : "WRONG");
+
+    // bulk load sorted keys with duplicates
+  size_t n = 10000;
+  int *keys = safeCalloc(n, sizeof(int));
+  void **data = safeCalloc(n, sizeof(void *));
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = (int)(i / 3);
+    data[i] = keys + i;
+  }
+  bptree *T = bptNew(cmpInt);
+  bool ok = bptBulkLoad(T, data, n) && checkTree(T, keys, n);
+  printf("Bulk load of %zu keys: %s, height %zu\n", n,
+         ok ? "correct" : "WRONG", bptHeight(T));
+
+    // range scans on the bulk-loaded tree
+  ok = true;
+  for (size_t q = 0; q < 1000; q++) {
+    int low = rand() % 3500, high = low + rand() % 100;
+    long sum = 0, expected = 0;
+    size_t count = bptRange(T, &low, &high, addInt, &sum);
+    size_t expCount = 0;
+    for (size_t i = 0; i < n; i++)
+      if (keys[i] >= low && keys[i] < high) {
+        expected += keys[i];
+        expCount++;
+      }
+    if (sum != expected || count != expCount)
+      ok = false;
+  }
+  printf("Range scans: %s\n", ok ? "correct" : "WRONG");
+
+    // search and lower bound on the bulk-loaded tree
+  int key = 1234, missing = 5000;
+  ok = bptSearch(T, &key) && *(int *)bptSearch(T, &key) == key &&
+       ! bptSearch(T, &missing) &&
+       bptData(bptLowerBound(T, &key)) == keys + 3 * key &&
+       bptAtEnd(bptLowerBound(T, &missing));
+  printf("Search and lower bound: %s\n", ok ? "correct" : "WRONG");
+
+    // a written tree is read back by a bulk load, and an
+    // unsorted file by insertions
+  FILE *fp = fopen("bptTest.txt", "w");
+  bptWrite(T, fp, writeInt);
+  fclose(fp);
+  bptree *R = bptFromFile("bptTest.txt", sizeof(int), cmpInt,
+                          strToInt);
+  bptOwnData(R, free);
+  ok = checkTree(R, keys, n);
+  bptFree(R);
+  fp = fopen("bptTest.txt", "w");
+  for (size_t i = n; i > 0; i--)
+    writeInt(keys + i - 1, fp);
+  fclose(fp);
+  R = bptFromFile("bptTest.txt", sizeof(int), cmpInt, strToInt);
+  bptOwnData(R, free);
+  ok = ok && checkTree(R, keys, n);
+  bptFree(R);
+  remove("bptTest.txt");
+  printf("Write and read back: %s\n", ok ? "correct" : "WRONG");
+
+    // a second bulk load and unsorted data are refused
+  data[0] = keys + n - 1;
+  bptree *U = bptNew(cmpInt);
+  printf("Refused bulk loads: %s\n", ! bptBulkLoad(T, data, n) &&
+         ! bptBulkLoad(U, data, n) ? "correct" : "WRONG");
+  bptFree(T);
+  bptFree(U);
+
+    // a small tree to show its structure
+  T = bptNew(cmpInt);
+  bptSetShow(T, showInt);
+  for (size_t i = 0; i < 40; i++)
+    bptInsert(T, keys + 3 * (rand() % 100));
+  printf("\n");
+  bptShowTree(T);
+  printf("\nIn order: ");
+  bptShow(T);
+  bptFree(T);
+
+  free(keys);
+  free(data);
+  return 0;
+}
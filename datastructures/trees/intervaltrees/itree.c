@@ -0,0 +1,419 @@
+/*
+  Interval tree implementation, based on the red-black tree
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include <float.h>
+#include "itree.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// Returns the largest of three values
+static inline double max3 (double a, double b, double c) {
+  double m = a > b ? a : b;
+  return m > c ? m : c;
+}
+
+//===================================================================
+// Recomputes the max field of x from its children
+static inline void updateMax (itnode *x) {
+  x->max = max3(x->high, x->left->max, x->right->max);
+}
+
+//===================================================================
+// Returns true if the interval of x overlaps [low, high)
+static inline bool overlaps (itnode *x, double low, double high) {
+  return x->low < high && low < x->high;
+}
+
+//===================================================================
+// Creates a new interval tree
+itree *itNew (void) {
+  itree *T = safeCalloc(1, sizeof(itree));
+  T->NIL = safeCalloc(1, sizeof(itnode));
+  T->NIL->color = IT_BLACK;
+  T->NIL->max = -DBL_MAX;
+  T->NIL->parent = T->NIL->left = T->NIL->right = T->NIL;
+  T->ROOT = T->NIL;
+  return T;
+}
+
+//===================================================================
+// Sets the tree to own the data
+void itOwnData (itree *T, itFreeData free) {
+  T->free = free;
+}
+
+//===================================================================
+// Sets the show function for the data
+void itSetShow (itree *T, itShowData show) {
+  T->show = show;
+}
+
+//===================================================================
+// Deallocates a node
+static void itFreeNode (itree *T, itnode *n) {
+  if (T->free)
+    T->free(n->data);
+  free(n);
+}
+
+//===================================================================
+// Deallocates all nodes in the subtree rooted at x
+static void itFreeNodes (itree *T, itnode *x) {
+  if (x != T->NIL) {
+    itFreeNodes(T, x->left);
+    itFreeNodes(T, x->right);
+    itFreeNode(T, x);
+  }
+}
+
+//===================================================================
+// Deallocates the interval tree
+void itFree (itree *T) {
+  if (T) {
+    itFreeNodes(T, T->ROOT);
+    free(T->NIL);
+    free(T);
+  }
+}
+
+//===================================================================
+// Performs a left rotation on the subtree rooted at x
+static void leftRotate (itree *T, itnode *x) {
+  itnode *y = x->right;
+  x->right = y->left;
+  if (y->left != T->NIL)
+    y->left->parent = x;
+  y->parent = x->parent;
+  if (x->parent == T->NIL)
+    T->ROOT = y;
+  else if (x == x->parent->left)
+    x->parent->left = y;
+  else
+    x->parent->right = y;
+  y->left = x;
+  x->parent = y;
+  y->max = x->max;
+  updateMax(x);
+}
+
+//===================================================================
+// Performs a right rotation on the subtree rooted at x
+static void rightRotate (itree *T, itnode *x) {
+  itnode *y = x->left;
+  x->left = y->right;
+  if (y->right != T->NIL)
+    y->right->parent = x;
+  y->parent = x->parent;
+  if (x->parent == T->NIL)
+    T->ROOT = y;
+  else if (x == x->parent->right)
+    x->parent->right = y;
+  else
+    x->parent->left = y;
+  y->right = x;
+  x->parent = y;
+  y->max = x->max;
+  updateMax(x);
+}
+
+//===================================================================
+// Restores the red-black properties after insertion of z
+static void insertFixup (itree *T, itnode *z) {
+  while (z->parent->color == IT_RED) {
+    if (z->parent == z->parent->parent->left) {
+      itnode *y = z->parent->parent->right;
+      if (y->color == IT_RED) {
+        z->parent->color = IT_BLACK;
+        y->color = IT_BLACK;
+        z->parent->parent->color = IT_RED;
+        z = z->parent->parent;
+      } else {
+        if (z == z->parent->right) {
+          z = z->parent;
+          leftRotate(T, z);
+        }
+        z->parent->color = IT_BLACK;
+        z->parent->parent->color = IT_RED;
+        rightRotate(T, z->parent->parent);
+      }
+    } else {
+      itnode *y = z->parent->parent->left;
+      if (y->color == IT_RED) {
+        z->parent->color = IT_BLACK;
+        y->color = IT_BLACK;
+        z->parent->parent->color = IT_RED;
+        z = z->parent->parent;
+      } else {
+        if (z == z->parent->left) {
+          z = z->parent;
+          rightRotate(T, z);
+        }
+        z->parent->color = IT_BLACK;
+        z->parent->parent->color = IT_RED;
+        leftRotate(T, z->parent->parent);
+      }
+    }
+  }
+  T->ROOT->color = IT_BLACK;
+}
+
+//===================================================================
+// Inserts the interval [low, high) into the tree
+itnode *itInsert (itree *T, double low, double high, void *data) {
+  itnode *z = safeCalloc(1, sizeof(itnode));
+  z->low = low;
+  z->high = z->max = high;
+  z->data = data;
+  z->color = IT_RED;
+  z->left = z->right = T->NIL;
+
+    // the new interval is in the subtree of each node on
+    // its path, so their max fields are updated on the way
+  itnode *y = T->NIL;
+  itnode *x = T->ROOT;
+  while (x != T->NIL) {
+    y = x;
+    if (high > x->max)
+      x->max = high;
+    if (low < x->low)
+      x = x->left;
+    else
+      x = x->right;
+  }
+  z->parent = y;
+  if (y == T->NIL)
+    T->ROOT = z;
+  else if (low < y->low)
+    y->left = z;
+  else
+    y->right = z;
+  insertFixup(T, z);
+  T->size++;
+  return z;
+}
+
+//===================================================================
+// Replaces the subtree rooted at u with the subtree rooted at v
+static void itTransplant (itree *T, itnode *u, itnode *v) {
+  if (u->parent == T->NIL)
+    T->ROOT = v;
+  else if (u == u->parent->left)
+    u->parent->left = v;
+  else
+    u->parent->right = v;
+  v->parent = u->parent;
+}
+
+//===================================================================
+// Restores the red-black properties after deletion
+static void deleteFixup (itree *T, itnode *x) {
+  while (x != T->ROOT && x->color == IT_BLACK) {
+    if (x == x->parent->left) {
+      itnode *w = x->parent->right;
+      if (w->color == IT_RED) {
+        w->color = IT_BLACK;
+        x->parent->color = IT_RED;
+        leftRotate(T, x->parent);
+        w = x->parent->right;
+      }
+      if (w->left->color == IT_BLACK && w->right->color == IT_BLACK) {
+        w->color = IT_RED;
+        x = x->parent;
+      } else {
+        if (w->right->color == IT_BLACK) {
+          w->left->color = IT_BLACK;
+          w->color = IT_RED;
+          rightRotate(T, w);
+          w = x->parent->right;
+        }
+        w->color = x->parent->color;
+        x->parent->color = IT_BLACK;
+        w->right->color = IT_BLACK;
+        leftRotate(T, x->parent);
+        x = T->ROOT;
+      }
+    } else {
+      itnode *w = x->parent->left;
+      if (w->color == IT_RED) {
+        w->color = IT_BLACK;
+        x->parent->color = IT_RED;
+        rightRotate(T, x->parent);
+        w = x->parent->left;
+      }
+      if (w->right->color == IT_BLACK && w->left->color == IT_BLACK) {
+        w->color = IT_RED;
+        x = x->parent;
+      } else {
+        if (w->left->color == IT_BLACK) {
+          w->right->color = IT_BLACK;
+          w->color = IT_RED;
+          leftRotate(T, w);
+          w = x->parent->left;
+        }
+        w->color = x->parent->color;
+        x->parent->color = IT_BLACK;
+        w->left->color = IT_BLACK;
+        rightRotate(T, x->parent);
+        x = T->ROOT;
+      }
+    }
+  }
+  x->color = IT_BLACK;
+}
+
+//===================================================================
+// Deletes a node from the interval tree
+void itDelete (itree *T, itnode *z) {
+  itnode *y = z;
+  itnode *x;
+  int y_originalColor = y->color;
+  if (z->left == T->NIL) {
+    x = z->right;
+    itTransplant(T, z, z->right);
+  } else if (z->right == T->NIL) {
+    x = z->left;
+    itTransplant(T, z, z->left);
+  } else {
+    y = z->right;
+    while (y->left != T->NIL)
+      y = y->left;
+    y_originalColor = y->color;
+    x = y->right;
+    if (y->parent == z)
+      x->parent = y;
+    else {
+      itTransplant(T, y, y->right);
+      y->right = z->right;
+      y->right->parent = y;
+    }
+    itTransplant(T, z, y);
+    y->left = z->left;
+    y->left->parent = y;
+    y->color = z->color;
+  }
+
+    // the interval of z has left the subtrees of all nodes
+    // above the place where a node was removed, which include
+    // y if it took the place of z
+  for (itnode *p = x->parent; p != T->NIL; p = p->parent)
+    updateMax(p);
+
+  if (y_originalColor == IT_BLACK)
+    deleteFixup(T, x);
+  itFreeNode(T, z);
+  T->size--;
+}
+
+//===================================================================
+// Searches the subtree rooted at x for a node with exactly the
+// interval [low, high)
+static itnode *searchFrom (itree *T, itnode *x, double low,
+                           double high) {
+  while (x != T->NIL) {
+    if (low < x->low)
+      x = x->left;
+    else if (low > x->low)
+      x = x->right;
+    else if (x->high == high)
+      return x;
+    else {
+        // intervals with the same low endpoint may be in
+        // both subtrees of x
+      itnode *y = searchFrom(T, x->left, low, high);
+      if (y) return y;
+      x = x->right;
+    }
+  }
+  return NULL;
+}
+
+//===================================================================
+// Searches for a node with exactly the interval [low, high)
+itnode *itSearch (itree *T, double low, double high) {
+  return searchFrom(T, T->ROOT, low, high);
+}
+
+//===================================================================
+// Returns a node whose interval overlaps [low, high)
+itnode *itOverlap (itree *T, double low, double high) {
+  itnode *x = T->ROOT;
+  while (x != T->NIL && ! overlaps(x, low, high)) {
+      // if some interval in the left subtree ends after low,
+      // either it overlaps, or no interval to the right does
+    if (x->left != T->NIL && x->left->max > low)
+      x = x->left;
+    else
+      x = x->right;
+  }
+  return x == T->NIL ? NULL : x;
+}
+
+//===================================================================
+// Visits all nodes in the subtree rooted at x that overlap
+// [low, high); returns the number of such nodes
+static size_t visitOverlaps (itree *T, itnode *x, double low,
+                             double high, itVisit visit, void *arg) {
+  size_t count = 0;
+  while (x != T->NIL && x->max > low) {
+    count += visitOverlaps(T, x->left, low, high, visit, arg);
+    if (x->low >= high)
+        // all intervals to the right start even later
+      break;
+    if (low < x->high) {
+      visit(x, arg);
+      count++;
+    }
+    x = x->right;
+  }
+  return count;
+}
+
+//===================================================================
+// Calls visit for each node that overlaps [low, high)
+size_t itAllOverlaps (itree *T, double low, double high,
+                      itVisit visit, void *arg) {
+  return visitOverlaps(T, T->ROOT, low, high, visit, arg);
+}
+
+//===================================================================
+// Returns the node with the smallest low endpoint
+itnode *itMinimum (itree *T) {
+  itnode *x = T->ROOT;
+  if (x == T->NIL) return NULL;
+  while (x->left != T->NIL)
+    x = x->left;
+  return x;
+}
+
+//===================================================================
+// Returns the successor of a node
+itnode *itSuccessor (itree *T, itnode *x) {
+  if (x->right != T->NIL) {
+    x = x->right;
+    while (x->left != T->NIL)
+      x = x->left;
+    return x;
+  }
+  itnode *y = x->parent;
+  while (y != T->NIL && x == y->right) {
+    x = y;
+    y = y->parent;
+  }
+  return y == T->NIL ? NULL : y;
+}
+
+//===================================================================
+// Shows the intervals in the tree in order
+void itShow (itree *T) {
+  for (itnode *x = itMinimum(T); x; x = itSuccessor(T, x)) {
+    printf("[%g, %g)", x->low, x->high);
+    if (T->show) {
+      printf(": ");
+      T->show(x->data);
+    }
+    printf("\n");
+  }
+}
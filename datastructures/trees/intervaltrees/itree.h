@@ -0,0 +1,98 @@
+/*
+  Interval tree: a red-black tree of intervals, ordered by their
+  low endpoints, in which each node also keeps the maximum high
+  endpoint in its subtree (CLRS 17.3)
+  The intervals are half-open, [low, high), so that an interval
+  that ends at time t does not overlap one that starts at t;
+  closed integer intervals [a, b] can be stored as [a, b + 1)
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef ITREE_H_INCLUDED
+#define ITREE_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// function pointer types
+typedef void (*itShowData)(void const *data);
+typedef void (*itFreeData)(void *data);
+
+// data structures and types
+typedef struct itnode {
+  double low, high;           // interval [low, high)
+  double max;                 // largest high in the subtree
+  void *data;                 // data stored with the interval
+  enum {IT_RED, IT_BLACK} color;  // color of the node
+  struct itnode *parent;      // parent node
+  struct itnode *left;        // left child
+  struct itnode *right;       // right child
+} itnode;
+
+typedef struct {
+  itnode *ROOT, *NIL;         // root and sentinel nodes
+  itShowData show;            // show function
+  itFreeData free;            // function to free data
+  size_t size;                // number of tree nodes
+} itree;
+
+// function called for each overlapping interval
+typedef void (*itVisit)(itnode *x, void *arg);
+
+// function prototypes
+
+  // creates a new interval tree
+itree *itNew (void);
+
+  // sets the tree to own the data
+void itOwnData (itree *T, itFreeData free);
+
+  // sets the show function for the data
+void itSetShow (itree *T, itShowData show);
+
+  // deallocates the tree
+void itFree (itree *T);
+
+  // inserts the interval [low, high) with its data, and
+  // returns its node, which stays valid until it is deleted
+itnode *itInsert (itree *T, double low, double high, void *data);
+
+  // deletes a node from the tree
+void itDelete (itree *T, itnode *z);
+
+  // returns a node with exactly the interval [low, high),
+  // or NULL if there is none
+itnode *itSearch (itree *T, double low, double high);
+
+  // returns a node whose interval overlaps [low, high),
+  // or NULL if there is none
+itnode *itOverlap (itree *T, double low, double high);
+
+  // calls visit(x, arg) for each node x whose interval
+  // overlaps [low, high), in order of their low endpoints;
+  // returns the number of overlapping intervals
+size_t itAllOverlaps (itree *T, double low, double high,
+                      itVisit visit, void *arg);
+
+  // returns the node with the smallest low endpoint
+itnode *itMinimum (itree *T);
+
+  // returns the successor of a node, or NULL
+itnode *itSuccessor (itree *T, itnode *x);
+
+  // shows the intervals in the tree in order
+void itShow (itree *T);
+
+  // returns the number of intervals in the tree
+static inline size_t itSize (itree *T) {
+  return T->size;
+}
+
+  // returns true if the tree is empty
+static inline bool itIsEmpty (itree *T) {
+  return T->size == 0;
+}
+
+#endif  // ITREE_H_INCLUDED
@@ -0,0 +1,172 @@
+/*
+  Benchmark of the interval tree for lecture hall scheduling
+  Assigns n random bookings to halls, once offline as in lhs-3.c
+    (sort the start and end events, and keep a stack of free
+    halls), and once online as in lhs-5.c, in the order in which
+    the bookings arrive, by asking an interval tree for the
+    bookings that overlap the new one; the bookings arrive in
+    random order, and in order of their start times
+  Then times overlap queries on the tree of all bookings
+  Usage: ./bench.out [n] [number of queries]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../itree.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+typedef struct {
+  size_t start, end;       // booking [start, end)
+  size_t hall;             // hall assigned to the booking
+} booking;
+
+typedef struct {
+  size_t time;             // time of the event
+  size_t isStart;          // 0 for an end, 1 for a start event
+  booking *b;              // booking of the event
+} event;
+
+typedef struct {
+  size_t *busy;            // id of the booking for which the
+                           // hall was last found busy
+  size_t id;               // id of the booking being assigned
+} busyHalls;
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Compares two events by time; end events go first
+int cmpEvents (void const *a, void const *b) {
+  event *e1 = (event *)a, *e2 = (event *)b;
+  if (e1->time != e2->time)
+    return e1->time < e2->time ? -1 : 1;
+  return (int)e1->isStart - (int)e2->isStart;
+}
+
+//===================================================================
+// Compares two bookings by start time
+int cmpBookings (void const *a, void const *b) {
+  booking *b1 = (booking *)a, *b2 = (booking *)b;
+  return (b1->start > b2->start) - (b1->start < b2->start);
+}
+
+//===================================================================
+// Offline assignment, as in lhs-3.c; returns the number of halls
+size_t offline (booking *bs, size_t n) {
+  event *events = safeCalloc(2 * n, sizeof(event));
+  for (size_t i = 0; i < n; i++) {
+    events[2 * i] = (event){bs[i].start, 1, bs + i};
+    events[2 * i + 1] = (event){bs[i].end, 0, bs + i};
+  }
+  qsort(events, 2 * n, sizeof(event), cmpEvents);
+  size_t *freeHalls = safeCalloc(n, sizeof(size_t));
+  size_t nFree = 0, nHalls = 0;
+  for (size_t i = 0; i < 2 * n; i++) {
+    if (events[i].isStart)
+      events[i].b->hall = nFree ? freeHalls[--nFree] : nHalls++;
+    else
+      freeHalls[nFree++] = events[i].b->hall;
+  }
+  free(events);
+  free(freeHalls);
+  return nHalls;
+}
+
+//===================================================================
+// Marks the hall of an overlapping booking as busy
+void markBusy (itnode *x, void *arg) {
+  busyHalls *B = arg;
+  B->busy[((booking *)x->data)->hall] = B->id;
+}
+
+//===================================================================
+// Online assignment, as in lhs-5.c; returns the number of halls
+size_t online (booking *bs, size_t n, itree *T) {
+  busyHalls B = {safeCalloc(n, sizeof(size_t)), 0};
+  size_t nHalls = 0;
+  for (size_t i = 0; i < n; i++) {
+    B.id = i + 1;
+    itAllOverlaps(T, bs[i].start, bs[i].end, markBusy, &B);
+    size_t h = 0;
+    while (h < nHalls && B.busy[h] == B.id)
+      h++;
+    if (h == nHalls)
+      nHalls++;
+    bs[i].hall = h;
+    itInsert(T, bs[i].start, bs[i].end, bs + i);
+  }
+  free(B.busy);
+  return nHalls;
+}
+
+//===================================================================
+// Counts the visited nodes
+void countNode (itnode *x, void *arg) {
+  (*(size_t *)arg)++;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+  srand(time(NULL));
+
+    // bookings of 1 to 120 minutes in a year, in random order
+  size_t year = 365 * 24 * 60;
+  booking *bs = safeCalloc(n, sizeof(booking));
+  for (size_t i = 0; i < n; i++) {
+    bs[i].start = rand() % year;
+    bs[i].end = bs[i].start + 1 + rand() % 120;
+  }
+  printf("%zu bookings\n", n);
+
+  for (size_t sorted = 0; sorted < 2; sorted++) {
+    if (sorted)
+      qsort(bs, n, sizeof(booking), cmpBookings);
+    double start = now();
+    size_t hOff = offline(bs, n);
+    double tOff = now() - start;
+    itree *T = itNew();
+    start = now();
+    size_t hOn = online(bs, n, T);
+    double tOn = now() - start;
+    printf("  %s order:\n"
+           "    offline (lhs-3): %6.3f s, %zu halls\n"
+           "    online  (lhs-5): %6.3f s, %zu halls\n",
+           sorted ? "start time" : "random", tOff, hOff, tOn, hOn);
+
+    if (sorted) {
+        // overlap queries of one hour on the tree of all bookings
+      size_t count = 0;
+      start = now();
+      for (size_t i = 0; i < q; i++) {
+        size_t low = rand() % year;
+        count += itOverlap(T, low, low + 60) != NULL;
+      }
+      double t1 = now() - start;
+      size_t total = 0;
+      start = now();
+      for (size_t i = 0; i < q; i++) {
+        size_t low = rand() % year;
+        itAllOverlaps(T, low, low + 60, countNode, &total);
+      }
+      double t2 = now() - start;
+      printf("  %zu overlap queries of one hour:\n"
+             "    any overlap: %6.3f us/query (%zu hits)\n"
+             "    all overlaps: %6.3f us/query (%.1f per query)\n",
+             q, t1 * 1e6 / q, count, t2 * 1e6 / q, (double)total / q);
+    }
+    itFree(T);
+  }
+  free(bs);
+  return 0;
+}
@@ -0,0 +1,95 @@
+/*
+  Interval tree
+  Inserts and deletes random intervals, checks the max fields
+    and the red-black properties, and compares the overlap
+    queries with a scan over all intervals
+  Author: David De Potter
+*/
+
+#include "../itree.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+#define N 20000
+
+double lows[N], highs[N];
+itnode *nodes[N];
+
+//===================================================================
+// Checks the max fields and the red-black properties of the
+// subtree rooted at x; returns its black height
+size_t check (itree *T, itnode *x, bool *ok) {
+  if (x == T->NIL) return 1;
+  size_t hl = check(T, x->left, ok), hr = check(T, x->right, ok);
+  double max = x->high;
+  if (x->left->max > max) max = x->left->max;
+  if (x->right->max > max) max = x->right->max;
+  if (hl != hr || x->max != max ||
+      (x->color == IT_RED && (x->left->color == IT_RED ||
+                              x->right->color == IT_RED)))
+    *ok = false;
+  return hl + (x->color == IT_BLACK);
+}
+
+//===================================================================
+// Counts the visited nodes
+void countNode (itnode *x, void *arg) {
+  (*(size_t *)arg)++;
+}
+
+//===================================================================
+
+int main (void) {
+  srand(time(NULL));
+  itree *T = itNew();
+  bool ok = true;
+
+    // insert all intervals, then delete and reinsert some
+  for (size_t i = 0; i < N; i++) {
+    lows[i] = rand() % 100000;
+    highs[i] = lows[i] + 1 + rand() % 500;
+    nodes[i] = itInsert(T, lows[i], highs[i], NULL);
+  }
+  for (size_t r = 0; r < N; r++) {
+    size_t i = rand() % N;
+    if (nodes[i]) {
+      itDelete(T, nodes[i]);
+      nodes[i] = NULL;
+    } else
+      nodes[i] = itInsert(T, lows[i], highs[i], NULL);
+  }
+  check(T, T->ROOT, &ok);
+  size_t size = 0;
+  for (size_t i = 0; i < N; i++)
+    if (nodes[i]) {
+      size++;
+      if (! itSearch(T, lows[i], highs[i])) ok = false;
+    }
+  if (size != itSize(T)) ok = false;
+  printf("%zu intervals, tree is %s\n", size, ok ? "valid" : "INVALID");
+
+    // overlap queries
+  for (size_t q = 0; q < 2000; q++) {
+    double low = rand() % 100000, high = low + rand() % 100;
+    size_t count = 0, visited = 0;
+    for (size_t i = 0; i < N; i++)
+      if (nodes[i] && lows[i] < high && low < highs[i])
+        count++;
+    itnode *x = itOverlap(T, low, high);
+    if ((x != NULL) != (count > 0) ||
+        (x && ! (x->low < high && low < x->high)))
+      ok = false;
+    if (itAllOverlaps(T, low, high, countNode, &visited) != count ||
+        visited != count)
+      ok = false;
+  }
+  printf("Overlap queries: %s\n", ok ? "correct" : "WRONG");
+
+    // delete everything in order
+  while (! itIsEmpty(T))
+    itDelete(T, itMinimum(T));
+  printf("Empty after deleting all: %s\n",
+         T->ROOT == T->NIL ? "yes" : "no");
+  itFree(T);
+  return 0;
+}
@@ -0,0 +1,510 @@
+/*
+  Generic persistent red-black tree implementation
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "prbt.h"
+#include "../../../lib/clib.h"
+#include <stdint.h>
+
+  // bound on the height of a tree, which is at most
+  // 2 log(n + 1); one more is needed while deleting
+#define PRB_MAXDEPTH 130
+
+//===================================================================
+// Creates a new red node with given data for the current update
+static prbnode *newNode (prbtree *T, void *data) {
+  prbnode *n = safeCalloc(1, sizeof(prbnode));
+  n->data = data;
+  n->color = PRB_RED;
+  n->refs = 1;
+  n->stamp = T->stamp;
+  __atomic_add_fetch(&T->nodes, 1, __ATOMIC_RELAXED);
+  return n;
+}
+
+//===================================================================
+// Adds a reference to a node
+static inline void hold (prbnode *n) {
+  if (n)
+    __atomic_add_fetch(&n->refs, 1, __ATOMIC_RELAXED);
+}
+
+//===================================================================
+// Removes a reference to a node, and frees it if it was the last
+// one, which in turn removes the references to its children
+static void drop (prbtree *T, prbnode *n) {
+  while (n && __atomic_sub_fetch(&n->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+    prbnode *right = n->right;
+    drop(T, n->left);
+    free(n);
+    __atomic_sub_fetch(&T->nodes, 1, __ATOMIC_RELAXED);
+    n = right;
+  }
+}
+
+//===================================================================
+// Returns the node in *slot after replacing it by a copy if it
+// was created by an earlier update, so that it can be changed;
+// the original keeps its other references, at least the one
+// from the previous version, so that it is never freed here
+static prbnode *own (prbtree *T, prbnode **slot) {
+  prbnode *n = *slot;
+  if (n->stamp == T->stamp)
+    return n;
+  prbnode *c = newNode(T, n->data);
+  c->color = n->color;
+  c->left = n->left;
+  c->right = n->right;
+  hold(c->left);
+  hold(c->right);
+  drop(T, n);
+  *slot = c;
+  return c;
+}
+
+//===================================================================
+// Returns true if a node is black; NULL leaves are black
+static inline bool isBlack (prbnode *n) {
+  return ! n || n->color == PRB_BLACK;
+}
+
+//===================================================================
+// Performs a left rotation on the node in *slot; both the node
+// and its right child must belong to the current update
+static void leftRotate (prbnode **slot) {
+  prbnode *x = *slot, *y = x->right;
+  x->right = y->left;
+  y->left = x;
+  *slot = y;
+}
+
+//===================================================================
+// Performs a right rotation on the node in *slot; both the node
+// and its left child must belong to the current update
+static void rightRotate (prbnode **slot) {
+  prbnode *x = *slot, *y = x->left;
+  x->left = y->right;
+  y->right = x;
+  *slot = y;
+}
+
+//===================================================================
+// Returns the slot that points to path[i], which is either the
+// root of version V, or a child pointer of path[i - 1]
+static prbnode **slotOf (prbversion *V, prbnode **path, size_t i) {
+  if (i == 0)
+    return &V->root;
+  if (path[i - 1]->left == path[i])
+    return &path[i - 1]->left;
+  return &path[i - 1]->right;
+}
+
+//===================================================================
+// Creates a new version with the same nodes as the current one
+static prbversion *newVersion (prbtree *T) {
+  prbversion *V = safeCalloc(1, sizeof(prbversion));
+  V->root = T->current->root;
+  V->size = T->current->size;
+  V->refs = 1;
+  hold(V->root);
+  return V;
+}
+
+//===================================================================
+// Frees the replaced versions that no reader can still be using:
+// those replaced before the oldest epoch announced by a reader
+static void collect (prbtree *T) {
+  size_t oldest = SIZE_MAX;
+  for (size_t i = 0; i < T->nReaders; i++) {
+    size_t e = __atomic_load_n(&T->readers[i].epoch, __ATOMIC_SEQ_CST);
+    if (e && e < oldest)
+      oldest = e;
+  }
+  prbversion **v = &T->retired;
+  while (*v) {
+    if ((*v)->epoch < oldest) {
+      prbversion *old = *v;
+      *v = old->next;
+      prbtRelease(T, old);
+    } else
+      v = &(*v)->next;
+  }
+}
+
+//===================================================================
+// Makes V the current version; a reader that announced an epoch
+// later than the one in which the old version is replaced, will
+// find the new version, so that the old one can be freed as soon
+// as all readers have announced a later epoch or stopped reading
+static void publish (prbtree *T, prbversion *V) {
+  prbversion *old = T->current;
+  __atomic_store_n(&T->current, V, __ATOMIC_SEQ_CST);
+  old->epoch = __atomic_fetch_add(&T->epoch, 1, __ATOMIC_SEQ_CST);
+  old->next = T->retired;
+  T->retired = old;
+  collect(T);
+}
+
+//===================================================================
+// Creates a new persistent red-black tree
+prbtree *prbtNew (prbCmpData cmp, size_t nReaders) {
+  prbtree *T = safeCalloc(1, sizeof(prbtree));
+  T->cmp = cmp;
+  T->current = safeCalloc(1, sizeof(prbversion));
+  T->current->refs = 1;
+  T->epoch = 1;
+  T->nReaders = nReaders;
+  T->readers = safeCalloc(nReaders, sizeof(prbreader));
+  pthread_mutex_init(&T->lock, NULL);
+  return T;
+}
+
+//===================================================================
+// Sets the show function for the tree
+void prbtSetShow (prbtree *T, prbShowData show) {
+  T->show = show;
+}
+
+//===================================================================
+// Deallocates the tree and all its versions
+void prbtFree (prbtree *T) {
+  if (! T) return;
+  while (T->retired) {
+    prbversion *old = T->retired;
+    T->retired = old->next;
+    prbtRelease(T, old);
+  }
+  prbtRelease(T, T->current);
+  pthread_mutex_destroy(&T->lock);
+  free(T->readers);
+  free(T);
+}
+
+//===================================================================
+// Inserts the data into a copy of the path from the root to its
+// position, and restores the red-black properties as in CLRS,
+// with a stack of the copied nodes instead of parent pointers
+void prbtInsert (prbtree *T, void *data) {
+  pthread_mutex_lock(&T->lock);
+  T->stamp++;
+  prbversion *V = newVersion(T);
+  prbnode *path[PRB_MAXDEPTH];
+  size_t d = 0;
+
+  prbnode **slot = &V->root;
+  while (*slot) {
+    prbnode *x = own(T, slot);
+    path[d++] = x;
+    slot = T->cmp(data, x->data) < 0 ? &x->left : &x->right;
+  }
+  prbnode *z = *slot = newNode(T, data);
+
+    // a red parent is not the root, so that d >= 2
+  while (d > 0 && path[d - 1]->color == PRB_RED) {
+    prbnode *p = path[d - 1], *g = path[d - 2];
+    if (p == g->left) {
+      if (! isBlack(g->right)) {
+        own(T, &g->right)->color = PRB_BLACK;
+        p->color = PRB_BLACK;
+        g->color = PRB_RED;
+        z = g;
+        d -= 2;
+      } else {
+        if (z == p->right) {
+          leftRotate(&g->left);
+          p = g->left;
+        }
+        p->color = PRB_BLACK;
+        g->color = PRB_RED;
+        rightRotate(slotOf(V, path, d - 2));
+        break;
+      }
+    } else {
+      if (! isBlack(g->left)) {
+        own(T, &g->left)->color = PRB_BLACK;
+        p->color = PRB_BLACK;
+        g->color = PRB_RED;
+        z = g;
+        d -= 2;
+      } else {
+        if (z == p->left) {
+          rightRotate(&g->right);
+          p = g->right;
+        }
+        p->color = PRB_BLACK;
+        g->color = PRB_RED;
+        leftRotate(slotOf(V, path, d - 2));
+        break;
+      }
+    }
+  }
+  V->root->color = PRB_BLACK;
+  V->size++;
+  publish(T, V);
+  pthread_mutex_unlock(&T->lock);
+}
+
+//===================================================================
+// Restores the red-black properties after a black node was
+// removed above x, the child of path[d - 1], as in CLRS; the
+// sibling of x and its children are copied before they change
+static void deleteFixup (prbtree *T, prbversion *V, prbnode **path,
+                         size_t d, prbnode *x) {
+
+    // a NULL x has a sibling, since it misses a black node
+  while (d > 0 && isBlack(x)) {
+    prbnode *p = path[d - 1];
+    prbnode **pslot = slotOf(V, path, d - 1);
+    if (x == p->left) {
+      prbnode *w = own(T, &p->right);
+      if (w->color == PRB_RED) {
+        w->color = PRB_BLACK;
+        p->color = PRB_RED;
+        leftRotate(pslot);
+        path[d - 1] = w;      // w is now the parent of p
+        path[d++] = p;
+        pslot = &w->left;
+        w = own(T, &p->right);
+      }
+      if (isBlack(w->left) && isBlack(w->right)) {
+        w->color = PRB_RED;
+        x = p;
+        d--;
+      } else {
+        if (isBlack(w->right)) {
+          own(T, &w->left)->color = PRB_BLACK;
+          w->color = PRB_RED;
+          rightRotate(&p->right);
+          w = p->right;
+        }
+        w->color = p->color;
+        p->color = PRB_BLACK;
+        own(T, &w->right)->color = PRB_BLACK;
+        leftRotate(pslot);
+        return;
+      }
+    } else {
+      prbnode *w = own(T, &p->left);
+      if (w->color == PRB_RED) {
+        w->color = PRB_BLACK;
+        p->color = PRB_RED;
+        rightRotate(pslot);
+        path[d - 1] = w;
+        path[d++] = p;
+        pslot = &w->right;
+        w = own(T, &p->left);
+      }
+      if (isBlack(w->left) && isBlack(w->right)) {
+        w->color = PRB_RED;
+        x = p;
+        d--;
+      } else {
+        if (isBlack(w->left)) {
+          own(T, &w->right)->color = PRB_BLACK;
+          w->color = PRB_RED;
+          leftRotate(&p->left);
+          w = p->left;
+        }
+        w->color = p->color;
+        p->color = PRB_BLACK;
+        own(T, &w->left)->color = PRB_BLACK;
+        rightRotate(pslot);
+        return;
+      }
+    }
+  }
+  if (x) {
+    if (d == 0)
+      own(T, &V->root)->color = PRB_BLACK;
+    else if (path[d - 1]->left == x)
+      own(T, &path[d - 1]->left)->color = PRB_BLACK;
+    else
+      own(T, &path[d - 1]->right)->color = PRB_BLACK;
+  }
+}
+
+//===================================================================
+// Deletes a node with the given key from a copy of the path from
+// the root to the node that is removed; as in CLRS, that is the
+// node itself if it has at most one child, and otherwise its
+// successor, whose data then replaces that of the node
+bool prbtDelete (prbtree *T, void *key) {
+  pthread_mutex_lock(&T->lock);
+  if (! prbtSearch(T, T->current, key)) {
+    pthread_mutex_unlock(&T->lock);
+    return false;
+  }
+  T->stamp++;
+  prbversion *V = newVersion(T);
+  prbnode *path[PRB_MAXDEPTH];
+  size_t d = 0;
+
+  prbnode **slot = &V->root;
+  int c;
+  while ((c = T->cmp(key, (*slot)->data)) != 0) {
+    prbnode *x = own(T, slot);
+    path[d++] = x;
+    slot = c < 0 ? &x->left : &x->right;
+  }
+  prbnode **yslot = slot;
+  if ((*slot)->left && (*slot)->right) {
+    prbnode *z = own(T, slot);
+    path[d++] = z;
+    yslot = &z->right;
+    while ((*yslot)->left) {
+      prbnode *w = own(T, yslot);
+      path[d++] = w;
+      yslot = &w->left;
+    }
+    z->data = (*yslot)->data;
+  }
+
+    // y has at most one child x, which takes its place
+  prbnode *y = *yslot;
+  prbnode *x = y->left ? y->left : y->right;
+  prbColor color = y->color;
+  hold(x);
+  *yslot = x;
+  drop(T, y);
+  if (color == PRB_BLACK)
+    deleteFixup(T, V, path, d, x);
+  V->size--;
+  publish(T, V);
+  pthread_mutex_unlock(&T->lock);
+  return true;
+}
+
+//===================================================================
+// Starts a read section and returns the current version
+prbversion *prbtReadBegin (prbtree *T, size_t reader) {
+  size_t e = __atomic_load_n(&T->epoch, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&T->readers[reader].epoch, e, __ATOMIC_SEQ_CST);
+  return __atomic_load_n(&T->current, __ATOMIC_SEQ_CST);
+}
+
+//===================================================================
+// Ends a read section
+void prbtReadEnd (prbtree *T, size_t reader) {
+  __atomic_store_n(&T->readers[reader].epoch, 0, __ATOMIC_RELEASE);
+}
+
+//===================================================================
+// Returns the current version with a reference to it; within the
+// read section, the version cannot be freed before it is taken
+prbversion *prbtSnapshot (prbtree *T, size_t reader) {
+  prbversion *V = prbtReadBegin(T, reader);
+  __atomic_add_fetch(&V->refs, 1, __ATOMIC_RELAXED);
+  prbtReadEnd(T, reader);
+  return V;
+}
+
+//===================================================================
+// Releases a reference to a version, and frees it if it was the
+// last one, together with the nodes that only it used
+void prbtRelease (prbtree *T, prbversion *V) {
+  if (__atomic_sub_fetch(&V->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+    drop(T, V->root);
+    free(V);
+  }
+}
+
+//===================================================================
+// Searches version V for a key
+void *prbtSearch (prbtree *T, prbversion *V, void *key) {
+  prbnode *x = V->root;
+  while (x) {
+    int c = T->cmp(key, x->data);
+    if (c == 0)
+      return x->data;
+    x = c < 0 ? x->left : x->right;
+  }
+  return NULL;
+}
+
+//===================================================================
+// Returns the data with the smallest key not less than key
+void *prbtLowerBound (prbtree *T, prbversion *V, void *key) {
+  prbnode *x = V->root;
+  void *data = NULL;
+  while (x) {
+    if (T->cmp(x->data, key) < 0)
+      x = x->right;
+    else {
+      data = x->data;
+      x = x->left;
+    }
+  }
+  return data;
+}
+
+//===================================================================
+// Visits the data in the subtree rooted at x in order
+static void prbtVisitNodes (prbnode *x, prbVisitData visit,
+                            void *arg) {
+  if (x) {
+    prbtVisitNodes(x->left, visit, arg);
+    visit(x->data, arg);
+    prbtVisitNodes(x->right, visit, arg);
+  }
+}
+
+//===================================================================
+// Visits the data in version V in order
+void prbtVisit (prbversion *V, prbVisitData visit, void *arg) {
+  prbtVisitNodes(V->root, visit, arg);
+}
+
+//===================================================================
+// Returns the height of the subtree rooted at x
+static size_t prbtSubtreeHeight (prbnode *x) {
+  if (! x)
+    return 0;
+  size_t left = prbtSubtreeHeight(x->left);
+  size_t right = prbtSubtreeHeight(x->right);
+  return 1 + MAX(left, right);
+}
+
+//===================================================================
+// Returns the height of version V
+size_t prbtHeight (prbversion *V) {
+  return prbtSubtreeHeight(V->root);
+}
+
+//===================================================================
+// Shows all levels of the subtree rooted at x by in-order
+// traversal; the parent is passed on, since nodes do not know it
+static void prbtShowLevels (prbtree *T, prbnode *x, prbnode *parent,
+                            size_t level) {
+  if (! x) return;
+
+  prbtShowLevels(T, x->left, x, level + 1);
+
+  if (level) {
+    for (size_t i = 0; i < level; i++)
+      printf("-");
+    if (parent->left == x)
+      printf("|L(%zu): ", level);
+    else
+      printf("|R(%zu): ", level);
+  } else
+    printf("ROOT: ");
+  T->show(x->data);
+  printf(x->color == PRB_RED ? " (R)\n" : " (B)\n");
+
+  prbtShowLevels(T, x->right, x, level + 1);
+}
+
+//===================================================================
+// Shows the structure of version V
+void prbtShowTree (prbtree *T, prbversion *V) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  printf("--------------\n"
+         "Tree structure\n"
+         "--------------\n");
+  prbtShowLevels(T, V->root, NULL, 0);
+}
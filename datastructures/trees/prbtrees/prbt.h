@@ -0,0 +1,138 @@
+/*
+  Generic persistent red-black tree implementation
+    An update never changes a node that may be seen by a reader:
+    it copies the nodes on the path from the root to the changed
+    node, and the few nodes around it that are recolored or
+    rotated, and publishes the result as a new version of the
+    tree. All other nodes are shared with the previous version.
+  Readers hence need no locks: a reader announces that it is
+    reading (prbtReadBegin), which gives it the current version,
+    and can then search that version for as long as it likes,
+    while the writer keeps publishing new ones.
+  Memory is reclaimed with epochs and reference counts: a version
+    that is replaced is kept until no reader that could have seen
+    it is still reading, and a node is freed when the last
+    version or node pointing to it is gone. A version can also
+    be kept after the read section, as a snapshot.
+  Updates are serialized by a mutex, so that there may be several
+    writers. The tree never frees the data items, which must hence
+    outlive all versions that contain them.
+  Programs using this tree must be linked with -pthread.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef PRBT_H_INCLUDED
+#define PRBT_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+
+// function pointer types
+typedef int (*prbCmpData)(void const *a, void const *b);
+typedef void (*prbShowData)(void const *data);
+typedef void (*prbVisitData)(void *data, void *arg);
+
+typedef enum { PRB_RED, PRB_BLACK } prbColor;
+
+// data structures and types
+typedef struct prbnode {
+  void *data;                 // data stored in the node
+  prbColor color;             // node color
+  size_t refs;                // number of pointers to the node
+  size_t stamp;               // update that created the node
+  struct prbnode *left;       // left child
+  struct prbnode *right;      // right child
+} prbnode;
+
+typedef struct prbversion {
+  prbnode *root;              // root of this version, or NULL
+  size_t size;                // number of nodes in this version
+  size_t refs;                // number of references to the version
+  size_t epoch;               // epoch in which it was replaced
+  struct prbversion *next;    // next version waiting to be freed
+} prbversion;
+
+typedef struct {
+  size_t epoch;               // announced epoch, 0 if not reading
+  char pad[56];               // keeps readers in separate cache lines
+} prbreader;
+
+typedef struct {
+  prbversion *current;        // latest version
+  prbCmpData cmp;             // comparison function
+  prbShowData show;           // show function
+  pthread_mutex_t lock;       // serializes the updates
+  size_t stamp;               // number of updates so far
+  size_t epoch;               // global epoch, starts at 1
+  prbversion *retired;        // replaced versions not yet freed
+  prbreader *readers;         // announced epochs of the readers
+  size_t nReaders;            // number of reader slots
+  size_t nodes;               // number of allocated nodes
+} prbtree;
+
+// function prototypes
+
+  // creates a new persistent red-black tree for nReaders
+  // reader threads, numbered 0 to nReaders - 1
+prbtree *prbtNew (prbCmpData cmp, size_t nReaders);
+
+  // sets the show function for the tree
+void prbtSetShow (prbtree *T, prbShowData show);
+
+  // deallocates the tree and all its versions; no thread
+  // may be reading, and all snapshots must have been released
+void prbtFree (prbtree *T);
+
+  // publishes a new version with the data inserted
+void prbtInsert (prbtree *T, void *data);
+
+  // publishes a new version without the (or one) node with the
+  // given key; returns false if there is no such node, in which
+  // case no new version is published
+bool prbtDelete (prbtree *T, void *key);
+
+  // starts a read section for the given reader, and returns the
+  // current version, which remains valid until prbtReadEnd
+prbversion *prbtReadBegin (prbtree *T, size_t reader);
+
+  // ends the read section of the given reader
+void prbtReadEnd (prbtree *T, size_t reader);
+
+  // returns the current version, which remains valid until it is
+  // released with prbtRelease, also after the read section; the
+  // reader must not be in a read section when calling this
+prbversion *prbtSnapshot (prbtree *T, size_t reader);
+
+  // releases a snapshot
+void prbtRelease (prbtree *T, prbversion *V);
+
+  // returns the data with the given key in version V, or NULL
+void *prbtSearch (prbtree *T, prbversion *V, void *key);
+
+  // returns the data with the smallest key not less than key
+  // in version V, or NULL if there is none
+void *prbtLowerBound (prbtree *T, prbversion *V, void *key);
+
+  // calls visit(data, arg) for the data in version V in order
+void prbtVisit (prbversion *V, prbVisitData visit, void *arg);
+
+  // returns the number of nodes in version V
+static inline size_t prbtSize (prbversion *V) {
+  return V->size;
+}
+
+  // returns the height of version V
+size_t prbtHeight (prbversion *V);
+
+  // shows the structure of version V
+void prbtShowTree (prbtree *T, prbversion *V);
+
+  // returns the number of allocated nodes, over all versions
+static inline size_t prbtNodes (prbtree *T) {
+  return __atomic_load_n(&T->nodes, __ATOMIC_RELAXED);
+}
+
+#endif  // PRBT_H_INCLUDED
@@ -0,0 +1,170 @@
+/*
+  Benchmark of concurrent readers and a writer on the persistent
+    red-black tree, against the red-black tree behind a
+    readers-writer lock
+  Starts from n random keys; one writer keeps inserting and deleting
+    random keys, while the readers keep searching random keys,
+    taking a read section (or the read lock) per batch of searches;
+    reports the searches and the updates per second, and the number
+    of allocated nodes of the persistent tree at the end, which
+    includes the versions the readers were still using
+  Usage: ./bench.out [n] [seconds per run] [max readers]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../prbt.h"
+#include "../../rbtrees/rbt.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+#include <unistd.h>
+
+#define BATCH 64             // searches per read section
+
+typedef struct {
+  prbtree *P;                // persistent tree, or NULL
+  rbtree *T;                 // locked tree, if P is NULL
+  pthread_rwlock_t *lock;    // lock for T
+  int *keys;                 // the keys
+  size_t n;                  // keys are in [0, n)
+  size_t id;                 // thread number
+  bool *stop;                // set at the end of the run
+  size_t ops;                // searches or updates done
+} worker;
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the next number of a xorshift generator, since rand
+// is not meant to be called by several threads
+static inline uint64_t nextRand (uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+//===================================================================
+// Searches random keys in batches until the run is over
+void *readKeys (void *arg) {
+  worker *w = arg;
+  uint64_t state = 0x9e3779b97f4a7c15ULL * (w->id + 1);
+  size_t found = 0;
+  while (! __atomic_load_n(w->stop, __ATOMIC_RELAXED)) {
+    if (w->P) {
+      prbversion *V = prbtReadBegin(w->P, w->id);
+      for (size_t i = 0; i < BATCH; i++)
+        found += prbtSearch(w->P, V,
+                            w->keys + nextRand(&state) % w->n) != NULL;
+      prbtReadEnd(w->P, w->id);
+    } else {
+      pthread_rwlock_rdlock(w->lock);
+      for (size_t i = 0; i < BATCH; i++)
+        found += rbtSearch(w->T,
+                           w->keys + nextRand(&state) % w->n) != NULL;
+      pthread_rwlock_unlock(w->lock);
+    }
+    w->ops += BATCH;
+  }
+  return (void *)found;
+}
+
+//===================================================================
+// Inserts and deletes random keys until the run is over
+void *writeKeys (void *arg) {
+  worker *w = arg;
+  uint64_t state = 0x2545f4914f6cdd1dULL;
+  while (! __atomic_load_n(w->stop, __ATOMIC_RELAXED)) {
+    int *key = w->keys + nextRand(&state) % w->n;
+    if (w->P) {
+      if (w->ops % 2)
+        prbtDelete(w->P, key);
+      else
+        prbtInsert(w->P, key);
+    } else {
+      pthread_rwlock_wrlock(w->lock);
+      rbnode *x;
+      if (w->ops % 2 == 0)
+        rbtInsert(w->T, key);
+      else if ((x = rbtSearch(w->T, key)))
+        rbtDelete(w->T, x);
+      pthread_rwlock_unlock(w->lock);
+    }
+    w->ops++;
+  }
+  return NULL;
+}
+
+//===================================================================
+// Runs a writer and r readers on one of the trees for the given
+// number of seconds
+static void run (prbtree *P, rbtree *T, int *keys, size_t n,
+                 size_t r, double seconds) {
+  pthread_rwlock_t lock;
+  pthread_rwlock_init(&lock, NULL);
+  pthread_t *threads = safeCalloc(r + 1, sizeof(pthread_t));
+  worker *workers = safeCalloc(r + 1, sizeof(worker));
+  bool stop = false;
+  for (size_t i = 0; i <= r; i++) {
+    workers[i] = (worker){P, T, &lock, keys, n, i, &stop, 0};
+    pthread_create(threads + i, NULL, i < r ? readKeys : writeKeys,
+                   workers + i);
+  }
+  struct timespec ts = {(time_t)seconds,
+                        (long)((seconds - (time_t)seconds) * 1e9)};
+  nanosleep(&ts, NULL);
+  __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+  size_t reads = 0;
+  for (size_t i = 0; i <= r; i++) {
+    pthread_join(threads[i], NULL);
+    if (i < r)
+      reads += workers[i].ops;
+  }
+  printf("    %-10s %10.0f searches/s %9.0f updates/s", P ?
+         "persistent" : "rwlock", reads / seconds,
+         workers[r].ops / seconds);
+  if (P)
+    printf("  (%zu nodes)", prbtNodes(P));
+  printf("\n");
+  pthread_rwlock_destroy(&lock);
+  free(threads);
+  free(workers);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  double seconds = argc > 2 ? atof(argv[2]) : 1;
+  size_t maxReaders = argc > 3 ? strtoul(argv[3], NULL, 10) : 4;
+  srand(time(NULL));
+
+    // keys in [0, 2n), n of them in the initial trees
+  int *keys = safeCalloc(2 * n, sizeof(int));
+  for (size_t i = 0; i < 2 * n; i++)
+    keys[i] = i;
+  printf("%zu keys, %ld processors\n", n, sysconf(_SC_NPROCESSORS_ONLN));
+
+  for (size_t r = 1; r <= maxReaders; r *= 2) {
+    prbtree *P = prbtNew(cmpInt, r);
+    rbtree *T = rbtNew(cmpInt);
+    for (size_t i = 0; i < n; i++) {
+      int *key = keys + rand() % (2 * n);
+      prbtInsert(P, key);
+      rbtInsert(T, key);
+    }
+    printf("  %zu reader%s and a writer\n", r, r > 1 ? "s" : "");
+    run(P, NULL, keys, 2 * n, r, seconds);
+    run(NULL, T, keys, 2 * n, r, seconds);
+    prbtFree(P);
+    rbtFree(T);
+  }
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*
+  Tests of the persistent red-black tree
+  Checks the red-black properties of each new version under random
+    insertions and deletions, checks that snapshots taken along
+    the way never change, and that all nodes that are no longer
+    used are freed; then lets reader threads check the versions
+    they find while a writer keeps updating the tree
+  Usage: ./prbtTest.out [number of readers]
+  Author: David De Potter
+*/
+
+#include "../prbt.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+
+#define N 1000               // keys are in [0, N)
+#define SNAPSHOTS 50
+
+typedef struct {
+  int *keys;                 // keys found so far
+  size_t n;                  // number of keys found
+} collector;
+
+typedef struct {
+  prbtree *T;                // the tree
+  size_t id;                 // reader number
+  bool *stop;                // set when the writer is done
+  bool ok;                   // false if a version was invalid
+  size_t reads;              // number of versions checked
+} reader;
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Shows an integer
+void showInt (void const *a) {
+  printf("%d", *(int *)a);
+}
+
+//===================================================================
+// Adds a key to a collector
+void collect (void *data, void *arg) {
+  collector *c = arg;
+  c->keys[c->n++] = *(int *)data;
+}
+
+//===================================================================
+// Checks the red-black properties of the subtree rooted at x;
+// returns its black height
+static size_t checkRbt (prbnode *x, bool *ok) {
+  if (! x)
+    return 1;
+  if (x->color == PRB_RED &&
+      ((x->left && x->left->color == PRB_RED) ||
+       (x->right && x->right->color == PRB_RED)))
+    *ok = false;
+  size_t left = checkRbt(x->left, ok);
+  if (left != checkRbt(x->right, ok))
+    *ok = false;
+  return left + (x->color == PRB_BLACK);
+}
+
+//===================================================================
+// Returns true if version V is a valid red-black tree whose keys
+// are sorted, and are counted by count if it is not NULL
+static bool checkVersion (prbversion *V, int *count) {
+  bool ok = ! V->root || V->root->color == PRB_BLACK;
+  checkRbt(V->root, &ok);
+  collector c = {safeCalloc(prbtSize(V) + 1, sizeof(int)), 0};
+  prbtVisit(V, collect, &c);
+  if (c.n != prbtSize(V))
+    ok = false;
+  for (size_t i = 1; i < c.n; i++)
+    if (c.keys[i - 1] > c.keys[i])
+      ok = false;
+  if (count) {
+    int copy[N] = {0};
+    for (size_t i = 0; i < c.n; i++)
+      copy[c.keys[i]]++;
+    for (size_t i = 0; i < N; i++)
+      if (copy[i] != count[i])
+        ok = false;
+  }
+  free(c.keys);
+  return ok;
+}
+
+//===================================================================
+// Checks the versions of the tree until the writer is done
+void *readVersions (void *arg) {
+  reader *r = arg;
+  while (! __atomic_load_n(r->stop, __ATOMIC_ACQUIRE)) {
+    prbversion *V = prbtReadBegin(r->T, r->id);
+    if (! checkVersion(V, NULL))
+      r->ok = false;
+    prbtReadEnd(r->T, r->id);
+    r->reads++;
+  }
+  return NULL;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t nReaders = argc > 1 ? strtoul(argv[1], NULL, 10) : 3;
+  srand(time(NULL));
+  int *values = safeCalloc(N, sizeof(int));
+  for (int i = 0; i < N; i++)
+    values[i] = i;
+
+    // a small tree
+  prbtree *T = prbtNew(cmpInt, nReaders + 1);
+  prbtSetShow(T, showInt);
+  for (int i = 0; i < 20; i++)
+    prbtInsert(T, values + rand() % 100);
+  prbversion *V = prbtSnapshot(T, 0);
+  prbtShowTree(T, V);
+  prbtRelease(T, V);
+  prbtFree(T);
+
+    // random updates, with a snapshot now and then
+  T = prbtNew(cmpInt, nReaders + 1);
+  int count[N] = {0};
+  int *expected[SNAPSHOTS];
+  prbversion *snapshots[SNAPSHOTS];
+  size_t nSnapshots = 0;
+  bool ok = true;
+  for (size_t i = 0; i < 40 * N; i++) {
+    int key = rand() % N;
+    if (rand() % 3) {
+      prbtInsert(T, values + key);
+      count[key]++;
+    } else if (prbtDelete(T, &key) != (count[key] > 0))
+      ok = false;
+    else if (count[key])
+      count[key]--;
+    V = prbtReadBegin(T, 0);
+    if (! checkVersion(V, count))
+      ok = false;
+    prbtReadEnd(T, 0);
+    if (i % (40 * N / SNAPSHOTS) == 0 && nSnapshots < SNAPSHOTS) {
+      snapshots[nSnapshots] = prbtSnapshot(T, 0);
+      expected[nSnapshots] = safeCalloc(N, sizeof(int));
+      memcpy(expected[nSnapshots++], count, sizeof(count));
+    }
+  }
+  for (size_t i = 0; i < nSnapshots; i++) {
+    if (! checkVersion(snapshots[i], expected[i]))
+      ok = false;
+    prbtRelease(T, snapshots[i]);
+    free(expected[i]);
+  }
+  printf("\nRandom updates and snapshots: %s\n",
+         ok ? "passed" : "FAILED");
+
+    // the old versions are freed by the next update
+  prbtInsert(T, values);
+  V = prbtReadBegin(T, 0);
+  size_t size = prbtSize(V);
+  prbtReadEnd(T, 0);
+  printf("Nodes left after releasing the snapshots: %zu of %zu "
+         "(%s)\n", prbtNodes(T), size,
+         prbtNodes(T) == size ? "passed" : "FAILED");
+
+    // concurrent readers
+  pthread_t *threads = safeCalloc(nReaders, sizeof(pthread_t));
+  reader *readers = safeCalloc(nReaders, sizeof(reader));
+  bool stop = false;
+  for (size_t i = 0; i < nReaders; i++) {
+    readers[i] = (reader){T, i + 1, &stop, true, 0};
+    pthread_create(threads + i, NULL, readVersions, readers + i);
+  }
+  for (size_t i = 0; i < 20 * N; i++) {
+    int key = rand() % N;
+    if (rand() % 2)
+      prbtInsert(T, values + key);
+    else
+      prbtDelete(T, &key);
+  }
+  __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+  ok = true;
+  size_t reads = 0;
+  for (size_t i = 0; i < nReaders; i++) {
+    pthread_join(threads[i], NULL);
+    ok = ok && readers[i].ok;
+    reads += readers[i].reads;
+  }
+  printf("Concurrent readers: %zu versions checked (%s)\n", reads,
+         ok ? "passed" : "FAILED");
+
+  free(threads);
+  free(readers);
+  free(values);
+  prbtFree(T);
+  return 0;
+}
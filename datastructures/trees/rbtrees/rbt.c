@@ -17,6 +17,7 @@ static rbnode *rbtNewNode (rbtree *T, void *data) {
     n->data = data;
   n->color = RED;
   n->parent = n->left = n->right = T->NIL;
+  n->size = 1;
   return n;
 }
 
@@ -28,6 +29,7 @@ rbtree *rbtNew (rbtCmpData cmp) {
   T->cmp = cmp;
   T->NIL = rbtNewNode(T, NULL);
   T->NIL->color = BLACK;
+  T->NIL->size = 0;
   T->ROOT = T->NIL;
   return T;
 }
@@ -130,18 +132,60 @@ rbnode *rbtPredecessor (rbtree *T, rbnode *x) {
 }
 
 //===================================================================
-// Searches for a key in the red-black tree
-rbnode *rbtSearch (rbtree *T, void *key) {
+// Returns the node with the k-th smallest key
+rbnode *rbtSelect (rbtree *T, size_t k) {
+  if (k == 0 || k > T->size)
+    return NULL;
   rbnode *x = T->ROOT;
-  while (x != T->NIL && T->cmp(x->data, key) != 0){
-    if (T->cmp(key, x->data) < 0)
+  while (true) {
+    size_t r = x->left->size + 1;
+    if (k == r)
+      return x;
+    if (k < r)
       x = x->left;
-    else
+    else {
+      k -= r;
       x = x->right;
+    }
   }
-  if (x == T->NIL)
-    return NULL;
-  return x;
+}
+
+//===================================================================
+// Returns the position of node x in the in-order traversal
+size_t rbtRank (rbtree *T, rbnode *x) {
+  size_t r = x->left->size + 1;
+  for (rbnode *y = x; y != T->ROOT; y = y->parent)
+    if (y == y->parent->right)
+      r += y->parent->left->size + 1;
+  return r;
+}
+
+//===================================================================
+// Returns the number of nodes with a key less than key
+size_t rbtCountLess (rbtree *T, void *key) {
+  size_t count = 0;
+  rbnode *x = T->ROOT;
+  while (x != T->NIL) {
+    if (T->cmp(x->data, key) < 0) {
+      count += x->left->size + 1;
+      x = x->right;
+    } else
+      x = x->left;
+  }
+  return count;
+}
+
+//===================================================================
+// Searches for a key in the red-black tree
+rbnode *rbtSearch (rbtree *T, void *key) {
+  rbnode *x = T->ROOT;
+  while (x != T->NIL) {
+    int c = T->cmp(key, x->data);
+    if (c == 0)
+      return x;
+    x = c < 0 ? x->left : x->right;
+  }
+  return NULL;
 }
 
 //===================================================================
@@ -160,6 +204,8 @@ static void leftRotate (rbtree *T, rbnode *x) {
     x->parent->right = y;
   y->left = x;
   x->parent = y;
+  y->size = x->size;
+  x->size = x->left->size + x->right->size + 1;
 }
 
 //===================================================================
@@ -178,6 +224,8 @@ static void rightRotate (rbtree *T, rbnode *x) {
     x->parent->left = y;
   y->right = x;
   x->parent = y;
+  y->size = x->size;
+  x->size = x->left->size + x->right->size + 1;
 }
 
 //===================================================================
@@ -230,6 +278,7 @@ void rbtInsert (rbtree *T, void *data) {
 
   while (x != T->NIL) {
     y = x;
+    x->size++;
     if (T->cmp(z->data, x->data) < 0)
       x = x->left;
     else
@@ -246,6 +295,53 @@ void rbtInsert (rbtree *T, void *data) {
   T->size++;
 }
 
+//===================================================================
+// Builds a perfectly balanced subtree from the sorted data in
+// [lo, hi), with its root at the given depth; only the nodes at
+// the red depth, the deepest level if it is not full, are red
+static rbnode *rbtBuild (rbtree *T, void **data, size_t lo,
+    size_t hi, size_t depth, size_t redDepth, rbnode *parent) {
+  if (lo == hi)
+    return T->NIL;
+  size_t mid = lo + (hi - lo) / 2;
+  rbnode *x = rbtNewNode(T, data[mid]);
+  x->parent = parent;
+  x->color = depth == redDepth ? RED : BLACK;
+  x->size = hi - lo;
+  x->left = rbtBuild(T, data, lo, mid, depth + 1, redDepth, x);
+  x->right = rbtBuild(T, data, mid + 1, hi, depth + 1, redDepth, x);
+  return x;
+}
+
+//===================================================================
+// Builds a balanced tree from n data items sorted by key
+bool rbtBulkLoad (rbtree *T, void **data, size_t n) {
+  if (T->ROOT != T->NIL) {
+    fprintf(stderr, "rbtBulkLoad: tree is not empty\n");
+    return false;
+  }
+  for (size_t i = 1; i < n; i++)
+    if (T->cmp(data[i - 1], data[i]) > 0) {
+      fprintf(stderr, "rbtBulkLoad: data is not sorted\n");
+      return false;
+    }
+  if (n == 0)
+    return true;
+
+    // splitting at the middle keeps all leaves within one level
+    // of each other, so that making the deepest level red gives
+    // all paths the same number of black nodes, unless that level
+    // is full, in which case all nodes are black
+  size_t height = 0;
+  while ((size_t)2 << height <= n)
+    height++;
+  size_t redDepth = n == ((size_t)2 << height) - 1 ? n : height;
+  T->ROOT = rbtBuild(T, data, 0, n, 0, redDepth, T->NIL);
+  T->ROOT->color = BLACK;
+  T->size = n;
+  return true;
+}
+
 //===================================================================
 // Replaces the subtree rooted at u with the subtree rooted at v
 static void rbtTransplant (rbtree *T, rbnode *u, rbnode *v) {
@@ -321,6 +417,15 @@ void rbtDelete (rbtree *T, rbnode *z) {
   rbnode *y = z;
   rbnode *x;
   char y_originalColor = y->color;
+
+    // the node that is removed from its place is z, or its
+    // successor if z has two children; all nodes above it
+    // lose one node in their subtree
+  if (z->left != T->NIL && z->right != T->NIL)
+    y = rbtMinimum(T, z->right);
+  for (rbnode *p = y->parent; p != T->NIL; p = p->parent)
+    p->size--;
+
   if (z->left == T->NIL) {
     x = z->right;
     rbtTransplant(T, z, z->right);
@@ -328,7 +433,6 @@ void rbtDelete (rbtree *T, rbnode *z) {
     x = z->left;
     rbtTransplant(T, z, z->left);
   } else {
-    y = rbtMinimum(T, z->right);
     y_originalColor = y->color;
     x = y->right;
     if (y->parent == z)
@@ -342,6 +446,7 @@ void rbtDelete (rbtree *T, rbnode *z) {
     y->left = z->left;
     y->left->parent = y;
     y->color = z->color;
+    y->size = z->size;
   }
   if (y_originalColor == BLACK)
     deleteFixup(T, x);
@@ -349,6 +454,60 @@ void rbtDelete (rbtree *T, rbnode *z) {
   T->size--;
 }
 
+//===================================================================
+// Returns the first node with a key not less than key
+rbnode *rbtLowerBound (rbtree *T, void *key) {
+  rbnode *x = T->ROOT, *y = T->NIL;
+  while (x != T->NIL) {
+    if (T->cmp(x->data, key) < 0)
+      x = x->right;
+    else {
+      y = x;
+      x = x->left;
+    }
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the first node with a key greater than key
+rbnode *rbtUpperBound (rbtree *T, void *key) {
+  rbnode *x = T->ROOT, *y = T->NIL;
+  while (x != T->NIL) {
+    if (T->cmp(x->data, key) <= 0)
+      x = x->right;
+    else {
+      y = x;
+      x = x->left;
+    }
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the number of nodes with a key in [low, high), using
+// the subtree sizes
+size_t rbtCountRange (rbtree *T, void *low, void *high) {
+  if (T->cmp(low, high) >= 0)
+    return 0;
+  return rbtCountLess(T, high) - rbtCountLess(T, low);
+}
+
+//===================================================================
+// Deletes all nodes with a key in [low, high); deleting a node
+// relinks its successor, but keeps it valid
+size_t rbtDeleteRange (rbtree *T, void *low, void *high) {
+  size_t count = 0;
+  rbnode *x = rbtLowerBound(T, low);
+  while (x != T->NIL && T->cmp(x->data, high) < 0) {
+    rbnode *next = rbtSuccessor(T, x);
+    rbtDelete(T, x);
+    x = next;
+    count++;
+  }
+  return count;
+}
+
 //===================================================================
 // Shows the data in the tree in order, 20 items at a time
 static void rbtShowAllData (rbtree *T, rbnode *x, short *count) {
@@ -445,36 +604,55 @@ void rbtWrite (rbtree *T, rbnode *x, FILE *fp, rbtWriteData write) {
 }
 
 //===================================================================
-// Reads data from a file and inserts it into the tree
+// Reads data from a file with one record per line, of any length;
+// the records are collected first, so that sorted records can be
+// bulk loaded instead of inserted one by one
 rbtree *rbtFromFile (char *filename, size_t dataSize,
     rbtCmpData cmp, rbtStrToData fromStr) {
-  
-  FILE *fp; char buffer[100];
-  size_t lineNr = 0;
 
-  fp = fopen(filename, "r");
+  FILE *fp = fopen(filename, "r");
   if (fp == NULL) {
     printf("Error: could not open file %s\n", filename);
     exit(EXIT_FAILURE);
   }
-
-  rbtree *T = rbtNew(cmp);
-  while (fgets(buffer, 100, fp) != NULL) {
-    lineNr++;
-    void *data = safeCalloc(1, dataSize);
-    if (! fromStr(data, buffer)) {
-      printf("Error: invalid input data on line %lu.\n"
+    // a large stream buffer saves system calls on big files
+  setvbuf(fp, NULL, _IOFBF, 1 << 20);
+
+  string *line = newString(128);
+  size_t n = 0, cap = 1024;
+  void **data = safeCalloc(cap, sizeof(void *));
+  bool sorted = true;
+  while (readLine(fp, line)) {
+    if (n == cap) {
+      cap *= 2;
+      data = safeRealloc(data, cap * sizeof(void *));
+    }
+    data[n] = safeCalloc(1, dataSize);
+    if (! fromStr(data[n], (char *)line->data)) {
+      printf("Error: invalid input data on line %zu.\n"
              "Check file %s for errors and try again.\n", 
-              lineNr, filename);
-      if (T->free)
-        T->free(data);
-      rbtFree(T);
+              n + 1, filename);
+      for (size_t i = 0; i <= n; i++)
+        free(data[i]);
+      free(data);
+      freeString(line);
       fclose(fp);
       exit(EXIT_FAILURE);
     }
-    rbtInsert(T, data);
+    if (n && cmp(data[n - 1], data[n]) > 0)
+      sorted = false;
+    n++;
   }
+
+  rbtree *T = rbtNew(cmp);
+  if (sorted)
+    rbtBulkLoad(T, data, n);
+  else
+    for (size_t i = 0; i < n; i++)
+      rbtInsert(T, data[i]);
   printf("Data successfully read from file %s\n", filename);
+  free(data);
+  freeString(line);
   fclose(fp);
   return T;
 }
@@ -534,13 +712,18 @@ dll *rbtPostOrder (rbtree *T) {
 }
 
 //===================================================================
-// Returns the height of the tree
+// Returns the height of the subtree rooted at x
+static size_t rbtSubtreeHeight (rbtree *T, rbnode *x) {
+  if (x == T->NIL)
+    return 0;
+  size_t left = rbtSubtreeHeight(T, x->left);
+  size_t right = rbtSubtreeHeight(T, x->right);
+  return 1 + MAX(left, right);
+}
+
+//===================================================================
+// Returns the height of the tree, i.e. the number of nodes on
+// its longest path from the root to a leaf
 size_t rbtHeight (rbtree *T) {
-  size_t height = 0;
-  rbnode *x = T->ROOT;
-  while (x != T->NIL) {
-    height++;
-    x = x->left;
-  }
-  return height;
-}
\ No newline at end of file
+  return rbtSubtreeHeight(T, T->ROOT);
+}
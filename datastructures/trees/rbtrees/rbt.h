@@ -1,5 +1,8 @@
 /* 
   Generic red-black tree implementation 
+  Each node also keeps the size of its subtree (CLRS 17.1), so
+  that the k-th smallest node and the rank of a node can be
+  found in O(log n) time
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
 */
@@ -27,6 +30,7 @@ typedef struct rbnode {
   struct rbnode *parent;      // parent node
   struct rbnode *left;        // left child
   struct rbnode *right;       // right child
+  size_t size;                // number of nodes in the subtree
 } rbnode;
 
 typedef struct {
@@ -61,6 +65,11 @@ bool rbtIsEmpty (rbtree *T);
   // inserts a new node into the tree
 void rbtInsert (rbtree *T, void *data);
 
+  // builds a balanced tree from n data items sorted by key in
+  // O(n) time; the tree must be empty; returns false if it is
+  // not, or if the data is not sorted
+bool rbtBulkLoad (rbtree *T, void **data, size_t n);
+
   // deallocates the tree
 void rbtFree (rbtree *T);
 
@@ -82,6 +91,40 @@ rbnode *rbtSuccessor (rbtree *T, rbnode *x);
   // returns the predecessor of a node
 rbnode *rbtPredecessor (rbtree *T, rbnode *x);
 
+  // returns the node with the k-th smallest key, where k
+  // is in 1..n, or NULL if k is out of range
+rbnode *rbtSelect (rbtree *T, size_t k);
+
+  // returns the position (1..n) of node x in the in-order
+  // traversal of the tree
+size_t rbtRank (rbtree *T, rbnode *x);
+
+  // returns the number of nodes with a key less than key,
+  // which need not be in the tree
+size_t rbtCountLess (rbtree *T, void *key);
+
+  // returns the first node with a key not less than key,
+  // or NIL if there is none
+rbnode *rbtLowerBound (rbtree *T, void *key);
+
+  // returns the first node with a key greater than key,
+  // or NIL if there is none
+rbnode *rbtUpperBound (rbtree *T, void *key);
+
+  // the nodes with a key in [low, high) can be visited in order
+  // without building a list:
+  //   rbnode *end = rbtLowerBound(T, high);
+  //   for (rbnode *x = rbtLowerBound(T, low); x != end;
+  //        x = rbtSuccessor(T, x))
+  // and those in [low, high] by ending at rbtUpperBound(T, high)
+
+  // returns the number of nodes with a key in [low, high)
+size_t rbtCountRange (rbtree *T, void *low, void *high);
+
+  // deletes all nodes with a key in [low, high), and returns
+  // their number
+size_t rbtDeleteRange (rbtree *T, void *low, void *high);
+
   // displays the (sub)tree rooted at x in order
 void rbtShow (rbtree *T, rbnode *x);
 
@@ -95,7 +138,9 @@ void rbtShowNode (rbtree *T, rbnode *x);
 void rbtWrite (rbtree *T, rbnode *x, FILE *fp, 
   rbtWriteData write);
 
-  // reads a tree from a file
+  // reads a tree from a file with one record per line; if the
+  // records are sorted, as written by rbtWrite, the tree is
+  // built in O(n) time
 rbtree *rbtFromFile (char *filename, size_t dataSize,
   rbtCmpData cmp, rbtStrToData fromStr);
 
@@ -0,0 +1,452 @@
+/*
+  Join-based set operations on red-black trees
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "rbtsets.h"
+#include "../../../../lib/clib.h"
+
+  // below this combined size, both halves are combined by the
+  // same thread, since a task would cost more than it gains
+#define GRAIN 4096
+
+typedef enum { UNION, INTERSECTION, DIFFERENCE } setOp;
+
+typedef struct {
+  rbnode *root;               // root of the subtree
+  size_t bh;                  // number of black nodes on a path
+                              // from the root down to a leaf
+} subtree;
+
+typedef struct {
+  rbnode *NIL;                // sentinel shared by both trees
+  rbtCmpData cmp;             // comparison function
+  rbtFreeData freeA;          // frees the data of the first tree
+  rbtFreeData freeB;          // frees the data of the second tree
+  tpool *pool;                // task pool, or NULL
+  setOp op;                   // operation to perform
+} setContext;
+
+typedef struct {
+  setContext *ctx;            // context of the operation
+  subtree a, b;               // subtrees to combine
+  subtree result;             // combined subtree
+} combineArgs;
+
+//===================================================================
+// Returns the number of black nodes on the leftmost path of x
+static size_t blackHeight (rbnode *x, rbnode *NIL) {
+  size_t bh = 0;
+  for (; x != NIL; x = x->left)
+    bh += x->color == BLACK;
+  return bh;
+}
+
+//===================================================================
+// Returns the black height of the children of the root of t
+static inline size_t childHeight (subtree t) {
+  return t.bh - (t.root->color == BLACK);
+}
+
+//===================================================================
+// Makes x the parent of l and r with the given color
+static rbnode *link (setContext *c, rbnode *l, rbnode *x, rbnode *r,
+                     int color) {
+  x->left = l;
+  x->right = r;
+  x->color = color;
+  x->size = l->size + r->size + 1;
+  if (l != c->NIL)
+    l->parent = x;
+  if (r != c->NIL)
+    r->parent = x;
+  return x;
+}
+
+//===================================================================
+// Performs a left rotation on the subtree rooted at x, and
+// returns its new root, whose parent is left to the caller
+static rbnode *leftRotate (setContext *c, rbnode *x) {
+  rbnode *y = x->right;
+  x->right = y->left;
+  if (y->left != c->NIL)
+    y->left->parent = x;
+  y->left = x;
+  x->parent = y;
+  y->size = x->size;
+  x->size = x->left->size + x->right->size + 1;
+  return y;
+}
+
+//===================================================================
+// Performs a right rotation on the subtree rooted at x, and
+// returns its new root, whose parent is left to the caller
+static rbnode *rightRotate (setContext *c, rbnode *x) {
+  rbnode *y = x->left;
+  x->left = y->right;
+  if (y->right != c->NIL)
+    y->right->parent = x;
+  y->right = x;
+  x->parent = y;
+  y->size = x->size;
+  x->size = x->left->size + x->right->size + 1;
+  return y;
+}
+
+//===================================================================
+// Joins l, k and r, where l is higher than r, by going down the
+// right spine of l to a black node with the black height of r,
+// and putting k there; a red violation that this may cause is
+// passed up and repaired by a rotation; the result has the
+// black height of l, but may have a red root with a red child
+static rbnode *joinRight (setContext *c, rbnode *l, size_t bhl,
+                          rbnode *k, rbnode *r, size_t bhr) {
+  if (l->color == BLACK && bhl == bhr)
+    return link(c, l, k, r, RED);
+  rbnode *right = joinRight(c, l->right, bhl - (l->color == BLACK),
+                            k, r, bhr);
+  rbnode *t = link(c, l->left, l, right, l->color);
+  if (t->color == BLACK && t->right->color == RED &&
+      t->right->right->color == RED) {
+    t->right->right->color = BLACK;
+    return leftRotate(c, t);
+  }
+  return t;
+}
+
+//===================================================================
+// Joins l, k and r, where r is higher than l
+static rbnode *joinLeft (setContext *c, rbnode *l, size_t bhl,
+                         rbnode *k, rbnode *r, size_t bhr) {
+  if (r->color == BLACK && bhl == bhr)
+    return link(c, l, k, r, RED);
+  rbnode *left = joinLeft(c, l, bhl, k, r->left,
+                          bhr - (r->color == BLACK));
+  rbnode *t = link(c, left, r, r->right, r->color);
+  if (t->color == BLACK && t->left->color == RED &&
+      t->left->left->color == RED) {
+    t->left->left->color = BLACK;
+    return rightRotate(c, t);
+  }
+  return t;
+}
+
+//===================================================================
+// Joins l, node k and r into one red-black tree, provided that
+// the keys in l are not greater than that of k, and those in r
+// not less; takes O(|bh(l) - bh(r)| + 1) time
+static subtree join (setContext *c, subtree l, rbnode *k, subtree r) {
+  if (l.bh > r.bh) {
+    rbnode *t = joinRight(c, l.root, l.bh, k, r.root, r.bh);
+    if (t->color == RED && t->right->color == RED) {
+      t->color = BLACK;
+      return (subtree){t, l.bh + 1};
+    }
+    return (subtree){t, l.bh};
+  }
+  if (r.bh > l.bh) {
+    rbnode *t = joinLeft(c, l.root, l.bh, k, r.root, r.bh);
+    if (t->color == RED && t->left->color == RED) {
+      t->color = BLACK;
+      return (subtree){t, r.bh + 1};
+    }
+    return (subtree){t, r.bh};
+  }
+  if (l.root->color == BLACK && r.root->color == BLACK)
+    return (subtree){link(c, l.root, k, r.root, RED), l.bh};
+  return (subtree){link(c, l.root, k, r.root, BLACK), l.bh + 1};
+}
+
+//===================================================================
+// Removes the node with the largest key from t, and returns it;
+// the remaining nodes are joined into rest
+static rbnode *splitLast (setContext *c, subtree t, subtree *rest) {
+  rbnode *x = t.root;
+  size_t bh = childHeight(t);
+  if (x->right == c->NIL) {
+    *rest = (subtree){x->left, bh};
+    return x;
+  }
+  subtree r;
+  rbnode *last = splitLast(c, (subtree){x->right, bh}, &r);
+  *rest = join(c, (subtree){x->left, bh}, x, r);
+  return last;
+}
+
+//===================================================================
+// Joins l and r without a node in between
+static subtree join2 (setContext *c, subtree l, subtree r) {
+  if (l.root == c->NIL)
+    return r;
+  if (r.root == c->NIL)
+    return l;
+  subtree rest;
+  rbnode *k = splitLast(c, l, &rest);
+  return join(c, rest, k, r);
+}
+
+//===================================================================
+// Splits t into the nodes with a key less than key (or not
+// greater, if orEqual is true), and the other nodes; takes
+// O(log n) time, since the joins on the way up together
+// climb the height of the tree only once
+static void split (setContext *c, subtree t, void *key, bool orEqual,
+                   subtree *l, subtree *r) {
+  if (t.root == c->NIL) {
+    *l = *r = (subtree){c->NIL, 0};
+    return;
+  }
+  rbnode *x = t.root;
+  size_t bh = childHeight(t);
+  subtree xl = {x->left, bh}, xr = {x->right, bh}, part;
+  int cmp = c->cmp(x->data, key);
+  if (cmp < 0 || (orEqual && cmp == 0)) {
+    split(c, xr, key, orEqual, &part, r);
+    *l = join(c, xl, x, part);
+  } else {
+    split(c, xl, key, orEqual, l, &part);
+    *r = join(c, part, x, xr);
+  }
+}
+
+//===================================================================
+// Splits t into the nodes with a key less than, equal to, and
+// greater than key; the second split is only needed if the
+// smallest key that is not less than key is equal to it
+static void split3 (setContext *c, subtree t, void *key, subtree *l,
+                    subtree *e, subtree *r) {
+  subtree ge;
+  split(c, t, key, false, l, &ge);
+  rbnode *x = ge.root;
+  if (x != c->NIL) {
+    while (x->left != c->NIL)
+      x = x->left;
+    if (c->cmp(x->data, key) == 0) {
+      split(c, ge, key, true, e, r);
+      return;
+    }
+  }
+  *e = (subtree){c->NIL, 0};
+  *r = ge;
+}
+
+//===================================================================
+// Frees the nodes in the subtree rooted at x and their data
+static void freeNodes (setContext *c, rbnode *x, rbtFreeData freeData) {
+  while (x != c->NIL) {
+    rbnode *right = x->right;
+    freeNodes(c, x->left, freeData);
+    if (freeData)
+      freeData(x->data);
+    free(x);
+    x = right;
+  }
+}
+
+static subtree combine (setContext *c, subtree a, subtree b);
+
+//===================================================================
+// Runs combine as a task
+static void combineTask (void *arg) {
+  combineArgs *args = arg;
+  args->result = combine(args->ctx, args->a, args->b);
+}
+
+//===================================================================
+// Moves the nodes with the same key as the root of a from its left
+// and right subtree to el and er, so that they share the fate of
+// the root in an intersection or difference; checking the extreme
+// keys of the subtrees takes O(|a|) time over all roots of a, and
+// only duplicate keys cost a split
+static void takeEqual (setContext *c, subtree a, subtree *l,
+                       subtree *r, subtree *el, subtree *er) {
+  rbnode *k = a.root, *x;
+  size_t bh = childHeight(a);
+  *l = (subtree){k->left, bh};
+  *r = (subtree){k->right, bh};
+  *el = *er = (subtree){c->NIL, 0};
+  if (c->op == UNION)
+    return;
+  for (x = l->root; x != c->NIL && x->right != c->NIL; x = x->right);
+  if (x != c->NIL && c->cmp(x->data, k->data) == 0)
+    split(c, *l, k->data, false, l, el);
+  for (x = r->root; x != c->NIL && x->left != c->NIL; x = x->left);
+  if (x != c->NIL && c->cmp(x->data, k->data) == 0)
+    split(c, *r, k->data, true, er, r);
+}
+
+//===================================================================
+// Combines the subtrees a and b according to the operation: b is
+// split at the key k of the root of a, both left parts and both
+// right parts are combined recursively, in parallel if they are
+// large enough, and the results are joined with or without k
+static subtree combine (setContext *c, subtree a, subtree b) {
+  if (a.root == c->NIL) {
+    if (c->op == UNION)
+      return b;
+    freeNodes(c, b.root, c->freeB);
+    return a;
+  }
+  if (b.root == c->NIL) {
+    if (c->op != INTERSECTION)
+      return a;
+    freeNodes(c, a.root, c->freeA);
+    return b;
+  }
+  rbnode *k = a.root;
+  bool parallel = c->pool && k->size + b.root->size >= GRAIN;
+  subtree l, r, el, er, bl, be, br;
+  takeEqual(c, a, &l, &r, &el, &er);
+  split3(c, b, k->data, &bl, &be, &br);
+  bool found = be.root != c->NIL;
+  freeNodes(c, be.root, c->freeB);
+
+  if (parallel) {
+    tptask task;
+    combineArgs args = {c, l, bl, {NULL, 0}};
+    tpSpawn(c->pool, &task, combineTask, &args);
+    r = combine(c, r, br);
+    tpSync(c->pool, &task);
+    l = args.result;
+  } else {
+    l = combine(c, l, bl);
+    r = combine(c, r, br);
+  }
+
+  if (c->op == UNION || (c->op == INTERSECTION) == found)
+    return join(c, join2(c, l, el), k, join2(c, er, r));
+  freeNodes(c, el.root, c->freeA);
+  freeNodes(c, er.root, c->freeA);
+  if (c->freeA)
+    c->freeA(k->data);
+  free(k);
+  return join2(c, l, r);
+}
+
+//===================================================================
+// Makes the nodes in the subtree rooted at x point to the
+// sentinel to instead of from
+static void relabel (rbnode *x, rbnode *from, rbnode *to) {
+  while (x != from) {
+    if (x->left == from)
+      x->left = to;
+    else
+      relabel(x->left, from, to);
+    if (x->right == from) {
+      x->right = to;
+      return;
+    }
+    x = x->right;
+  }
+}
+
+//===================================================================
+// Makes the nodes of both trees use the sentinel of A, which is
+// either its own or that of B, so that only the nodes of the
+// smaller tree have to be relabeled
+static void shareSentinel (rbtree *A, rbtree *B) {
+  if (A->size < B->size) {
+    relabel(A->ROOT, A->NIL, B->NIL);
+    if (A->ROOT == A->NIL)
+      A->ROOT = B->NIL;
+    rbnode *NIL = A->NIL;
+    A->NIL = B->NIL;
+    B->NIL = NIL;
+  } else {
+    relabel(B->ROOT, B->NIL, A->NIL);
+    if (B->ROOT == B->NIL)
+      B->ROOT = A->NIL;
+  }
+}
+
+//===================================================================
+// Makes t the whole tree T, whose sentinel it must use
+static void setRoot (rbtree *T, subtree t) {
+  T->ROOT = t.root;
+  if (t.root != T->NIL) {
+    t.root->parent = T->NIL;
+    t.root->color = BLACK;
+  }
+  T->size = t.root->size;
+}
+
+//===================================================================
+// Returns the whole tree T as a subtree
+static inline subtree wholeTree (rbtree *T) {
+  return (subtree){T->ROOT, blackHeight(T->ROOT, T->NIL)};
+}
+
+//===================================================================
+// Performs a set operation on A and B, leaving the result in A
+static void setOperation (rbtree *A, rbtree *B, tpool *P, setOp op) {
+  shareSentinel(A, B);
+  setContext c = {A->NIL, A->cmp, A->free, B->free, P, op};
+  subtree a = wholeTree(A), b = {B->ROOT, blackHeight(B->ROOT, A->NIL)};
+  setRoot(A, combine(&c, a, b));
+  B->ROOT = B->NIL;
+  B->size = 0;
+}
+
+//===================================================================
+// Moves the nodes of B to A, except for duplicate keys
+void rbtUnion (rbtree *A, rbtree *B, tpool *P) {
+  setOperation(A, B, P, UNION);
+}
+
+//===================================================================
+// Keeps the nodes of A with a key in B
+void rbtIntersection (rbtree *A, rbtree *B, tpool *P) {
+  setOperation(A, B, P, INTERSECTION);
+}
+
+//===================================================================
+// Keeps the nodes of A with a key not in B
+void rbtDifference (rbtree *A, rbtree *B, tpool *P) {
+  setOperation(A, B, P, DIFFERENCE);
+}
+
+//===================================================================
+// Moves all nodes of R to L if no key of L is greater than any
+// key of R
+bool rbtJoin (rbtree *L, rbtree *R) {
+  if (L->ROOT != L->NIL && R->ROOT != R->NIL &&
+      L->cmp(rbtMaximum(L, L->ROOT)->data,
+             rbtMinimum(R, R->ROOT)->data) > 0)
+    return false;
+  shareSentinel(L, R);
+  setContext c = {L->NIL, L->cmp, NULL, NULL, NULL, UNION};
+  subtree r = {R->ROOT, blackHeight(R->ROOT, L->NIL)};
+  setRoot(L, join2(&c, wholeTree(L), r));
+  R->ROOT = R->NIL;
+  R->size = 0;
+  return true;
+}
+
+//===================================================================
+// Moves the nodes with a key not less than key from T to R
+void rbtSplit (rbtree *T, void *key, rbtree *R) {
+  if (R->ROOT != R->NIL) {
+    fprintf(stderr, "rbtSplit: tree R is not empty\n");
+    return;
+  }
+  setContext c = {T->NIL, T->cmp, NULL, NULL, NULL, UNION};
+  subtree l, r;
+  split(&c, wholeTree(T), key, false, &l, &r);
+
+    // the smaller part moves to the sentinel of R
+  if (l.root->size < r.root->size) {
+    relabel(l.root, T->NIL, R->NIL);
+    if (l.root == T->NIL)
+      l.root = R->NIL;
+    rbnode *NIL = T->NIL;
+    T->NIL = R->NIL;
+    R->NIL = NIL;
+  } else {
+    relabel(r.root, T->NIL, R->NIL);
+    if (r.root == T->NIL)
+      r.root = R->NIL;
+  }
+  setRoot(T, l);
+  setRoot(R, r);
+}
@@ -0,0 +1,53 @@
+/*
+  Join-based set operations on red-black trees
+    All operations are built on join, which links two trees and a
+    node in between into one red-black tree in O(log n) time, and
+    on split, which divides a tree at a key into the nodes with
+    smaller and larger keys, also in O(log n) time (Blelloch,
+    Ferizovic and Sun, "Just join for parallel ordered sets").
+  Union, intersection and difference of trees with n and m <= n
+    nodes take O(m log(n/m + 1)) time: splitting B at the key
+    of the root of A, then combining the left and right parts of
+    both recursively, and joining the results. As the parts are
+    independent, they are combined in parallel if a task pool is
+    given (see lib/tpool), and sequentially if it is NULL.
+  The operations move nodes from one tree to another, instead of
+    copying them, so that both trees must use the same comparison
+    function, and handle their data in the same way; with a task
+    pool, the function that frees the data must be thread-safe.
+    Keys that occur more than once in a tree are kept as they are.
+  Programs using these operations must be linked with -pthread.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef RBTSETS_H_INCLUDED
+#define RBTSETS_H_INCLUDED
+
+#include "../rbt.h"
+#include "../../../../lib/tpool/tpool.h"
+
+  // moves all nodes of R to L, provided that no key of L is
+  // greater than any key of R; returns false, and leaves both
+  // trees unchanged, otherwise; takes O(log n) time for the
+  // join itself, and O(min(|L|, |R|)) to move the nodes over
+bool rbtJoin (rbtree *L, rbtree *R);
+
+  // moves the nodes with a key not less than key from T to the
+  // empty tree R; takes O(log n) time for the split itself, and
+  // O(min(|T|, |R|)) to move the nodes over
+void rbtSplit (rbtree *T, void *key, rbtree *R);
+
+  // moves the nodes of B to A, except for those with a key
+  // that is already in A, which are freed; leaves B empty
+void rbtUnion (rbtree *A, rbtree *B, tpool *P);
+
+  // keeps the nodes of A with a key that is also in B, and frees
+  // all other nodes of A and B; leaves B empty
+void rbtIntersection (rbtree *A, rbtree *B, tpool *P);
+
+  // keeps the nodes of A with a key that is not in B, and frees
+  // all other nodes of A and B; leaves B empty
+void rbtDifference (rbtree *A, rbtree *B, tpool *P);
+
+#endif  // RBTSETS_H_INCLUDED
@@ -0,0 +1,133 @@
+/*
+  Benchmark of the join-based set operations on red-black trees
+  Builds two trees A and B with about n keys each, 3/4 of which
+    they have in common, and merges them once by inserting the keys
+    of B that are not in A one by one, and once with rbtUnion, both
+    sequentially and with a task pool for 2, 4, ... threads; then
+    does the same for the intersection and the difference, and for
+    a tree B with only n/1000 keys, where the join-based union
+    only has to split A at a few keys
+  Usage: ./bench.out [n] [max threads]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../rbtsets.h"
+#include "../../../../../lib/clib.h"
+#include <time.h>
+#include <unistd.h>
+
+typedef enum { INSERT, UNION, INTERSECTION, DIFFERENCE } method;
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Builds a tree from n sorted keys
+static rbtree *buildTree (void **keys, size_t n) {
+  rbtree *T = rbtNew(cmpInt);
+  rbtBulkLoad(T, keys, n);
+  return T;
+}
+
+//===================================================================
+// Merges B into A with the given method and number of threads,
+// and returns the time taken and the size of the result
+static double run (void **a, size_t na, void **b, size_t nb,
+                   method m, size_t threads, size_t *size) {
+  rbtree *A = buildTree(a, na), *B = buildTree(b, nb);
+  tpool *P = threads > 1 ? tpNew(threads - 1) : NULL;
+  double start = now();
+  if (m == INSERT) {
+    for (size_t i = 0; i < nb; i++)
+      if (! rbtSearch(A, b[i]))
+        rbtInsert(A, b[i]);
+  } else if (m == UNION)
+    rbtUnion(A, B, P);
+  else if (m == INTERSECTION)
+    rbtIntersection(A, B, P);
+  else
+    rbtDifference(A, B, P);
+  double t = now() - start;
+  *size = rbtSize(A);
+  tpFree(P);
+  rbtFree(A);
+  rbtFree(B);
+  return t;
+}
+
+//===================================================================
+// Runs an operation sequentially and, unless it is an insertion,
+// for 2, 4, ... threads
+static void runAll (char *name, void **a, size_t na, void **b,
+                    size_t nb, method m, size_t maxThreads) {
+  size_t size;
+  for (size_t t = 1; t <= (m == INSERT ? 1 : maxThreads); t *= 2) {
+    double time = run(a, na, b, nb, m, t, &size);
+    printf("    %-13s %2zu thread%s %8.3f s  (%zu keys)\n", name, t,
+           t > 1 ? "s" : " ", time, size);
+  }
+}
+
+//===================================================================
+// Fills a and b with sorted keys in [0, range): a key is in a
+// with probability pa, and in b with probability pb
+static void sample (int *values, size_t range, double pa, double pb,
+                    void **a, size_t *na, void **b, size_t *nb) {
+  *na = *nb = 0;
+  for (size_t i = 0; i < range; i++) {
+    if (rand() < pa * RAND_MAX)
+      a[(*na)++] = values + i;
+    if (rand() < pb * RAND_MAX)
+      b[(*nb)++] = values + i;
+  }
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+  size_t maxThreads = argc > 2 ? strtoul(argv[2], NULL, 10) :
+                                 sysconf(_SC_NPROCESSORS_ONLN);
+  srand(time(NULL));
+
+    // keys in [0, 4n/3), each in A and B with probability 3/4
+  size_t range = 4 * n / 3, na, nb;
+  int *values = safeCalloc(range, sizeof(int));
+  for (size_t i = 0; i < range; i++)
+    values[i] = i;
+  void **a = safeCalloc(range, sizeof(void *));
+  void **b = safeCalloc(range, sizeof(void *));
+  sample(values, range, 0.75, 0.75, a, &na, b, &nb);
+  printf("|A| = %zu, |B| = %zu, %ld processors\n", na, nb,
+         sysconf(_SC_NPROCESSORS_ONLN));
+
+  printf("  A and B of the same size\n");
+  runAll("insertion", a, na, b, nb, INSERT, maxThreads);
+  runAll("union", a, na, b, nb, UNION, maxThreads);
+  runAll("intersection", a, na, b, nb, INTERSECTION, maxThreads);
+  runAll("difference", a, na, b, nb, DIFFERENCE, maxThreads);
+
+  sample(values, range, 0.75, 0.00075, a, &na, b, &nb);
+  printf("  B with %zu keys\n", nb);
+  runAll("insertion", a, na, b, nb, INSERT, maxThreads);
+  runAll("union", a, na, b, nb, UNION, maxThreads);
+
+  free(values);
+  free(a);
+  free(b);
+  return 0;
+}
@@ -0,0 +1,183 @@
+/*
+  Tests of the join-based set operations on red-black trees
+  Performs union, intersection, difference, join and split on
+    random trees of random sizes, with and without a task pool,
+    and checks the red-black properties, subtree sizes, parent
+    pointers and sentinels of the results, and their keys against
+    a count of the keys in the original trees; some keys occur
+    more than once in a tree
+  Usage: ./setTest.out [number of rounds]
+  Author: David De Potter
+*/
+
+#include "../rbtsets.h"
+#include "../../../../../lib/clib.h"
+#include <time.h>
+
+#define RANGE 5000           // keys are in [0, RANGE)
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns a new integer
+static int *newInt (int value) {
+  int *p = safeMalloc(sizeof(int));
+  *p = value;
+  return p;
+}
+
+//===================================================================
+// Checks the red-black properties, subtree sizes and parent
+// pointers of the subtree rooted at x; returns its black height
+static size_t checkNodes (rbtree *T, rbnode *x, bool *ok) {
+  if (x == T->NIL)
+    return 1;
+  if (x->color == RED && (x->left->color == RED ||
+                          x->right->color == RED))
+    *ok = false;
+  if (x->size != x->left->size + x->right->size + 1)
+    *ok = false;
+  if ((x->left != T->NIL && x->left->parent != x) ||
+      (x->right != T->NIL && x->right->parent != x))
+    *ok = false;
+  size_t left = checkNodes(T, x->left, ok);
+  if (left != checkNodes(T, x->right, ok))
+    *ok = false;
+  return left + (x->color == BLACK);
+}
+
+//===================================================================
+// Returns true if T is a valid red-black tree that holds key i
+// exactly count[i] times, in order
+static bool checkTree (rbtree *T, int *count) {
+  bool ok = T->ROOT == T->NIL || (T->ROOT->color == BLACK &&
+                                   T->ROOT->parent == T->NIL);
+  checkNodes(T, T->ROOT, &ok);
+  if (T->size != T->ROOT->size)
+    ok = false;
+  int *found = safeCalloc(RANGE, sizeof(int));
+  int prev = -1;
+  rbnode *x = T->ROOT == T->NIL ? T->NIL : rbtMinimum(T, T->ROOT);
+  for (; x != T->NIL; x = rbtSuccessor(T, x)) {
+    int key = *(int *)x->data;
+    if (key < prev)
+      ok = false;
+    found[key]++;
+    prev = key;
+  }
+  for (size_t i = 0; i < RANGE; i++)
+    if (found[i] != count[i])
+      ok = false;
+  free(found);
+  return ok;
+}
+
+//===================================================================
+// Fills a tree with n random keys in [low, high), counting them
+static rbtree *randomTree (size_t n, int low, int high, int *count) {
+  rbtree *T = rbtNew(cmpInt);
+  rbtOwnData(T, free);
+  for (size_t i = 0; i < n; i++) {
+    int key = low + rand() % (high - low);
+    if (rand() % 50 == 0 || count[key] == 0) {
+      rbtInsert(T, newInt(key));
+      count[key]++;
+    }
+  }
+  return T;
+}
+
+//===================================================================
+// Tests one set operation on two random trees
+static bool testSetOp (int op, tpool *P) {
+  int *countA = safeCalloc(RANGE, sizeof(int));
+  int *countB = safeCalloc(RANGE, sizeof(int));
+  int *expected = safeCalloc(RANGE, sizeof(int));
+  size_t sizes[] = {0, 1, 10, 100, 1000, 10000};
+  rbtree *A = randomTree(sizes[rand() % 6], 0, RANGE, countA);
+  rbtree *B = randomTree(sizes[rand() % 6], 0, RANGE, countB);
+  for (size_t i = 0; i < RANGE; i++)
+    if (op == 0)
+      expected[i] = countA[i] ? countA[i] : countB[i];
+    else if (op == 1)
+      expected[i] = countB[i] ? countA[i] : 0;
+    else
+      expected[i] = countB[i] ? 0 : countA[i];
+  if (op == 0)
+    rbtUnion(A, B, P);
+  else if (op == 1)
+    rbtIntersection(A, B, P);
+  else
+    rbtDifference(A, B, P);
+  memset(countB, 0, RANGE * sizeof(int));
+  bool ok = checkTree(A, expected) && checkTree(B, countB);
+
+    // both trees remain usable
+  rbtInsert(B, newInt(0));
+  countB[0]++;
+  ok = ok && checkTree(B, countB);
+  free(countA);
+  free(countB);
+  free(expected);
+  rbtFree(A);
+  rbtFree(B);
+  return ok;
+}
+
+//===================================================================
+// Tests splitting a random tree and joining the parts again
+static bool testSplitJoin () {
+  int *count = safeCalloc(RANGE, sizeof(int));
+  int *left = safeCalloc(RANGE, sizeof(int));
+  int *right = safeCalloc(RANGE, sizeof(int));
+  rbtree *T = randomTree(rand() % 10000, 0, RANGE, count);
+  rbtree *R = rbtNew(cmpInt);
+  rbtOwnData(R, free);
+  int key = rand() % RANGE;
+  for (int i = 0; i < RANGE; i++)
+    (i < key ? left : right)[i] = count[i];
+  rbtSplit(T, &key, R);
+  bool ok = checkTree(T, left) && checkTree(R, right);
+
+    // the parts cannot be joined in the wrong order
+  if (T->size && R->size && rbtJoin(R, T))
+    ok = false;
+  ok = ok && rbtJoin(T, R) && checkTree(T, count);
+  memset(right, 0, RANGE * sizeof(int));
+  ok = ok && checkTree(R, right);
+  free(count);
+  free(left);
+  free(right);
+  rbtFree(T);
+  rbtFree(R);
+  return ok;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t rounds = argc > 1 ? strtoul(argv[1], NULL, 10) : 100;
+  srand(time(NULL));
+  char *names[] = {"Union", "Intersection", "Difference"};
+  tpool *P = tpNew(3);
+
+  for (int op = 0; op < 3; op++) {
+    bool ok = true;
+    for (size_t i = 0; i < rounds; i++)
+      ok = ok && testSetOp(op, NULL) && testSetOp(op, P);
+    printf("%-14s %s\n", names[op], ok ? "passed" : "FAILED");
+  }
+  bool ok = true;
+  for (size_t i = 0; i < rounds; i++)
+    ok = ok && testSplitJoin();
+  printf("%-14s %s\n", "Split, join", ok ? "passed" : "FAILED");
+
+  tpFree(P);
+  return 0;
+}
@@ -0,0 +1,129 @@
+/*
+  Benchmark of the order-statistic queries on the red-black tree
+  Finds the k-th smallest key and the rank of a node, once by
+    walking the in-order list of the tree (rbtInOrder), which
+    takes O(n) per query, and once with rbtSelect and rbtRank,
+    which use the subtree sizes and take O(log n) per query
+  Usage: ./bench.out [n] [number of queries]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../rbt.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Checks the subtree sizes, returns the size of the subtree of x
+static size_t checkSizes (rbtree *T, rbnode *x, bool *ok) {
+  if (x == T->NIL) return 0;
+  size_t size = checkSizes(T, x->left, ok) +
+                checkSizes(T, x->right, ok) + 1;
+  if (size != x->size) *ok = false;
+  return size;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+  size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000;
+  srand(time(NULL));
+
+    // insert n keys and delete a quarter of them again
+  int *keys = safeCalloc(n, sizeof(int));
+  rbtree *T = rbtNew(cmpInt);
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = rand() % (4 * n);
+    rbtInsert(T, keys + i);
+  }
+  for (size_t i = 0; i < n / 4; i++) {
+    rbnode *x = rbtSearch(T, keys + rand() % n);
+    if (x) rbtDelete(T, x);
+  }
+  bool ok = true;
+  checkSizes(T, T->ROOT, &ok);
+  size_t size = rbtSize(T);
+  printf("%zu keys, %zu queries\n", size, q);
+  printf("Subtree sizes are %s\n", ok ? "correct" : "WRONG");
+
+  size_t *ks = safeCalloc(q, sizeof(size_t));
+  rbnode **nodes = safeCalloc(q, sizeof(rbnode *));
+  for (size_t i = 0; i < q; i++) {
+    ks[i] = 1 + rand() % size;
+    nodes[i] = rbtSelect(T, 1 + rand() % size);
+  }
+
+    // k-th smallest key
+  long sumList = 0, sumTree = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++) {
+    dll *list = rbtInOrder(T);
+    dllNode *node = list->NIL->next;
+    for (size_t k = 1; k < ks[i]; k++)
+      node = node->next;
+    sumList += *(int *)node->dllData;
+    dllFree(list);
+  }
+  double tList = now() - start;
+  start = now();
+  for (size_t i = 0; i < q; i++)
+    sumTree += *(int *)rbtSelect(T, ks[i])->data;
+  double tTree = now() - start;
+  printf("  select: %10.1f us with the list, %6.2f us with "
+         "rbtSelect (%s)\n", tList * 1e6 / q, tTree * 1e6 / q,
+         sumList == sumTree ? "same keys" : "DIFFERENT keys");
+
+    // the number of keys below the k-th smallest key is k - 1,
+    // unless that key occurs more than once
+  for (size_t i = 0; i < q; i++) {
+    int *key = rbtSelect(T, ks[i])->data;
+    size_t less = rbtCountLess(T, key);
+    if (less >= ks[i] || cmpInt(rbtSelect(T, less + 1)->data, key))
+      ok = false;
+  }
+  printf("  count less: %s\n", ok ? "correct" : "WRONG");
+
+    // rank of a node
+  size_t rankList = 0, rankTree = 0;
+  start = now();
+  for (size_t i = 0; i < q; i++) {
+    dll *list = rbtInOrder(T);
+    size_t rank = 1;
+    for (dllNode *node = list->NIL->next;
+         node->dllData != nodes[i]->data; node = node->next)
+      rank++;
+    rankList += rank;
+    dllFree(list);
+  }
+  tList = now() - start;
+  start = now();
+  for (size_t i = 0; i < q; i++)
+    rankTree += rbtRank(T, nodes[i]);
+  tTree = now() - start;
+  printf("  rank:   %10.1f us with the list, %6.2f us with "
+         "rbtRank   (%s)\n", tList * 1e6 / q, tTree * 1e6 / q,
+         rankList == rankTree ? "same ranks" : "DIFFERENT ranks");
+
+  free(ks);
+  free(nodes);
+  free(keys);
+  rbtFree(T);
+  return 0;
+}
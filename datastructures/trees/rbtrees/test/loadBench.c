@@ -0,0 +1,196 @@
+/*
+  Benchmark of reading trees from files
+  Writes n records of random length, up to 200 characters, in
+    random order to a file, and reads it with rbtFromFile, which
+    has to insert the records one by one; then writes the tree
+    back with rbtWrite, in sorted order, and reads that file with
+    rbtFromFile and bstFromFile, which build balanced trees in
+    linear time; finally compares inserting the sorted records
+    with bulk loading them, without any file access
+  Usage: ./loadBench.out [n]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../rbt.h"
+#include "../../bstrees/bst.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+
+typedef struct {
+  long key;                // key of the record
+  char *text;              // text of the record
+} record;
+
+//===================================================================
+// Compares two records by key
+int cmpRecords (void const *a, void const *b) {
+  long x = ((record *)a)->key, y = ((record *)b)->key;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Parses a record from a line: its key and the remaining text
+bool recordFromStr (void *data, char const *str) {
+  record *r = data;
+  char *end;
+  r->key = strtol(str, &end, 10);
+  if (end == str || *end != ' ')
+    return false;
+  r->text = safeMalloc(strlen(end + 1) + 1);
+  strcpy(r->text, end + 1);
+  return true;
+}
+
+//===================================================================
+// Writes a record to a file
+void writeRecord (void const *data, FILE *fp) {
+  record *r = (record *)data;
+  fprintf(fp, "%ld %s\n", r->key, r->text);
+}
+
+//===================================================================
+// Deallocates a record
+void freeRecord (void *data) {
+  if (data) {
+    free(((record *)data)->text);
+    free(data);
+  }
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Checks the red-black properties and subtree sizes of the
+// subtree rooted at x; returns its black height
+static size_t checkRbt (rbtree *T, rbnode *x, bool *ok) {
+  if (x == T->NIL)
+    return 1;
+  if (x->color == RED && (x->left->color == RED ||
+                          x->right->color == RED))
+    *ok = false;
+  if (x->size != x->left->size + x->right->size + 1)
+    *ok = false;
+  size_t left = checkRbt(T, x->left, ok);
+  if (left != checkRbt(T, x->right, ok))
+    *ok = false;
+  return left + (x->color == BLACK);
+}
+
+//===================================================================
+// Returns the height of the subtree rooted at x
+static size_t bstHeight (bstree *T, bsnode *x) {
+  if (x == T->NIL)
+    return 0;
+  size_t left = bstHeight(T, x->left);
+  size_t right = bstHeight(T, x->right);
+  return 1 + (left > right ? left : right);
+}
+
+//===================================================================
+// Returns true if the tree holds the keys 0..n-1 in order
+static bool checkKeys (rbtree *T, size_t n) {
+  size_t i = 0;
+  for (rbnode *x = rbtMinimum(T, T->ROOT); x != T->NIL;
+       x = rbtSuccessor(T, x), i++)
+    if (((record *)x->data)->key != (long)i)
+      return false;
+  return i == n;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  char *unsortedFile = "unsorted.txt", *sortedFile = "sorted.txt";
+  srand(time(NULL));
+
+    // records with keys 0..n-1 in random order
+  long *keys = safeCalloc(n, sizeof(long));
+  for (size_t i = 0; i < n; i++)
+    keys[i] = i;
+  for (size_t i = n - 1; i > 0; i--) {
+    size_t j = rand() % (i + 1);
+    long tmp = keys[i];
+    keys[i] = keys[j];
+    keys[j] = tmp;
+  }
+  char text[201];
+  for (size_t i = 0; i < 200; i++)
+    text[i] = 'a' + i % 26;
+  text[200] = '\0';
+  FILE *fp = fopen(unsortedFile, "w");
+  size_t bytes = 0;
+  for (size_t i = 0; i < n; i++)
+    bytes += fprintf(fp, "%ld %.*s\n", keys[i], 1 + rand() % 200,
+                     text);
+  fclose(fp);
+  free(keys);
+  printf("%zu records, %.1f MB\n", n, bytes / 1e6);
+
+    // unsorted file: one insertion per record
+  double start = now();
+  rbtree *T = rbtFromFile(unsortedFile, sizeof(record),
+                          cmpRecords, recordFromStr);
+  double t = now() - start;
+  rbtOwnData(T, freeRecord);
+  bool ok = true;
+  checkRbt(T, T->ROOT, &ok);
+  printf("  rbtFromFile, unsorted: %6.2f s, height %zu, %s\n", t,
+         rbtHeight(T), ok && checkKeys(T, n) ? "valid" : "INVALID");
+
+    // sorted file: bulk load
+  fp = fopen(sortedFile, "w");
+  rbtWrite(T, T->ROOT, fp, writeRecord);
+  fclose(fp);
+  rbtFree(T);
+  start = now();
+  T = rbtFromFile(sortedFile, sizeof(record), cmpRecords,
+                  recordFromStr);
+  t = now() - start;
+  rbtOwnData(T, freeRecord);
+  checkRbt(T, T->ROOT, &ok);
+  printf("  rbtFromFile, sorted:   %6.2f s, height %zu, %s\n", t,
+         rbtHeight(T), ok && checkKeys(T, n) ? "valid" : "INVALID");
+
+  start = now();
+  bstree *B = bstFromFile(sortedFile, sizeof(record), cmpRecords,
+                          recordFromStr);
+  t = now() - start;
+  bstOwnData(B, freeRecord);
+  printf("  bstFromFile, sorted:   %6.2f s, height %zu\n", t,
+         bstHeight(B, B->ROOT));
+  bstFree(B);
+
+    // the same sorted records without file access
+  void **data = safeCalloc(n, sizeof(void *));
+  size_t i = 0;
+  for (rbnode *x = rbtMinimum(T, T->ROOT); x != T->NIL;
+       x = rbtSuccessor(T, x))
+    data[i++] = x->data;
+  rbtree *U = rbtNew(cmpRecords);
+  start = now();
+  for (i = 0; i < n; i++)
+    rbtInsert(U, data[i]);
+  double tIns = now() - start;
+  rbtFree(U);
+  U = rbtNew(cmpRecords);
+  start = now();
+  rbtBulkLoad(U, data, n);
+  double tBulk = now() - start;
+  printf("  sorted records in memory: rbtInsert %.3f s, "
+         "rbtBulkLoad %.3f s\n", tIns, tBulk);
+  rbtFree(U);
+  rbtFree(T);
+  free(data);
+  remove(unsortedFile);
+  remove(sortedFile);
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+  Benchmark of range queries on the red-black tree
+  Sums the keys in random ranges, once by filtering the in-order
+    list of the tree (rbtInOrder), and once by walking from the
+    lower bound of the range to its end with rbtSuccessor, which
+    does not allocate anything; then compares rbtCountRange with
+    counting the nodes, and checks rbtDeleteRange and the
+    bst versions of these operations against a brute force count
+  Usage: ./rangeBench.out [n] [number of queries]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../rbt.h"
+#include "../../bstrees/bst.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Returns the number of keys in [low, high)
+static size_t bruteCount (int *keys, size_t n, int low, int high) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; i++)
+    count += keys[i] >= low && keys[i] < high;
+  return count;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 100;
+  srand(time(NULL));
+
+    // keys with duplicates, and ranges of about 1% of them
+  int *keys = safeCalloc(n, sizeof(int));
+  int range = n / 50 + 1;
+  rbtree *T = rbtNew(cmpInt);
+  bstree *B = bstNew(cmpInt);
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = rand() % (2 * n);
+    rbtInsert(T, keys + i);
+    bstInsert(B, keys + i);
+  }
+  int *lows = safeCalloc(q, sizeof(int));
+  int *highs = safeCalloc(q, sizeof(int));
+  for (size_t i = 0; i < q; i++) {
+    lows[i] = rand() % (2 * n);
+    highs[i] = lows[i] + rand() % range;
+  }
+  printf("%zu keys, %zu range queries\n", n, q);
+
+    // sum of the keys in each range
+  long sumList = 0, sumCursor = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++) {
+    dll *list = rbtInOrder(T);
+    for (dllNode *node = list->NIL->next; node != list->NIL;
+         node = node->next) {
+      int key = *(int *)node->dllData;
+      if (key >= highs[i])
+        break;
+      if (key >= lows[i])
+        sumList += key;
+    }
+    dllFree(list);
+  }
+  double tList = now() - start;
+  start = now();
+  for (size_t i = 0; i < q; i++) {
+    rbnode *end = rbtLowerBound(T, highs + i);
+    for (rbnode *x = rbtLowerBound(T, lows + i); x != end;
+         x = rbtSuccessor(T, x))
+      sumCursor += *(int *)x->data;
+  }
+  double tCursor = now() - start;
+  printf("  range sum:   %10.1f us with the list, %6.2f us with "
+         "the cursor (%s)\n", tList * 1e6 / q, tCursor * 1e6 / q,
+         sumList == sumCursor ? "same sums" : "DIFFERENT sums");
+
+    // number of keys in each range
+  size_t countWalk = 0, countTree = 0;
+  start = now();
+  for (size_t i = 0; i < q; i++)
+    countWalk += bstCountRange(B, lows + i, highs + i);
+  double tWalk = now() - start;
+  start = now();
+  for (size_t i = 0; i < q; i++)
+    countTree += rbtCountRange(T, lows + i, highs + i);
+  double tTree = now() - start;
+  bool ok = countWalk == countTree;
+  for (size_t i = 0; i < q && i < 100; i++)
+    if (rbtCountRange(T, lows + i, highs + i) !=
+        bruteCount(keys, n, lows[i], highs[i]))
+      ok = false;
+  printf("  range count: %10.2f us by walking (bst), %6.2f us with "
+         "rbtCountRange (%s)\n", tWalk * 1e6 / q, tTree * 1e6 / q,
+         ok ? "correct" : "WRONG");
+
+    // delete a few ranges from both trees
+  size_t left = n;
+  ok = true;
+  for (size_t i = 0; i < 10 && i < q; i++) {
+    size_t count = rbtCountRange(T, lows + i, highs + i);
+    if (rbtDeleteRange(T, lows + i, highs + i) != count ||
+        bstDeleteRange(B, lows + i, highs + i) != count ||
+        rbtCountRange(T, lows + i, highs + i) ||
+        bstCountRange(B, lows + i, highs + i))
+      ok = false;
+    left -= count;
+  }
+  if (rbtSize(T) != left || bstSize(B) != left)
+    ok = false;
+  int prev = -1;
+  for (rbnode *x = rbtMinimum(T, T->ROOT); x != T->NIL;
+       x = rbtSuccessor(T, x)) {
+    int key = *(int *)x->data;
+    for (size_t i = 0; i < 10 && i < q; i++)
+      if (key >= lows[i] && key < highs[i])
+        ok = false;
+    if (key < prev)
+      ok = false;
+    prev = key;
+  }
+  printf("  range delete: %s, %zu keys left\n",
+         ok ? "correct" : "WRONG", left);
+
+  free(keys);
+  free(lows);
+  free(highs);
+  rbtFree(T);
+  bstFree(B);
+  return 0;
+}
@@ -0,0 +1,569 @@
+/*
+  Generic splay tree implementation
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "spt.h"
+#include "../../../lib/clib.h"
+
+typedef enum { PRE, IN, POST } order;
+
+  // visits a node at the given depth during a walk
+typedef void (*visitFn)(spnode *x, size_t depth, void *ctx);
+
+typedef struct {
+  FILE *fp;                 // file to write to
+  sptWriteData write;       // function to write data to file
+} writeContext;
+
+typedef struct {
+  sptShowData show;         // show function
+  short count;              // number of items shown so far
+} showContext;
+
+//===================================================================
+// Creates a new node with the given data
+static spnode *sptNewNode (sptree *T, void *data) {
+  spnode *n = safeCalloc(1, sizeof(spnode));
+  if (T->copy)
+    n->data = T->copy(data);
+  else
+    n->data = data;
+  n->parent = n->left = n->right = T->NIL;
+  return n;
+}
+
+//===================================================================
+// Creates a new splay tree
+sptree *sptNew (sptCmpData cmp) {
+  sptree *T = safeCalloc(1, sizeof(sptree));
+  T->cmp = cmp;
+  T->NIL = sptNewNode(T, NULL);
+  T->ROOT = T->NIL;
+  return T;
+}
+
+//===================================================================
+// Makes the tree make copies of the data
+void sptCopyData (sptree *T, sptCpyData copy, sptFreeData free) {
+  T->copy = copy;
+  T->free = free;
+}
+
+//===================================================================
+// Sets the show function for the tree
+void sptSetShow (sptree *T, sptShowData show) {
+  T->show = show;
+}
+
+//===================================================================
+// Sets the tree to own the data; i.e. the tree will free the data
+// when the tree is deallocated
+void sptOwnData (sptree *T, sptFreeData free) {
+  T->free = free;
+}
+
+//===================================================================
+// Deallocates a node
+static void sptFreeNode (sptree *T, spnode *n) {
+  if (T->free)
+    T->free(n->data);
+  free(n);
+}
+
+//===================================================================
+// Deallocates the splay tree; since the tree may be as high as it
+// has nodes, the nodes are not freed recursively, but by rotating
+// each left child up until the node at the top has none
+void sptFree (sptree *T) {
+  if (! T) return;
+  spnode *x = T->ROOT;
+  while (x != T->NIL) {
+    spnode *y;
+    if (x->left != T->NIL) {
+      y = x->left;
+      x->left = y->right;
+      y->right = x;
+    } else {
+      y = x->right;
+      sptFreeNode(T, x);
+    }
+    x = y;
+  }
+  free(T->NIL);
+  free(T);
+}
+
+//===================================================================
+// Visits the nodes of the subtree rooted at x in the given order;
+// the walk follows the parent pointers instead of recursing, as
+// a splay tree can degenerate into a long path
+static void walk (sptree *T, spnode *x, order o, visitFn visit,
+                  void *ctx) {
+  if (x == T->NIL)
+    return;
+  spnode *top = x->parent, *prev = top;
+  size_t depth = 1;
+  while (x != top) {
+    bool down = prev == x->parent;
+    if (down) {
+      if (o == PRE)
+        visit(x, depth, ctx);
+      if (x->left != T->NIL) {
+        prev = x;
+        x = x->left;
+        depth++;
+        continue;
+      }
+    }
+    if (down || prev == x->left) {
+      if (o == IN)
+        visit(x, depth, ctx);
+      if (x->right != T->NIL) {
+        prev = x;
+        x = x->right;
+        depth++;
+        continue;
+      }
+    }
+    if (o == POST)
+      visit(x, depth, ctx);
+    prev = x;
+    x = x->parent;
+    depth--;
+  }
+}
+
+//===================================================================
+// Checks if the tree is empty
+bool sptIsEmpty (sptree *T) {
+  return T->ROOT == T->NIL;
+}
+
+//===================================================================
+// Rotates x above its parent, which becomes its child
+static void rotateUp (sptree *T, spnode *x) {
+  spnode *p = x->parent, *g = p->parent;
+  if (x == p->left) {
+    p->left = x->right;
+    if (x->right != T->NIL)
+      x->right->parent = p;
+    x->right = p;
+  } else {
+    p->right = x->left;
+    if (x->left != T->NIL)
+      x->left->parent = p;
+    x->left = p;
+  }
+  p->parent = x;
+  x->parent = g;
+  if (g == T->NIL)
+    T->ROOT = x;
+  else if (g->left == p)
+    g->left = x;
+  else
+    g->right = x;
+}
+
+//===================================================================
+// Moves x to the root: if x and its parent are both left or both
+// right children (zig-zig), the parent is rotated up first, and
+// then x; otherwise (zig-zag), x is rotated up twice; a last
+// single rotation (zig) is needed if x ends up as a child of
+// the root
+static void splay (sptree *T, spnode *x) {
+  while (x->parent != T->NIL) {
+    spnode *p = x->parent, *g = p->parent;
+    if (g != T->NIL)
+      rotateUp(T, (x == p->left) == (p == g->left) ? p : x);
+    rotateUp(T, x);
+  }
+}
+
+//===================================================================
+// Inserts a new node into the tree, and splays it to the root
+void sptInsert (sptree *T, void *data) {
+  spnode *z = sptNewNode(T, data);
+  spnode *y = T->NIL;
+  spnode *x = T->ROOT;
+  bool left = false;
+
+  while (x != T->NIL) {
+    y = x;
+    left = T->cmp(z->data, x->data) < 0;
+    x = left ? x->left : x->right;
+  }
+  z->parent = y;
+  if (y == T->NIL)
+    T->ROOT = z;
+  else if (left)
+    y->left = z;
+  else
+    y->right = z;
+  T->size++;
+  splay(T, z);
+}
+
+//===================================================================
+// Builds a perfectly balanced subtree from the sorted data
+// in [lo, hi)
+static spnode *sptBuild (sptree *T, void **data, size_t lo,
+                         size_t hi, spnode *parent) {
+  if (lo == hi)
+    return T->NIL;
+  size_t mid = lo + (hi - lo) / 2;
+  spnode *x = sptNewNode(T, data[mid]);
+  x->parent = parent;
+  x->left = sptBuild(T, data, lo, mid, x);
+  x->right = sptBuild(T, data, mid + 1, hi, x);
+  return x;
+}
+
+//===================================================================
+// Builds a perfectly balanced tree from n data items sorted by key
+bool sptBulkLoad (sptree *T, void **data, size_t n) {
+  if (T->ROOT != T->NIL) {
+    fprintf(stderr, "sptBulkLoad: tree is not empty\n");
+    return false;
+  }
+  for (size_t i = 1; i < n; i++)
+    if (T->cmp(data[i - 1], data[i]) > 0) {
+      fprintf(stderr, "sptBulkLoad: data is not sorted\n");
+      return false;
+    }
+  T->ROOT = sptBuild(T, data, 0, n, T->NIL);
+  T->size = n;
+  return true;
+}
+
+//===================================================================
+// Searches the tree for a key, and splays the node that was found,
+// or the last node on the search path, to the root
+spnode *sptSearch (sptree *T, void *key) {
+  spnode *x = T->ROOT, *last = T->NIL;
+  while (x != T->NIL) {
+    int c = T->cmp(key, x->data);
+    if (c == 0) {
+      splay(T, x);
+      return x;
+    }
+    last = x;
+    x = c < 0 ? x->left : x->right;
+  }
+  if (last != T->NIL)
+    splay(T, last);
+  return NULL;
+}
+
+//===================================================================
+// Returns the node with the smallest key in the subtree rooted at x
+spnode *sptMinimum (sptree *T, spnode *x) {
+  while (x->left != T->NIL)
+    x = x->left;
+  return x;
+}
+
+//===================================================================
+// Returns the node with the largest key in the subtree rooted at x
+spnode *sptMaximum (sptree *T, spnode *x) {
+  while (x->right != T->NIL)
+    x = x->right;
+  return x;
+}
+
+//===================================================================
+// Deletes a node from the tree: z is splayed to the root, and
+// the maximum of its left subtree is splayed to the root of that
+// subtree, where it has no right child, and adopts the right
+// subtree of z; the other nodes stay where they are, so that a
+// successor that was computed before the deletion is still valid
+void sptDelete (sptree *T, spnode *z) {
+  splay(T, z);
+  spnode *L = z->left, *R = z->right;
+  if (L == T->NIL) {
+    T->ROOT = R;
+    R->parent = T->NIL;
+  } else {
+    L->parent = T->NIL;
+    T->ROOT = L;
+    spnode *m = sptMaximum(T, L);
+    splay(T, m);
+    m->right = R;
+    if (R != T->NIL)
+      R->parent = m;
+  }
+  sptFreeNode(T, z);
+  T->size--;
+}
+
+//===================================================================
+// Returns the successor of a node
+spnode *sptSuccessor (sptree *T, spnode *x) {
+  if (x->right != T->NIL)
+    return sptMinimum(T, x->right);
+  spnode *y = x->parent;
+  while (y != T->NIL && x == y->right) {
+    x = y;
+    y = y->parent;
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the predecessor of a node
+spnode *sptPredecessor (sptree *T, spnode *x) {
+  if (x->left != T->NIL)
+    return sptMaximum(T, x->left);
+  spnode *y = x->parent;
+  while (y != T->NIL && x == y->left) {
+    x = y;
+    y = y->parent;
+  }
+  return y;
+}
+
+//===================================================================
+// Returns the first node with a key not less than key (upper is
+// false) or greater than key (upper is true), and splays the last
+// node on the search path to the root
+static spnode *bound (sptree *T, void *key, bool upper) {
+  spnode *x = T->ROOT, *y = T->NIL, *last = T->NIL;
+  while (x != T->NIL) {
+    last = x;
+    int c = T->cmp(x->data, key);
+    if (c < 0 || (upper && c == 0))
+      x = x->right;
+    else {
+      y = x;
+      x = x->left;
+    }
+  }
+  if (last != T->NIL)
+    splay(T, last);
+  return y;
+}
+
+//===================================================================
+// Returns the first node with a key not less than key
+spnode *sptLowerBound (sptree *T, void *key) {
+  return bound(T, key, false);
+}
+
+//===================================================================
+// Returns the first node with a key greater than key
+spnode *sptUpperBound (sptree *T, void *key) {
+  return bound(T, key, true);
+}
+
+//===================================================================
+// Returns the number of nodes with a key in [low, high)
+size_t sptCountRange (sptree *T, void *low, void *high) {
+  size_t count = 0;
+  for (spnode *x = sptLowerBound(T, low); x != T->NIL &&
+       T->cmp(x->data, high) < 0; x = sptSuccessor(T, x))
+    count++;
+  return count;
+}
+
+//===================================================================
+// Deletes all nodes with a key in [low, high); deleting a node
+// rotates its successor, but keeps it valid
+size_t sptDeleteRange (sptree *T, void *low, void *high) {
+  size_t count = 0;
+  spnode *x = sptLowerBound(T, low);
+  while (x != T->NIL && T->cmp(x->data, high) < 0) {
+    spnode *next = sptSuccessor(T, x);
+    sptDelete(T, x);
+    x = next;
+    count++;
+  }
+  return count;
+}
+
+//===================================================================
+// Shows the data of a node, asking to continue after every 20 items
+static void showData (spnode *x, size_t depth, void *ctx) {
+  showContext *c = ctx;
+  char buffer[100], ch;
+  if (c->count < 20) {
+    c->show(x->data);
+    c->count++;
+  } else if (c->count == 20) {
+    printf("Print 20 more? (y/n): ");
+    if ((fgets (buffer, 100, stdin) &&
+        sscanf(buffer, "%c", &ch) != 1) || ch != 'y')
+      c->count = 21;
+    else
+      c->count = 0;
+    clearStdin(buffer);
+  }
+}
+
+//===================================================================
+// Shows the data in the tree in order
+void sptShow (sptree *T, spnode *x) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  showContext c = {T->show, 0};
+  walk(T, x, IN, showData, &c);
+  printf("\n");
+}
+
+//===================================================================
+// Shows a node of the tree T passed as the context, indented by
+// its level below the root of the walk
+static void showLevel (spnode *x, size_t depth, void *ctx) {
+  size_t level = depth - 1;
+  if (level) {
+    for (size_t i = 0; i < level; i++)
+      printf("-");
+    if (x->parent->left == x)
+      printf("|L(%zu): ", level);
+    else
+      printf("|R(%zu): ", level);
+  } else
+    printf("ROOT: ");
+  sptShowNode(ctx, x);
+  printf("\n");
+}
+
+//===================================================================
+// Shows the structure of the tree rooted at x
+void sptShowTree (sptree *T, spnode *x) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  printf("--------------\n"
+         "Tree structure\n"
+         "--------------\n");
+  walk(T, x, IN, showLevel, T);
+}
+
+//===================================================================
+// Shows the data in a node
+void sptShowNode (sptree *T, spnode *n) {
+  if (! T->show) {
+    fprintf(stderr, "Error: show function not set\n");
+    return;
+  }
+  if (n) T->show(n->data);
+}
+
+//===================================================================
+// Writes the data of a node to a file
+static void writeData (spnode *x, size_t depth, void *ctx) {
+  writeContext *c = ctx;
+  c->write(x->data, c->fp);
+}
+
+//===================================================================
+// Writes the data in the tree in order to given file
+void sptWrite (sptree *T, spnode *x, FILE *fp,
+               sptWriteData write) {
+  writeContext c = {fp, write};
+  walk(T, x, IN, writeData, &c);
+}
+
+//===================================================================
+// Reads data from a file with one record per line, of any length;
+// the records are collected first, so that sorted records can be
+// bulk loaded instead of inserted one by one
+sptree *sptFromFile (char *filename, size_t dataSize,
+    sptCmpData cmp, sptStrToData fromStr) {
+
+  FILE *fp = fopen(filename, "r");
+  if (! fp) {
+    printf("Error: could not open file %s\n", filename);
+    exit(EXIT_FAILURE);
+  }
+    // a large stream buffer saves system calls on big files
+  setvbuf(fp, NULL, _IOFBF, 1 << 20);
+
+  string *line = newString(128);
+  size_t n = 0, cap = 1024;
+  void **data = safeCalloc(cap, sizeof(void *));
+  bool sorted = true;
+  while (readLine(fp, line)) {
+    if (n == cap) {
+      cap *= 2;
+      data = safeRealloc(data, cap * sizeof(void *));
+    }
+    data[n] = safeCalloc(1, dataSize);
+    if (! fromStr(data[n], (char *)line->data)) {
+      printf("Error: invalid input data on line %zu.\n"
+             "Check file %s for errors and try again.\n",
+              n + 1, filename);
+      for (size_t i = 0; i <= n; i++)
+        free(data[i]);
+      free(data);
+      freeString(line);
+      fclose(fp);
+      exit(EXIT_FAILURE);
+    }
+    if (n && cmp(data[n - 1], data[n]) > 0)
+      sorted = false;
+    n++;
+  }
+
+  sptree *T = sptNew(cmp);
+  if (sorted)
+    sptBulkLoad(T, data, n);
+  else
+    for (size_t i = 0; i < n; i++)
+      sptInsert(T, data[i]);
+  printf("Data successfully read from file %s\n", filename);
+  free(data);
+  freeString(line);
+  fclose(fp);
+  return T;
+}
+
+//===================================================================
+// Keeps the largest depth of the nodes visited
+static void maxDepth (spnode *x, size_t depth, void *ctx) {
+  size_t *height = ctx;
+  if (depth > *height)
+    *height = depth;
+}
+
+//===================================================================
+// Returns the height of the tree, in nodes
+size_t sptHeight (sptree *T) {
+  size_t height = 0;
+  walk(T, T->ROOT, PRE, maxDepth, &height);
+  return height;
+}
+
+//===================================================================
+// Adds the data of a node to a list
+static void addData (spnode *x, size_t depth, void *ctx) {
+  dllPushBack((dll *)ctx, x->data);
+}
+
+//===================================================================
+// Returns an in-order traversal list of the tree
+dll *sptInOrder (sptree *T) {
+  dll *L = dllNew();
+  walk(T, T->ROOT, IN, addData, L);
+  return L;
+}
+
+//===================================================================
+// Returns a pre-order traversal list of the tree
+dll *sptPreOrder (sptree *T) {
+  dll *L = dllNew();
+  walk(T, T->ROOT, PRE, addData, L);
+  return L;
+}
+
+//===================================================================
+// Returns a post-order traversal list of the tree
+dll *sptPostOrder (sptree *T) {
+  dll *L = dllNew();
+  walk(T, T->ROOT, POST, addData, L);
+  return L;
+}
@@ -0,0 +1,152 @@
+/*
+  Generic splay tree implementation
+  A splay tree is a binary search tree without any balance
+  information: every search, insertion and deletion moves the
+  node it reaches to the root by a sequence of rotations, so that
+  often used keys stay close to the root. A single operation may
+  take O(n) time, but any sequence of m operations takes
+  O((m + n) log n) time, and much less when the accesses are
+  skewed towards a few keys.
+  The interface is the same as that of the binary search tree;
+  successor, predecessor, minimum and maximum do not splay, so
+  that nodes can be visited in order without changing the tree.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef SPT_H_INCLUDED
+#define SPT_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "../../lists/dll.h"
+
+// function pointer types
+typedef int (*sptCmpData)(void const *a, void const *b);
+typedef void (*sptShowData)(void const *data);
+typedef void (*sptWriteData)(void const *data, FILE *file);
+typedef bool (*sptStrToData)(void *data, char const *str);
+typedef void (*sptFreeData)(void *data);
+typedef void *(*sptCpyData)(void const *data);
+
+// data structures and types
+typedef struct spnode {
+  void *data;               // data stored in the node
+  struct spnode *parent;    // parent node
+  struct spnode *left;      // left child
+  struct spnode *right;     // right child
+} spnode;
+
+typedef struct {
+  spnode *ROOT, *NIL;       // root and sentinel nodes
+  sptCmpData cmp;           // comparison function
+  sptShowData show;         // show function
+  sptFreeData free;         // function to free data
+  sptCpyData copy;          // function to copy data
+  size_t size;              // number of tree nodes
+} sptree;
+
+// function prototypes
+
+  // creates a new splay tree
+sptree *sptNew (sptCmpData cmp);
+
+  // makes the tree make copies of the data
+void sptCopyData (sptree *T, sptCpyData copy,
+                  sptFreeData free);
+
+  // sets the tree to own the data
+void sptOwnData (sptree *T, sptFreeData free);
+
+  // sets the show function for the tree
+void sptSetShow (sptree *T, sptShowData show);
+
+  // returns true if the tree is empty
+bool sptIsEmpty (sptree *T);
+
+  // inserts a new node into the tree, and splays it to the root
+void sptInsert (sptree *T, void *data);
+
+  // builds a perfectly balanced tree from n data items sorted
+  // by key in O(n) time; the tree must be empty; returns false
+  // if it is not, or if the data is not sorted
+bool sptBulkLoad (sptree *T, void **data, size_t n);
+
+  // deallocates the tree
+void sptFree (sptree *T);
+
+  // searches the tree for a key, and splays the node that was
+  // found, or else the last node on the search path, to the root;
+  // returns NULL if the key is not in the tree
+spnode *sptSearch (sptree *T, void *key);
+
+  // deletes a node from the tree
+void sptDelete (sptree *T, spnode *z);
+
+  // returns the minimum node in the subtree rooted at x
+spnode *sptMinimum (sptree *T, spnode *x);
+
+  // returns the maximum node in the subtree rooted at x
+spnode *sptMaximum (sptree *T, spnode *x);
+
+  // returns the successor of a node
+spnode *sptSuccessor (sptree *T, spnode *x);
+
+  // returns the predecessor of a node
+spnode *sptPredecessor (sptree *T, spnode *x);
+
+  // returns the first node with a key not less than key,
+  // or NIL if there is none; splays the last node on the
+  // search path to the root
+spnode *sptLowerBound (sptree *T, void *key);
+
+  // returns the first node with a key greater than key,
+  // or NIL if there is none; splays the last node on the
+  // search path to the root
+spnode *sptUpperBound (sptree *T, void *key);
+
+  // returns the number of nodes with a key in [low, high)
+size_t sptCountRange (sptree *T, void *low, void *high);
+
+  // deletes all nodes with a key in [low, high), and returns
+  // their number
+size_t sptDeleteRange (sptree *T, void *low, void *high);
+
+  // displays the (sub)tree rooted at x in order
+void sptShow (sptree *T, spnode *x);
+
+  // shows the structure of the tree rooted at x
+void sptShowTree (sptree *T, spnode *x);
+
+  // displays a tree node
+void sptShowNode (sptree *T, spnode *x);
+
+  // writes a tree to a file in order
+void sptWrite (sptree *T, spnode *x, FILE *fp,
+  sptWriteData write);
+
+  // reads a tree from a file with one record per line; if the
+  // records are sorted, as written by sptWrite, the tree is
+  // built in O(n) time
+sptree *sptFromFile (char *filename, size_t dataSize,
+  sptCmpData cmp, sptStrToData fromStr);
+
+  // returns the number of nodes in the tree
+static inline size_t sptSize (sptree *T) {
+  return T->size;
+}
+
+  // returns the height of the tree, in nodes
+size_t sptHeight (sptree *T);
+
+  // returns an in-order traversal list of the tree
+dll *sptInOrder (sptree *T);
+
+  // returns a pre-order traversal list of the tree
+dll *sptPreOrder (sptree *T);
+
+  // returns a post-order traversal list of the tree
+dll *sptPostOrder (sptree *T);
+
+#endif  // SPT_H_INCLUDED
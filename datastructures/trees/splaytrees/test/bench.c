@@ -0,0 +1,169 @@
+/*
+  Benchmark of the splay tree against the red-black tree and the
+    unbalanced binary search tree for skewed lookups
+  Builds each tree from the same n keys in random order, then
+    searches it for q keys drawn from a Zipf distribution, in which
+    the key of rank k is searched with a probability proportional
+    to 1/k^s; the ranks are assigned to the keys at random, apart
+    from the order of insertion, so that the hot keys are spread
+    over the whole key range and over all depths; reports the
+    time and the number of key comparisons per lookup for several
+    skew parameters s, where s = 0 gives uniform lookups
+  Usage: ./bench.out [n] [number of lookups]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../spt.h"
+#include "../../rbtrees/rbt.h"
+#include "../../bstrees/bst.h"
+#include "../../../../lib/clib.h"
+#include <time.h>
+#include <math.h>
+
+typedef struct {
+  double time;             // seconds for all lookups
+  size_t comparisons;      // key comparisons for all lookups
+} result;
+
+static size_t comparisons = 0;
+
+//===================================================================
+// Compares two integers, and counts the comparisons
+int cmpInt (void const *a, void const *b) {
+  int x = *(int *)a, y = *(int *)b;
+  comparisons++;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Returns a random number in [0, 1)
+static double uniform () {
+  return (rand() + (double)rand() / (RAND_MAX + 1.0)) /
+         (RAND_MAX + 1.0);
+}
+
+//===================================================================
+// Fills lookups with q keys from a Zipf distribution with skew s
+// over the n keys, where keys[k] has rank k + 1; each key is drawn
+// by a binary search for a uniform number in the cumulative
+// distribution
+static void zipf (int *keys, size_t n, double s, int **lookups,
+                  size_t q) {
+  double *cdf = safeCalloc(n, sizeof(double));
+  double sum = 0;
+  for (size_t k = 0; k < n; k++)
+    cdf[k] = sum += pow(k + 1, -s);
+  for (size_t i = 0; i < q; i++) {
+    double u = uniform() * sum;
+    size_t lo = 0, hi = n - 1;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (cdf[mid] <= u)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    lookups[i] = keys + lo;
+  }
+  free(cdf);
+}
+
+//===================================================================
+// Searches a splay tree with n keys for q keys
+static result runSpt (int **keys, size_t n, int **lookups, size_t q) {
+  sptree *T = sptNew(cmpInt);
+  for (size_t i = 0; i < n; i++)
+    sptInsert(T, keys[i]);
+  comparisons = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++)
+    sptSearch(T, lookups[i]);
+  result r = {now() - start, comparisons};
+  sptFree(T);
+  return r;
+}
+
+//===================================================================
+// Searches a red-black tree with n keys for q keys
+static result runRbt (int **keys, size_t n, int **lookups, size_t q) {
+  rbtree *T = rbtNew(cmpInt);
+  for (size_t i = 0; i < n; i++)
+    rbtInsert(T, keys[i]);
+  comparisons = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++)
+    rbtSearch(T, lookups[i]);
+  result r = {now() - start, comparisons};
+  rbtFree(T);
+  return r;
+}
+
+//===================================================================
+// Searches an unbalanced binary search tree with n keys for q keys
+static result runBst (int **keys, size_t n, int **lookups, size_t q) {
+  bstree *T = bstNew(cmpInt);
+  for (size_t i = 0; i < n; i++)
+    bstInsert(T, keys[i]);
+  comparisons = 0;
+  double start = now();
+  for (size_t i = 0; i < q; i++)
+    bstSearch(T, lookups[i]);
+  result r = {now() - start, comparisons};
+  bstFree(T);
+  return r;
+}
+
+//===================================================================
+// Shows a result
+static void showResult (char *name, result r, size_t q) {
+  printf("    %-6s %8.3f us/op  %6.1f cmp/op\n", name,
+         r.time * 1e6 / q, (double)r.comparisons / q);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 5000000;
+  srand(time(NULL));
+
+    // distinct keys in order of rank, and in order of insertion
+  int *keys = safeCalloc(n, sizeof(int));
+  int **order = safeCalloc(n, sizeof(int *));
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = i;
+    order[i] = keys + i;
+  }
+  for (size_t i = n - 1; i > 0; i--) {
+    size_t j = rand() % (i + 1);
+    SWAP(keys[i], keys[j]);
+    j = rand() % (i + 1);
+    SWAP(order[i], order[j]);
+  }
+  int **lookups = safeCalloc(q, sizeof(int *));
+  printf("%zu keys, %zu lookups\n", n, q);
+
+  double skews[] = {0, 0.8, 1.0, 1.2, 1.5};
+  for (size_t k = 0; k < sizeof(skews) / sizeof(skews[0]); k++) {
+    zipf(keys, n, skews[k], lookups, q);
+    printf("  s = %.1f\n", skews[k]);
+    showResult("splay", runSpt(order, n, lookups, q), q);
+    showResult("rbt", runRbt(order, n, lookups, q), q);
+    showResult("bst", runBst(order, n, lookups, q), q);
+  }
+
+  free(keys);
+  free(order);
+  free(lookups);
+  return 0;
+}
@@ -0,0 +1,167 @@
+#include "../spt.h"
+#include "../../../../lib/clib.h"
+#include <stdio.h>
+#include <time.h>
+
+//===================================================================
+// Compares two integers
+int cmpInt (void const *a, void const *b) {
+  return *(int *)a - *(int *)b;
+}
+
+//===================================================================
+// Shows an integer
+void showInt (void const *a) {
+  printf("%d", *(int *)a);
+}
+
+//===================================================================
+// Checks the parent pointers of the subtree rooted at x, and
+// returns its number of nodes
+static size_t checkNodes (sptree *T, spnode *x, bool *ok) {
+  if (x == T->NIL)
+    return 0;
+  if (x->left != T->NIL && x->left->parent != x)
+    *ok = false;
+  if (x->right != T->NIL && x->right->parent != x)
+    *ok = false;
+  return checkNodes(T, x->left, ok) +
+         checkNodes(T, x->right, ok) + 1;
+}
+
+//===================================================================
+// Checks a tree under random insertions, searches and deletions
+// against an array that counts how often each key is in the tree;
+// a node that is found or inserted must end up at the root
+static bool stressTest (size_t n) {
+  sptree *T = sptNew(cmpInt);
+  sptOwnData(T, free);
+  int *count = safeCalloc(n, sizeof(int));
+  size_t size = 0;
+  bool ok = true;
+  for (size_t i = 0; i < 20 * n && ok; i++) {
+    int key = rand() % n;
+    if (rand() % 2) {
+      int *d = safeMalloc(sizeof(int));
+      *d = key;
+      sptInsert(T, d);
+      if (T->ROOT->data != d)
+        ok = false;
+      count[key]++;
+      size++;
+    } else {
+      spnode *x = sptSearch(T, &key);
+      if ((x != NULL) != (count[key] > 0))
+        ok = false;
+      else if (x && T->ROOT != x)
+        ok = false;
+      else if (x && rand() % 2) {
+        sptDelete(T, x);
+        count[key]--;
+        size--;
+      }
+    }
+    if ((T->ROOT != T->NIL && T->ROOT->parent != T->NIL) ||
+        sptSize(T) != size ||
+        checkNodes(T, T->ROOT, &ok) != size)
+      ok = false;
+  }
+  int key = 0;
+  for (spnode *x = sptIsEmpty(T) ? T->NIL : sptMinimum(T, T->ROOT);
+       x != T->NIL; x = sptSuccessor(T, x)) {
+    while (key < (int)n && count[key] == 0)
+      key++;
+    if (key == (int)n || *(int *)x->data != key)
+      ok = false;
+    else
+      count[key]--;
+  }
+  free(count);
+  sptFree(T);
+  return ok;
+}
+
+//===================================================================
+// Checks that a tree of n ascending keys, which degenerates into
+// a path, can be traversed and deallocated without recursing
+static bool pathTest (size_t n) {
+  sptree *T = sptNew(cmpInt);
+  sptOwnData(T, free);
+  for (size_t i = 0; i < n; i++) {
+    int *d = safeMalloc(sizeof(int));
+    *d = i;
+    sptInsert(T, d);
+  }
+  bool ok = sptHeight(T) == n;
+  dll *L = sptInOrder(T);
+  ok = ok && dllSize(L) == n;
+  dllFree(L);
+    // searching the smallest key halves the height of the path
+  int key = 0;
+  ok = ok && sptSearch(T, &key) && sptHeight(T) <= n / 2 + 2;
+  sptFree(T);
+  return ok;
+}
+
+//===================================================================
+
+int main (void) {
+  srand(time(NULL));
+  sptree *T = sptNew(cmpInt);
+  sptSetShow(T, showInt);
+  sptOwnData(T, free);
+
+  // insert 20 random integers
+  for (int i = 0; i < 20; i++) {
+    int *d = safeMalloc(sizeof(int));
+    *d = rand() % 100;
+    sptInsert(T, d);
+  }
+
+  // the last inserted key is at the root
+  sptShowTree(T, T->ROOT);
+  printf("\n");
+
+  // in-order traversal
+  printf("\nIn-order \n");
+  printf("---------\n");
+  dll *inOrder = sptInOrder(T);
+  dllSetShow(inOrder, showInt);
+  dllShow(inOrder);
+  dllFree(inOrder);
+  printf("\n");
+
+  // pre-order traversal
+  printf("Pre-order \n");
+  printf("---------\n");
+  dll *preOrder = sptPreOrder(T);
+  dllSetShow(preOrder, showInt);
+  dllShow(preOrder);
+  dllFree(preOrder);
+  printf("\n");
+
+  // post-order traversal
+  printf("Post-order \n");
+  printf("----------\n");
+  dll *postOrder = sptPostOrder(T);
+  dllSetShow(postOrder, showInt);
+  dllShow(postOrder);
+  dllFree(postOrder);
+  printf("\n");
+
+  // searching the smallest key splays
+  // it to the root
+  spnode *min = sptMinimum(T, T->ROOT);
+  sptSearch(T, min->data);
+  sptShowTree(T, T->ROOT);
+  printf("\n");
+
+  // random insertions, searches and deletions
+  printf("Random operations: %s\n",
+         stressTest(1000) ? "passed" : "FAILED");
+  printf("Degenerate tree: %s\n",
+         pathTest(1000000) ? "passed" : "FAILED");
+
+  sptFree(T);
+  return 0;
+}
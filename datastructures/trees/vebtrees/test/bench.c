@@ -0,0 +1,132 @@
+/*
+  Benchmark of the integer set against the red-black tree on a
+    dense set: n distinct random keys from 0..2n-1
+  Times the inserts, random lookups, a walk over all keys in
+    order by successor queries, successor queries from random
+    keys in the set, and the deletions
+  Usage: ./bench.out [n] [number of queries]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>
+#include "../veb.h"
+#include "../../rbtrees/rbt.h"
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// Compares two 32-bit unsigned integers
+int cmpKeys (void const *a, void const *b) {
+  uint32_t x = *(uint32_t *)a, y = *(uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Shows the time per operation for both structures
+static void report (char *name, double tVeb, double tRbt,
+                    size_t n, size_t check) {
+  printf("  %-12s: %7.1f ns  %7.1f ns   (%zu)\n", name,
+         tVeb * 1e9 / n, tRbt * 1e9 / n, check);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 4000000;
+  srand(time(NULL));
+
+    // n distinct keys: a random half of 0..2n-1, shuffled
+  uint32_t *keys = safeCalloc(2 * n, sizeof(uint32_t));
+  for (size_t i = 0; i < 2 * n; i++)
+    keys[i] = i;
+  for (size_t i = 2 * n - 1; i > 0; i--) {
+    size_t j = rand() % (i + 1);
+    SWAP(keys[i], keys[j]);
+  }
+  uint32_t *queries = safeCalloc(q, sizeof(uint32_t));
+  for (size_t i = 0; i < q; i++)
+    queries[i] = keys[rand() % (2 * n)];
+
+  printf("%zu keys in 0..%zu, %zu queries\n", n, 2 * n - 1, q);
+  printf("  %-12s  %10s  %10s\n", "", "veb", "rbt");
+
+  vebtree *V = vebNew(2 * n);
+  rbtree *T = rbtNew(cmpKeys);
+  double start = now();
+  for (size_t i = 0; i < n; i++)
+    vebInsert(V, keys[i]);
+  double tVeb = now() - start;
+  start = now();
+  for (size_t i = 0; i < n; i++)
+    rbtInsert(T, keys + i);
+  report("insert", tVeb, now() - start, n, vebSize(V));
+
+    // lookups of keys of which about half are in the set
+  size_t found = 0;
+  start = now();
+  for (size_t i = 0; i < q; i++)
+    found += vebMember(V, queries[i]);
+  tVeb = now() - start;
+  start = now();
+  for (size_t i = 0; i < q; i++)
+    found -= rbtSearch(T, queries + i) != NULL;
+  report("search", tVeb, now() - start, q, found);
+
+    // walk over all keys in increasing order
+  size_t count = 0;
+  uint32_t k;
+  start = now();
+  for (bool ok = vebMin(V, &k); ok; ok = vebSuccessor(V, k, &k))
+    count++;
+  tVeb = now() - start;
+  start = now();
+  for (rbnode *x = rbtMinimum(T, T->ROOT); x != T->NIL;
+       x = rbtSuccessor(T, x))
+    count--;
+  report("walk", tVeb, now() - start, n, count);
+
+    // successors of random keys in the set; the tree first
+    // has to find the node of the key
+  uint64_t sum = 0;
+  start = now();
+  for (size_t i = 0; i < q; i++) {
+    uint32_t key = keys[i % n];
+    if (vebSuccessor(V, key, &k))
+      sum += k;
+  }
+  tVeb = now() - start;
+  start = now();
+  for (size_t i = 0; i < q; i++) {
+    rbnode *x = rbtSuccessor(T, rbtSearch(T, keys + i % n));
+    if (x != T->NIL)
+      sum -= *(uint32_t *)x->data;
+  }
+  report("successor", tVeb, now() - start, q, sum);
+
+  start = now();
+  for (size_t i = 0; i < n; i++)
+    vebDelete(V, keys[i]);
+  tVeb = now() - start;
+  start = now();
+  for (size_t i = 0; i < n; i++)
+    rbtDelete(T, rbtSearch(T, keys + i));
+  report("delete", tVeb, now() - start, n, vebSize(V) + rbtSize(T));
+  printf("  (the numbers in parentheses should be 0 except for "
+         "insert)\n");
+
+  vebFree(V);
+  rbtFree(T);
+  free(keys);
+  free(queries);
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+  Ordered set of integer keys (64-ary bitmap hierarchy)
+  Compares random inserts, deletions, and successor and
+    predecessor queries with a plain array of flags, checks the
+    keys at both ends of a 32-bit universe, and uses the set as
+    a monotone priority queue
+  Author: David De Potter
+*/
+
+#include "../veb.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+#define U (1 << 20)
+
+//===================================================================
+// Returns the smallest key after key in the flags, or U if none
+uint64_t nextFlag (bool *flags, uint64_t key) {
+  for (key++; key < U && ! flags[key]; key++) ;
+  return key;
+}
+
+//===================================================================
+// Returns the largest key before key in the flags, or U if none
+uint64_t prevFlag (bool *flags, uint64_t key) {
+  while (key-- > 0)
+    if (flags[key]) return key;
+  return U;
+}
+
+//===================================================================
+
+int main (void) {
+  srand(time(NULL));
+  vebtree *V = vebNew(U);
+  bool *flags = safeCalloc(U, sizeof(bool));
+  bool ok = true;
+  uint32_t k;
+
+    // random inserts and deletions in a small part of the
+    // universe, so that blocks fill up and become empty
+  for (size_t i = 0; i < 2000000; i++) {
+    uint32_t key = rand() % (U / 8);
+    if (i % 3 == 0) {
+      if (vebDelete(V, key) != flags[key]) ok = false;
+      flags[key] = false;
+    } else {
+      if (vebInsert(V, key) == flags[key]) ok = false;
+      flags[key] = true;
+    }
+  }
+  size_t size = 0;
+  for (size_t i = 0; i < U; i++)
+    if (vebMember(V, i) != flags[i]) ok = false;
+    else size += flags[i];
+  if (size != vebSize(V)) ok = false;
+  printf("Inserts, deletions, member: %s\n", ok ? "ok" : "FAILED");
+
+    // successor and predecessor of random keys,
+    // which need not be in the set
+  for (size_t i = 0; i < 100000; i++) {
+    uint32_t key = rand() % U;
+    uint64_t next = nextFlag(flags, key), prev = prevFlag(flags, key);
+    if (vebSuccessor(V, key, &k) ? k != next : next != U) ok = false;
+    if (vebPredecessor(V, key, &k) ? k != prev : prev != U) ok = false;
+  }
+  printf("Successor and predecessor: %s\n", ok ? "ok" : "FAILED");
+
+    // the set as a monotone priority queue
+  uint32_t last = 0;
+  size_t count = 0;
+  while (vebPopMin(V, &k)) {
+    if (k < last || ! flags[k]) ok = false;
+    last = k;
+    count++;
+  }
+  if (count != size || V->nBlocks != 0) ok = false;
+  printf("Popped %zu keys in order: %s\n", count, ok ? "ok" : "FAILED");
+  vebFree(V);
+
+    // keys at both ends of the 32-bit universe
+  V = vebNew(1ULL << 32);
+  vebInsert(V, 0);
+  vebInsert(V, 4294967295U);
+  vebInsert(V, 1U << 31);
+  uint32_t min, max, mid;
+  ok = vebMin(V, &min) && min == 0 && vebMax(V, &max)
+       && max == 4294967295U && vebSuccessor(V, 0, &mid)
+       && mid == 1U << 31 && vebPredecessor(V, max, &k) && k == mid
+       && ! vebSuccessor(V, max, &k) && ! vebPredecessor(V, 0, &k);
+  printf("32-bit universe: %s\n", ok ? "ok" : "FAILED");
+  vebShow(V);
+  vebFree(V);
+
+  free(flags);
+  return 0;
+}
@@ -0,0 +1,272 @@
+/*
+  Ordered set of integer keys, using a hierarchy of 64-ary bitmaps
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "veb.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// Returns the position of the lowest set bit of x, which is
+// not zero
+static inline unsigned lowBit (uint64_t x) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(x);
+#else
+  unsigned b = 0;
+  while (! (x & 1)) {
+    x >>= 1;
+    b++;
+  }
+  return b;
+#endif
+}
+
+//===================================================================
+// Returns the position of the highest set bit of x, which is
+// not zero
+static inline unsigned highBit (uint64_t x) {
+#if defined(__GNUC__)
+  return 63 - __builtin_clzll(x);
+#else
+  unsigned b = 0;
+  while (x >>= 1)
+    b++;
+  return b;
+#endif
+}
+
+//===================================================================
+// Returns word i of the given level
+static inline uint64_t getWord (vebtree *V, size_t level,
+                                uint64_t i) {
+  if (level)
+    return V->levels[level][i];
+  uint64_t *block = V->blocks[i >> 6];
+  return block ? block[i & 63] : 0;
+}
+
+//===================================================================
+// Creates a new set for keys in 0..universe-1
+vebtree *vebNew (uint64_t universe) {
+
+  if (universe == 0 || universe > (1ULL << 32)) {
+    fprintf(stderr, "vebNew: universe must be in 1..2^32\n");
+    return NULL;
+  }
+  vebtree *V = safeCalloc(1, sizeof(vebtree));
+  V->universe = universe;
+
+    // level k has ceil(universe / 64^(k+1)) words
+  uint64_t nWords = (universe + 63) / 64;
+  V->blocks = safeCalloc((nWords + 63) / 64, sizeof(uint64_t *));
+  V->nLevels = 1;
+  while (nWords > 1) {
+    nWords = (nWords + 63) / 64;
+    V->levels[V->nLevels++] = safeCalloc(nWords, sizeof(uint64_t));
+  }
+  return V;
+}
+
+//===================================================================
+// Deallocates the set
+void vebFree (vebtree *V) {
+  if (! V) return;
+  vebClear(V);
+  free(V->blocks);
+  for (size_t k = 1; k < V->nLevels; k++)
+    free(V->levels[k]);
+  free(V);
+}
+
+//===================================================================
+// Returns true if the key is in the set
+bool vebMember (vebtree *V, uint32_t key) {
+  if (key >= V->universe) return false;
+  uint64_t *block = V->blocks[key >> 12];
+  return block && (block[(key >> 6) & 63] >> (key & 63)) & 1;
+}
+
+//===================================================================
+// Inserts a key into the set
+bool vebInsert (vebtree *V, uint32_t key) {
+
+  if (key >= V->universe) {
+    fprintf(stderr, "vebInsert: key out of range\n");
+    return false;
+  }
+  uint64_t **block = V->blocks + (key >> 12);
+  if (! *block) {
+    *block = safeCalloc(64, sizeof(uint64_t));
+    V->nBlocks++;
+  }
+  uint64_t *w = *block + ((key >> 6) & 63);
+  uint64_t bit = 1ULL << (key & 63);
+  if (*w & bit)
+    return false;
+
+    // set the bit, and the bits of the higher levels as
+    // long as the words there were empty
+  bool wasEmpty = *w == 0;
+  *w |= bit;
+  uint64_t i = key >> 6;
+  for (size_t k = 1; wasEmpty && k < V->nLevels; k++, i >>= 6) {
+    w = V->levels[k] + (i >> 6);
+    wasEmpty = *w == 0;
+    *w |= 1ULL << (i & 63);
+  }
+  V->size++;
+  return true;
+}
+
+//===================================================================
+// Deletes a key from the set
+bool vebDelete (vebtree *V, uint32_t key) {
+
+  if (! vebMember(V, key))
+    return false;
+
+    // clear the bit, and the bits of the higher levels as
+    // long as the words below them became empty
+  uint64_t *w = V->blocks[key >> 12] + ((key >> 6) & 63);
+  *w &= ~(1ULL << (key & 63));
+  bool isEmpty = *w == 0;
+  uint64_t i = key >> 6;
+  for (size_t k = 1; isEmpty && k < V->nLevels; k++, i >>= 6) {
+    w = V->levels[k] + (i >> 6);
+    *w &= ~(1ULL << (i & 63));
+    isEmpty = *w == 0;
+    if (k == 1 && isEmpty) {
+        // the block of level 0 holding the key is empty
+      free(V->blocks[i >> 6]);
+      V->blocks[i >> 6] = NULL;
+      V->nBlocks--;
+    }
+  }
+  V->size--;
+  return true;
+}
+
+//===================================================================
+// Returns the smallest key below bit i of the given level
+static inline uint64_t minBelow (vebtree *V, size_t level,
+                                 uint64_t i) {
+  for (; level > 0; level--)
+    i = i * 64 + lowBit(getWord(V, level - 1, i));
+  return i;
+}
+
+//===================================================================
+// Returns the largest key below bit i of the given level
+static inline uint64_t maxBelow (vebtree *V, size_t level,
+                                 uint64_t i) {
+  for (; level > 0; level--)
+    i = i * 64 + highBit(getWord(V, level - 1, i));
+  return i;
+}
+
+//===================================================================
+// Finds the smallest key in the set
+bool vebMin (vebtree *V, uint32_t *key) {
+  if (V->size == 0) return false;
+  size_t top = V->nLevels - 1;
+  *key = minBelow(V, top, lowBit(getWord(V, top, 0)));
+  return true;
+}
+
+//===================================================================
+// Finds the largest key in the set
+bool vebMax (vebtree *V, uint32_t *key) {
+  if (V->size == 0) return false;
+  size_t top = V->nLevels - 1;
+  *key = maxBelow(V, top, highBit(getWord(V, top, 0)));
+  return true;
+}
+
+//===================================================================
+// Finds the smallest key greater than the given key
+bool vebSuccessor (vebtree *V, uint32_t key, uint32_t *succ) {
+
+  if (key >= V->universe) return false;
+
+    // go up until a word has a set bit after bit i, and
+    // then go down to the smallest key below that bit
+  uint64_t i = key;
+  for (size_t k = 0; k < V->nLevels; k++, i >>= 6) {
+    unsigned pos = i & 63;
+    if (pos == 63)
+      continue;
+    uint64_t w = getWord(V, k, i >> 6) & (~0ULL << (pos + 1));
+    if (w) {
+      *succ = minBelow(V, k, (i & ~63ULL) + lowBit(w));
+      return true;
+    }
+  }
+  return false;
+}
+
+//===================================================================
+// Finds the largest key less than the given key
+bool vebPredecessor (vebtree *V, uint32_t key, uint32_t *pred) {
+
+  if (key >= V->universe)
+      // every key in the set is less than the given key
+    return vebMax(V, pred);
+
+    // go up until a word has a set bit before bit i, and
+    // then go down to the largest key below that bit
+  uint64_t i = key;
+  for (size_t k = 0; k < V->nLevels; k++, i >>= 6) {
+    unsigned pos = i & 63;
+    uint64_t w = getWord(V, k, i >> 6) & ((1ULL << pos) - 1);
+    if (w) {
+      *pred = maxBelow(V, k, (i & ~63ULL) + highBit(w));
+      return true;
+    }
+  }
+  return false;
+}
+
+//===================================================================
+// Removes the smallest key from the set
+bool vebPopMin (vebtree *V, uint32_t *key) {
+  if (! vebMin(V, key)) return false;
+  vebDelete(V, *key);
+  return true;
+}
+
+//===================================================================
+// Removes all keys from the set
+void vebClear (vebtree *V) {
+  uint64_t nBlocks = (V->universe + 4095) / 4096;
+  for (uint64_t b = 0; b < nBlocks; b++) {
+    free(V->blocks[b]);
+    V->blocks[b] = NULL;
+  }
+  uint64_t nWords = (V->universe + 63) / 64;
+  for (size_t k = 1; k < V->nLevels; k++) {
+    nWords = (nWords + 63) / 64;
+    memset(V->levels[k], 0, nWords * sizeof(uint64_t));
+  }
+  V->size = V->nBlocks = 0;
+}
+
+//===================================================================
+// Shows the keys in the set in increasing order
+void vebShow (vebtree *V) {
+  printf("--------------------\n"
+         " Integer set\n"
+         " Universe: %llu\n"
+         " Size: %zu\n"
+         "--------------------\n",
+         (unsigned long long)V->universe, V->size);
+  uint32_t key;
+  size_t count = 0;
+  for (bool found = vebMin(V, &key); found;
+       found = vebSuccessor(V, key, &key)) {
+    printf("%u%s", key, ++count < V->size ? ", " : "\n");
+    if (count % 10 == 0 && count < V->size) printf("\n");
+  }
+  printf("--------------------\n\n");
+}
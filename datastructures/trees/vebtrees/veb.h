@@ -0,0 +1,92 @@
+/*
+  Ordered set of integer keys, in the spirit of a van Emde Boas
+  tree: a hierarchy of 64-ary bitmaps
+    Level 0 has a bit for each key in the universe 0..U-1, and
+    bit i of level k+1 is set if word i of level k is not zero.
+    The top level is a single word. For a 32-bit universe there
+    are 6 levels, and each operation looks at one word per level,
+    using the bit scan instructions to find the next set bit in
+    a word. Level 0 is allocated in blocks of 4096 keys, only for
+    the parts of the universe that contain keys, and a block is
+    freed when its last key is deleted.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef VEB_H_INCLUDED
+#define VEB_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#define VEB_LEVELS 6          // enough levels for 32-bit keys
+
+typedef struct {
+  uint64_t **blocks;          // level 0, in blocks of 64 words
+  uint64_t *levels[VEB_LEVELS];  // levels 1 and up
+  size_t nLevels;             // number of levels in use
+  uint64_t universe;          // keys are in 0..universe-1
+  size_t size;                // number of keys in the set
+  size_t nBlocks;             // number of allocated blocks
+} vebtree;
+
+// function prototypes
+
+  // creates a new set for keys in 0..universe-1, where the
+  // universe is at most 2^32
+vebtree *vebNew (uint64_t universe);
+
+  // deallocates the set
+void vebFree (vebtree *V);
+
+  // inserts a key; returns false if the key was already
+  // in the set or is out of range
+bool vebInsert (vebtree *V, uint32_t key);
+
+  // deletes a key; returns false if the key was not in the set
+bool vebDelete (vebtree *V, uint32_t key);
+
+  // returns true if the key is in the set
+bool vebMember (vebtree *V, uint32_t key);
+
+  // sets *key to the smallest key in the set;
+  // returns false if the set is empty
+bool vebMin (vebtree *V, uint32_t *key);
+
+  // sets *key to the largest key in the set;
+  // returns false if the set is empty
+bool vebMax (vebtree *V, uint32_t *key);
+
+  // sets *succ to the smallest key in the set that is greater
+  // than key, which need not be in the set itself; returns
+  // false if there is no such key
+bool vebSuccessor (vebtree *V, uint32_t key, uint32_t *succ);
+
+  // sets *pred to the largest key in the set that is less
+  // than key; returns false if there is no such key
+bool vebPredecessor (vebtree *V, uint32_t key, uint32_t *pred);
+
+  // removes the smallest key from the set and stores it in
+  // *key, so that the set can be used as a monotone priority
+  // queue; returns false if the set is empty
+bool vebPopMin (vebtree *V, uint32_t *key);
+
+  // removes all keys from the set
+void vebClear (vebtree *V);
+
+  // shows the keys in the set in increasing order
+void vebShow (vebtree *V);
+
+  // returns the number of keys in the set
+static inline size_t vebSize (vebtree *V) {
+  return V->size;
+}
+
+  // returns true if the set is empty
+static inline bool vebIsEmpty (vebtree *V) {
+  return V->size == 0;
+}
+
+#endif  // VEB_H_INCLUDED
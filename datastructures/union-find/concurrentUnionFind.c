@@ -0,0 +1,104 @@
+
+#include "concurrentUnionFind.h"
+#include "../../lib/clib.h"
+#include <time.h>
+
+//===================================================================
+// Returns the parent of x
+static inline size_t getParent(concurrentUF *uf, size_t x) {
+  return __atomic_load_n(&uf->parent[x], __ATOMIC_ACQUIRE);
+}
+
+//===================================================================
+// Sets the parent of x from p to q, unless another thread changed
+// it first; returns true on success
+static inline bool casParent(concurrentUF *uf, size_t x, size_t p,
+                             size_t q) {
+  return __atomic_compare_exchange_n(&uf->parent[x], &p, q, false,
+                                     __ATOMIC_ACQ_REL,
+                                     __ATOMIC_ACQUIRE);
+}
+
+//===================================================================
+// Returns the linking priority of x: the splitmix64 finalizer is
+// a bijection, so that different indices never get the same one
+static inline uint64_t priority(concurrentUF *uf, size_t x) {
+  uint64_t z = x ^ uf->seed;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+//===================================================================
+// Creates a new union-find data structure with n singleton sets
+concurrentUF *cufNew(size_t n) {
+  concurrentUF *uf = safeCalloc(1, sizeof(concurrentUF));
+  uf->parent = safeCalloc(n ? n : 1, sizeof(size_t));
+  for (size_t i = 0; i < n; i++)
+    uf->parent[i] = i;
+  uf->seed = (uintptr_t)uf ^ ((uint64_t)time(NULL) << 32);
+  uf->n = uf->nSets = n;
+  return uf;
+}
+
+//===================================================================
+// Deallocates the union-find data structure
+void cufFree(concurrentUF *uf) {
+  if (!uf) return;
+  free(uf->parent);
+  free(uf);
+}
+
+//===================================================================
+// Finds the root of the set containing x, making every other node
+// on the path point to its grandparent
+size_t cufFindSet(concurrentUF *uf, size_t x) {
+  size_t p = getParent(uf, x);
+  while (p != x) {
+    size_t g = getParent(uf, p);
+    if (g == p)
+      return p;
+    casParent(uf, x, p, g);
+    x = g;
+    p = getParent(uf, x);
+  }
+  return x;
+}
+
+//===================================================================
+// Unifies the sets containing x and y by linking the root with
+// the lower priority below the other root; the link only succeeds
+// if the first root is still a root, and is retried otherwise
+bool cufUnify(concurrentUF *uf, size_t x, size_t y) {
+  while (true) {
+    x = cufFindSet(uf, x);
+    y = cufFindSet(uf, y);
+    if (x == y)
+      return false;
+    if (priority(uf, x) > priority(uf, y)) {
+      size_t t = x;
+      x = y;
+      y = t;
+    }
+    if (casParent(uf, x, x, y)) {
+      __atomic_fetch_sub(&uf->nSets, 1, __ATOMIC_RELAXED);
+      return true;
+    }
+  }
+}
+
+//===================================================================
+// Returns true if x and y are in the same set; if their roots
+// differ, the answer is only false if the root of x is still
+// a root after the root of y was found, since both were roots
+// at that moment
+bool cufSameSet(concurrentUF *uf, size_t x, size_t y) {
+  while (true) {
+    x = cufFindSet(uf, x);
+    y = cufFindSet(uf, y);
+    if (x == y)
+      return true;
+    if (getParent(uf, x) == x)
+      return false;
+  }
+}
@@ -0,0 +1,63 @@
+/*
+  Concurrent union find on the integers 0, 1, ..., n-1
+  Any number of threads may call find, unify and sameSet at the
+  same time without locks: the parents are kept in a flat array
+  whose entries are only changed by compare-and-swap, after
+  Jayanti and Tarjan, "Concurrent disjoint set union". A root is
+  linked below another root with a CAS that fails if it gained a
+  parent in the meantime, in which case the unify starts over;
+  finds shorten their paths by path halving, also with a CAS,
+  which may fail without harm, since it only skips a node that is
+  still on the path to the same root.
+  The roots are linked by randomized priority instead of rank, as
+  the rank of a root cannot be updated together with its parent:
+  each index has a fixed priority given by a hash of the index and
+  a seed, and the root with the lower priority is linked below the
+  other one. This keeps the trees of logarithmic height with high
+  probability, whatever the order of the unions.
+  All operations are lock-free and linearizable: a thread can only
+  have to retry because another thread made progress.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef CONCURRENTUNIONFIND_H_INCLUDED
+#define CONCURRENTUNIONFIND_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct concurrentUF {
+  size_t *parent;           // parent of each element
+  uint64_t seed;            // seed of the linking priorities
+  size_t n;                 // number of elements
+  size_t nSets;             // number of disjoint sets
+} concurrentUF;
+
+  // creates a new union-find structure with n singleton
+  // sets {0}, {1}, ..., {n-1}
+concurrentUF *cufNew(size_t n);
+
+  // deallocates the union-find structure; no other thread
+  // may still use it
+void cufFree(concurrentUF *uf);
+
+  // returns the root of the set containing x at some moment
+  // during the call; x must be less than n
+size_t cufFindSet(concurrentUF *uf, size_t x);
+
+  // unifies the sets containing x and y; returns false if they
+  // were already in the same set, and true otherwise
+bool cufUnify(concurrentUF *uf, size_t x, size_t y);
+
+  // returns true if x and y are in the same set; the answer
+  // holds at some moment during the call
+bool cufSameSet(concurrentUF *uf, size_t x, size_t y);
+
+  // returns the number of sets in the union-find structure
+static inline size_t cufNumSets(concurrentUF *uf) {
+  return __atomic_load_n(&uf->nSets, __ATOMIC_RELAXED);
+}
+
+#endif  // CONCURRENTUNIONFIND_H_INCLUDED
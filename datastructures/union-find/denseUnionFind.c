@@ -0,0 +1,43 @@
+
+#include "denseUnionFind.h"
+#include "../../lib/clib.h"
+
+//===================================================================
+// Creates a new union-find data structure with n singleton sets
+denseUF *dufNew(size_t n) {
+  denseUF *uf = safeCalloc(1, sizeof(denseUF));
+  uf->parent = safeCalloc(n ? n : 1, sizeof(size_t));
+  uf->rank = safeCalloc(n ? n : 1, sizeof(unsigned char));
+  for (size_t i = 0; i < n; i++)
+    uf->parent[i] = i;
+  uf->n = uf->nSets = n;
+  return uf;
+}
+
+//===================================================================
+// Deallocates the union-find data structure
+void dufFree(denseUF *uf) {
+  if (!uf) return;
+  free(uf->parent);
+  free(uf->rank);
+  free(uf);
+}
+
+//===================================================================
+// Unifies the sets containing x and y by making the root with
+// the smaller rank point to the other root
+bool dufUnify(denseUF *uf, size_t x, size_t y) {
+  x = dufFindSet(uf, x);
+  y = dufFindSet(uf, y);
+  if (x == y)
+    return false;
+  if (uf->rank[x] > uf->rank[y]) {
+    uf->parent[y] = x;
+  } else {
+    uf->parent[x] = y;
+    if (uf->rank[x] == uf->rank[y])
+      uf->rank[y]++;
+  }
+  uf->nSets--;
+  return true;
+}
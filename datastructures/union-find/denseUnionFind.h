@@ -0,0 +1,61 @@
+/*
+  Union find on the integers 0, 1, ..., n-1
+  with path halving and union by rank
+  Unlike the generic union find, which maps each data element to
+  the index of its set by hashing, this variant takes the indices
+  themselves, and keeps the parents and ranks in two flat arrays,
+  so that a find only follows array entries. It suits algorithms
+  whose elements are already numbered, such as the vertices of a
+  graph.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef DENSEUNIONFIND_H_INCLUDED
+#define DENSEUNIONFIND_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef struct denseUF {
+  size_t *parent;           // parent of each element
+  unsigned char *rank;      // upper bound on the height of each root
+  size_t n;                 // number of elements
+  size_t nSets;             // number of disjoint sets
+} denseUF;
+
+  // creates a new union-find structure with n singleton
+  // sets {0}, {1}, ..., {n-1}
+denseUF *dufNew(size_t n);
+
+  // deallocates the union-find structure
+void dufFree(denseUF *uf);
+
+  // returns the root of the set containing x; path halving makes
+  // every other node on the path point to its grandparent, which
+  // takes a single pass and gives the same bounds as full path
+  // compression; x must be less than n
+static inline size_t dufFindSet(denseUF *uf, size_t x) {
+  size_t *parent = uf->parent;
+  while (parent[x] != x) {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
+  }
+  return x;
+}
+
+  // unifies the sets containing x and y; returns false if they
+  // were already in the same set, and true otherwise
+bool dufUnify(denseUF *uf, size_t x, size_t y);
+
+  // returns true if x and y are in the same set
+static inline bool dufSameSet(denseUF *uf, size_t x, size_t y) {
+  return dufFindSet(uf, x) == dufFindSet(uf, y);
+}
+
+  // returns the number of sets in the union-find structure
+static inline size_t dufNumSets(denseUF *uf) {
+  return uf->nSets;
+}
+
+#endif  // DENSEUNIONFIND_H_INCLUDED
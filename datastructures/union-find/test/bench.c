@@ -0,0 +1,129 @@
+/*
+  Benchmark of the dense union find against the generic one
+  Streams m random edges over n vertices through each structure
+  in the way Kruskal's algorithm does: if the end points of an
+  edge are not yet in the same set, their sets are unified. The
+  generic union find is run once with the labels of the vertices
+  as keys, and once with their addresses as integer ids; the
+  dense union find takes the vertex numbers. The edges are
+  generated on the fly from the same seed for every run, so that
+  100 million edges take no memory; reports the time per edge
+  and the number of sets left, which must be the same for all
+  Usage: ./bench.out [n] [m]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../unionFind.h"
+#include "../denseUnionFind.h"
+#include "../../../lib/clib.h"
+#include <time.h>
+
+#define SEED 0x9e3779b97f4a7c15
+
+typedef struct {
+  char label[24];           // decimal label of the vertex
+} vertex;
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Returns the next number of a splitmix64 generator
+static uint64_t next (uint64_t *state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+//===================================================================
+// Returns the label of a vertex
+char *vertexToString (void const *data) {
+  return ((vertex *)data)->label;
+}
+
+//===================================================================
+// Returns the address of a vertex as its id
+uint64_t vertexToId (void const *data) {
+  return (uintptr_t)data;
+}
+
+//===================================================================
+// Streams the edges through a generic union find, keyed by label
+// or, if byId is true, by address; returns the number of sets left
+static size_t runGeneric (vertex *V, size_t n, size_t m, bool byId,
+                          double *time) {
+  unionFind *uf = ufNew(n, vertexToString);
+  if (byId)
+    ufSetToId(uf, vertexToId);
+  for (size_t i = 0; i < n; i++)
+    ufAddSet(uf, V + i);
+  uint64_t state = SEED;
+  double start = now();
+  for (size_t i = 0; i < m; i++) {
+    vertex *u = V + next(&state) % n, *v = V + next(&state) % n;
+    if (! ufSameSet(uf, u, v))
+      ufUnify(uf, u, v);
+  }
+  *time = now() - start;
+  size_t sets = ufNumSets(uf);
+  ufFree(uf);
+  return sets;
+}
+
+//===================================================================
+// Streams the edges through a dense union find
+static size_t runDense (size_t n, size_t m, double *time) {
+  denseUF *uf = dufNew(n);
+  uint64_t state = SEED;
+  double start = now();
+  for (size_t i = 0; i < m; i++) {
+    size_t u = next(&state) % n, v = next(&state) % n;
+    dufUnify(uf, u, v);
+  }
+  *time = now() - start;
+  size_t sets = dufNumSets(uf);
+  dufFree(uf);
+  return sets;
+}
+
+//===================================================================
+// Shows a result
+static void showResult (char *name, double time, size_t m,
+                        size_t sets) {
+  printf("  %-16s %8.2f s  %7.1f ns/edge  %zu sets\n", name, time,
+         time * 1e9 / m, sets);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t m = argc > 2 ? strtoul(argv[2], NULL, 10) : 100000000;
+  if (n == 0) {
+    fprintf(stderr, "bench: no vertices\n");
+    return 1;
+  }
+  vertex *V = safeCalloc(n, sizeof(vertex));
+  for (size_t i = 0; i < n; i++)
+    snprintf(V[i].label, sizeof(V[i].label), "%zu", i);
+  printf("%zu vertices, %zu edges\n", n, m);
+
+  double time;
+  size_t sets = runGeneric(V, n, m, false, &time);
+  showResult("generic, labels", time, m, sets);
+  sets = runGeneric(V, n, m, true, &time);
+  showResult("generic, ids", time, m, sets);
+  sets = runDense(n, m, &time);
+  showResult("dense", time, m, sets);
+
+  free(V);
+  return 0;
+}
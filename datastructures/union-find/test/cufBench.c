@@ -0,0 +1,149 @@
+/*
+  Benchmark of the concurrent union find for a growing number of
+    threads
+  Unifies the end points of m random edges over n vertices, with
+    the edges divided evenly over the threads, and then asks for m
+    random pairs whether they are in the same set; the sequential
+    dense union find does the same work for comparison. Edge i is
+    derived from i by a hash, so that all runs see the same edges
+    without storing them, and must end with the same number of sets
+  Usage: ./cufBench.out [n] [m] [max threads]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../concurrentUnionFind.h"
+#include "../denseUnionFind.h"
+#include "../../../lib/clib.h"
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+  concurrentUF *uf;         // shared union find
+  size_t n;                 // number of vertices
+  size_t lo, hi;            // range of edges of the thread
+  bool query;               // true for queries, false for unions
+  size_t found;             // number of pairs in the same set
+} workContext;
+
+//===================================================================
+// Returns the wall clock time in seconds
+static double now () {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+// Returns a hash of i, by the splitmix64 finalizer
+static uint64_t hash (uint64_t i) {
+  uint64_t z = i * 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+//===================================================================
+// Sets u and v to the end points of edge i, or to the pair of
+// query i if query is true
+static inline void pair (size_t i, size_t n, bool query,
+                         size_t *u, size_t *v) {
+  uint64_t h = hash(2 * i + query);
+  *u = (h >> 32) % n;
+  *v = (h & 0xffffffff) % n;
+}
+
+//===================================================================
+// Unifies or queries the pairs in the range of a thread
+static void *work (void *arg) {
+  workContext *w = arg;
+  for (size_t i = w->lo; i < w->hi; i++) {
+    size_t u, v;
+    pair(i, w->n, w->query, &u, &v);
+    if (w->query)
+      w->found += cufSameSet(w->uf, u, v);
+    else
+      cufUnify(w->uf, u, v);
+  }
+  return NULL;
+}
+
+//===================================================================
+// Runs the unions or the queries on t threads; returns the time
+// taken, and adds the number of pairs found in the same set
+static double runThreads (concurrentUF *uf, size_t n, size_t m,
+                          size_t t, bool query, size_t *found) {
+  pthread_t *threads = safeCalloc(t, sizeof(pthread_t));
+  workContext *w = safeCalloc(t, sizeof(workContext));
+  double start = now();
+  for (size_t i = 0; i < t; i++) {
+    w[i] = (workContext){uf, n, m * i / t, m * (i + 1) / t,
+                         query, 0};
+    pthread_create(threads + i, NULL, work, w + i);
+  }
+  for (size_t i = 0; i < t; i++) {
+    pthread_join(threads[i], NULL);
+    *found += w[i].found;
+  }
+  double time = now() - start;
+  free(threads);
+  free(w);
+  return time;
+}
+
+//===================================================================
+// Shows a result
+static void showResult (char *name, size_t t, double unions,
+                        double queries, size_t m, size_t sets,
+                        size_t found) {
+  printf("  %-10s %2zu thread%s  unions %6.1f ns  "
+         "queries %6.1f ns  %zu sets, %zu found\n", name, t,
+         t > 1 ? "s" : " ", unions * 1e9 / m, queries * 1e9 / m,
+         sets, found);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+  size_t m = argc > 2 ? strtoul(argv[2], NULL, 10) : 20000000;
+  size_t maxThreads = argc > 3 ? strtoul(argv[3], NULL, 10) :
+                                 sysconf(_SC_NPROCESSORS_ONLN);
+  if (n == 0) {
+    fprintf(stderr, "cufBench: no vertices\n");
+    return 1;
+  }
+  printf("%zu vertices, %zu edges, %ld processors\n", n, m,
+         sysconf(_SC_NPROCESSORS_ONLN));
+
+    // sequential baseline
+  denseUF *seq = dufNew(n);
+  size_t found = 0, u, v;
+  double start = now();
+  for (size_t i = 0; i < m; i++) {
+    pair(i, n, false, &u, &v);
+    dufUnify(seq, u, v);
+  }
+  double unions = now() - start;
+  start = now();
+  for (size_t i = 0; i < m; i++) {
+    pair(i, n, true, &u, &v);
+    found += dufSameSet(seq, u, v);
+  }
+  showResult("dense", 1, unions, now() - start, m, dufNumSets(seq),
+             found);
+  dufFree(seq);
+
+  for (size_t t = 1; t <= maxThreads; t *= 2) {
+    concurrentUF *uf = cufNew(n);
+    found = 0;
+    unions = runThreads(uf, n, m, t, false, &found);
+    double queries = runThreads(uf, n, m, t, true, &found);
+    showResult("concurrent", t, unions, queries, m, cufNumSets(uf),
+               found);
+    cufFree(uf);
+  }
+  return 0;
+}
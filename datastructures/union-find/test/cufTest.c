@@ -0,0 +1,230 @@
+/*
+  Linearizability stress test of the concurrent union find
+  Writer threads take the edges of a random graph one by one from
+  a shared counter, and unify their end points; after an edge is
+  done, its writer waits until all earlier edges are done before
+  announcing it, so that the announced edges always form a prefix.
+  Meanwhile, reader threads ask whether random pairs of vertices
+  are in the same set, and note which edges were announced before
+  the query and which were taken after it. Every answer is then
+  checked against the number of edges after which the pair is
+  connected, computed sequentially: the pair must be in the same
+  set if it was connected by announced edges, and may not be if
+  it was only connected by edges that were taken later. Finally,
+  the sets must be the same as those of a sequential union find,
+  and the number of successful unions must match the number of
+  sets.
+  Usage: ./cufTest.out [number of rounds] [number of threads]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include "../concurrentUnionFind.h"
+#include "../denseUnionFind.h"
+#include "../../../lib/clib.h"
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define N 2000               // number of vertices
+#define M 3000               // number of edges
+#define NEVER SIZE_MAX       // connection time of unconnected pairs
+
+typedef struct {
+  concurrentUF *uf;          // union find under test
+  size_t *u, *v;             // end points of the edges
+  bool *merged;              // result of the union of each edge
+  size_t taken;              // number of edges taken by writers
+  size_t announced;          // number of edges announced
+  size_t *par, *when;        // sequential forest with link times
+  size_t queries;            // number of queries checked
+  size_t errors;             // number of wrong answers
+} testContext;
+
+typedef struct {
+  testContext *c;
+  unsigned seed;             // seed of the reader
+} readerContext;
+
+//===================================================================
+// Returns the root of x in the sequential forest, and its depth
+static size_t seqRoot (size_t *par, size_t x, size_t *depth) {
+  *depth = 0;
+  while (par[x] != x) {
+    x = par[x];
+    (*depth)++;
+  }
+  return x;
+}
+
+//===================================================================
+// Builds the sequential forest, linking by rank without path
+// compression, and noting the index of the edge that linked
+// each node below its parent
+static void buildForest (testContext *c) {
+  unsigned char *rank = safeCalloc(N, sizeof(unsigned char));
+  for (size_t i = 0; i < N; i++)
+    c->par[i] = i;
+  for (size_t i = 0; i < M; i++) {
+    size_t dx, dy;
+    size_t x = seqRoot(c->par, c->u[i], &dx);
+    size_t y = seqRoot(c->par, c->v[i], &dy);
+    if (x == y)
+      continue;
+    if (rank[x] > rank[y]) {
+      size_t t = x;
+      x = y;
+      y = t;
+    }
+    c->par[x] = y;
+    c->when[x] = i;
+    if (rank[x] == rank[y])
+      rank[y]++;
+  }
+  free(rank);
+}
+
+//===================================================================
+// Returns the number of edges after which a and b are connected:
+// one more than the largest link time on the path between them,
+// or 0 if a and b are the same
+static size_t connectTime (testContext *c, size_t a, size_t b) {
+  size_t da, db;
+  if (seqRoot(c->par, a, &da) != seqRoot(c->par, b, &db))
+    return NEVER;
+  size_t t = 0;
+  for (; da > db; da--, a = c->par[a])
+    t = MAX(t, c->when[a] + 1);
+  for (; db > da; db--, b = c->par[b])
+    t = MAX(t, c->when[b] + 1);
+  for (; a != b; a = c->par[a], b = c->par[b])
+    t = MAX(t, MAX(c->when[a], c->when[b]) + 1);
+  return t;
+}
+
+//===================================================================
+// Unifies the end points of the edges, and announces them in order
+static void *writer (void *arg) {
+  testContext *c = arg;
+  size_t i;
+  while ((i = __atomic_fetch_add(&c->taken, 1,
+                                 __ATOMIC_SEQ_CST)) < M) {
+    c->merged[i] = cufUnify(c->uf, c->u[i], c->v[i]);
+    while (__atomic_load_n(&c->announced, __ATOMIC_ACQUIRE) != i)
+      sched_yield();
+    __atomic_store_n(&c->announced, i + 1, __ATOMIC_RELEASE);
+  }
+  return NULL;
+}
+
+//===================================================================
+// Checks same-set queries against the edges that were announced
+// before and taken after each query, until all edges are announced
+static void *reader (void *arg) {
+  readerContext *r = arg;
+  testContext *c = r->c;
+  size_t queries = 0, errors = 0, lo;
+  do {
+    size_t a = rand_r(&r->seed) % N, b = rand_r(&r->seed) % N;
+    lo = __atomic_load_n(&c->announced, __ATOMIC_SEQ_CST);
+    bool same = cufSameSet(c->uf, a, b);
+    size_t hi = __atomic_load_n(&c->taken, __ATOMIC_SEQ_CST);
+    size_t t = connectTime(c, a, b);
+    if ((t <= lo && ! same) || (t > hi && same))
+      errors++;
+    queries++;
+  } while (lo < M);
+  __atomic_fetch_add(&c->queries, queries, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&c->errors, errors, __ATOMIC_RELAXED);
+  return NULL;
+}
+
+//===================================================================
+// Runs one round with the given number of writers and readers
+// on a new random graph; returns true if all checks pass
+static bool testRound (size_t writers, size_t readers,
+                       size_t *queries) {
+  testContext c = {0};
+  c.uf = cufNew(N);
+  c.u = safeCalloc(M, sizeof(size_t));
+  c.v = safeCalloc(M, sizeof(size_t));
+  c.merged = safeCalloc(M, sizeof(bool));
+  c.par = safeCalloc(N, sizeof(size_t));
+  c.when = safeCalloc(N, sizeof(size_t));
+  for (size_t i = 0; i < M; i++) {
+    c.u[i] = rand() % N;
+    c.v[i] = rand() % N;
+  }
+  buildForest(&c);
+
+  pthread_t *threads = safeCalloc(writers + readers,
+                                  sizeof(pthread_t));
+  readerContext *rc = safeCalloc(readers, sizeof(readerContext));
+  for (size_t i = 0; i < readers; i++) {
+    rc[i] = (readerContext){&c, rand()};
+    pthread_create(threads + i, NULL, reader, rc + i);
+  }
+  for (size_t i = 0; i < writers; i++)
+    pthread_create(threads + readers + i, NULL, writer, &c);
+  for (size_t i = 0; i < writers + readers; i++)
+    pthread_join(threads[i], NULL);
+
+    // the final sets must be those of a sequential union find
+  denseUF *seq = dufNew(N);
+  size_t merged = 0;
+  for (size_t i = 0; i < M; i++) {
+    dufUnify(seq, c.u[i], c.v[i]);
+    merged += c.merged[i];
+  }
+  bool ok = c.errors == 0 && cufNumSets(c.uf) == dufNumSets(seq) &&
+            merged == N - cufNumSets(c.uf);
+  for (size_t x = 0; x < N; x++)
+    if (! cufSameSet(c.uf, x, dufFindSet(seq, x)))
+      ok = false;
+  *queries += c.queries;
+
+  dufFree(seq);
+  cufFree(c.uf);
+  free(c.u);
+  free(c.v);
+  free(c.merged);
+  free(c.par);
+  free(c.when);
+  free(threads);
+  free(rc);
+  return ok;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t rounds = argc > 1 ? strtoul(argv[1], NULL, 10) : 50;
+  size_t threads = argc > 2 ? strtoul(argv[2], NULL, 10) : 4;
+  if (threads < 2) threads = 2;
+  srand(time(NULL));
+
+  bool ok = true;
+  size_t queries = 0;
+  for (size_t i = 0; i < rounds; i++)
+    if (! testRound(threads - threads / 2, threads / 2, &queries))
+      ok = false;
+  printf("%zu rounds, %zu queries checked\n", rounds, queries);
+  printf("Linearizability: %s\n", ok ? "passed" : "FAILED");
+
+    // a single thread must see the sets of a sequential run
+  ok = true;
+  concurrentUF *uf = cufNew(N);
+  denseUF *seq = dufNew(N);
+  for (size_t i = 0; i < 4 * N && ok; i++) {
+    size_t a = rand() % N, b = rand() % N;
+    if (rand() % 2)
+      ok = cufUnify(uf, a, b) == dufUnify(seq, a, b);
+    else
+      ok = cufSameSet(uf, a, b) == dufSameSet(seq, a, b);
+  }
+  printf("Sequential: %s\n", ok ? "passed" : "FAILED");
+  cufFree(uf);
+  dufFree(seq);
+  return 0;
+}
@@ -0,0 +1,123 @@
+/*
+  Test of the generic union find with the data keyed by its
+    string and by an integer id, each with and without copies
+  The sets are built from the edges i, i+1 for i not a multiple
+    of 10, which gives the sets of ten consecutive vertices; the
+    lookups take the caller's vertex pointers, and must find the
+    right set and its root, which is a copy if the union find
+    copies the data. A second vertex with the same label as the
+    first one is found by the string key, but not by the id,
+    which is the address of the vertex
+  Author: David De Potter
+*/
+
+#include "../unionFind.h"
+#include "../../../lib/clib.h"
+
+#define N 100
+
+typedef struct {
+  char label[8];            // decimal label of the vertex
+} vertex;
+
+//===================================================================
+// Returns the label of a vertex
+char *vertexToString (void const *data) {
+  return ((vertex *)data)->label;
+}
+
+//===================================================================
+// Returns the address of a vertex as its id
+uint64_t vertexToId (void const *data) {
+  return (uintptr_t)data;
+}
+
+//===================================================================
+// Returns a copy of a vertex
+void *copyVertex (void const *data) {
+  vertex *copy = safeCalloc(1, sizeof(vertex));
+  *copy = *(vertex *)data;
+  return copy;
+}
+
+//===================================================================
+// Returns true if the root of the set of vertex i is vertex r of
+// V, or a copy of it if copied is true
+static bool rootIs (unionFind *uf, vertex *V, size_t i, size_t r,
+                    bool copied) {
+  vertex *root = ufFindSet(uf, V + i);
+  if (! root)
+    return false;
+  if (! copied)
+    return root == V + r;
+  return (root < V || root >= V + N) &&
+         strcmp(root->label, V[r].label) == 0;
+}
+
+//===================================================================
+// Builds the sets and checks the lookups; returns true if all
+// of them are right
+static bool testMode (vertex *V, bool byId, bool copy) {
+  unionFind *uf = ufNew(N, vertexToString);
+  if (byId) {
+      // a second call finds the string map already freed
+    ufSetToId(uf, vertexToId);
+    ufSetToId(uf, vertexToId);
+  }
+  if (copy)
+    ufCopyData(uf, copyVertex, free);
+  for (size_t i = 0; i < N; i++)
+    ufAddSet(uf, V + i);
+
+    // adding a vertex again adds nothing
+  ufAddSet(uf, V);
+  bool ok = ufNumSets(uf) == N;
+
+  for (size_t i = 0; i < N; i++)
+    if (i % 10 != 9)
+      ufUnify(uf, V + i, V + i + 1);
+  ok = ok && ufNumSets(uf) == N / 10;
+
+  for (size_t i = 0; i < N; i++) {
+    size_t first = i - i % 10;
+    if (! ufContains(uf, V + i) ||
+        ! ufSameSet(uf, V + i, V + first) ||
+        ufSameSet(uf, V + i, V + (first + 10) % N))
+      ok = false;
+      // all vertices of a set have the same root
+    vertex *root = ufFindSet(uf, V + first);
+    size_t r = 0;
+    while (r < N && strcmp(V[r].label, root->label) != 0)
+      r++;
+    if (r / 10 != i / 10 || ! rootIs(uf, V, i, r, copy))
+      ok = false;
+  }
+
+    // a vertex with the label of vertex 0 at another address
+  vertex other = V[0];
+  ok = ok && ufContains(uf, &other) == ! byId &&
+       ufSameSet(uf, &other, V + 1) == ! byId;
+
+  ufFree(uf);
+  return ok;
+}
+
+//===================================================================
+
+int main () {
+  vertex *V = safeCalloc(N, sizeof(vertex));
+  for (size_t i = 0; i < N; i++)
+    snprintf(V[i].label, sizeof(V[i].label), "%zu", i);
+
+  printf("String keys:         %s\n",
+         testMode(V, false, false) ? "correct" : "WRONG");
+  printf("String keys, copies: %s\n",
+         testMode(V, false, true) ? "correct" : "WRONG");
+  printf("Ids:                 %s\n",
+         testMode(V, true, false) ? "correct" : "WRONG");
+  printf("Ids, copies:         %s\n",
+         testMode(V, true, true) ? "correct" : "WRONG");
+
+  free(V);
+  return 0;
+}
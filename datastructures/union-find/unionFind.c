@@ -32,7 +32,9 @@ void ufFree(unionFind *uf) {
       uf->freeData(uf->sets[i]->data);
     free(uf->sets[i]);
   }
-  sstMapFree(uf->indexMap);
+  if (uf->indexMap)
+    sstMapFree(uf->indexMap);
+  u64MapFree(uf->idMap);
   free(uf->sets);
   free(uf);
 }
@@ -51,10 +53,42 @@ void ufCopyData(unionFind *uf, ufCpyData copyData,
   uf->freeData = freeData;
 }
 
+//===================================================================
+// Makes the union-find map the data to indices by integer id
+void ufSetToId(unionFind *uf, ufToId toId) {
+  if (uf->size > 0) {
+    fprintf(stderr, "ufSetToId: union-find is not empty\n");
+    return;
+  }
+  if (! toId)
+    return;
+  uf->toId = toId;
+  if (! uf->idMap)
+    uf->idMap = u64MapNew(uf->capacity);
+  if (uf->indexMap)
+    sstMapFree(uf->indexMap);
+  uf->indexMap = NULL;
+}
+
+//===================================================================
+// Returns true if the data is in the union-find and
+// sets idx to the index of its set
+static inline bool findIdx(unionFind *uf, void *data, size_t *idx) {
+  if (uf->toId) {
+    uint64_t val;
+    if (! u64MapHasKeyVal(uf->idMap, uf->toId(data), &val))
+      return false;
+    *idx = val;
+    return true;
+  }
+  return sstMapHasKeyVal(uf->indexMap, uf->toString(data), idx);
+}
+
 //===================================================================
 // Adds a new set to the union-find data structure
 void ufAddSet(unionFind *uf, void *data) {
-  if (sstMapHasKey(uf->indexMap, uf->toString(data)))
+  size_t idx;
+  if (findIdx(uf, data, &idx))
     return;
 
   if (uf->size >= uf->capacity) {
@@ -62,12 +96,18 @@ void ufAddSet(unionFind *uf, void *data) {
     uf->sets = safeRealloc(uf->sets, uf->capacity * sizeof(ufSet *));
   }
   
+  idx = uf->size;
+    // the key is taken from the caller's data, which is what
+    // later lookups get, and not from the copy
+  if (uf->toId)
+    u64MapAddKey(uf->idMap, uf->toId(data), idx);
+  else
+    sstMapAddKey(uf->indexMap, uf->toString(data), idx);
+
   if (uf->copyData)
     data = uf->copyData(data);
 
-  size_t idx = uf->size;
   ufSet *set = ufSetNew(idx, 0);
-  sstMapAddKey(uf->indexMap, uf->toString(data), idx);
   uf->sets[idx] = set;
   uf->sets[idx]->data = data;
   uf->size++;
@@ -87,7 +127,7 @@ static size_t ufFindRootIdx(unionFind *uf, size_t idx) {
 // returns NULL if the data is not in a set
 void *ufFindSet(unionFind *uf, void *data) {
   size_t idx;
-  if (!sstMapHasKeyVal(uf->indexMap, uf->toString(data), &idx))
+  if (! findIdx(uf, data, &idx))
     return NULL;
   return uf->sets[ufFindRootIdx(uf, idx)]->data;
 }
@@ -108,8 +148,8 @@ static void link(unionFind *uf, size_t x, size_t y) {
 // Unifies the sets containing the given data
 void ufUnify(unionFind *uf, void *data1, void *data2) {
   size_t idx1, idx2;
-  if (!sstMapHasKeyVal(uf->indexMap, uf->toString(data1), &idx1) ||
-      !sstMapHasKeyVal(uf->indexMap, uf->toString(data2), &idx2))
+  if (! findIdx(uf, data1, &idx1) ||
+      ! findIdx(uf, data2, &idx2))
     return;
   link(uf, ufFindRootIdx(uf, idx1), ufFindRootIdx(uf, idx2));
   uf->size--;
@@ -118,14 +158,15 @@ void ufUnify(unionFind *uf, void *data1, void *data2) {
 //===================================================================
 // Returns true if the data is in the union-find data structure
 bool ufContains(unionFind *uf, void *data) {
-  return sstMapHasKey(uf->indexMap, uf->toString(data));
+  size_t idx;
+  return findIdx(uf, data, &idx);
 }
 
 //===================================================================
 // Returns the rank of the set containing the data
 size_t ufRank(unionFind *uf, void *data) {
   size_t idx;
-  if (!sstMapHasKeyVal(uf->indexMap, uf->toString(data), &idx))
+  if (! findIdx(uf, data, &idx))
     return 0;
   return uf->sets[idx]->rank;
 }
@@ -134,8 +175,8 @@ size_t ufRank(unionFind *uf, void *data) {
 // Returns true if the data is in the same set as the other data
 bool ufSameSet(unionFind *uf, void *data1, void *data2) {
   size_t idx1, idx2;
-  if (!sstMapHasKeyVal(uf->indexMap, uf->toString(data1), &idx1) ||
-      !sstMapHasKeyVal(uf->indexMap, uf->toString(data2), &idx2))
+  if (! findIdx(uf, data1, &idx1) ||
+      ! findIdx(uf, data2, &idx2))
     return false;
   return ufFindRootIdx(uf, idx1) == ufFindRootIdx(uf, idx2);
 }
@@ -10,11 +10,14 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "../htables/single-value/string-size-t/sstMap.h"
+#include "../htables/single-value/uint64-uint64/u64Map.h"
 
 typedef void (*ufFreeData)(void *data);
 typedef void *(*ufCpyData)(void const *data);
 typedef char *(*ufToString)(void const *data);
+typedef uint64_t (*ufToId)(void const *data);
 
 typedef struct ufSet {
   void *data;
@@ -26,11 +29,13 @@ typedef struct ufSet {
 typedef struct unionFind {
   ufSet **sets;
   sstMap *indexMap;
+  u64Map *idMap;
   size_t size;
   size_t capacity;
   ufFreeData freeData;
   ufCpyData copyData;
   ufToString toString;
+  ufToId toId;
 } unionFind;
 
   // creates a new union-find structure
@@ -44,6 +49,15 @@ void ufOwnData(unionFind *uf, ufFreeData freeData);
 void ufCopyData(unionFind *uf, ufCpyData cpyData,
                 ufFreeData freeData);
 
+  // sets a function that maps each data element to a unique 
+  // integer id, which is then used instead of the string 
+  // representation to find the elements; must be called 
+  // before adding any sets; with ufCopyData, the ids (and the
+  // strings) are computed from the data the caller passes, and
+  // never from the copies, so that they must identify the data
+  // the caller will pass later, e.g. by its address
+void ufSetToId(unionFind *uf, ufToId toId);
+
   // create a new set with the given data
   // nothing happens if the data is already in a set
 void ufAddSet(unionFind *uf, void *data);
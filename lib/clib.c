@@ -56,4 +56,28 @@ void *safeRealloc(void *ptr, size_t newSize) {
     exit(EXIT_FAILURE);
   }
   return ptr;
+}
+
+//=================================================================
+// reads a line of any length from a file into a string, 
+// growing the string when the line does not fit
+bool readLine(FILE *fp, string *line) {
+  line->size = 0;
+  if (line->cap < 2) {
+    line->cap = 128;
+    line->data = safeRealloc(line->data, line->cap);
+  }
+  while (fgets((char *)line->data + line->size, 
+               line->cap - line->size, fp)) {
+    line->size += strlen((char *)line->data + line->size);
+    if (line->data[line->size - 1] == '\n') {
+      line->data[--line->size] = '\0';
+      return true;
+    }
+    if (line->size + 1 == line->cap) {
+      line->cap <<= 1;
+      line->data = safeRealloc(line->data, line->cap);
+    }
+  }
+  return line->size > 0;
 }
\ No newline at end of file
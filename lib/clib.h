@@ -291,4 +291,8 @@ static inline size_t strLen(string *s) {
   return s->size;
 }
 
+  // reads a line of any length from a file into a string,
+  // without the newline; returns false at the end of the file
+bool readLine(FILE *fp, string *line);
+
 #endif // CLIB_H_INCLUDED
\ No newline at end of file
@@ -0,0 +1,112 @@
+/* file: tpool.c
+   author: David De Potter
+   description: fork-join task pool
+*/
+
+#include "tpool.h"
+#include "../clib.h"
+
+//===================================================================
+// Removes a task from the queue; the lock must be held
+static void dequeue (tpool *P, tptask *t) {
+  if (t->prev)
+    t->prev->next = t->next;
+  else
+    P->newest = t->next;
+  if (t->next)
+    t->next->prev = t->prev;
+  else
+    P->oldest = t->prev;
+}
+
+//===================================================================
+// Runs a task that was taken from the queue; the lock must be
+// held, and is released while the task runs
+static void run (tpool *P, tptask *t) {
+  dequeue(P, t);
+  t->state = TP_RUNNING;
+  pthread_mutex_unlock(&P->lock);
+  t->fn(t->arg);
+  pthread_mutex_lock(&P->lock);
+  t->state = TP_DONE;
+  pthread_cond_broadcast(&P->changed);
+}
+
+//===================================================================
+// Runs the oldest tasks until the pool is stopped
+static void *work (void *arg) {
+  tpool *P = arg;
+  pthread_mutex_lock(&P->lock);
+  while (! P->stop) {
+    if (P->oldest)
+      run(P, P->oldest);
+    else
+      pthread_cond_wait(&P->changed, &P->lock);
+  }
+  pthread_mutex_unlock(&P->lock);
+  return NULL;
+}
+
+//===================================================================
+// Creates a pool with nThreads worker threads
+tpool *tpNew (size_t nThreads) {
+  tpool *P = safeCalloc(1, sizeof(tpool));
+  pthread_mutex_init(&P->lock, NULL);
+  pthread_cond_init(&P->changed, NULL);
+  P->nThreads = nThreads;
+  P->threads = safeCalloc(nThreads + 1, sizeof(pthread_t));
+  for (size_t i = 0; i < nThreads; i++)
+    pthread_create(P->threads + i, NULL, work, P);
+  return P;
+}
+
+//===================================================================
+// Stops the worker threads and deallocates the pool
+void tpFree (tpool *P) {
+  if (! P) return;
+  pthread_mutex_lock(&P->lock);
+  P->stop = true;
+  pthread_cond_broadcast(&P->changed);
+  pthread_mutex_unlock(&P->lock);
+  for (size_t i = 0; i < P->nThreads; i++)
+    pthread_join(P->threads[i], NULL);
+  pthread_cond_destroy(&P->changed);
+  pthread_mutex_destroy(&P->lock);
+  free(P->threads);
+  free(P);
+}
+
+//===================================================================
+// Adds a task to the newest end of the queue
+void tpSpawn (tpool *P, tptask *t, tpTaskFn fn, void *arg) {
+  t->fn = fn;
+  t->arg = arg;
+  t->state = TP_QUEUED;
+  t->prev = NULL;
+  pthread_mutex_lock(&P->lock);
+  t->next = P->newest;
+  if (P->newest)
+    P->newest->prev = t;
+  else
+    P->oldest = t;
+  P->newest = t;
+  pthread_cond_signal(&P->changed);
+  pthread_mutex_unlock(&P->lock);
+}
+
+//===================================================================
+// Waits for a task, running it or other tasks in the meantime;
+// the newest tasks are taken, which were probably spawned by
+// the task that is waited for, and hence help it along
+void tpSync (tpool *P, tptask *t) {
+  pthread_mutex_lock(&P->lock);
+  if (t->state == TP_QUEUED)
+    run(P, t);
+  while (t->state != TP_DONE) {
+    if (P->newest)
+      run(P, P->newest);
+    else
+      pthread_cond_wait(&P->changed, &P->lock);
+  }
+  pthread_mutex_unlock(&P->lock);
+}
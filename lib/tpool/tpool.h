@@ -0,0 +1,58 @@
+/* file: tpool.h
+   author: David De Potter
+   description: fork-join task pool
+     A task is spawned with tpSpawn and waited for with tpSync.
+     Idle worker threads take the oldest spawned tasks, which
+     in a divide-and-conquer algorithm are the largest ones,
+     while a thread that waits for a task runs it itself if no
+     worker has taken it yet, and otherwise helps out with other
+     tasks, so that no thread ever blocks while there is work.
+     Tasks live in memory owned by the caller, typically on the
+     stack of the function that spawns and syncs them.
+     Programs using the pool must be linked with -pthread.
+*/
+
+#ifndef TPOOL_H_INCLUDED
+#define TPOOL_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+typedef void (*tpTaskFn)(void *arg);
+
+typedef enum { TP_QUEUED, TP_RUNNING, TP_DONE } tpState;
+
+typedef struct tptask {
+  tpTaskFn fn;                // function to run
+  void *arg;                  // argument of the function
+  tpState state;              // state of the task
+  struct tptask *prev;        // newer task in the queue
+  struct tptask *next;        // older task in the queue
+} tptask;
+
+typedef struct {
+  pthread_t *threads;         // worker threads
+  size_t nThreads;            // number of worker threads
+  pthread_mutex_t lock;       // protects the queue and task states
+  pthread_cond_t changed;     // signals new or finished tasks
+  tptask *newest, *oldest;    // ends of the task queue
+  bool stop;                  // set when the pool is freed
+} tpool;
+
+  // creates a pool with nThreads worker threads; the threads
+  // that call tpSync also run tasks, so that nThreads is best
+  // set to the number of processors minus one
+tpool *tpNew (size_t nThreads);
+
+  // stops the worker threads and deallocates the pool; all
+  // spawned tasks must have been synced
+void tpFree (tpool *P);
+
+  // spawns the task fn(arg), using the memory of t
+void tpSpawn (tpool *P, tptask *t, tpTaskFn fn, void *arg);
+
+  // returns when the task t is done
+void tpSync (tpool *P, tptask *t);
+
+#endif  // TPOOL_H_INCLUDED